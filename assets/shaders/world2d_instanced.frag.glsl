@@ -0,0 +1,42 @@
+#version 330
+
+in vec2 vert_uv;
+flat in vec4 vert_tile_params;
+flat in uint vert_id;
+
+layout(location=0) out vec4 col;
+layout(location=1) out uint id;
+
+uniform sampler2D tex;
+
+void main() {
+	// position (top left corner) and size: (x, y, width, height)
+	vec2 uv = vec2(
+		vert_uv.x * vert_tile_params.z + vert_tile_params.x,
+		vert_uv.y * vert_tile_params.w + vert_tile_params.y
+	);
+
+	vec4 tex_val = texture(tex, uv);
+	int alpha = int(round(tex_val.a * 255));
+	switch (alpha) {
+		case 0:
+			col = tex_val;
+			discard;
+
+			// do not save the ID
+			return;
+		case 254:
+			col = vec4(1.0f, 0.0f, 0.0f, 1.0f);
+			break;
+		case 252:
+			col = vec4(0.0f, 1.0f, 0.0f, 1.0f);
+			break;
+		case 250:
+			col = vec4(0.0f, 0.0f, 1.0f, 1.0f);
+			break;
+		default:
+			col = tex_val;
+			break;
+	}
+	id = vert_id;
+}
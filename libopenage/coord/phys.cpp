@@ -1,24 +1,71 @@
-// Copyright 2016-2023 the openage authors. See copying.md for legal info.
+// Copyright 2016-2025 the openage authors. See copying.md for legal info.
 
 #include "phys.h"
 
+#include <cstdint>
+#include <cstdlib>
+
 #include "coord/pixel.h"
 #include "coord/scene.h"
 #include "coord/tile.h"
-#include "util/math.h"
-#include "util/math_constants.h"
+#include "util/fixed_point.h"
 
 
 namespace openage::coord {
 
+namespace {
+
+/**
+ * Calculate the angle between two vectors in degrees using only
+ * fixed point math, so that the result is deterministic.
+ *
+ * @return Angle in [0, 360).
+ */
+phys_angle_t angle_between(phys_t ne, phys_t se, phys_t other_ne, phys_t other_se) {
+	// scale the components down so that the products below can't overflow
+	auto fits = [](phys_t a, phys_t b) {
+		constexpr int64_t limit = int64_t{1} << 30;
+		return std::abs(a.get_raw_value()) < limit and std::abs(b.get_raw_value()) < limit;
+	};
+	while (not fits(ne, se)) {
+		ne /= 2;
+		se /= 2;
+	}
+	while (not fits(other_ne, other_se)) {
+		other_ne /= 2;
+		other_se /= 2;
+	}
+
+	int64_t det = other_ne.get_raw_value() * se.get_raw_value() - ne.get_raw_value() * other_se.get_raw_value();
+	int64_t dot = ne.get_raw_value() * other_ne.get_raw_value() + se.get_raw_value() * other_se.get_raw_value();
+
+	// atan2 only depends on the ratio of det and dot, so their scale doesn't matter
+	using angle_t = util::FixedPoint<int64_t, 30>;
+	auto radians = angle_t::from_raw_value(det).atan2fp(angle_t::from_raw_value(dot));
 
-double phys2_delta::length() const {
-	return std::hypot(this->ne.to_double(), this->se.to_double());
+	// round to the precision of phys_angle_t
+	auto angle = radians * 180 / angle_t::pi();
+	angle += angle_t::from_raw_value(int64_t{1} << (30 - 16 - 1));
+	if (angle < 0) {
+		angle += angle_t::from_int(360);
+	}
+	else if (angle >= angle_t::from_int(360)) {
+		angle -= angle_t::from_int(360);
+	}
+
+	return phys_angle_t::from_fixedpoint(angle);
+}
+
+} // namespace
+
+
+phys_t phys2_delta::length() const {
+	return this->ne.hypotfp(this->se);
 }
 
 
 phys2_delta phys2_delta::normalize(double length) const {
-	return *this * (length / this->length());
+	return *this * (length / this->length().to_double());
 }
 
 
@@ -32,22 +79,12 @@ scene2_delta phys2_delta::to_scene2() const {
 }
 
 phys_angle_t phys2_delta::to_angle(const coord::phys2_delta &other) const {
-	// TODO: Using floats here will result in inaccuracies.
-	//       Better use a fixed point version of atan2.
-	auto det = other.ne.to_float() * this->se.to_float() - this->ne.to_float() * other.se.to_float();
-	auto dot = this->ne.to_float() * other.ne.to_float() + this->se.to_float() * other.se.to_float();
-
-	auto angle = std::atan2(det, dot) * 180 / math::PI;
-	if (angle < 0) {
-		angle += 360;
-	}
-
-	return phys_angle_t::from_float(angle);
+	return angle_between(this->ne, this->se, other.ne, other.se);
 }
 
 
 double phys2::distance(phys2 other) const {
-	return (*this - other).length();
+	return (*this - other).length().to_double();
 }
 
 
@@ -63,13 +100,13 @@ scene2 phys2::to_scene2() const {
 	return scene2(this->ne, this->se);
 }
 
-double phys3_delta::length() const {
-	return math::hypot3(this->ne.to_double(), this->se.to_double(), this->up.to_double());
+phys_t phys3_delta::length() const {
+	return this->ne.hypotfp(this->se).hypotfp(this->up);
 }
 
 
 phys3_delta phys3_delta::normalize(double length) const {
-	return *this * (length / this->length());
+	return *this * (length / this->length().to_double());
 }
 
 
@@ -83,17 +120,7 @@ scene3_delta phys3_delta::to_scene3() const {
 }
 
 phys_angle_t phys3_delta::to_angle(const coord::phys2_delta &other) const {
-	// TODO: Using floats here will result in inaccuracies.
-	//       Better use a fixed point version of atan2.
-	auto det = other.ne.to_float() * this->se.to_float() - this->ne.to_float() * other.se.to_float();
-	auto dot = this->ne.to_float() * other.ne.to_float() + this->se.to_float() * other.se.to_float();
-
-	auto angle = std::atan2(det, dot) * 180 / math::PI;
-	if (angle < 0) {
-		angle += 360;
-	}
-
-	return phys_angle_t::from_float(angle);
+	return angle_between(this->ne, this->se, other.ne, other.se);
 }
 
 tile3 phys3::to_tile3() const {
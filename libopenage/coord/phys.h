@@ -1,4 +1,4 @@
-// Copyright 2016-2023 the openage authors. See copying.md for legal info.
+// Copyright 2016-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -24,14 +24,13 @@ namespace coord {
 struct phys2_delta : CoordNeSeRelative<phys_t, phys2, phys2_delta> {
 	using CoordNeSeRelative<phys_t, phys2, phys2_delta>::CoordNeSeRelative;
 
-	double length() const;
+	phys_t length() const;
 	phys2_delta normalize(double length = 1) const;
 
 	// coordinate conversions
 	phys3_delta to_phys3() const;
 	scene2_delta to_scene2() const;
 
-	// TODO: This DOES NOT use fixed point math currently
 	phys_angle_t to_angle(const coord::phys2_delta &other = {-1, 1}) const;
 };
 
@@ -54,14 +53,13 @@ struct phys3_delta : CoordNeSeUpRelative<phys_t, phys3, phys3_delta> {
 	// tile3_delta{1, 0, 0} depending on the absolute position.
 	// we don't allow ambiguous conversions.
 
-	double length() const;
+	phys_t length() const;
 	phys3_delta normalize(double length = 1) const;
 
 	// coordinate conversions
 	phys2_delta to_phys2() const;
 	scene3_delta to_scene3() const;
 
-	// TODO: This DOES NOT use fixed point math currently
 	phys_angle_t to_angle(const coord::phys2_delta &other = {-1, 1}) const;
 };
 
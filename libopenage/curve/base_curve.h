@@ -8,6 +8,7 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "error/error.h"
 #include "log/log.h"
@@ -136,6 +137,22 @@ public:
 	          const std::function<T(const O &)> &converter,
 	          const time::time_t &start = time::TIME_MIN);
 
+	/**
+	 * Replace the keyframes at t >= start with keyframes taken from another curve.
+	 * After syncing, the two curves are guaranteed to return the same values
+	 * for t >= start.
+	 *
+	 * Useful if the other curve can't be accessed directly, e.g. because
+	 * it is modified by another thread.
+	 *
+	 * @param keyframes Keyframes of the other curve with t >= start, sorted by time.
+	 * @param start_value Value of the other curve at \p start.
+	 * @param start Start time at which keyframes are replaced.
+	 */
+	void sync(const std::vector<Keyframe<T>> &keyframes,
+	          const T &start_value,
+	          const time::time_t &start);
+
 	/**
 	 * Get the identifier of this curve.
 	 *
@@ -316,5 +333,25 @@ void BaseCurve<T>::sync(const BaseCurve<O> &other,
 	this->changes(start);
 }
 
+
+template <typename T>
+void BaseCurve<T>::sync(const std::vector<Keyframe<T>> &keyframes,
+                        const T &start_value,
+                        const time::time_t &start) {
+	// Replace keyframes for t >= start
+	auto at = this->container.last_before(start);
+	at = this->container.erase_after(at);
+	for (const auto &keyframe : keyframes) {
+		at = this->container.insert_after(keyframe, at);
+	}
+	this->last_element = this->container.size();
+
+	if (this->get(start) != start_value) {
+		this->set_insert(start, start_value);
+	}
+
+	this->changes(start);
+}
+
 } // namespace curve
 } // namespace openage
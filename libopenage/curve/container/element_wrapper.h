@@ -48,6 +48,15 @@ public:
 		return _alive;
 	}
 
+	/**
+	 * Set the insertion time of this element.
+	 *
+	 * @param time Time when the element was inserted into the container.
+	 */
+	void set_alive(const time::time_t &time) {
+		_alive = time;
+	}
+
 	/**
 	 * Get the erasure time of this element.
 	 *
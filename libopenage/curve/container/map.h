@@ -2,12 +2,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <optional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "curve/container/element_wrapper.h"
+#include "curve/container/map_alive_iterator.h"
 #include "curve/container/map_filter_iterator.h"
 #include "time/time.h"
 #include "util/fixed_point.h"
@@ -17,18 +21,55 @@ namespace openage::curve {
 
 /**
  * Map that keeps track of the lifetime of the contained elements.
- * Make sure that no key is reused.
+ * Make sure that no key is reused while its element is still stored.
+ *
+ * Elements are stored densely, so iterating over the map only visits
+ * the stored elements. Elements that are dead stay in the map until they are
+ * removed with \p clean(), which allows looking up past states until then.
+ *
+ * Inserting or removing elements invalidates all iterators.
  */
 template <typename key_t, typename val_t>
 class UnorderedMap {
 	/**
-	 * Data holder. Maps keys to map elements.
+	 * Data holder. Stores the keys and the map elements.
 	 * Map elements themselves store when they are valid.
 	 */
-	std::unordered_map<key_t, element_wrapper<val_t>> container;
+	std::vector<std::pair<key_t, element_wrapper<val_t>>> container;
+
+	/**
+	 * Position of each key in \p container.
+	 */
+	std::unordered_map<key_t, size_t> index;
+
+	/**
+	 * Erasure times of the killed elements, ordered as a min-heap.
+	 *
+	 * Entries are not updated when an element is killed again or removed,
+	 * so they have to be checked against the element before using them.
+	 */
+	std::vector<std::pair<time::time_t, key_t>> deaths;
+
+	/**
+	 * Heap order of \p deaths, with the earliest erasure time on top.
+	 */
+	static bool later_death(const std::pair<time::time_t, key_t> &a,
+	                        const std::pair<time::time_t, key_t> &b) {
+		return a.first > b.first;
+	}
+
+	/**
+	 * Remember the erasure time of an element for \p clean().
+	 */
+	void add_death(const time::time_t &time, const key_t &key);
+
+	/**
+	 * Remove the element at a position from the container.
+	 */
+	void erase(size_t pos);
 
 public:
-	using const_iterator = typename std::unordered_map<key_t, element_wrapper<val_t>>::const_iterator;
+	using const_iterator = typename std::vector<std::pair<key_t, element_wrapper<val_t>>>::const_iterator;
 
 	std::optional<MapFilterIterator<key_t, val_t, UnorderedMap>>
 	operator()(const time::time_t &, const key_t &) const;
@@ -42,6 +83,25 @@ public:
 	MapFilterIterator<key_t, val_t, UnorderedMap>
 	end(const time::time_t &e = time::TIME_MAX) const;
 
+	/**
+	 * Get an iterator to the first element that is alive at a given time.
+	 *
+	 * Only stored elements are visited, so the cost of iterating
+	 * does not depend on how many elements were removed by \p clean().
+	 *
+	 * @param time Time at which the elements must be alive.
+	 *
+	 * @return Iterator to the first alive element or \p alive_end().
+	 */
+	MapAliveIterator<key_t, val_t, UnorderedMap>
+	alive_begin(const time::time_t &time) const;
+
+	/**
+	 * Get the iterator past the last element for \p alive_begin().
+	 */
+	MapAliveIterator<key_t, val_t, UnorderedMap>
+	alive_end(const time::time_t &time = time::TIME_MAX) const;
+
 	MapFilterIterator<key_t, val_t, UnorderedMap>
 	insert(const time::time_t &birth, const key_t &, const val_t &);
 
@@ -53,21 +113,37 @@ public:
 
 	void birth(const time::time_t &, const key_t &);
 	void birth(const time::time_t &,
-	           const MapFilterIterator<val_t, val_t, UnorderedMap> &);
+	           const MapFilterIterator<key_t, val_t, UnorderedMap> &);
 
 	void kill(const time::time_t &, const key_t &);
 	void kill(const time::time_t &,
-	          const MapFilterIterator<val_t, val_t, UnorderedMap> &);
+	          const MapFilterIterator<key_t, val_t, UnorderedMap> &);
 
-	// remove all dead elements before that point in time
-	void clean(const time::time_t &);
+	/**
+	 * Remove all elements that are dead at or before a point in time.
+	 *
+	 * The elements can no longer be looked up afterwards, even for
+	 * earlier times. Only elements that were killed are checked, so the
+	 * cost does not depend on the number of alive elements.
+	 *
+	 * @param time Watermark. No lookups before this time may happen afterwards.
+	 */
+	void clean(const time::time_t &time);
+
+	/**
+	 * Get the number of stored elements, including dead elements
+	 * that were not removed yet.
+	 *
+	 * @return Number of elements.
+	 */
+	size_t size() const;
 
 	/**
 	 * gdb helper method.
 	 */
 	void dump() {
-		for (auto i : container) {
-			std::cout << "Element: " << i.second.value << std::endl;
+		for (auto &i : container) {
+			std::cout << "Element: " << i.second.value() << std::endl;
 		}
 	}
 };
@@ -83,8 +159,13 @@ template <typename key_t, typename val_t>
 std::optional<MapFilterIterator<key_t, val_t, UnorderedMap<key_t, val_t>>>
 UnorderedMap<key_t, val_t>::at(const time::time_t &time,
                                const key_t &key) const {
-	auto e = this->container.find(key);
-	if (e != this->container.end() and e->second.alive() <= time and e->second.dead() > time) {
+	auto pos = this->index.find(key);
+	if (pos == this->index.end()) {
+		return {};
+	}
+
+	auto e = this->container.begin() + pos->second;
+	if (e->second.alive() <= time and e->second.dead() > time) {
 		return MapFilterIterator<key_t, val_t, UnorderedMap<key_t, val_t>>(
 			e,
 			this,
@@ -116,6 +197,29 @@ UnorderedMap<key_t, val_t>::end(const time::time_t &time) const {
 		time);
 }
 
+template <typename key_t, typename val_t>
+MapAliveIterator<key_t, val_t, UnorderedMap<key_t, val_t>>
+UnorderedMap<key_t, val_t>::alive_begin(const time::time_t &time) const {
+	auto it = MapAliveIterator<key_t, val_t, UnorderedMap<key_t, val_t>>(
+		this->container.begin(),
+		this,
+		time);
+
+	if (it != this->alive_end() and not it.valid()) {
+		++it;
+	}
+	return it;
+}
+
+template <typename key_t, typename val_t>
+MapAliveIterator<key_t, val_t, UnorderedMap<key_t, val_t>>
+UnorderedMap<key_t, val_t>::alive_end(const time::time_t &time) const {
+	return MapAliveIterator<key_t, val_t, UnorderedMap<key_t, val_t>>(
+		this->container.end(),
+		this,
+		time);
+}
+
 template <typename key_t, typename val_t>
 MapFilterIterator<key_t, val_t, UnorderedMap<key_t, val_t>>
 UnorderedMap<key_t, val_t>::between(const time::time_t &from, const time::time_t &to) const {
@@ -149,10 +253,16 @@ UnorderedMap<key_t, val_t>::insert(const time::time_t &alive,
                                    const time::time_t &dead,
                                    const key_t &key,
                                    const val_t &value) {
-	element_wrapper<val_t> e{alive, dead, value};
-	auto it = this->container.insert(std::make_pair(key, e));
+	auto [pos, inserted] = this->index.try_emplace(key, this->container.size());
+	if (inserted) {
+		this->container.emplace_back(key, element_wrapper<val_t>{alive, dead, value});
+		if (dead != time::TIME_MAX) {
+			this->add_death(dead, key);
+		}
+	}
+
 	return MapFilterIterator<key_t, val_t, UnorderedMap<key_t, val_t>>(
-		it.first,
+		this->container.begin() + pos->second,
 		this,
 		alive,
 		dead);
@@ -161,36 +271,71 @@ UnorderedMap<key_t, val_t>::insert(const time::time_t &alive,
 template <typename key_t, typename val_t>
 void UnorderedMap<key_t, val_t>::birth(const time::time_t &time,
                                        const key_t &key) {
-	auto it = this->container.find(key);
-	if (it != this->container.end()) {
-		it->second.alive = time;
+	auto pos = this->index.find(key);
+	if (pos != this->index.end()) {
+		this->container[pos->second].second.set_alive(time);
 	}
 }
 
 template <typename key_t, typename val_t>
 void UnorderedMap<key_t, val_t>::birth(const time::time_t &time,
-                                       const MapFilterIterator<val_t, val_t, UnorderedMap> &it) {
-	it->second.alive = time;
+                                       const MapFilterIterator<key_t, val_t, UnorderedMap> &it) {
+	this->birth(time, it.key());
 }
 
 template <typename key_t, typename val_t>
 void UnorderedMap<key_t, val_t>::kill(const time::time_t &time,
                                       const key_t &key) {
-	auto it = this->container.find(key);
-	if (it != this->container.end()) {
-		it->second.dead = time;
+	auto pos = this->index.find(key);
+	if (pos != this->index.end()) {
+		this->container[pos->second].second.set_dead(time);
+		this->add_death(time, key);
 	}
 }
 
 template <typename key_t, typename val_t>
 void UnorderedMap<key_t, val_t>::kill(const time::time_t &time,
-                                      const MapFilterIterator<val_t, val_t, UnorderedMap> &it) {
-	it->second.dead = time;
+                                      const MapFilterIterator<key_t, val_t, UnorderedMap> &it) {
+	this->kill(time, it.key());
+}
+
+template <typename key_t, typename val_t>
+void UnorderedMap<key_t, val_t>::clean(const time::time_t &time) {
+	while (not this->deaths.empty() and this->deaths.front().first <= time) {
+		std::pop_heap(this->deaths.begin(), this->deaths.end(), later_death);
+		auto [dead, key] = std::move(this->deaths.back());
+		this->deaths.pop_back();
+
+		// skip outdated entries of elements that were killed again or already removed
+		auto pos = this->index.find(key);
+		if (pos != this->index.end() and this->container[pos->second].second.dead() == dead) {
+			this->erase(pos->second);
+		}
+	}
 }
 
 template <typename key_t, typename val_t>
-void UnorderedMap<key_t, val_t>::clean(const time::time_t &) {
-	// TODO save everything to a file and be happy.
+size_t UnorderedMap<key_t, val_t>::size() const {
+	return this->container.size();
+}
+
+template <typename key_t, typename val_t>
+void UnorderedMap<key_t, val_t>::add_death(const time::time_t &time,
+                                           const key_t &key) {
+	this->deaths.emplace_back(time, key);
+	std::push_heap(this->deaths.begin(), this->deaths.end(), later_death);
+}
+
+template <typename key_t, typename val_t>
+void UnorderedMap<key_t, val_t>::erase(size_t pos) {
+	this->index.erase(this->container[pos].first);
+
+	// fill the gap with the last element
+	if (pos != this->container.size() - 1) {
+		this->container[pos] = std::move(this->container.back());
+		this->index[this->container[pos].first] = pos;
+	}
+	this->container.pop_back();
 }
 
 } // namespace openage::curve
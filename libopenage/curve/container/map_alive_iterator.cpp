@@ -0,0 +1,9 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "map_alive_iterator.h"
+
+namespace openage::curve {
+
+// This file is intended to be empty
+
+} // namespace openage::curve
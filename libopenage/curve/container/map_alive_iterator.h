@@ -0,0 +1,56 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include "curve/container/iterator.h"
+#include "time/time.h"
+
+
+namespace openage::curve {
+
+/**
+ * Iterates over all elements of a map that are alive at a point in time,
+ * i.e. elements that were inserted at or before the time and are erased after it.
+ */
+template <typename key_t,
+          typename val_t,
+          typename container_t>
+class MapAliveIterator : public CurveIterator<val_t, container_t> {
+public:
+	using iterator_t = typename container_t::const_iterator;
+
+	/**
+	 * Construct the iterator.
+	 *
+	 * @param base Position in the container.
+	 * @param container Container that is iterated.
+	 * @param time Time at which the elements must be alive.
+	 */
+	MapAliveIterator(const iterator_t &base,
+	                 const container_t *container,
+	                 const time::time_t &time) :
+		CurveIterator<val_t, container_t>(base, container, time, time) {}
+
+	using CurveIterator<val_t, container_t>::operator=;
+
+	virtual bool valid() const override {
+		return (this->get_base()->second.alive() <= this->from
+		        and this->get_base()->second.dead() > this->from);
+	}
+
+	/**
+	 * Get the value behind the iterator.
+	 */
+	val_t const &value() const override {
+		return this->get_base()->second.value();
+	}
+
+	/**
+	 * Get the key pointed to by this iterator.
+	 */
+	const key_t &key() const {
+		return this->get_base()->first;
+	}
+};
+
+} // namespace openage::curve
@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
+#include <deque>
 #include <iostream>
 #include <iterator>
 #include <list>
@@ -16,6 +18,7 @@
 #include "curve/container/queue_filter_iterator.h"
 #include "event/evententity.h"
 #include "time/time.h"
+#include "util/memory_tag.h"
 #include "util/fixed_point.h"
 
 
@@ -30,14 +33,23 @@ namespace curve {
  * A container that manages events on a timeline. Every event has exactly one
  * time it will happen.
  * This container can be used to store interactions
+ *
+ * Elements are sorted by insertion time. Popped elements stay in the
+ * container (so that the queue can be accessed at earlier times) until
+ * they are removed with \p compact().
  */
 template <class T>
 class Queue : public event::EventEntity {
 public:
 	/**
 	 * The underlaying container type.
+	 *
+	 * Supports random access for searching by time and cheap removal
+	 * of elements at the front for compaction. Its memory is accounted
+	 * to the curve memory tag.
 	 */
-	using container_t = typename std::vector<element_wrapper<T>>;
+	using container_t = std::deque<element_wrapper<T>,
+	                               util::TaggedAllocator<element_wrapper<T>, util::memory_tag::curve>>;
 
 	/**
 	 * The index type to access elements in the container
@@ -162,6 +174,16 @@ public:
 	 */
 	void clear(const time::time_t &time);
 
+	/**
+	 * Remove the elements at the front of the queue that are dead at t <= time.
+	 *
+	 * Keeps the queue from growing if elements are inserted and popped
+	 * repeatedly. Afterwards, the queue must not be accessed at t < time.
+	 *
+	 * @param time Time before which the queue is not accessed anymore.
+	 */
+	void compact(const time::time_t &time);
+
 	/**
 	 * Print the queue to stdout.
 	 */
@@ -374,17 +396,18 @@ void Queue<T>::kill(const time::time_t &time,
 template <typename T>
 QueueFilterIterator<T, Queue<T>> Queue<T>::insert(const time::time_t &time,
                                                   const T &e) {
-	elem_ptr at = this->container.size();
-	while (at > 0) {
-		--at;
-		if (this->container.at(at).alive() <= time) {
-			++at;
-			break;
-		}
+	// insert after all elements with insertion time <= time
+	iterator insertion_point = this->container.end();
+	if (not this->container.empty() and this->container.back().alive() > time) {
+		insertion_point = std::upper_bound(
+			this->container.begin(),
+			this->container.end(),
+			time,
+			[](const time::time_t &time, const element_wrapper<T> &elem) {
+				return time < elem.alive();
+			});
 	}
-
-	// Get the iterator to the insertion point
-	iterator insertion_point = std::next(this->container.begin(), at);
+	elem_ptr at = std::distance(this->container.begin(), insertion_point);
 	insertion_point = this->container.insert(insertion_point, element_wrapper<T>{time, e});
 
 	// TODO: Inserting before any dead elements shoud reset their death time
@@ -442,5 +465,26 @@ void Queue<T>::clear(const time::time_t &time) {
 }
 
 
+template <typename T>
+void Queue<T>::compact(const time::time_t &time) {
+	// elements are killed in order, so dead elements are at the front
+	elem_ptr count = 0;
+	while (count != this->container.size()
+	       and this->container.at(count).dead() <= time) {
+		++count;
+	}
+
+	if (count == 0) {
+		return;
+	}
+
+	this->container.erase(this->container.begin(),
+	                      std::next(this->container.begin(), count));
+
+	// keep the cached front position pointing to the same element
+	this->front_start = this->front_start > count ? this->front_start - count : 0;
+}
+
+
 } // namespace curve
 } // namespace openage
@@ -1,4 +1,4 @@
-// Copyright 2017-2024 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -6,10 +6,12 @@
 #include <functional>
 #include <iostream>
 #include <list>
+#include <vector>
 
 #include "curve/keyframe.h"
 #include "time/time.h"
 #include "util/fixed_point.h"
+#include "util/memory_tag.h"
 
 
 namespace openage::curve {
@@ -33,9 +35,10 @@ public:
 	using keyframe_t = Keyframe<T>;
 
 	/**
-	 * The underlaying container type.
+	 * The underlaying container type. Its memory is accounted to the curve memory tag.
 	 */
-	using container_t = std::vector<keyframe_t>;
+	using container_t = std::vector<keyframe_t,
+	                                util::TaggedAllocator<keyframe_t, util::memory_tag::curve>>;
 
 	/**
 	 * The index type to access elements in the container
@@ -1,6 +1,7 @@
 // Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
 #include <algorithm>
+#include <chrono>
 #include <deque>
 #include <iostream>
 #include <memory>
@@ -16,6 +17,7 @@
 #include "curve/container/queue.h"
 #include "curve/container/queue_filter_iterator.h"
 #include "event/event_loop.h"
+#include "log/log.h"
 #include "testing/testing.h"
 
 
@@ -136,11 +138,59 @@ void test_map() {
 		}
 		TESTEQUALS(reference.empty(), true);
 	}
+	// Test 4.0 Alive iteration and cleanup
+	{
+		UnorderedMap<int, int> alive_map;
+		alive_map.insert(0, 1, 1);
+		alive_map.insert(0, 2, 2);
+		alive_map.insert(5, 3, 3);
+		alive_map.kill(10, 1);
+		alive_map.kill(20, 2);
+
+		auto alive_keys = [&](const time::time_t &time) {
+			std::unordered_set<int> keys;
+			for (auto it = alive_map.alive_begin(time); it != alive_map.alive_end(); ++it) {
+				keys.insert(it.key());
+			}
+			return keys;
+		};
+		(alive_keys(0) == std::unordered_set<int>{1, 2}) or TESTFAIL;
+		(alive_keys(5) == std::unordered_set<int>{1, 2, 3}) or TESTFAIL;
+		(alive_keys(10) == std::unordered_set<int>{2, 3}) or TESTFAIL;
+		(alive_keys(20) == std::unordered_set<int>{3}) or TESTFAIL;
+
+		// killing an element again replaces its erasure time
+		alive_map.kill(30, 2);
+		alive_map.clean(15);
+		(alive_map.size() == 2) or TESTFAIL;
+		TESTEQUALS(alive_map.at(12, 1).has_value(), false);
+		TESTEQUALS(alive_map.at(25, 2).has_value(), true);
+		(alive_keys(20) == std::unordered_set<int>{2, 3}) or TESTFAIL;
+
+		alive_map.clean(30);
+		(alive_map.size() == 1) or TESTFAIL;
+		TESTEQUALS(alive_map.at(30, 3).value().value(), 3);
+		(alive_keys(30) == std::unordered_set<int>{3}) or TESTFAIL;
+
+		// removed keys can be inserted again
+		alive_map.insert(40, 1, 4);
+		TESTEQUALS(alive_map.at(40, 1).value().value(), 4);
+		(alive_keys(40) == std::unordered_set<int>{1, 3}) or TESTFAIL;
+	}
 }
 
 void test_list() {
 }
 
+template <typename T>
+size_t count_elements(const Queue<T> &q) {
+	size_t count = 0;
+	for (auto it = q.begin(); it != q.end(); ++it) {
+		++count;
+	}
+	return count;
+}
+
 void test_queue() {
 	static_assert(std::is_copy_constructible<QueueFilterIterator<int, Queue<int>>>::value,
 	              "QueueIterator not Copy Constructable able");
@@ -241,6 +291,30 @@ void test_queue() {
 	q.clear(0);
 	TESTEQUALS(q.empty(0), true);
 	TESTEQUALS(q.empty(100001), false);
+
+	// compaction removes popped elements without changing the queue at later times
+	Queue<int> c{loop, 0};
+	for (int i = 0; i < 10; ++i) {
+		c.insert(i, i);
+	}
+	TESTEQUALS(c.pop_front(5), 0);
+	TESTEQUALS(c.pop_front(5), 1);
+	TESTEQUALS(c.pop_front(6), 2);
+
+	c.compact(5);
+	TESTEQUALS(count_elements(c), 8);
+	TESTEQUALS(c.front(6), 3);
+
+	c.compact(6);
+	TESTEQUALS(count_elements(c), 7);
+	TESTEQUALS(c.front(6), 3);
+	TESTEQUALS(*c.begin(), 3);
+
+	// inserting before the front
+	c.insert(2, 20);
+	TESTEQUALS(c.front(6), 20);
+	TESTEQUALS(c.pop_front(7), 20);
+	TESTEQUALS(c.pop_front(7), 3);
 }
 
 void test_array() {
@@ -355,4 +429,78 @@ void container() {
 }
 
 
+void queue_benchmark() {
+	using clock = std::chrono::steady_clock;
+	constexpr int cycles = 100000;
+
+	auto loop = std::make_shared<event::EventLoop>();
+	auto command = std::make_shared<int>(0);
+
+	// commands are added, checked and popped like in the command queue of a unit
+	auto run = [&](bool compact) {
+		Queue<std::shared_ptr<int>> q{loop, 0};
+
+		auto start = clock::now();
+		for (int i = 0; i < cycles; ++i) {
+			time::time_t time = i;
+			q.insert(time, command);
+			if (not q.empty(time) and q.front(time) == command) {
+				q.pop_front(time);
+			}
+			if (compact) {
+				q.compact(time);
+			}
+		}
+		std::chrono::duration<double, std::nano> duration = clock::now() - start;
+
+		log::log(INFO << cycles << " insert/pop cycles " << (compact ? "with" : "without")
+		              << " compaction: " << duration.count() / cycles << " ns/cycle, "
+		              << count_elements(q) << " elements stored");
+	};
+
+	run(false);
+	run(true);
+}
+
+
+
+void map_benchmark() {
+	using clock = std::chrono::steady_clock;
+	constexpr int steps = 20000;
+	constexpr int alive = 1000;
+
+	// entities are spawned and killed over a long session, like in an entity registry
+	auto run = [&](bool clean) {
+		UnorderedMap<int, int> map;
+		size_t visited = 0;
+
+		auto start = clock::now();
+		for (int i = 0; i < steps; ++i) {
+			time::time_t time = i;
+			map.insert(time, i, i);
+			if (i >= alive) {
+				map.kill(time, i - alive);
+			}
+			if (clean) {
+				map.clean(time);
+			}
+
+			for (auto it = map.alive_begin(time); it != map.alive_end(); ++it) {
+				++visited;
+			}
+		}
+		std::chrono::duration<double, std::micro> duration = clock::now() - start;
+
+		log::log(INFO << steps << " steps with " << alive << " alive elements "
+		              << (clean ? "with" : "without") << " cleanup: "
+		              << duration.count() / steps << " us/step, "
+		              << visited / steps << " elements visited per step, "
+		              << map.size() << " elements stored");
+	};
+
+	run(false);
+	run(true);
+}
+
+
 } // namespace openage::curve::tests
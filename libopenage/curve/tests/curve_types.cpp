@@ -1,10 +1,13 @@
-// Copyright 2017-2024 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
+#include <chrono>
 #include <iterator>
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "coord/phys.h"
 #include "curve/continuous.h"
 #include "curve/discrete.h"
 #include "curve/discrete_mod.h"
@@ -12,6 +15,7 @@
 #include "curve/keyframe_container.h"
 #include "curve/segmented.h"
 #include "event/event_loop.h"
+#include "log/log.h"
 #include "testing/testing.h"
 #include "time/time.h"
 #include "util/fixed_point.h"
@@ -386,6 +390,90 @@ void curve_types() {
 		TESTEQUALS(c.get(1), 0);
 		TESTEQUALS(c.get(5), 0);
 	}
+
+	// batch evaluation returns the same values as get()
+	{
+		using fixed_t = util::FixedPoint<int64_t, 16>;
+
+		auto f = std::make_shared<event::EventLoop>();
+		Continuous<fixed_t> a(f, 0);
+		Segmented<fixed_t> b(f, 0);
+		Continuous<fixed_t> c(f, 0);
+
+		a.set_insert(0, 0);
+		a.set_insert(10, 20);
+		b.set_insert(0, 5);
+		b.set_insert_jump(5, 5, 50);
+		b.set_insert(10, 10);
+		// c only has the default keyframe
+
+		std::vector<const Interpolated<fixed_t> *> curves{&a, &b, &c};
+		std::vector<fixed_t> values(curves.size());
+
+		// also evaluate backwards in time, the buffers are reused
+		evaluate_buffers<fixed_t> buffers;
+		for (double t : {-1.0, 0.0, 2.5, 5.0, 7.5, 10.0, 20.0, 3.0, 0.5}) {
+			evaluate_all<fixed_t>(curves, t, values, buffers);
+			TESTEQUALS(values[0], a.get(t));
+			TESTEQUALS(values[1], b.get(t));
+			TESTEQUALS(values[2], c.get(t));
+		}
+
+		evaluate_all<fixed_t>(curves, 2.5, values);
+		TESTEQUALS(values[0], a.get(2.5));
+
+		std::vector<fixed_t> too_few(1);
+		TESTTHROWS(evaluate_all<fixed_t>(curves, 0, too_few));
+	}
+}
+
+
+void interpolated_benchmark() {
+	using clock = std::chrono::steady_clock;
+	constexpr size_t curve_count = 10000;
+	constexpr size_t frames = 100;
+
+	// moving entities with a few waypoints each
+	auto loop = std::make_shared<event::EventLoop>();
+	std::vector<std::unique_ptr<Continuous<coord::phys3>>> curves;
+	std::vector<const Interpolated<coord::phys3> *> curve_ptrs;
+	for (size_t i = 0; i < curve_count; ++i) {
+		auto curve = std::make_unique<Continuous<coord::phys3>>(
+			loop, i, "", nullptr, coord::phys3(0, 0, 0));
+		for (int k = 0; k < 8; ++k) {
+			curve->set_last(k * 10 + static_cast<int>(i % 10),
+			                coord::phys3(k + static_cast<int>(i % 7), k, 0));
+		}
+		curve_ptrs.push_back(curve.get());
+		curves.push_back(std::move(curve));
+	}
+
+	std::vector<coord::phys3> values(curve_count, coord::phys3(0, 0, 0));
+
+	// one frame every 1/60 s
+	auto frame_time = [](size_t frame) {
+		return time::time_t::from_double(frame / 60.0);
+	};
+
+	auto start = clock::now();
+	for (size_t frame = 0; frame < frames; ++frame) {
+		auto time = frame_time(frame);
+		for (size_t i = 0; i < curve_count; ++i) {
+			values[i] = curves[i]->get(time);
+		}
+	}
+	std::chrono::duration<double, std::micro> single = clock::now() - start;
+
+	evaluate_buffers<coord::phys3> buffers;
+	start = clock::now();
+	for (size_t frame = 0; frame < frames; ++frame) {
+		evaluate_all<coord::phys3>(curve_ptrs, frame_time(frame), values, buffers);
+	}
+	std::chrono::duration<double, std::micro> batch = clock::now() - start;
+
+	log::log(INFO << "Evaluating " << curve_count << " position curves: "
+	              << "get() " << single.count() / frames << " us/frame, "
+	              << "evaluate_all() " << batch.count() / frames << " us/frame");
 }
 
 } // namespace openage::curve::tests
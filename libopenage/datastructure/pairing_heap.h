@@ -1,4 +1,4 @@
-// Copyright 2014-2024 the openage authors. See copying.md for legal info.
+// Copyright 2014-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -20,6 +20,8 @@
 #include <memory>
 #include <type_traits>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "../error/error.h"
 #include "../util/compiler.h"
@@ -207,6 +209,9 @@ public:
 
 	~PairingHeap() {
 		this->clear();
+		for (auto mem : this->free_nodes) {
+			::operator delete(mem);
+		}
 	};
 
 	/**
@@ -214,7 +219,7 @@ public:
 	 * O(1)
 	 */
 	element_t push(const T &item) {
-		element_t new_node = new heapnode_t(item);
+		element_t new_node = this->make_node(item);
 		this->push_node(new_node);
 		return new_node;
 	}
@@ -224,7 +229,7 @@ public:
 	 * O(1)
 	 */
 	element_t push(T &&item) {
-		element_t new_node = new heapnode_t(std::move(item));
+		element_t new_node = this->make_node(std::move(item));
 		this->push_node(new_node);
 		return new_node;
 	}
@@ -313,7 +318,7 @@ public:
 
 		// and it's done!
 		T data = std::move(ret->data);
-		delete ret;
+		this->release_node(ret);
 		return data;
 	}
 
@@ -404,8 +409,8 @@ public:
 	 * erase all elements on the heap.
 	 */
 	void clear() {
-		auto delete_node = [](element_t node) { delete node; };
-		this->iter_all<true>(delete_node);
+		auto release_node = [this](element_t node) { this->release_node(node); };
+		this->iter_all<true>(release_node);
 		this->root_node = nullptr;
 		this->node_count = 0;
 #if OPENAGE_PAIRINGHEAP_DEBUG
@@ -612,8 +617,10 @@ private:
 					break;
 				}
 
+				// the node may be deleted by func
+				auto next = node->next_sibling;
 				this->walk_tree<reverse>(node, func);
-				node = node->next_sibling;
+				node = next;
 			}
 			if constexpr (reverse) {
 				func(start);
@@ -639,6 +646,28 @@ private:
 		this->node_count += 1;
 	}
 
+	/**
+	 * Create a node, reusing the memory of a released node if possible.
+	 */
+	template <typename... Args>
+	element_t make_node(Args &&...args) {
+		if (this->free_nodes.empty()) [[unlikely]] {
+			return new heapnode_t(std::forward<Args>(args)...);
+		}
+
+		void *mem = this->free_nodes.back();
+		this->free_nodes.pop_back();
+		return new (mem) heapnode_t(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * Destroy a node and keep its memory for the next push.
+	 */
+	void release_node(element_t node) {
+		node->~heapnode_t();
+		this->free_nodes.push_back(node);
+	}
+
 	/**
 	 * insert a node into the heap.
 	 */
@@ -655,6 +684,12 @@ private:
 	size_t node_count;
 	element_t root_node;
 
+	/**
+	 * Memory of released nodes. Heaps that are popped and pushed
+	 * alternately, like update() does, don't have to allocate.
+	 */
+	std::vector<void *> free_nodes;
+
 #if OPENAGE_PAIRINGHEAP_DEBUG
 	std::unordered_set<element_t> nodes;
 #endif
@@ -0,0 +1,108 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace openage::datastructure {
+
+/**
+ * A value that is read by many threads without taking a lock (sequence lock).
+ *
+ * Writing increments a sequence counter before and after the value is
+ * changed. Readers copy the value and retry if the counter was odd or changed
+ * in the meantime, i.e. they only wait while a write is in progress, which
+ * takes as long as copying the value. Readers never block writers.
+ *
+ * Concurrent writes are not supported, writers have to be serialized by the caller.
+ *
+ * The value is stored in atomic words, so there are no data races
+ * between readers and writers.
+ */
+template <typename T>
+	requires std::is_trivially_copyable_v<T>
+class SeqLock {
+public:
+	SeqLock(const T &value = T{}) :
+		sequence{0} {
+		this->write_words(value);
+	}
+
+	SeqLock(const SeqLock &) = delete;
+	SeqLock &operator=(const SeqLock &) = delete;
+
+	/**
+	 * Get a consistent copy of the value.
+	 *
+	 * Can be called from any thread.
+	 */
+	T load() const {
+		while (true) {
+			uint64_t seq = this->sequence.load(std::memory_order_acquire);
+			if (seq & 1) [[unlikely]] {
+				// write in progress
+				continue;
+			}
+
+			std::array<uint64_t, word_count> buf;
+			for (size_t i = 0; i < word_count; ++i) {
+				buf[i] = this->words[i].load(std::memory_order_relaxed);
+			}
+
+			// the words must be read before the sequence is checked again
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (this->sequence.load(std::memory_order_relaxed) == seq) [[likely]] {
+				T value;
+				std::memcpy(&value, buf.data(), sizeof(T));
+				return value;
+			}
+		}
+	}
+
+	/**
+	 * Replace the value.
+	 *
+	 * Must not be called from multiple threads at the same time.
+	 */
+	void store(const T &value) {
+		uint64_t seq = this->sequence.load(std::memory_order_relaxed);
+		this->sequence.store(seq + 1, std::memory_order_relaxed);
+
+		// readers must see the odd sequence before any of the new words
+		std::atomic_thread_fence(std::memory_order_release);
+		this->write_words(value);
+
+		this->sequence.store(seq + 2, std::memory_order_release);
+	}
+
+private:
+	/**
+	 * Number of words needed for storing the value.
+	 */
+	static constexpr size_t word_count = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+	void write_words(const T &value) {
+		std::array<uint64_t, word_count> buf{};
+		std::memcpy(buf.data(), &value, sizeof(T));
+		for (size_t i = 0; i < word_count; ++i) {
+			this->words[i].store(buf[i], std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * Incremented before and after each write. Odd while a write is in progress.
+	 */
+	std::atomic<uint64_t> sequence;
+
+	/**
+	 * Storage of the value.
+	 */
+	std::array<std::atomic<uint64_t>, word_count> words;
+};
+
+} // namespace openage::datastructure
@@ -0,0 +1,191 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+
+namespace openage::datastructure {
+
+/**
+ * A lock-free queue for passing values from one producer thread to
+ * one consumer thread (single-producer single-consumer).
+ *
+ * Values are stored in a ring buffer. Neither side ever blocks: if the
+ * ring is full, the producer continues in a new ring of twice the size and
+ * the consumer switches to it once the old ring is empty. Memory is
+ * only allocated in that case. Rings never grow beyond the maximum capacity,
+ * pushing fails instead.
+ *
+ * Multiple threads may push (or pop) if their calls are serialized by the caller,
+ * e.g. through a mutex.
+ */
+template <typename T>
+class SPSCQueue {
+public:
+	/**
+	 * Create a new queue.
+	 *
+	 * @param capacity Initial size of the ring buffer. Rounded up to a power of 2.
+	 * @param max_capacity Maximum size of the ring buffer.
+	 */
+	SPSCQueue(size_t capacity,
+	          size_t max_capacity = std::numeric_limits<size_t>::max()) :
+		write_ring{new ring_t{std::bit_ceil(std::max<size_t>(capacity, 1))}},
+		read_ring{write_ring},
+		max_capacity{max_capacity} {}
+
+	~SPSCQueue() {
+		while (this->read_ring) {
+			auto next = this->read_ring->next.load(std::memory_order_acquire);
+			delete this->read_ring;
+			this->read_ring = next;
+		}
+	}
+
+	SPSCQueue(const SPSCQueue &) = delete;
+	SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+	/**
+	 * Append a value. Must only be called by the producer.
+	 *
+	 * Fails if the current ring is full and can't grow anymore. The consumer
+	 * has to pop all values of older rings and some values of the current ring
+	 * before pushing succeeds again.
+	 *
+	 * @param value Value that is moved into the queue. Not moved if pushing fails.
+	 *
+	 * @return true if the value was added, false if the queue is full.
+	 */
+	[[nodiscard]] bool push(T &&value) {
+		if (this->write_ring->try_push(std::move(value))) [[likely]] {
+			return true;
+		}
+
+		size_t size = this->write_ring->slots.size();
+		if (size > this->max_capacity / 2) {
+			return false;
+		}
+
+		// the consumer switches to the new ring after emptying the current one
+		auto ring = new ring_t{size * 2};
+		ring->try_push(std::move(value));
+		this->write_ring->next.store(ring, std::memory_order_release);
+		this->write_ring = ring;
+		return true;
+	}
+
+	/**
+	 * Remove the oldest value. Must only be called by the consumer.
+	 *
+	 * @return Oldest value or \p std::nullopt if the queue is empty.
+	 */
+	std::optional<T> try_pop() {
+		while (true) {
+			auto value = this->read_ring->try_pop();
+			if (value) [[likely]] {
+				return value;
+			}
+
+			auto next = this->read_ring->next.load(std::memory_order_acquire);
+			if (not next) {
+				return std::nullopt;
+			}
+
+			// the producer finished the ring before it created the next one,
+			// so values that were pushed in between are visible now
+			value = this->read_ring->try_pop();
+			if (value) {
+				return value;
+			}
+
+			delete this->read_ring;
+			this->read_ring = next;
+		}
+	}
+
+private:
+	/**
+	 * Bounded ring buffer.
+	 */
+	struct ring_t {
+		ring_t(size_t size) :
+			slots(size),
+			head{0},
+			tail{0},
+			next{nullptr} {}
+
+		bool try_push(T &&value) {
+			size_t pos = this->tail.load(std::memory_order_relaxed);
+			if (pos - this->head.load(std::memory_order_acquire) == this->slots.size()) {
+				return false;
+			}
+
+			this->slots[pos & (this->slots.size() - 1)] = std::move(value);
+			this->tail.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		std::optional<T> try_pop() {
+			size_t pos = this->head.load(std::memory_order_relaxed);
+			if (pos == this->tail.load(std::memory_order_acquire)) {
+				return std::nullopt;
+			}
+
+			auto &slot = this->slots[pos & (this->slots.size() - 1)];
+			std::optional<T> value = std::move(slot);
+
+			// free the resources of the value before the slot is handed back to the producer
+			slot.reset();
+			this->head.store(pos + 1, std::memory_order_release);
+			return value;
+		}
+
+		/**
+		 * Storage of the values. Size is a power of 2.
+		 */
+		std::vector<std::optional<T>> slots;
+
+		/**
+		 * Position of the next value that is popped. Only written by the consumer.
+		 *
+		 * Producer and consumer positions are on separate cache lines.
+		 */
+		alignas(64) std::atomic<size_t> head;
+
+		/**
+		 * Position of the next value that is pushed. Only written by the producer.
+		 */
+		alignas(64) std::atomic<size_t> tail;
+
+		/**
+		 * Ring that the producer continued with after this one was full.
+		 */
+		std::atomic<ring_t *> next;
+	};
+
+	/**
+	 * Ring that values are pushed to. Only accessed by the producer.
+	 */
+	ring_t *write_ring;
+
+	/**
+	 * Ring that values are popped from. Only accessed by the consumer.
+	 */
+	ring_t *read_ring;
+
+	/**
+	 * Maximum size of a ring.
+	 */
+	size_t max_capacity;
+};
+
+} // namespace openage::datastructure
@@ -1,17 +1,23 @@
-// Copyright 2014-2024 the openage authors. See copying.md for legal info.
+// Copyright 2014-2025 the openage authors. See copying.md for legal info.
 
 #include "tests.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "testing/testing.h"
 
 #include "datastructure/concurrent_queue.h"
 #include "datastructure/constexpr_map.h"
 #include "datastructure/pairing_heap.h"
+#include "datastructure/seqlock.h"
+#include "datastructure/spsc_queue.h"
 
 
 namespace openage::datastructure::tests {
@@ -353,4 +359,94 @@ void concurrent_queue() {
 	concurrent_queue_copy_move_elements_compilation();
 }
 
+
+// exported test
+void seqlock() {
+	// all words of a value are the same, so torn reads can be detected
+	using value_t = std::array<uint64_t, 4>;
+	SeqLock<value_t> lock{value_t{0, 0, 0, 0}};
+
+	constexpr uint64_t writes = 100000;
+	std::atomic<bool> torn{false};
+	std::atomic<bool> running{true};
+
+	std::vector<std::thread> readers;
+	for (size_t i = 0; i < 3; ++i) {
+		readers.emplace_back([&]() {
+			uint64_t last = 0;
+			while (running.load()) {
+				auto value = lock.load();
+				if (value[0] != value[1] or value[0] != value[2] or value[0] != value[3]
+				    or value[0] < last) {
+					torn = true;
+				}
+				last = value[0];
+			}
+		});
+	}
+
+	for (uint64_t i = 1; i <= writes; ++i) {
+		lock.store(value_t{i, i, i, i});
+	}
+	running = false;
+
+	for (auto &reader : readers) {
+		reader.join();
+	}
+
+	TESTEQUALS(torn.load(), false);
+
+	auto last = lock.load();
+	TESTEQUALS(last[0], writes);
+}
+
+
+void spsc_queue() {
+	// tiny initial capacity, so the queue grows while the consumer lags behind
+	SPSCQueue<std::unique_ptr<uint64_t>> queue{2};
+	queue.try_pop().has_value() and TESTFAIL;
+
+	constexpr uint64_t values = 100000;
+	std::atomic<bool> out_of_order{false};
+
+	std::thread consumer{[&]() {
+		uint64_t expected = 0;
+		while (expected < values) {
+			auto value = queue.try_pop();
+			if (not value) {
+				continue;
+			}
+			if (**value != expected) {
+				out_of_order = true;
+			}
+			expected += 1;
+		}
+	}};
+
+	for (uint64_t i = 0; i < values; ++i) {
+		queue.push(std::make_unique<uint64_t>(i)) or TESTFAIL;
+	}
+	consumer.join();
+
+	TESTEQUALS(out_of_order.load(), false);
+	queue.try_pop().has_value() and TESTFAIL;
+
+	// capped queue: rings of size 2 and 4 fill up, then pushing fails
+	SPSCQueue<std::unique_ptr<uint64_t>> capped{2, 4};
+	for (uint64_t i = 0; i < 6; ++i) {
+		capped.push(std::make_unique<uint64_t>(i)) or TESTFAIL;
+	}
+	auto rejected = std::make_unique<uint64_t>(6);
+	capped.push(std::move(rejected)) and TESTFAIL;
+	(rejected != nullptr) or TESTFAILMSG("rejected value was moved");
+
+	for (uint64_t i = 0; i < 6; ++i) {
+		auto value = capped.try_pop();
+		(value and **value == i) or TESTFAIL;
+	}
+	capped.push(std::move(rejected)) or TESTFAIL;
+	auto last = capped.try_pop();
+	(last and **last == 6) or TESTFAIL;
+}
+
 } // namespace openage::datastructure::tests
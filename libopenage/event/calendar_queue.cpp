@@ -0,0 +1,323 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "calendar_queue.h"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+#include "log/message.h"
+
+#include "error/error.h"
+#include "event/event.h"
+#include "util/fixed_point.h"
+
+
+namespace openage::event {
+
+namespace {
+
+/**
+ * Minimum number of buckets.
+ */
+constexpr size_t min_buckets = 16;
+
+/**
+ * Number of earliest events that are used for estimating the bucket width.
+ */
+constexpr size_t width_samples = 32;
+
+/**
+ * Bucket width limits (as shift of the raw time value).
+ *
+ * Using a width of at least 2 raw units keeps the day counter far away
+ * from overflowing.
+ */
+constexpr int min_width_shift = 1;
+constexpr int max_width_shift = 48;
+
+/**
+ * Initial bucket width: 1/16 seconds.
+ */
+constexpr int default_width_shift = 12;
+
+} // namespace
+
+
+CalendarEventStore::CalendarEventStore() :
+	buckets(min_buckets),
+	width_shift{default_width_shift},
+	current_slot{std::numeric_limits<int64_t>::max()},
+	next_seq{0},
+	stale_count{0} {}
+
+
+void CalendarEventStore::push(const std::shared_ptr<Event> &event) {
+	if (event == nullptr) [[unlikely]] {
+		throw Error{ERR << "inserting nullptr event to queue"};
+	}
+
+	uint64_t seq = this->next_seq++;
+	auto [it, inserted] = this->events.emplace(event.get(), seq);
+	if (not inserted) [[unlikely]] {
+		throw Error{ERR << "event is already in the store"};
+	}
+
+	this->insert({event->get_time().get_raw_value(), seq, event});
+	this->check_resize();
+}
+
+
+std::shared_ptr<Event> CalendarEventStore::pop() {
+	entry_t *next = this->find_next();
+	if (next == nullptr) [[unlikely]] {
+		throw Error{ERR << "popping from empty event store"};
+	}
+
+	std::shared_ptr<Event> event = std::move(next->event);
+
+	auto &bucket = this->get_bucket(this->current_slot);
+	std::pop_heap(std::begin(bucket), std::end(bucket), &CalendarEventStore::later);
+	bucket.pop_back();
+
+	this->events.erase(event.get());
+	this->check_resize();
+
+	return event;
+}
+
+
+const std::shared_ptr<Event> &CalendarEventStore::top() {
+	entry_t *next = this->find_next();
+	if (next == nullptr) [[unlikely]] {
+		throw Error{ERR << "accessing top of empty event store"};
+	}
+
+	return next->event;
+}
+
+
+bool CalendarEventStore::erase(const std::shared_ptr<Event> &event) {
+	auto it = this->events.find(event.get());
+	if (it == std::end(this->events)) {
+		return false;
+	}
+
+	// the entry in the bucket is skipped from now on
+	this->events.erase(it);
+	this->stale_count += 1;
+	this->check_resize();
+
+	return true;
+}
+
+
+void CalendarEventStore::update(const std::shared_ptr<Event> &event) {
+	auto it = this->events.find(event.get());
+	if (it == std::end(this->events)) [[unlikely]] {
+		throw Error{ERR << "event to update not found in store"};
+	}
+
+	// add a new entry for the new time, the old one becomes outdated
+	uint64_t seq = this->next_seq++;
+	it->second = seq;
+	this->stale_count += 1;
+
+	this->insert({event->get_time().get_raw_value(), seq, event});
+	this->check_resize();
+}
+
+
+bool CalendarEventStore::contains(const std::shared_ptr<Event> &event) const {
+	return this->events.contains(event.get());
+}
+
+
+void CalendarEventStore::clear() {
+	this->buckets.clear();
+	this->buckets.resize(min_buckets);
+	this->current_slot = std::numeric_limits<int64_t>::max();
+	this->stale_count = 0;
+	this->events.clear();
+}
+
+
+size_t CalendarEventStore::size() const {
+	return this->events.size();
+}
+
+
+bool CalendarEventStore::empty() const {
+	return this->events.empty();
+}
+
+
+std::vector<std::shared_ptr<Event>> CalendarEventStore::get_sorted_events() const {
+	std::vector<std::pair<Event *, uint64_t>> sorted{
+		std::begin(this->events),
+		std::end(this->events),
+	};
+
+	std::sort(
+		std::begin(sorted),
+		std::end(sorted),
+		[](const auto &a, const auto &b) {
+			if (a.first->get_time() == b.first->get_time()) {
+				return a.second < b.second;
+			}
+			return a.first->get_time() < b.first->get_time();
+		});
+
+	std::vector<std::shared_ptr<Event>> ret;
+	ret.reserve(sorted.size());
+	std::transform(
+		std::begin(sorted),
+		std::end(sorted),
+		std::back_inserter(ret),
+		[](const auto &elem) {
+			return elem.first->shared_from_this();
+		});
+
+	return ret;
+}
+
+
+bool CalendarEventStore::later(const entry_t &a, const entry_t &b) {
+	if (a.time == b.time) {
+		return a.seq > b.seq;
+	}
+	return a.time > b.time;
+}
+
+
+int64_t CalendarEventStore::get_slot(int64_t time) const {
+	return time >> this->width_shift;
+}
+
+
+std::vector<CalendarEventStore::entry_t> &CalendarEventStore::get_bucket(int64_t slot) {
+	// bucket count is a power of 2
+	return this->buckets[static_cast<uint64_t>(slot) & (this->buckets.size() - 1)];
+}
+
+
+bool CalendarEventStore::is_current(const entry_t &entry) const {
+	auto it = this->events.find(entry.event.get());
+	return it != std::end(this->events) and it->second == entry.seq;
+}
+
+
+void CalendarEventStore::insert(entry_t &&entry) {
+	int64_t slot = this->get_slot(entry.time);
+	if (slot < this->current_slot) {
+		this->current_slot = slot;
+	}
+
+	auto &bucket = this->get_bucket(slot);
+	bucket.push_back(std::move(entry));
+	std::push_heap(std::begin(bucket), std::end(bucket), &CalendarEventStore::later);
+}
+
+
+void CalendarEventStore::drop_stale(std::vector<entry_t> &bucket) {
+	while (not bucket.empty() and not this->is_current(bucket.front())) {
+		std::pop_heap(std::begin(bucket), std::end(bucket), &CalendarEventStore::later);
+		bucket.pop_back();
+		this->stale_count -= 1;
+	}
+}
+
+
+CalendarEventStore::entry_t *CalendarEventStore::find_next() {
+	if (this->events.empty()) {
+		return nullptr;
+	}
+
+	// walk through the days of one year
+	for (size_t i = 0; i < this->buckets.size(); ++i) {
+		auto &bucket = this->get_bucket(this->current_slot);
+		this->drop_stale(bucket);
+
+		// the bucket may also contain events of later years
+		if (not bucket.empty() and this->get_slot(bucket.front().time) == this->current_slot) {
+			return &bucket.front();
+		}
+
+		this->current_slot += 1;
+	}
+
+	// the events are sparse, so jump directly to the earliest one
+	entry_t *next = nullptr;
+	for (auto &bucket : this->buckets) {
+		this->drop_stale(bucket);
+		if (not bucket.empty() and (next == nullptr or later(*next, bucket.front()))) {
+			next = &bucket.front();
+		}
+	}
+
+	ENSURE(next != nullptr, "event store buckets are inconsistent");
+	this->current_slot = this->get_slot(next->time);
+
+	return next;
+}
+
+
+void CalendarEventStore::check_resize() {
+	size_t bucket_count = this->buckets.size();
+	size_t event_count = this->events.size();
+
+	if (event_count > 2 * bucket_count) {
+		this->resize(2 * bucket_count);
+	}
+	else if (bucket_count > min_buckets and event_count < bucket_count / 4) {
+		this->resize(bucket_count / 2);
+	}
+	else if (this->stale_count > event_count + bucket_count) {
+		this->resize(bucket_count);
+	}
+}
+
+
+void CalendarEventStore::resize(size_t bucket_count) {
+	std::vector<entry_t> entries;
+	entries.reserve(this->events.size());
+	for (auto &bucket : this->buckets) {
+		for (auto &entry : bucket) {
+			if (this->is_current(entry)) {
+				entries.push_back(std::move(entry));
+			}
+		}
+	}
+
+	// bucket width is a few times the average distance of the earliest events
+	size_t samples = std::min(entries.size(), width_samples);
+	if (samples > 1) {
+		auto earlier = [](const entry_t &a, const entry_t &b) {
+			return a.time < b.time;
+		};
+		auto sample_end = std::begin(entries) + samples;
+		std::nth_element(std::begin(entries), sample_end - 1, std::end(entries), earlier);
+		std::sort(std::begin(entries), sample_end, earlier);
+
+		uint64_t span = static_cast<uint64_t>(entries[samples - 1].time) - static_cast<uint64_t>(entries[0].time);
+		uint64_t width = 3 * (span / (samples - 1));
+		if (width > 0) {
+			this->width_shift = std::clamp(static_cast<int>(std::bit_width(width)) - 1,
+			                               min_width_shift,
+			                               max_width_shift);
+		}
+	}
+
+	this->buckets.clear();
+	this->buckets.resize(bucket_count);
+	this->current_slot = std::numeric_limits<int64_t>::max();
+	this->stale_count = 0;
+
+	for (auto &entry : entries) {
+		this->insert(std::move(entry));
+	}
+}
+
+} // namespace openage::event
@@ -0,0 +1,157 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "event/eventstore.h"
+#include "util/memory_tag.h"
+
+
+namespace openage::event {
+
+class Event;
+
+/**
+ * Event store implemented as a calendar queue.
+ *
+ * Events are sorted into buckets that cover a fixed time span each ("days").
+ * The buckets are used cyclically, so one pass over all buckets covers
+ * a "year". Popping events walks through the days starting at the current
+ * one, which takes amortized constant time if the bucket width matches the
+ * distance between the events. The number of buckets and their width are
+ * adjusted when the number of events grows or shrinks.
+ *
+ * Events with the same time are popped in the order in which they were
+ * pushed or updated.
+ *
+ * Erased and updated events are not removed from their bucket immediately.
+ * Their old entries are skipped when they are reached and dropped when the
+ * buckets are rebuilt.
+ */
+class CalendarEventStore : public EventStore {
+public:
+	CalendarEventStore();
+	~CalendarEventStore() = default;
+
+	void push(const std::shared_ptr<Event> &event) override;
+	std::shared_ptr<Event> pop() override;
+	const std::shared_ptr<Event> &top() override;
+	bool erase(const std::shared_ptr<Event> &event) override;
+	void update(const std::shared_ptr<Event> &event) override;
+	bool contains(const std::shared_ptr<Event> &event) const override;
+	void clear() override;
+	size_t size() const override;
+	bool empty() const override;
+
+	std::vector<std::shared_ptr<Event>> get_sorted_events() const override;
+
+private:
+	/**
+	 * Position of an event in the store.
+	 */
+	struct entry_t {
+		/// Raw value of the event time when the entry was created.
+		int64_t time;
+		/// Insertion counter for ordering events with the same time.
+		uint64_t seq;
+		/// Stored event.
+		std::shared_ptr<Event> event;
+	};
+
+	/**
+	 * Order of entries in a bucket. Buckets are min-heaps of this order.
+	 */
+	static bool later(const entry_t &a, const entry_t &b);
+
+	/**
+	 * Get the day of a point in time.
+	 */
+	int64_t get_slot(int64_t time) const;
+
+	/**
+	 * Get the bucket used for a day.
+	 */
+	std::vector<entry_t> &get_bucket(int64_t slot);
+
+	/**
+	 * Check if an entry is the current position of its event.
+	 */
+	bool is_current(const entry_t &entry) const;
+
+	/**
+	 * Add an entry to its bucket.
+	 */
+	void insert(entry_t &&entry);
+
+	/**
+	 * Remove outdated entries from the front of a bucket.
+	 */
+	void drop_stale(std::vector<entry_t> &bucket);
+
+	/**
+	 * Find the entry of the earliest event and move the current day to it.
+	 *
+	 * @return Entry of the earliest event or \p nullptr if the store is empty.
+	 */
+	entry_t *find_next();
+
+	/**
+	 * Change the number of buckets if the number of events changed a lot or
+	 * too many outdated entries have piled up.
+	 */
+	void check_resize();
+
+	/**
+	 * Rebuild the buckets and estimate a new bucket width from
+	 * the earliest events.
+	 *
+	 * @param bucket_count New number of buckets. Must be a power of 2.
+	 */
+	void resize(size_t bucket_count);
+
+	/**
+	 * Buckets, each one is a min-heap of entries.
+	 */
+	std::vector<std::vector<entry_t>> buckets;
+
+	/**
+	 * Bucket width is 2^width_shift raw time units.
+	 */
+	int width_shift;
+
+	/**
+	 * Day at which the search for the next event starts.
+	 * There are no current entries for earlier days.
+	 */
+	int64_t current_slot;
+
+	/**
+	 * Insertion counter.
+	 */
+	uint64_t next_seq;
+
+	/**
+	 * Number of outdated entries in the buckets.
+	 */
+	size_t stale_count;
+
+	/**
+	 * Events in the store and the insertion counter of their current entry.
+	 *
+	 * The events are owned by their entries in the buckets.
+	 */
+	std::unordered_map<Event *,
+	                   uint64_t,
+	                   std::hash<Event *>,
+	                   std::equal_to<Event *>,
+	                   util::TaggedAllocator<std::pair<Event *const, uint64_t>, util::memory_tag::event>>
+		events;
+};
+
+} // namespace openage::event
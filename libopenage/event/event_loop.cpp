@@ -1,13 +1,18 @@
-// Copyright 2017-2023 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
 #include "event_loop.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "log/level.h"
 #include "log/log.h"
+#include "log/logsink.h"
 #include "log/message.h"
 
 #include "error/error.h"
@@ -21,6 +26,29 @@
 
 namespace openage::event {
 
+namespace {
+
+/**
+ * Maximum number of changes that are reported when the events don't settle.
+ */
+constexpr size_t max_settle_trace = 16;
+
+/**
+ * Describe an event for diagnostics.
+ */
+std::string describe_event(const Event &evnt) {
+	auto entity = evnt.get_entity().lock();
+	return evnt.get_eventhandler()->id() + " on " + (entity ? entity->idstr() : "(removed)");
+}
+
+} // namespace
+
+
+EventLoop::EventLoop(event_store_t store_type) :
+	queue{store_type},
+	active_event{nullptr},
+	tracing_settle{false} {}
+
 
 void EventLoop::add_event_handler(const std::shared_ptr<EventHandler> eventhandler) {
 	std::unique_lock lock{this->mutex};
@@ -29,11 +57,11 @@ void EventLoop::add_event_handler(const std::shared_ptr<EventHandler> eventhandl
 }
 
 
-std::shared_ptr<Event> EventLoop::create_event(const std::string name,
-                                               const std::shared_ptr<EventEntity> target,
-                                               const std::shared_ptr<State> state,
-                                               const time::time_t reference_time,
-                                               const EventHandler::param_map params) {
+std::shared_ptr<Event> EventLoop::create_event(const std::string &name,
+                                               const std::shared_ptr<EventEntity> &target,
+                                               const std::shared_ptr<State> &state,
+                                               const time::time_t &reference_time,
+                                               const EventHandler::param_map &params) {
 	std::unique_lock lock{this->mutex};
 
 	auto it = classstore.find(name);
@@ -46,11 +74,11 @@ std::shared_ptr<Event> EventLoop::create_event(const std::string name,
 }
 
 
-std::shared_ptr<Event> EventLoop::create_event(const std::shared_ptr<EventHandler> eventhandler,
-                                               const std::shared_ptr<EventEntity> target,
-                                               const std::shared_ptr<State> state,
-                                               const time::time_t reference_time,
-                                               const EventHandler::param_map params) {
+std::shared_ptr<Event> EventLoop::create_event(const std::shared_ptr<EventHandler> &eventhandler,
+                                               const std::shared_ptr<EventEntity> &target,
+                                               const std::shared_ptr<State> &state,
+                                               const time::time_t &reference_time,
+                                               const EventHandler::param_map &params) {
 	std::unique_lock lock{this->mutex};
 
 	auto it = this->classstore.find(eventhandler->id());
@@ -72,47 +100,68 @@ void EventLoop::reach_time(const time::time_t &time_until,
                            const std::shared_ptr<State> &state) {
 	std::unique_lock lock{this->mutex};
 
-	// TODO detect infinite loops (is this a halting problem?)
-	// this happens when the events don't settle:
-	// at least one processed event adds another event so
-	// the queue never stops adding changes
-	// simple "solution": abort after over 9000 attempts.
-	int max_attempts = 10;
+	size_t passes = 0;
 
-	int cnt = 0;
-	int attempts = 0;
+	bool profiling = this->profiler.is_active();
+	EventProfiler::clock_t::time_point start;
+	if (profiling) [[unlikely]] {
+		start = EventProfiler::clock_t::now();
+	}
 
+	// Each pass only reevaluates the events whose dependencies were changed
+	// by the previous pass, so settling ends once a pass makes no changes.
 	do {
-		if (attempts > max_attempts) {
-			throw Error(ERR << "Loop: reached event settling threshold of "
-			                << max_attempts << ", giving up.");
-			break;
+		if (passes == max_settle_passes) [[unlikely]] {
+			this->tracing_settle = false;
+
+			std::string changes;
+			for (const auto &change : this->settle_trace) {
+				changes += " [" + change + "]";
+			}
+
+			throw Error(ERR << "Loop: events did not settle after " << max_settle_passes
+			                << " passes to reach t=" << time_until
+			                << ", changes of the last pass:" << changes);
+		}
+
+		// record the changes of the last pass to find the event handlers that don't settle
+		if (passes == max_settle_passes - 1) [[unlikely]] {
+			this->tracing_settle = true;
+			this->settle_trace.clear();
 		}
 
-		log::log(SPAM << "Loop: Attempt " << attempts << " to reach t=" << time_until);
+		log::log(SPAM << "Loop: Pass " << passes << " to reach t=" << time_until);
 		this->update_changes(state);
-		cnt = this->execute_events(time_until, state);
+		int cnt = this->execute_events(time_until, state);
 
 		log::log(SPAM << "Loop: to reach t=" << time_until
 		              << ", n=" << cnt << " events were executed");
 
-		attempts += 1;
+		passes += 1;
 	}
-	while (cnt != 0);
+	while (not this->queue.get_changes().empty());
+
+	this->tracing_settle = false;
 
 	// Swap in the end of the execution, else we might skip changes that happen
 	// in the main loop for one frame - which is bad btw.
 	this->queue.swap_changesets();
+
+	if (profiling) [[unlikely]] {
+		this->profiler.record_reach_time(time_until, passes, start, EventProfiler::clock_t::now());
+	}
+
 	log::log(SPAM << "Loop: t=" << time_until << " was reached! ========");
 }
 
 
 int EventLoop::execute_events(const time::time_t &time_until,
                               const std::shared_ptr<State> &state) {
-	log::log(SPAM << "Loop: Pending events in the queue (# = "
-	              << this->queue.get_event_queue().size() << "):");
+	// sorting all events is expensive, so only do it when they are actually logged
+	if (log::LogSinkList::instance().supports_loglevel(log::level::spam)) [[unlikely]] {
+		log::log(SPAM << "Loop: Pending events in the queue (# = "
+		              << this->queue.get_event_queue().size() << "):");
 
-	{
 		size_t i = 0;
 		for (const auto &e : this->queue.get_event_queue().get_sorted_events()) {
 			log::log(SPAM << "  event "
@@ -137,12 +186,25 @@ int EventLoop::execute_events(const time::time_t &time_until,
 			             << "\" on target \"" << target->idstr()
 			             << "\" for time t=" << event->get_time());
 
-			this->active_event = event;
+			this->active_event = event.get();
+
+			bool profiling = this->profiler.is_active();
+			EventProfiler::clock_t::time_point start;
+			if (profiling) [[unlikely]] {
+				start = EventProfiler::clock_t::now();
+			}
 
 			// apply the event effects
 			event->get_eventhandler()->invoke(
 				*this, target, state, event->get_time(), event->get_params());
 
+			if (profiling) [[unlikely]] {
+				this->profiler.record_invoke(event->get_eventhandler()->id(),
+				                             event->get_time(),
+				                             start,
+				                             EventProfiler::clock_t::now());
+			}
+
 			this->active_event = nullptr;
 			cnt += 1;
 
@@ -159,6 +221,10 @@ int EventLoop::execute_events(const time::time_t &time_until,
 					             << "\" will be reenqueued for time t=" << event->get_time());
 
 					this->queue.reenqueue(event);
+
+					if (this->profiler.is_active()) [[unlikely]] {
+						this->profiler.record_reenqueue(event->get_eventhandler()->id());
+					}
 				}
 			}
 		}
@@ -174,11 +240,26 @@ int EventLoop::execute_events(const time::time_t &time_until,
 }
 
 
-void EventLoop::create_change(const std::shared_ptr<Event> evnt,
-                              const time::time_t changes_at) {
+void EventLoop::create_change(const std::shared_ptr<Event> &evnt,
+                              const time::time_t &changes_at) {
 	std::unique_lock lock{this->mutex};
 
 	this->queue.add_change(evnt, changes_at);
+
+	// attribute the change to the event handler that is currently executed
+	if (this->active_event and this->profiler.is_active()) [[unlikely]] {
+		this->profiler.record_change(this->active_event->get_eventhandler()->id());
+	}
+
+	if (this->tracing_settle) [[unlikely]] {
+		auto cause = this->active_event ? describe_event(*this->active_event) : "unknown";
+		auto change = cause + " -> " + describe_event(*evnt);
+		if (std::find(std::begin(this->settle_trace), std::end(this->settle_trace), change)
+		        == std::end(this->settle_trace)
+		    and this->settle_trace.size() < max_settle_trace) {
+			this->settle_trace.push_back(std::move(change));
+		}
+	}
 }
 
 
@@ -1,14 +1,17 @@
-// Copyright 2017-2024 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "event/eventhandler.h"
 #include "event/eventqueue.h"
+#include "event/profiler.h"
 #include "time/time.h"
 
 
@@ -32,10 +35,17 @@ class EventLoop {
 	friend int demo::curvepong();
 
 public:
+	/**
+	 * Maximum number of passes for settling the events in \p reach_time().
+	 */
+	static constexpr size_t max_settle_passes = 10;
+
 	/**
 	 * Create a new event loop.
+	 *
+	 * @param store_type Data structure used for sorting the queued events.
 	 */
-	EventLoop() = default;
+	EventLoop(event_store_t store_type = event_store_t::HEAP);
 	~EventLoop() = default;
 
 	/**
@@ -59,11 +69,11 @@ public:
 	 *                       by other events.
 	 * @param params Event parameters map (default = {}). Passed to the event handler on event execution.
 	 */
-	std::shared_ptr<Event> create_event(const std::string eventhandler,
-	                                    const std::shared_ptr<EventEntity> target,
-	                                    const std::shared_ptr<State> state,
-	                                    const time::time_t reference_time,
-	                                    const EventHandler::param_map params = EventHandler::param_map({}));
+	std::shared_ptr<Event> create_event(const std::string &eventhandler,
+	                                    const std::shared_ptr<EventEntity> &target,
+	                                    const std::shared_ptr<State> &state,
+	                                    const time::time_t &reference_time,
+	                                    const EventHandler::param_map &params = EventHandler::param_map({}));
 
 	/**
 	 * Add a new event to the queue using an arbritary event handler. If an event handler
@@ -81,15 +91,23 @@ public:
 	 *                       by other events.
 	 * @param params Event parameters map (default = {}). Passed to the event handler on event execution.
 	 */
-	std::shared_ptr<Event> create_event(const std::shared_ptr<EventHandler> eventhandler,
-	                                    const std::shared_ptr<EventEntity> target,
-	                                    const std::shared_ptr<State> state,
-	                                    const time::time_t reference_time,
-	                                    const EventHandler::param_map params = EventHandler::param_map({}));
+	std::shared_ptr<Event> create_event(const std::shared_ptr<EventHandler> &eventhandler,
+	                                    const std::shared_ptr<EventEntity> &target,
+	                                    const std::shared_ptr<State> &state,
+	                                    const time::time_t &reference_time,
+	                                    const EventHandler::param_map &params = EventHandler::param_map({}));
 
 	/**
 	 * Execute events in the queue with execution time <= a given point in time.
 	 *
+	 * Events are settled in passes. Each pass reevaluates the events whose
+	 * dependencies were changed by the previous pass and then executes the
+	 * events that are due. Settling ends when no changes are pending.
+	 *
+	 * Throws if the events don't settle after \p max_settle_passes passes, i.e.
+	 * event handlers keep changing each other's dependencies. The error names
+	 * the event handlers that caused the changes in the last pass.
+	 *
 	 * @param time_until Maximum time until which events are executed.
 	 * @param state Global state.
 	 */
@@ -108,8 +126,8 @@ public:
 	 * @param event Event to reevaluate.
 	 * @param changes_at Time at which the event should be reevaluated.
 	 */
-	void create_change(const std::shared_ptr<Event> event,
-	                   const time::time_t changes_at);
+	void create_change(const std::shared_ptr<Event> &event,
+	                   const time::time_t &changes_at);
 
 	/**
 	 * Get the event queue.
@@ -120,6 +138,15 @@ public:
 		return this->queue;
 	}
 
+	/**
+	 * Get the profiler that collects statistics of the executed events.
+	 *
+	 * @return Event profiler.
+	 */
+	EventProfiler &get_profiler() {
+		return this->profiler;
+	}
+
 private:
 	/**
 	 *  Execute events in the queue with execution time <= a given point in time.
@@ -152,8 +179,26 @@ private:
 	/**
 	 * The currently processed event.
 	 * This is useful for event cancelations (so one can't cancel itself).
+	 *
+	 * The event is owned by \p execute_events() while it is active.
+	 */
+	const Event *active_event;
+
+	/**
+	 * Whether changes are recorded in \p settle_trace.
+	 */
+	bool tracing_settle;
+
+	/**
+	 * Changes made by events in the last settle pass, as "cause -> changed event".
+	 * Only recorded when the events are about to exceed \p max_settle_passes.
+	 */
+	std::vector<std::string> settle_trace;
+
+	/**
+	 * Collects statistics of the executed events if enabled.
 	 */
-	std::shared_ptr<Event> active_event;
+	EventProfiler profiler;
 
 	/**
 	 * Mutex for protecting threaded access.
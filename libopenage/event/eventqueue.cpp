@@ -1,4 +1,4 @@
-// Copyright 2017-2023 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
 #include "eventqueue.h"
 
@@ -15,6 +15,7 @@
 #include "log/log.h"
 #include "time/time.h"
 #include "util/fixed_point.h"
+#include "util/memory_tag.h"
 
 
 namespace openage::event {
@@ -24,7 +25,10 @@ std::shared_ptr<Event> EventQueue::create_event(const std::shared_ptr<EventEntit
                                                 const std::shared_ptr<State> &state,
                                                 const time::time_t &reference_time,
                                                 const EventHandler::param_map &params) {
-	auto event = std::make_shared<Event>(trgt, cls, params);
+	auto event = std::allocate_shared<Event>(util::TaggedAllocator<Event, util::memory_tag::event>{},
+	                                         trgt,
+	                                         cls,
+	                                         params);
 
 	cls->setup_event(event, state);
 
@@ -69,16 +73,17 @@ std::shared_ptr<Event> EventQueue::create_event(const std::shared_ptr<EventEntit
 	case EventHandler::trigger_type::REPEAT:
 	case EventHandler::trigger_type::ONCE:
 	default:
-		this->event_queue.push(event);
+		this->event_queue->push(event);
 	}
 
 	return event;
 }
 
 
-EventQueue::EventQueue() :
+EventQueue::EventQueue(event_store_t store_type) :
 	changes(&changeset_A),
-	future_changes(&changeset_B) {}
+	future_changes(&changeset_B),
+	event_queue{make_event_store(store_type)} {}
 
 
 void EventQueue::add_change(const std::shared_ptr<Event> &event,
@@ -137,44 +142,40 @@ void EventQueue::remove(const std::shared_ptr<Event> &evnt) {
 	// TODO: remove the event from the other storages.
 	//       this would require changes to dependent events and triggers.
 	//       (to stop being a dependent event or allow being triggered)
-	this->event_queue.erase(evnt);
+	this->event_queue->erase(evnt);
 }
 
 
 void EventQueue::enqueue(const std::shared_ptr<Event> &evnt) {
-	if (this->event_queue.contains(evnt)) {
-		this->event_queue.update(evnt);
+	if (this->event_queue->contains(evnt)) {
+		this->event_queue->update(evnt);
 	}
 	else {
-		this->event_queue.push(evnt);
+		this->event_queue->push(evnt);
 	}
 }
 
 
 void EventQueue::reenqueue(const std::shared_ptr<Event> &evnt) {
-	this->event_queue.push(evnt);
+	this->event_queue->push(evnt);
 }
 
 
 const EventStore &EventQueue::get_event_queue() const {
-	return this->event_queue;
+	return *this->event_queue;
 }
 
 
 std::shared_ptr<Event> EventQueue::take_event(const time::time_t &max_time) {
-	if (this->event_queue.size() == 0) {
+	if (this->event_queue->size() == 0) {
 		return nullptr;
 	}
 
-	std::shared_ptr<Event> event = this->event_queue.top();
-
 	// check if this event should be processed
 	// we take any event that happens <= max_time
-	if (event->get_time() <= max_time) {
+	if (this->event_queue->top()->get_time() <= max_time) {
 		// remove the event from the queue
-		this->event_queue.pop();
-
-		return event;
+		return this->event_queue->pop();
 	}
 	else {
 		return nullptr;
@@ -206,27 +207,10 @@ EventQueue::Change::Change(const std::shared_ptr<Event> &evnt,
 
 size_t EventQueue::Change::Equal::operator()(const Change &left,
                                              const Change &right) const {
-	auto left_evnt = left.evnt.lock();
-	auto right_evnt = right.evnt.lock();
-	if (left_evnt && right_evnt) {
-		if (left_evnt->get_eventhandler()->id() == right_evnt->get_eventhandler()->id()) {
-			return true;
-		}
-	}
-	else {
-		return false;
-	}
-
-	auto left_entity = left_evnt->get_entity().lock();
-	auto right_entity = right_evnt->get_entity().lock();
-
-	if (left_entity && right_entity) {
-		if (left_entity->id() == right_entity->id()) {
-			return true;
-		}
-	}
-
-	return false;
+	// changes are equal if they are for the same event,
+	// which can be checked without locking the pointers
+	return not left.evnt.owner_before(right.evnt)
+	       and not right.evnt.owner_before(left.evnt);
 }
 
 } // namespace openage::event
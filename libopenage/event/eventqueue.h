@@ -1,4 +1,4 @@
-// Copyright 2017-2023 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -53,7 +53,12 @@ public:
 	                                      Change::Equal>;
 
 
-	EventQueue();
+	/**
+	 * Create a new event queue.
+	 *
+	 * @param store_type Data structure used for sorting the events.
+	 */
+	EventQueue(event_store_t store_type = event_store_t::HEAP);
 
 	/**
 	 * Add an event for a specified target
@@ -150,7 +155,7 @@ private:
 	/**
 	 * The universe timeline processes through this queue.
 	 */
-	EventStore event_queue;
+	std::unique_ptr<EventStore> event_queue;
 };
 
 } // namespace openage::event
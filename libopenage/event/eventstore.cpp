@@ -1,4 +1,4 @@
-// Copyright 2018-2024 the openage authors. See copying.md for legal info.
+// Copyright 2018-2025 the openage authors. See copying.md for legal info.
 
 #include "eventstore.h"
 
@@ -9,24 +9,37 @@
 #include "log/message.h"
 
 #include "error/error.h"
+#include "event/calendar_queue.h"
 
 
 namespace openage::event {
 
-void EventStore::push(const std::shared_ptr<Event> &event) {
+std::unique_ptr<EventStore> make_event_store(event_store_t type) {
+	switch (type) {
+	case event_store_t::HEAP:
+		return std::make_unique<HeapEventStore>();
+	case event_store_t::CALENDAR:
+		return std::make_unique<CalendarEventStore>();
+	default:
+		throw Error{ERR << "unknown event store type"};
+	}
+}
+
+
+void HeapEventStore::push(const std::shared_ptr<Event> &event) {
 	if (event == nullptr) [[unlikely]] {
 		throw Error{ERR << "inserting nullptr event to queue"};
 	}
 
 	heap_t::element_t order = this->heap.push(event);
-	this->events.emplace(event, order);
+	this->events.emplace(event.get(), order);
 
 	ENSURE(this->heap.size() == this->events.size(),
 	       "heap and event set are inconsistent");
 }
 
 
-std::shared_ptr<Event> EventStore::pop() {
+std::shared_ptr<Event> HeapEventStore::pop() {
 	ENSURE(this->heap.size() == this->events.size(),
 	       "heap and event set are inconsistent 0");
 
@@ -34,7 +47,7 @@ std::shared_ptr<Event> EventStore::pop() {
 	size_t evnt_s = this->events.size();
 
 	std::shared_ptr<Event> event = this->heap.pop();
-	this->events.erase(event);
+	this->events.erase(event.get());
 
 	if (this->heap.size() != this->events.size()) {
 		throw Error{ERR << "inconsistent: prev_heap=" << heap_s
@@ -47,14 +60,14 @@ std::shared_ptr<Event> EventStore::pop() {
 }
 
 
-const std::shared_ptr<Event> &EventStore::top() {
+const std::shared_ptr<Event> &HeapEventStore::top() {
 	return this->heap.top();
 }
 
 
-bool EventStore::erase(const std::shared_ptr<Event> &event) {
+bool HeapEventStore::erase(const std::shared_ptr<Event> &event) {
 	bool erased = false;
-	auto it = this->events.find(event);
+	auto it = this->events.find(event.get());
 	if (it != std::end(this->events)) {
 		this->heap.remove_node(it->second);
 		this->events.erase(it);
@@ -65,8 +78,8 @@ bool EventStore::erase(const std::shared_ptr<Event> &event) {
 }
 
 
-void EventStore::update(const std::shared_ptr<Event> &event) {
-	auto it = this->events.find(event);
+void HeapEventStore::update(const std::shared_ptr<Event> &event) {
+	auto it = this->events.find(event.get());
 	if (it != std::end(this->events)) [[unlikely]] {
 		this->heap.update(it->second);
 	}
@@ -76,28 +89,28 @@ void EventStore::update(const std::shared_ptr<Event> &event) {
 }
 
 
-bool EventStore::contains(const std::shared_ptr<Event> &event) const {
-	return (this->events.find(event) != std::end(this->events));
+bool HeapEventStore::contains(const std::shared_ptr<Event> &event) const {
+	return (this->events.find(event.get()) != std::end(this->events));
 }
 
 
-void EventStore::clear() {
+void HeapEventStore::clear() {
 	this->heap.clear();
 	this->events.clear();
 }
 
 
-size_t EventStore::size() const {
+size_t HeapEventStore::size() const {
 	return this->events.size();
 }
 
 
-bool EventStore::empty() const {
+bool HeapEventStore::empty() const {
 	return this->events.empty();
 }
 
 
-std::vector<std::shared_ptr<Event>> EventStore::get_sorted_events() const {
+std::vector<std::shared_ptr<Event>> HeapEventStore::get_sorted_events() const {
 	std::vector<std::shared_ptr<Event>> ret;
 
 	ret.reserve(this->events.size());
@@ -107,7 +120,7 @@ std::vector<std::shared_ptr<Event>> EventStore::get_sorted_events() const {
 		std::end(this->events),
 		std::back_inserter(ret),
 		[](const auto &elem) {
-			return elem.first;
+			return elem.first->shared_from_this();
 		});
 
 	std::sort(
@@ -1,51 +1,124 @@
-// Copyright 2018-2023 the openage authors. See copying.md for legal info.
+// Copyright 2018-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
 #include "datastructure/pairing_heap.h"
 #include "event/event.h"
+#include "util/memory_tag.h"
 #include "util/misc.h"
 
 
 namespace openage::event {
 
+/**
+ * Data structure used for sorting the events of an event queue.
+ */
+enum class event_store_t {
+	/// Pairing heap (default).
+	HEAP,
+	/// Calendar queue with stable ordering of events with the same time.
+	CALENDAR,
+};
+
+
 /**
  * Sorted storage for events.
- * Implemented through a heap that automatically provides the newest event.
+ *
+ * Implementations always provide the event with the earliest time first.
  */
 class EventStore {
 public:
-	// TODO: don't store a double-sharedpointer.
-	//       instead, use the event-sharedpointer directly.
-	using heap_t = datastructure::PairingHeap<std::shared_ptr<Event>,
-	                                          util::SharedPtrLess<Event>>;
-	using elemmap_t = std::unordered_map<std::shared_ptr<Event>, heap_t::element_t>;
-
-	void push(const std::shared_ptr<Event> &event);
-	std::shared_ptr<Event> pop();
-	const std::shared_ptr<Event> &top();
-	bool erase(const std::shared_ptr<Event> &event);
-	void update(const std::shared_ptr<Event> &event);
-	bool contains(const std::shared_ptr<Event> &event) const;
-	void clear();
-	size_t size() const;
-	bool empty() const;
+	virtual ~EventStore() = default;
+
+	/**
+	 * Insert an event. The event must not already be in the store.
+	 */
+	virtual void push(const std::shared_ptr<Event> &event) = 0;
+
+	/**
+	 * Remove the event with the earliest time.
+	 */
+	virtual std::shared_ptr<Event> pop() = 0;
+
+	/**
+	 * Get the event with the earliest time.
+	 */
+	virtual const std::shared_ptr<Event> &top() = 0;
+
+	/**
+	 * Remove an event.
+	 *
+	 * @return true if the event was in the store, else false.
+	 */
+	virtual bool erase(const std::shared_ptr<Event> &event) = 0;
+
+	/**
+	 * Resort an event after its time was changed.
+	 */
+	virtual void update(const std::shared_ptr<Event> &event) = 0;
+
+	virtual bool contains(const std::shared_ptr<Event> &event) const = 0;
+	virtual void clear() = 0;
+	virtual size_t size() const = 0;
+	virtual bool empty() const = 0;
 
 	/**
 	 * Helper function that should not be called 'in production'.
 	 * It returns the events in the store sorted by time.
 	 * Use the pop() method instead (but with that you can't iterate).
 	 */
-	std::vector<std::shared_ptr<Event>> get_sorted_events() const;
+	virtual std::vector<std::shared_ptr<Event>> get_sorted_events() const = 0;
+};
+
+
+/**
+ * Create an empty event store.
+ *
+ * @param type Data structure of the store.
+ *
+ * @return New event store.
+ */
+std::unique_ptr<EventStore> make_event_store(event_store_t type);
+
+
+/**
+ * Event store implemented through a heap that automatically provides the newest event.
+ *
+ * Events with the same time are popped in no particular order.
+ */
+class HeapEventStore : public EventStore {
+public:
+	using heap_t = datastructure::PairingHeap<std::shared_ptr<Event>,
+	                                          util::SharedPtrLess<Event>>;
+
+	// the events are owned by the heap, so the lookup doesn't need to share them
+	using elemmap_t = std::unordered_map<Event *,
+	                                     heap_t::element_t,
+	                                     std::hash<Event *>,
+	                                     std::equal_to<Event *>,
+	                                     util::TaggedAllocator<std::pair<Event *const, heap_t::element_t>,
+	                                                           util::memory_tag::event>>;
+
+	void push(const std::shared_ptr<Event> &event) override;
+	std::shared_ptr<Event> pop() override;
+	const std::shared_ptr<Event> &top() override;
+	bool erase(const std::shared_ptr<Event> &event) override;
+	void update(const std::shared_ptr<Event> &event) override;
+	bool contains(const std::shared_ptr<Event> &event) const override;
+	void clear() override;
+	size_t size() const override;
+	bool empty() const override;
+
+	std::vector<std::shared_ptr<Event>> get_sorted_events() const override;
 
 	heap_t heap;
 	elemmap_t events;
 };
 
-
 } // namespace openage::event
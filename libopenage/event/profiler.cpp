@@ -0,0 +1,327 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "profiler.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+#include "log/log.h"
+#include "log/message.h"
+
+#include "util/file.h"
+#include "util/fixed_point.h"
+#include "util/thread_id.h"
+
+
+namespace openage::event {
+
+namespace {
+
+/**
+ * Maximum number of captured spans, so that a forgotten trace
+ * doesn't use up all memory.
+ */
+constexpr size_t max_spans = 1 << 22;
+
+/**
+ * Get the histogram bucket of an execution time.
+ */
+size_t get_histogram_bucket(int64_t ns) {
+	uint64_t value = std::max<int64_t>(ns, 0);
+	if (value < 4) {
+		return value;
+	}
+
+	// 4 buckets per power of two
+	size_t exponent = std::bit_width(value) - 1;
+	size_t sub = (value >> (exponent - 2)) & 3;
+	return (exponent - 1) * 4 + sub;
+}
+
+/**
+ * Get the highest execution time that falls into a histogram bucket.
+ */
+int64_t get_histogram_upper_bound(size_t bucket) {
+	if (bucket < 4) {
+		return bucket;
+	}
+
+	size_t exponent = bucket / 4 + 1;
+	size_t sub = bucket % 4;
+	return static_cast<int64_t>(((4 + sub + 1) << (exponent - 2)) - 1);
+}
+
+/**
+ * Write a string as JSON string literal.
+ */
+void write_json_string(std::ostream &out, const std::string &str) {
+	out << '"';
+	for (char c : str) {
+		switch (c) {
+		case '"':
+			out << "\\\"";
+			break;
+		case '\\':
+			out << "\\\\";
+			break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20) {
+				out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+				    << static_cast<int>(c) << std::dec << std::setfill(' ');
+			}
+			else {
+				out << c;
+			}
+		}
+	}
+	out << '"';
+}
+
+} // namespace
+
+
+int64_t EventProfiler::HandlerStats::get_percentile(double percentile) const {
+	if (this->invocations == 0) {
+		return 0;
+	}
+
+	size_t target = std::clamp<size_t>(std::ceil(percentile * this->invocations), 1, this->invocations);
+	size_t count = 0;
+	for (size_t i = 0; i < histogram_size; ++i) {
+		count += this->histogram[i];
+		if (count >= target) {
+			return std::min(get_histogram_upper_bound(i), this->max_ns);
+		}
+	}
+
+	return this->max_ns;
+}
+
+
+EventProfiler::EventProfiler() :
+	mode{0},
+	dropped_spans{0} {}
+
+
+void EventProfiler::set_enabled(bool enabled) {
+	if (enabled) {
+		this->mode.fetch_or(mode_counters);
+	}
+	else {
+		this->mode.fetch_and(~mode_counters);
+	}
+}
+
+
+bool EventProfiler::is_enabled() const {
+	return this->mode.load() & mode_counters;
+}
+
+
+void EventProfiler::start_trace() {
+	std::unique_lock lock{this->mutex};
+
+	this->spans.clear();
+	this->dropped_spans = 0;
+	this->trace_start = clock_t::now();
+	this->mode.fetch_or(mode_trace);
+}
+
+
+void EventProfiler::stop_trace() {
+	this->mode.fetch_and(~mode_trace);
+}
+
+
+bool EventProfiler::is_tracing() const {
+	return this->mode.load() & mode_trace;
+}
+
+
+void EventProfiler::record_invoke(const std::string &handler,
+                                  const time::time_t &time,
+                                  const clock_t::time_point &start,
+                                  const clock_t::time_point &end) {
+	int mode = this->mode.load(std::memory_order_relaxed);
+	std::unique_lock lock{this->mutex};
+
+	if (mode & mode_counters) {
+		int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+		auto &stats = this->handler_stats[handler];
+		stats.invocations += 1;
+		stats.total_ns += ns;
+		stats.max_ns = std::max(stats.max_ns, ns);
+		stats.histogram[get_histogram_bucket(ns)] += 1;
+	}
+
+	if (mode & mode_trace) {
+		this->add_span(handler, time, start, end);
+	}
+}
+
+
+void EventProfiler::record_change(const std::string &handler) {
+	if (not this->is_enabled()) {
+		return;
+	}
+
+	std::unique_lock lock{this->mutex};
+	this->handler_stats[handler].changes += 1;
+}
+
+
+void EventProfiler::record_reenqueue(const std::string &handler) {
+	if (not this->is_enabled()) {
+		return;
+	}
+
+	std::unique_lock lock{this->mutex};
+	this->handler_stats[handler].reenqueues += 1;
+}
+
+
+void EventProfiler::record_reach_time(const time::time_t &time,
+                                      size_t attempts,
+                                      const clock_t::time_point &start,
+                                      const clock_t::time_point &end) {
+	int mode = this->mode.load(std::memory_order_relaxed);
+	std::unique_lock lock{this->mutex};
+
+	if (mode & mode_counters) {
+		this->loop_stats.reach_count += 1;
+		this->loop_stats.settle_attempts += attempts;
+		this->loop_stats.max_settle_attempts = std::max(this->loop_stats.max_settle_attempts, attempts);
+		this->loop_stats.settle_histogram[std::min(attempts, settle_histogram_size - 1)] += 1;
+		this->loop_stats.total_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	}
+
+	if (mode & mode_trace) {
+		this->add_span("reach_time", time, start, end);
+	}
+}
+
+
+std::unordered_map<std::string, EventProfiler::HandlerStats> EventProfiler::get_handler_stats() const {
+	std::unique_lock lock{this->mutex};
+	return this->handler_stats;
+}
+
+
+EventProfiler::LoopStats EventProfiler::get_loop_stats() const {
+	std::unique_lock lock{this->mutex};
+	return this->loop_stats;
+}
+
+
+void EventProfiler::reset() {
+	std::unique_lock lock{this->mutex};
+
+	this->handler_stats.clear();
+	this->loop_stats = LoopStats{};
+}
+
+
+void EventProfiler::log_stats() const {
+	auto loop_stats = this->get_loop_stats();
+	auto handler_stats = this->get_handler_stats();
+
+	std::vector<std::pair<std::string, HandlerStats>> sorted{
+		std::begin(handler_stats),
+		std::end(handler_stats),
+	};
+	std::sort(std::begin(sorted), std::end(sorted), [](const auto &a, const auto &b) {
+		return a.second.total_ns > b.second.total_ns;
+	});
+
+	log::log(INFO << "Event loop: " << loop_stats.reach_count << " reach_time calls, "
+	              << loop_stats.total_ns / 1e6 << " ms total, "
+	              << loop_stats.settle_attempts << " settle attempts (max "
+	              << loop_stats.max_settle_attempts << " per call)");
+
+	std::ostringstream passes;
+	for (size_t i = 0; i < settle_histogram_size; ++i) {
+		if (loop_stats.settle_histogram[i] > 0) {
+			passes << " " << i << (i == settle_histogram_size - 1 ? "+" : "")
+			       << ": " << loop_stats.settle_histogram[i];
+		}
+	}
+	log::log(INFO << "  calls by settle attempts:" << passes.str());
+
+	for (const auto &[id, stats] : sorted) {
+		log::log(INFO << "  " << id << ": "
+		              << stats.invocations << " invocations, "
+		              << stats.total_ns / 1e6 << " ms total, "
+		              << "p50 " << stats.get_percentile(0.5) << " ns, "
+		              << "p99 " << stats.get_percentile(0.99) << " ns, "
+		              << "max " << stats.max_ns << " ns, "
+		              << stats.changes << " changes, "
+		              << stats.reenqueues << " reenqueues");
+	}
+}
+
+
+std::string EventProfiler::get_trace() const {
+	std::unique_lock lock{this->mutex};
+
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(3);
+	out << "{\"traceEvents\":[";
+
+	bool first = true;
+	for (const auto &span : this->spans) {
+		if (not first) {
+			out << ",";
+		}
+		first = false;
+
+		// timestamps are in microseconds
+		out << "\n{\"name\":";
+		write_json_string(out, span.name);
+		out << ",\"cat\":\"event\",\"ph\":\"X\""
+		    << ",\"ts\":" << span.start_ns / 1e3
+		    << ",\"dur\":" << span.duration_ns / 1e3
+		    << ",\"pid\":0,\"tid\":" << span.thread_id
+		    << ",\"args\":{\"time\":" << span.time.to_double() << "}}";
+	}
+
+	out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+	return out.str();
+}
+
+
+void EventProfiler::write_trace(const std::string &path) const {
+	util::File file{path, util::File::mode_t::W};
+	file.write(this->get_trace());
+	file.close();
+
+	log::log(INFO << "Wrote event trace to " << path);
+}
+
+
+void EventProfiler::add_span(std::string name,
+                             const time::time_t &time,
+                             const clock_t::time_point &start,
+                             const clock_t::time_point &end) {
+	if (this->spans.size() >= max_spans) [[unlikely]] {
+		if (this->dropped_spans == 0) {
+			log::log(WARN << "Event trace reached " << max_spans << " spans, dropping further spans");
+		}
+		this->dropped_spans += 1;
+		return;
+	}
+
+	this->spans.push_back({
+		std::move(name),
+		time,
+		std::chrono::duration_cast<std::chrono::nanoseconds>(start - this->trace_start).count(),
+		std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(),
+		util::get_current_thread_id(),
+	});
+}
+
+} // namespace openage::event
@@ -0,0 +1,271 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "time/time.h"
+
+
+namespace openage::event {
+
+/**
+ * Collects execution statistics of the event handlers invoked by an event loop.
+ *
+ * Profiling can be switched on and off at runtime. When it is off, the event loop
+ * only checks a single flag per processed event.
+ *
+ * Independent of the counters, the profiler can capture spans of the executed events
+ * and export them as Chrome trace JSON, which can be viewed in chrome://tracing or
+ * Perfetto.
+ */
+class EventProfiler {
+public:
+	using clock_t = std::chrono::steady_clock;
+
+	/**
+	 * Number of buckets of the execution time histogram.
+	 */
+	static constexpr size_t histogram_size = 64 * 4;
+
+	/**
+	 * Statistics of one event handler.
+	 */
+	struct HandlerStats {
+		/// Number of invocations.
+		size_t invocations = 0;
+		/// Number of changes the invocations made to event entities.
+		size_t changes = 0;
+		/// Number of times a REPEAT event was enqueued again.
+		size_t reenqueues = 0;
+		/// Summed execution time (in nanoseconds).
+		int64_t total_ns = 0;
+		/// Longest execution time (in nanoseconds).
+		int64_t max_ns = 0;
+		/// Execution times, 4 buckets per power of two nanoseconds.
+		std::array<uint32_t, histogram_size> histogram{};
+
+		/**
+		 * Get an execution time percentile.
+		 *
+		 * The result is the upper bound of the histogram bucket, i.e. it
+		 * is at most 25% higher than the exact value.
+		 *
+		 * @param percentile Percentile in the range [0.0, 1.0].
+		 *
+		 * @return Execution time (in nanoseconds).
+		 */
+		int64_t get_percentile(double percentile) const;
+	};
+
+	/**
+	 * Number of buckets of the settle pass histogram. The last bucket
+	 * counts all calls with at least that many passes.
+	 */
+	static constexpr size_t settle_histogram_size = 16;
+
+	/**
+	 * Statistics of the calls to \p EventLoop::reach_time().
+	 */
+	struct LoopStats {
+		/// Number of calls.
+		size_t reach_count = 0;
+		/// Summed number of settle attempts (update and execute passes).
+		size_t settle_attempts = 0;
+		/// Highest number of settle attempts of a single call.
+		size_t max_settle_attempts = 0;
+		/// Number of calls by their number of settle attempts.
+		std::array<size_t, settle_histogram_size> settle_histogram{};
+		/// Summed execution time (in nanoseconds).
+		int64_t total_ns = 0;
+	};
+
+	EventProfiler();
+	~EventProfiler() = default;
+
+	/**
+	 * Check if the event loop has to report to the profiler.
+	 *
+	 * @return true if counters or tracing are enabled, else false.
+	 */
+	bool is_active() const {
+		return this->mode.load(std::memory_order_relaxed) != 0;
+	}
+
+	/**
+	 * Enable or disable the counters.
+	 */
+	void set_enabled(bool enabled);
+
+	/**
+	 * Check if the counters are enabled.
+	 */
+	bool is_enabled() const;
+
+	/**
+	 * Start capturing event spans. Previously captured spans are discarded.
+	 */
+	void start_trace();
+
+	/**
+	 * Stop capturing event spans.
+	 */
+	void stop_trace();
+
+	/**
+	 * Check if event spans are captured.
+	 */
+	bool is_tracing() const;
+
+	/**
+	 * Record an event handler invocation.
+	 *
+	 * @param handler ID of the event handler.
+	 * @param time Simulation time of the event.
+	 * @param start Start of the invocation.
+	 * @param end End of the invocation.
+	 */
+	void record_invoke(const std::string &handler,
+	                   const time::time_t &time,
+	                   const clock_t::time_point &start,
+	                   const clock_t::time_point &end);
+
+	/**
+	 * Record a change made by an event handler.
+	 *
+	 * @param handler ID of the event handler.
+	 */
+	void record_change(const std::string &handler);
+
+	/**
+	 * Record that a REPEAT event was enqueued again.
+	 *
+	 * @param handler ID of the event handler.
+	 */
+	void record_reenqueue(const std::string &handler);
+
+	/**
+	 * Record a call to \p EventLoop::reach_time().
+	 *
+	 * @param time Simulation time that was reached.
+	 * @param attempts Number of settle attempts.
+	 * @param start Start of the call.
+	 * @param end End of the call.
+	 */
+	void record_reach_time(const time::time_t &time,
+	                       size_t attempts,
+	                       const clock_t::time_point &start,
+	                       const clock_t::time_point &end);
+
+	/**
+	 * Get the statistics of all event handlers that were invoked.
+	 *
+	 * @return Statistics by event handler ID.
+	 */
+	std::unordered_map<std::string, HandlerStats> get_handler_stats() const;
+
+	/**
+	 * Get the statistics of the event loop.
+	 */
+	LoopStats get_loop_stats() const;
+
+	/**
+	 * Reset all statistics.
+	 */
+	void reset();
+
+	/**
+	 * Log the statistics, sorted by the total execution time of the event handlers.
+	 */
+	void log_stats() const;
+
+	/**
+	 * Get the captured event spans as Chrome trace JSON.
+	 *
+	 * @return JSON document.
+	 */
+	std::string get_trace() const;
+
+	/**
+	 * Write the captured event spans to a file as Chrome trace JSON.
+	 *
+	 * @param path Path of the output file.
+	 */
+	void write_trace(const std::string &path) const;
+
+private:
+	/**
+	 * Flags for \p mode.
+	 */
+	static constexpr int mode_counters = 1;
+	static constexpr int mode_trace = 2;
+
+	/**
+	 * Captured span of an event or a \p reach_time() call.
+	 */
+	struct span_t {
+		/// Name of the span (event handler ID).
+		std::string name;
+		/// Simulation time.
+		time::time_t time;
+		/// Start relative to the trace start (in nanoseconds).
+		int64_t start_ns;
+		/// Duration (in nanoseconds).
+		int64_t duration_ns;
+		/// Thread that executed the span.
+		size_t thread_id;
+	};
+
+	/**
+	 * Add a span to the trace.
+	 */
+	void add_span(std::string name,
+	              const time::time_t &time,
+	              const clock_t::time_point &start,
+	              const clock_t::time_point &end);
+
+	/**
+	 * Enabled features (\p mode_counters and \p mode_trace).
+	 */
+	std::atomic<int> mode;
+
+	/**
+	 * Statistics by event handler ID.
+	 */
+	std::unordered_map<std::string, HandlerStats> handler_stats;
+
+	/**
+	 * Statistics of the event loop.
+	 */
+	LoopStats loop_stats;
+
+	/**
+	 * Start of the trace capture.
+	 */
+	clock_t::time_point trace_start;
+
+	/**
+	 * Captured spans.
+	 */
+	std::vector<span_t> spans;
+
+	/**
+	 * Number of spans that were not captured because the trace was full.
+	 */
+	size_t dropped_spans;
+
+	/**
+	 * Mutex for protecting threaded access.
+	 */
+	mutable std::mutex mutex;
+};
+
+} // namespace openage::event
@@ -1,14 +1,19 @@
-// Copyright 2017-2023 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
+#include <algorithm>
+#include <chrono>
 #include <compare>
 #include <cstring>
 #include <iostream>
 #include <list>
 #include <memory>
+#include <random>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
+#include "error/error.h"
 #include "log/log.h"
 #include "log/message.h"
 #include "testing/testing.h"
@@ -17,8 +22,11 @@
 #include "event/event_loop.h"
 #include "event/evententity.h"
 #include "event/eventhandler.h"
+#include "event/eventstore.h"
+#include "event/profiler.h"
 #include "event/state.h"
 #include "time/time.h"
+#include "util/alloc_count.h"
 #include "util/fixed_point.h"
 
 
@@ -593,4 +601,433 @@ void eventtrigger() {
 	}
 }
 
+
+void eventprofiler() {
+	auto loop = std::make_shared<EventLoop>();
+	loop->add_event_handler(std::make_shared<TestEventHandler>("test_on_A", 0));
+	loop->add_event_handler(std::make_shared<TestEventHandler>("test_on_B", 1));
+
+	auto state = std::make_shared<TestState>(loop);
+	auto gstate = std::static_pointer_cast<State>(state);
+
+	auto &profiler = loop->get_profiler();
+	profiler.is_active() and TESTFAIL;
+
+	// nothing is recorded while profiling is disabled
+	loop->create_event("test_on_B", state->objectB, gstate, 1);
+	loop->create_event("test_on_A", state->objectA, gstate, 1);
+	state->objectA->set_number(0, 0);
+	loop->reach_time(4, gstate);
+	profiler.get_handler_stats().empty() or TESTFAIL;
+
+	profiler.set_enabled(true);
+	profiler.start_trace();
+	for (int i = 3; i <= 10; ++i) {
+		loop->reach_time(i * 2, gstate);
+	}
+	profiler.stop_trace();
+	profiler.set_enabled(false);
+	profiler.is_active() and TESTFAIL;
+
+	// the ping pong executes every 3 seconds, alternating between A and B
+	auto stats = profiler.get_handler_stats();
+	TESTEQUALS(stats.size(), 2);
+	auto stats_a = stats["test_on_A"];
+	auto stats_b = stats["test_on_B"];
+	TESTEQUALS(stats_a.invocations + stats_b.invocations, 5);
+	TESTEQUALS(stats_a.changes, stats_a.invocations);
+	stats_a.get_percentile(0.5) <= stats_a.get_percentile(1.0) or TESTFAIL;
+	stats_a.get_percentile(1.0) == stats_a.max_ns or TESTFAIL;
+
+	auto loop_stats = profiler.get_loop_stats();
+	TESTEQUALS(loop_stats.reach_count, 8);
+	loop_stats.settle_attempts >= loop_stats.reach_count or TESTFAIL;
+
+	std::string trace = profiler.get_trace();
+	trace.starts_with("{\"traceEvents\":[") or TESTFAIL;
+	trace.find("\"name\":\"test_on_A\"") != std::string::npos or TESTFAIL;
+	trace.find("\"name\":\"reach_time\"") != std::string::npos or TESTFAIL;
+}
+
+void eventsettle() {
+	// handler that executes right when its dependency changes
+	class ImmediateEventHandler : public TestEventHandler {
+	public:
+		using TestEventHandler::TestEventHandler;
+
+		time::time_t predict_invoke_time(const std::shared_ptr<EventEntity> & /*target*/,
+		                                 const std::shared_ptr<State> & /*state*/,
+		                                 const time::time_t &at) override {
+			return at;
+		}
+	};
+
+	auto loop = std::make_shared<EventLoop>();
+	loop->add_event_handler(std::make_shared<ImmediateEventHandler>("ping_on_A", 0));
+	loop->add_event_handler(std::make_shared<ImmediateEventHandler>("pong_on_B", 1));
+
+	auto state = std::make_shared<TestState>(loop);
+	auto gstate = std::static_pointer_cast<State>(state);
+
+	auto &profiler = loop->get_profiler();
+	profiler.set_enabled(true);
+
+	loop->create_event("ping_on_A", state->objectA, gstate, 1);
+	loop->create_event("pong_on_B", state->objectB, gstate, 1);
+	state->objectA->set_number(0, 0);
+
+	// every pass executes the event that was changed by the previous one,
+	// at t=1, 2, 3 and 4, and no pass is needed after the last change
+	loop->reach_time(4, gstate);
+	TESTEQUALS(state->trace.size(), 4);
+	auto loop_stats = profiler.get_loop_stats();
+	TESTEQUALS(loop_stats.settle_attempts, 5);
+	TESTEQUALS(loop_stats.settle_histogram[5], 1);
+
+	// the events keep changing each other until the settle limit is reached
+	try {
+		loop->reach_time(100, gstate);
+		TESTFAILMSG("events should not have settled");
+	}
+	catch (testing::TestError &) {
+		throw;
+	}
+	catch (Error &e) {
+		std::string msg = e.what();
+		msg.find("ping_on_A on TestObject[0] -> pong_on_B on TestObject[1]") != std::string::npos
+			or TESTFAILMSG("unexpected message: " << msg);
+	}
+	TESTEQUALS(state->trace.size(), 4 + EventLoop::max_settle_passes);
+}
+
+/**
+ * Create events that are only used for filling event stores.
+ */
+std::vector<std::shared_ptr<Event>> create_store_events(size_t count) {
+	auto loop = std::make_shared<EventLoop>();
+	auto state = std::make_shared<TestState>(loop);
+	auto handler = std::make_shared<TestEventHandler>("test_store", 0);
+
+	std::vector<std::shared_ptr<Event>> events;
+	events.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		events.push_back(std::make_shared<Event>(state->objectA, handler, EventHandler::param_map{}));
+	}
+	return events;
+}
+
+
+void eventstore() {
+	// events with the same time are popped in insertion order
+	{
+		auto store = make_event_store(event_store_t::CALENDAR);
+		auto events = create_store_events(6);
+
+		for (size_t i = 0; i < events.size(); ++i) {
+			events[i]->set_time(i % 2 == 0 ? 1 : time::time_t::from_double(0.5));
+			store->push(events[i]);
+		}
+
+		// updating moves an event behind the others with the same time
+		store->update(events[1]);
+
+		std::vector<std::shared_ptr<Event>> expected{
+			events[3], events[5], events[1], events[0], events[2], events[4]};
+		store->get_sorted_events() == expected or TESTFAIL;
+		for (const auto &event : expected) {
+			store->top() == event or TESTFAIL;
+			store->pop() == event or TESTFAIL;
+		}
+		store->empty() or TESTFAIL;
+	}
+
+	// the calendar queue returns the events in the same order as the heap
+	{
+		auto heap = make_event_store(event_store_t::HEAP);
+		auto calendar = make_event_store(event_store_t::CALENDAR);
+		auto events = create_store_events(2000);
+
+		std::mt19937 rng{42};
+		std::vector<std::shared_ptr<Event>> stored;
+		time::time_t now = 0;
+
+		auto remove_stored = [&](const std::shared_ptr<Event> &event) {
+			auto it = std::find(std::begin(stored), std::end(stored), event);
+			*it = stored.back();
+			stored.pop_back();
+		};
+
+		for (size_t i = 0; i < 50000; ++i) {
+			auto event = events[rng() % events.size()];
+			auto time = now + time::time_t::from_raw_value(rng() % (1 << 20));
+
+			switch (rng() % 4) {
+			case 0:
+			case 1:
+				if (heap->contains(event)) {
+					event->set_time(time);
+					heap->update(event);
+					calendar->update(event);
+				}
+				else {
+					event->set_time(time);
+					heap->push(event);
+					calendar->push(event);
+					stored.push_back(event);
+				}
+				break;
+			case 2:
+				if (heap->erase(event)) {
+					calendar->erase(event) or TESTFAIL;
+					remove_stored(event);
+				}
+				else {
+					calendar->contains(event) and TESTFAIL;
+				}
+				break;
+			case 3:
+				if (not heap->empty()) {
+					auto heap_next = heap->pop();
+					auto calendar_next = calendar->pop();
+					heap_next->get_time() == calendar_next->get_time() or TESTFAIL;
+					heap_next->get_time() >= now or TESTFAIL;
+					now = heap_next->get_time();
+
+					// events with the same time may be popped in a different order
+					if (heap_next != calendar_next) {
+						heap->erase(calendar_next) or TESTFAIL;
+						calendar->erase(heap_next) or TESTFAIL;
+						remove_stored(calendar_next);
+					}
+					remove_stored(heap_next);
+				}
+				break;
+			}
+
+			heap->size() == calendar->size() or TESTFAIL;
+			calendar->size() == stored.size() or TESTFAIL;
+		}
+
+		while (not calendar->empty()) {
+			heap->top()->get_time() == calendar->top()->get_time() or TESTFAIL;
+			auto heap_next = heap->pop();
+			auto calendar_next = calendar->pop();
+			if (heap_next != calendar_next) {
+				heap->erase(calendar_next) or TESTFAIL;
+				calendar->erase(heap_next) or TESTFAIL;
+			}
+		}
+		heap->empty() or TESTFAIL;
+	}
+}
+
+
+void eventstore_benchmark() {
+	/**
+	 * Operation of a recorded event trace.
+	 */
+	struct trace_op {
+		/// Event that is updated or \p nullptr if the next event is executed.
+		std::shared_ptr<Event> event;
+		/// Delay from the time of the last executed event.
+		time::time_t delay;
+	};
+
+	std::mt19937 rng{42};
+
+	for (size_t count : {100, 1000, 10000, 100000}) {
+		auto events = create_store_events(count);
+
+		// record a trace like the one of the game simulation: executed events are
+		// enqueued again shortly after and dependency changes move other events
+		std::vector<trace_op> trace;
+		size_t ops = 20 * count;
+		trace.reserve(ops);
+		for (size_t i = 0; i < ops; ++i) {
+			int64_t delay;
+			switch (rng() % 8) {
+			case 0:
+				// executed at the same time
+				delay = 0;
+				break;
+			case 1:
+			case 2:
+				// one simulation step later
+				delay = time::time_t::from_double(0.05).get_raw_value();
+				break;
+			default:
+				// some time later
+				delay = rng() % time::time_t::from_int(4).get_raw_value();
+			}
+
+			std::shared_ptr<Event> event;
+			if (rng() % 4 == 0) {
+				event = events[rng() % count];
+			}
+			trace.push_back({event, time::time_t::from_raw_value(delay)});
+		}
+
+		std::vector<time::time_t> start_times;
+		for (size_t i = 0; i < count; ++i) {
+			start_times.push_back(time::time_t::from_raw_value(rng() % time::time_t::from_int(4).get_raw_value()));
+		}
+
+		for (auto store_type : {event_store_t::HEAP, event_store_t::CALENDAR}) {
+			auto store = make_event_store(store_type);
+			for (size_t i = 0; i < count; ++i) {
+				events[i]->set_time(start_times[i]);
+				store->push(events[i]);
+			}
+
+			time::time_t now = 0;
+			auto start = std::chrono::steady_clock::now();
+			for (const auto &op : trace) {
+				if (op.event == nullptr) {
+					auto event = store->pop();
+					now = event->get_time();
+					event->set_time(now + op.delay);
+					store->push(event);
+				}
+				else {
+					op.event->set_time(now + op.delay);
+					store->update(op.event);
+				}
+			}
+			std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+
+			log::log(INFO << (store_type == event_store_t::HEAP ? "heap" : "calendar")
+			              << " with " << count << " events: "
+			              << duration.count() / ops << " ns per operation");
+		}
+	}
+}
+
+
+void eventloop_benchmark() {
+	using clock = std::chrono::steady_clock;
+	constexpr size_t count = 10000;
+	constexpr int seconds = 50;
+
+	// entity that announces its changes to the dependent events
+	class BenchObject : public EventEntity {
+	public:
+		BenchObject(const std::shared_ptr<EventLoop> &loop, size_t id) :
+			EventEntity(loop),
+			_id{id} {}
+
+		size_t id() const override {
+			return this->_id;
+		}
+
+		std::string idstr() const override {
+			return "BenchObject[" + std::to_string(this->_id) + "]";
+		}
+
+		void change(const time::time_t &time) {
+			this->changes(time);
+		}
+
+	private:
+		size_t _id;
+	};
+
+	// changes its own target, which reschedules it 1s later
+	class TickHandler : public EventHandler {
+	public:
+		TickHandler() :
+			EventHandler("tick", EventHandler::trigger_type::DEPENDENCY) {}
+
+		void setup_event(const std::shared_ptr<Event> &event,
+		                 const std::shared_ptr<State> & /*state*/) override {
+			event->depend_on(event->get_entity().lock());
+		}
+
+		void invoke(EventLoop & /*loop*/,
+		            const std::shared_ptr<EventEntity> &target,
+		            const std::shared_ptr<State> & /*state*/,
+		            const time::time_t &time,
+		            const EventHandler::param_map & /*params*/) override {
+			static_cast<BenchObject &>(*target).change(time);
+			this->executed += 1;
+		}
+
+		time::time_t predict_invoke_time(const std::shared_ptr<EventEntity> & /*target*/,
+		                                 const std::shared_ptr<State> & /*state*/,
+		                                 const time::time_t &at) override {
+			return at + time::time_t::from_int(1);
+		}
+
+		size_t executed = 0;
+	};
+
+	// executed once at the reference time
+	class OnceHandler : public EventHandler {
+	public:
+		OnceHandler() :
+			EventHandler("once", EventHandler::trigger_type::ONCE) {}
+
+		void setup_event(const std::shared_ptr<Event> & /*event*/,
+		                 const std::shared_ptr<State> & /*state*/) override {}
+
+		void invoke(EventLoop & /*loop*/,
+		            const std::shared_ptr<EventEntity> & /*target*/,
+		            const std::shared_ptr<State> & /*state*/,
+		            const time::time_t & /*time*/,
+		            const EventHandler::param_map &params) override {
+			params.get<int>("value") == 1 or TESTFAIL;
+		}
+
+		time::time_t predict_invoke_time(const std::shared_ptr<EventEntity> & /*target*/,
+		                                 const std::shared_ptr<State> & /*state*/,
+		                                 const time::time_t &at) override {
+			return at;
+		}
+	};
+
+	auto loop = std::make_shared<EventLoop>();
+	auto tick = std::make_shared<TickHandler>();
+	loop->add_event_handler(tick);
+	loop->add_event_handler(std::make_shared<OnceHandler>());
+	auto state = std::make_shared<State>(loop);
+
+	std::vector<std::shared_ptr<BenchObject>> objects;
+	for (size_t i = 0; i < count; ++i) {
+		objects.push_back(std::make_shared<BenchObject>(loop, i));
+		loop->create_event("tick", objects.back(), state, 0);
+		objects.back()->change(time::time_t::from_double(static_cast<double>(i) / count));
+	}
+
+	// every object changes once per second
+	size_t allocs = util::get_alloc_count();
+	auto start = clock::now();
+	for (int i = 1; i <= seconds; ++i) {
+		loop->reach_time(i, state);
+	}
+	std::chrono::duration<double, std::nano> duration = clock::now() - start;
+	size_t executed = tick->executed;
+
+	log::log(INFO << executed << " dependency events: "
+	              << duration.count() / executed << " ns per executed event");
+	if (util::alloc_count_enabled()) {
+		log::log(INFO << "  " << static_cast<double>(util::get_alloc_count() - allocs) / executed
+		              << " allocations per executed event");
+	}
+
+	// short-lived events, e.g. for commands
+	allocs = util::get_alloc_count();
+	start = clock::now();
+	for (size_t i = 0; i < count; ++i) {
+		loop->create_event("once", objects[i], state, seconds + 1, {{"value", 1}});
+	}
+	loop->reach_time(seconds + 1, state);
+	duration = clock::now() - start;
+
+	log::log(INFO << count << " once events: "
+	              << duration.count() / count << " ns per created and executed event");
+	if (util::alloc_count_enabled()) {
+		log::log(INFO << "  " << static_cast<double>(util::get_alloc_count() - allocs) / count
+		              << " allocations per created and executed event");
+	}
+}
+
 } // namespace openage::event::tests
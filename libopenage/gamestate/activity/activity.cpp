@@ -1,7 +1,9 @@
-// Copyright 2023-2023 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "activity.h"
 
+#include "gamestate/activity/node_table.h"
+
 
 namespace openage::gamestate::activity {
 
@@ -10,7 +12,8 @@ Activity::Activity(activity_id id,
                    activity_label label) :
 	id{id},
 	label{label},
-	start{start} {
+	start{start},
+	table{NodeTable::compile(start)} {
 }
 
 activity_id Activity::get_id() const {
@@ -25,4 +28,8 @@ const std::shared_ptr<Node> &Activity::get_start() const {
 	return this->start;
 }
 
+const std::shared_ptr<const NodeTable> &Activity::get_table() const {
+	return this->table;
+}
+
 } // namespace openage::gamestate::activity
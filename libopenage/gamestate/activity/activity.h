@@ -1,4 +1,4 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -9,6 +9,7 @@
 
 namespace openage::gamestate::activity {
 class Node;
+class NodeTable;
 
 using activity_id = size_t;
 using activity_label = std::string;
@@ -50,6 +51,16 @@ public:
 	 */
 	const std::shared_ptr<Node> &get_start() const;
 
+	/**
+	 * Get the compiled node table of this activity.
+	 *
+	 * The table is compiled once when the activity is created and
+	 * shared by all game entities using the activity.
+	 *
+	 * @return Compiled node table.
+	 */
+	const std::shared_ptr<const NodeTable> &get_table() const;
+
 private:
 	/**
 	 * Unique ID.
@@ -65,6 +76,11 @@ private:
 	 * Start node.
 	 */
 	std::shared_ptr<Node> start;
+
+	/**
+	 * Compiled node table.
+	 */
+	std::shared_ptr<const NodeTable> table;
 };
 
 } // namespace openage::gamestate::activity
@@ -1,4 +1,4 @@
-// Copyright 2023-2023 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -27,7 +27,7 @@ namespace activity {
  * @param entity Game entity.
  * @param loop Event loop that the event is registered on.
  * @param state Game state.
- * @param next_id ID of the next node in the activity graph.
+ * @param next_id Index of the next node in the activity's node table.
  *
  * @return Scheduled event.
  */
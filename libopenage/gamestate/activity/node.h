@@ -1,4 +1,4 @@
-// Copyright 2023-2023 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -69,6 +69,13 @@ public:
 	 */
 	const std::shared_ptr<Node> &next(node_id_t id) const;
 
+	/**
+	 * Get all output nodes.
+	 *
+	 * @return Output nodes by their identifier.
+	 */
+	const std::unordered_map<node_id_t, std::shared_ptr<Node>> &get_outputs() const;
+
 protected:
 	/**
 	 * Output nodes.
@@ -0,0 +1,193 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "node_table.h"
+
+#include <unordered_map>
+
+#include "error/error.h"
+#include "log/message.h"
+
+#include "gamestate/activity/start_node.h"
+#include "gamestate/activity/task_system_node.h"
+
+
+namespace openage::gamestate::activity {
+
+namespace {
+
+using condition_ptr_t = bool (*)(const time::time_t &,
+                                 const std::shared_ptr<gamestate::GameEntity> &);
+
+using primer_ptr_t = std::shared_ptr<openage::event::Event> (*)(const time::time_t &,
+                                                                const std::shared_ptr<gamestate::GameEntity> &,
+                                                                const std::shared_ptr<event::EventLoop> &,
+                                                                const std::shared_ptr<gamestate::GameState> &,
+                                                                size_t);
+
+/**
+ * Add a function to a function list and return its ID.
+ *
+ * If the function wraps a plain function pointer that is already
+ * in the list, the ID of the existing entry is returned instead.
+ */
+template <typename ptr_t, typename func_t>
+uint32_t intern(std::vector<func_t> &funcs, const func_t &func) {
+	auto ptr = func.template target<ptr_t>();
+	if (ptr != nullptr) {
+		for (size_t i = 0; i < funcs.size(); ++i) {
+			auto other = funcs[i].template target<ptr_t>();
+			if (other != nullptr and *other == *ptr) {
+				return static_cast<uint32_t>(i);
+			}
+		}
+	}
+
+	funcs.push_back(func);
+	return static_cast<uint32_t>(funcs.size() - 1);
+}
+
+} // namespace
+
+
+std::shared_ptr<const NodeTable> NodeTable::compile(const std::shared_ptr<Node> &start) {
+	if (start == nullptr) [[unlikely]] {
+		throw Error{MSG(err) << "Cannot compile activity graph without start node"};
+	}
+
+	std::shared_ptr<NodeTable> table{new NodeTable{}};
+
+	// nodes in breadth-first order; the position in this vector is the node index
+	std::vector<std::shared_ptr<Node>> order;
+	std::unordered_map<const Node *, node_index_t> indices;
+
+	auto index_of = [&](const std::shared_ptr<Node> &node) {
+		if (node == nullptr) {
+			return NO_NODE;
+		}
+
+		auto it = indices.find(node.get());
+		if (it != indices.end()) {
+			return it->second;
+		}
+
+		auto index = static_cast<node_index_t>(order.size());
+		indices.emplace(node.get(), index);
+		order.push_back(node);
+		return index;
+	};
+
+	auto single_output = [&](const Node &node) {
+		const auto &outputs = node.get_outputs();
+		if (outputs.empty()) {
+			return NO_NODE;
+		}
+		return index_of(outputs.begin()->second);
+	};
+
+	index_of(start);
+
+	// order grows while the nodes are visited
+	for (size_t i = 0; i < order.size(); ++i) {
+		auto node = order[i];
+
+		node_entry entry{node->get_type(), node->get_id()};
+		entry.branches_begin = static_cast<uint32_t>(table->branches.size());
+
+		switch (node->get_type()) {
+		case node_t::START:
+		case node_t::END:
+			entry.next = single_output(*node);
+			break;
+
+		case node_t::TASK_CUSTOM: {
+			auto task_node = std::static_pointer_cast<TaskCustom>(node);
+			entry.next = single_output(*node);
+			entry.task_id = static_cast<uint32_t>(table->tasks.size());
+			table->tasks.push_back(task_node->get_task_func());
+		} break;
+
+		case node_t::TASK_SYSTEM: {
+			auto task_node = std::static_pointer_cast<TaskSystemNode>(node);
+			entry.next = single_output(*node);
+			entry.system_id = task_node->get_system_id();
+		} break;
+
+		case node_t::XOR_GATE: {
+			auto gate = std::static_pointer_cast<XorGate>(node);
+			// conditions are checked in the order of their output node IDs
+			for (const auto &condition : gate->get_conditions()) {
+				table->branches.push_back({
+					index_of(gate->next(condition.first)),
+					intern<condition_ptr_t>(table->conditions, condition.second),
+				});
+			}
+			entry.next = index_of(gate->get_default());
+		} break;
+
+		case node_t::XOR_EVENT_GATE: {
+			auto gate = std::static_pointer_cast<XorEventGate>(node);
+			for (const auto &primer : gate->get_primers()) {
+				table->branches.push_back({
+					index_of(gate->next(primer.first)),
+					intern<primer_ptr_t>(table->primers, primer.second),
+				});
+			}
+		} break;
+
+		default:
+			throw Error{MSG(err) << "Cannot compile activity node " << node->str()
+			                     << " with unknown type " << static_cast<int>(node->get_type())};
+		}
+
+		entry.branches_end = static_cast<uint32_t>(table->branches.size());
+		table->nodes.push_back(entry);
+	}
+
+	return table;
+}
+
+size_t NodeTable::size() const {
+	return this->nodes.size();
+}
+
+node_index_t NodeTable::get_start() const {
+	return 0;
+}
+
+const NodeTable::node_entry &NodeTable::get_node(node_index_t index) const {
+	if (index >= this->nodes.size()) [[unlikely]] {
+		throw Error{MSG(err) << "Activity node index " << index << " is out of range"};
+	}
+
+	return this->nodes[index];
+}
+
+std::span<const NodeTable::branch_entry> NodeTable::get_branches(node_index_t index) const {
+	const auto &node = this->get_node(index);
+	return std::span{this->branches}.subspan(node.branches_begin,
+	                                         node.branches_end - node.branches_begin);
+}
+
+const condition_t &NodeTable::get_condition(uint32_t id) const {
+	return this->conditions.at(id);
+}
+
+const event_primer_t &NodeTable::get_primer(uint32_t id) const {
+	return this->primers.at(id);
+}
+
+const task_func_t &NodeTable::get_task(uint32_t id) const {
+	return this->tasks.at(id);
+}
+
+node_index_t NodeTable::find(node_id_t id) const {
+	for (size_t i = 0; i < this->nodes.size(); ++i) {
+		if (this->nodes[i].id == id) {
+			return static_cast<node_index_t>(i);
+		}
+	}
+
+	return NO_NODE;
+}
+
+} // namespace openage::gamestate::activity
@@ -0,0 +1,209 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "gamestate/activity/node.h"
+#include "gamestate/activity/task_node.h"
+#include "gamestate/activity/types.h"
+#include "gamestate/activity/xor_event_gate.h"
+#include "gamestate/activity/xor_gate.h"
+#include "gamestate/system/types.h"
+
+
+namespace openage::gamestate::activity {
+
+/**
+ * Index of a node in a node table.
+ */
+using node_index_t = uint32_t;
+
+/**
+ * Marks a missing node in a node table, e.g. an unset default output.
+ */
+constexpr node_index_t NO_NODE = std::numeric_limits<node_index_t>::max();
+
+
+/**
+ * Flat, immutable representation of an activity node graph.
+ *
+ * Nodes are stored in a contiguous array and reference their outputs
+ * by index. Conditions, event primers and custom tasks are stored
+ * once per table and referenced by ID. Identical function pointers
+ * share the same ID.
+ *
+ * A table is compiled once per activity and shared by all game entities
+ * that use the activity, so the per-entity state is just the index of
+ * the current node.
+ */
+class NodeTable {
+public:
+	/**
+	 * Entry for a single node.
+	 */
+	struct node_entry {
+		/**
+		 * Type of the node.
+		 */
+		node_t type;
+
+		/**
+		 * ID of the node in the source graph.
+		 */
+		node_id_t id;
+
+		/**
+		 * Next node for START, TASK_CUSTOM and TASK_SYSTEM nodes.
+		 * Default output for XOR_GATE nodes.
+		 */
+		node_index_t next = NO_NODE;
+
+		/**
+		 * Range of the node's branches in the branch array.
+		 * Used by XOR_GATE and XOR_EVENT_GATE nodes.
+		 */
+		uint32_t branches_begin = 0;
+		uint32_t branches_end = 0;
+
+		/**
+		 * ID of the task function (TASK_CUSTOM).
+		 */
+		uint32_t task_id = 0;
+
+		/**
+		 * System that is run (TASK_SYSTEM).
+		 */
+		system::system_id_t system_id = system::system_id_t::NONE;
+	};
+
+	/**
+	 * Conditional output of a gate node.
+	 */
+	struct branch_entry {
+		/**
+		 * Output node.
+		 */
+		node_index_t target;
+
+		/**
+		 * ID of the condition (XOR_GATE) or event primer (XOR_EVENT_GATE).
+		 */
+		uint32_t func_id;
+	};
+
+	/**
+	 * Compile a node graph into a table.
+	 *
+	 * Nodes are stored in breadth-first order, so the start node
+	 * always has index 0.
+	 *
+	 * @param start Start node of the graph.
+	 *
+	 * @return Compiled table.
+	 */
+	static std::shared_ptr<const NodeTable> compile(const std::shared_ptr<Node> &start);
+
+	/**
+	 * Get the number of nodes in the table.
+	 *
+	 * @return Number of nodes.
+	 */
+	size_t size() const;
+
+	/**
+	 * Get the index of the start node.
+	 *
+	 * @return Start node index.
+	 */
+	node_index_t get_start() const;
+
+	/**
+	 * Get a node.
+	 *
+	 * @param index Index of the node.
+	 *
+	 * @return Node entry.
+	 */
+	const node_entry &get_node(node_index_t index) const;
+
+	/**
+	 * Get the branches of a gate node.
+	 *
+	 * @param index Index of the node.
+	 *
+	 * @return Branches of the node, in the order they are checked.
+	 */
+	std::span<const branch_entry> get_branches(node_index_t index) const;
+
+	/**
+	 * Get a condition function.
+	 *
+	 * @param id ID of the condition.
+	 *
+	 * @return Condition function.
+	 */
+	const condition_t &get_condition(uint32_t id) const;
+
+	/**
+	 * Get an event primer function.
+	 *
+	 * @param id ID of the event primer.
+	 *
+	 * @return Event primer function.
+	 */
+	const event_primer_t &get_primer(uint32_t id) const;
+
+	/**
+	 * Get a custom task function.
+	 *
+	 * @param id ID of the task.
+	 *
+	 * @return Task function.
+	 */
+	const task_func_t &get_task(uint32_t id) const;
+
+	/**
+	 * Find the index of a node by its ID in the source graph.
+	 *
+	 * @param id ID of the node.
+	 *
+	 * @return Index of the node, or \p NO_NODE if it is not in the table.
+	 */
+	node_index_t find(node_id_t id) const;
+
+private:
+	NodeTable() = default;
+
+	/**
+	 * Nodes of the graph.
+	 */
+	std::vector<node_entry> nodes;
+
+	/**
+	 * Branches of all gate nodes.
+	 */
+	std::vector<branch_entry> branches;
+
+	/**
+	 * Condition functions.
+	 */
+	std::vector<condition_t> conditions;
+
+	/**
+	 * Event primer functions.
+	 */
+	std::vector<event_primer_t> primers;
+
+	/**
+	 * Custom task functions.
+	 */
+	std::vector<task_func_t> tasks;
+};
+
+} // namespace openage::gamestate::activity
@@ -1,4 +1,4 @@
-// Copyright 2023-2023 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include <cstddef>
 #include <functional>
@@ -16,11 +16,13 @@
 
 #include "gamestate/activity/end_node.h"
 #include "gamestate/activity/node.h"
+#include "gamestate/activity/node_table.h"
 #include "gamestate/activity/start_node.h"
 #include "gamestate/activity/task_node.h"
 #include "gamestate/activity/types.h"
 #include "gamestate/activity/xor_event_gate.h"
 #include "gamestate/activity/xor_gate.h"
+#include "testing/testing.h"
 #include "time/time.h"
 
 
@@ -286,4 +288,75 @@ void activity_demo() {
 	loop->reach_time(0, state);
 }
 
+
+/**
+ * Condition that is used for multiple branches in the node table test.
+ */
+bool always_true(const time::time_t & /* time */,
+                 const std::shared_ptr<gamestate::GameEntity> & /* entity */) {
+	return true;
+}
+
+
+/**
+ * Check that an activity graph is compiled into the expected node table.
+ *
+ * Graph:
+ * Start -> Task 1 -> XOR -> Event -> Task 2 -> End
+ *            ^--------|      |
+ *                    End <---| (default)
+ */
+void activity_node_table() {
+	auto start = std::make_shared<activity::StartNode>(0);
+	auto task1 = std::make_shared<activity::TaskCustom>(1);
+	auto xor_node = std::make_shared<activity::XorGate>(2);
+	auto event_node = std::make_shared<activity::XorEventGate>(3);
+	auto task2 = std::make_shared<activity::TaskCustom>(4);
+	auto end = std::make_shared<activity::EndNode>(5);
+
+	start->add_output(task1);
+	task1->add_output(xor_node);
+	xor_node->add_output(task1, always_true);
+	xor_node->add_output(event_node, always_true);
+	xor_node->set_default(end);
+	activity::event_primer_t primer = [](const time::time_t & /* time */,
+	                                     const std::shared_ptr<gamestate::GameEntity> & /* entity */,
+	                                     const std::shared_ptr<event::EventLoop> & /* loop */,
+	                                     const std::shared_ptr<gamestate::GameState> & /* state */,
+	                                     size_t /* next_id */) {
+		return std::shared_ptr<event::Event>{nullptr};
+	};
+	event_node->add_output(task2, primer);
+	task2->add_output(end);
+
+	auto table = activity::NodeTable::compile(start);
+
+	// nodes are stored in breadth-first order
+	TESTEQUALS(table->size(), 6);
+	TESTEQUALS(table->get_start(), 0);
+	TESTEQUALS(table->get_node(0).type == activity::node_t::START, true);
+	TESTEQUALS(table->get_node(0).next, 1);
+	TESTEQUALS(table->get_node(1).type == activity::node_t::TASK_CUSTOM, true);
+	TESTEQUALS(table->get_node(1).next, 2);
+
+	// conditions are checked in the order of their output node IDs
+	// and share the same ID because they wrap the same function
+	auto xor_idx = table->find(2);
+	TESTEQUALS(xor_idx, 2);
+	auto xor_branches = table->get_branches(xor_idx);
+	TESTEQUALS(xor_branches.size(), 2);
+	TESTEQUALS(xor_branches[0].target, table->find(1));
+	TESTEQUALS(xor_branches[1].target, table->find(3));
+	TESTEQUALS(xor_branches[0].func_id, xor_branches[1].func_id);
+	TESTEQUALS(table->get_node(xor_idx).next, table->find(5));
+
+	auto event_branches = table->get_branches(table->find(3));
+	TESTEQUALS(event_branches.size(), 1);
+	TESTEQUALS(event_branches[0].target, table->find(4));
+
+	TESTEQUALS(table->get_node(table->find(5)).type == activity::node_t::END, true);
+	TESTEQUALS(table->get_node(table->find(5)).next, activity::NO_NODE);
+	TESTEQUALS(table->find(42), activity::NO_NODE);
+}
+
 } // namespace openage::gamestate::tests
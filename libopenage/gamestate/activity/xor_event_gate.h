@@ -1,4 +1,4 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -38,7 +38,8 @@ namespace activity {
  * @param entity Game entity that the activity is assigned to.
  * @param loop Event loop that events are registered on.
  * @param state Game state.
- * @param next_id ID of the next node to visit. This is passed as an event parameter.
+ * @param next_id Next node to visit. This is passed as an event parameter. The activity
+ *                system passes the index of the node in the activity's node table.
  *
  * @return Event registered on the event loop.
  */
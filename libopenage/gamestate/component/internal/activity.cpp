@@ -1,4 +1,4 @@
-// Copyright 2023-2023 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "activity.h"
 
@@ -12,7 +12,8 @@ namespace openage::gamestate::component {
 Activity::Activity(const std::shared_ptr<openage::event::EventLoop> &loop,
                    const std::shared_ptr<activity::Activity> &start_activity) :
 	start_activity{start_activity},
-	node{loop, 0} {
+	table{start_activity->get_table()},
+	node{loop, 0, "", nullptr, activity::NO_NODE} {
 }
 
 component_t Activity::get_type() const {
@@ -23,17 +24,21 @@ const std::shared_ptr<activity::Activity> &Activity::get_start_activity() const
 	return this->start_activity;
 }
 
-const std::shared_ptr<activity::Node> Activity::get_node(const time::time_t &time) const {
+const std::shared_ptr<const activity::NodeTable> &Activity::get_table() const {
+	return this->table;
+}
+
+activity::node_index_t Activity::get_node(const time::time_t &time) const {
 	return this->node.get(time);
 }
 
 void Activity::set_node(const time::time_t &time,
-                        const std::shared_ptr<activity::Node> &node) {
+                        activity::node_index_t node) {
 	this->node.set_last(time, node);
 }
 
 void Activity::init(const time::time_t &time) {
-	this->set_node(time, this->start_activity->get_start());
+	this->set_node(time, this->table->get_start());
 }
 
 void Activity::add_event(const std::shared_ptr<event::Event> &event) {
@@ -1,4 +1,4 @@
-// Copyright 2021-2024 the openage authors. See copying.md for legal info.
+// Copyright 2021-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "curve/discrete.h"
+#include "gamestate/activity/node_table.h"
 #include "gamestate/component/internal_component.h"
 #include "gamestate/component/types.h"
 #include "time/time.h"
@@ -22,7 +23,6 @@ namespace gamestate {
 
 namespace activity {
 class Activity;
-class Node;
 } // namespace activity
 
 namespace component {
@@ -47,22 +47,29 @@ public:
 	 */
 	const std::shared_ptr<activity::Activity> &get_start_activity() const;
 
+	/**
+	 * Get the compiled node table of the start activity.
+	 *
+	 * @return Node table.
+	 */
+	const std::shared_ptr<const activity::NodeTable> &get_table() const;
+
 	/**
 	 * Get the node in the activity flow graph at a given time.
 	 *
 	 * @param time Time at which the node is requested.
-	 * @return Current node in the flow graph.
+	 * @return Index of the current node in the node table.
 	 */
-	const std::shared_ptr<activity::Node> get_node(const time::time_t &time) const;
+	activity::node_index_t get_node(const time::time_t &time) const;
 
 	/**
 	 * Sets the current node in the activity flow graph at a given time.
 	 *
 	 * @param time Time at which the node is set.
-	 * @param node Current node in the flow graph.
+	 * @param node Index of the current node in the node table.
 	 */
 	void set_node(const time::time_t &time,
-	              const std::shared_ptr<activity::Node> &node);
+	              activity::node_index_t node);
 
 	/**
 	 * Set the current node to the start node of the start activity.
@@ -97,9 +104,15 @@ private:
 	std::shared_ptr<activity::Activity> start_activity;
 
 	/**
-	 * Current node in the activity flow graph.
+	 * Compiled node table of the start activity. Shared with all other
+	 * entities using the same activity.
+	 */
+	std::shared_ptr<const activity::NodeTable> table;
+
+	/**
+	 * Index of the current node in the node table.
 	 */
-	curve::Discrete<std::shared_ptr<activity::Node>> node;
+	curve::Discrete<activity::node_index_t> node;
 
 	/**
 	 * Scheduled events that are waited for to progress in the node graph.
@@ -1,4 +1,4 @@
-// Copyright 2021-2023 the openage authors. See copying.md for legal info.
+// Copyright 2021-2025 the openage authors. See copying.md for legal info.
 
 #include "command_queue.h"
 
@@ -27,7 +27,13 @@ curve::Queue<std::shared_ptr<command::Command>> &CommandQueue::get_queue() {
 }
 
 const std::shared_ptr<command::Command> CommandQueue::pop_command(const time::time_t &time) {
-	return this->command_queue.pop_front(time);
+	auto command = this->command_queue.pop_front(time);
+
+	// commands are only accessed at the current simulation time, so
+	// popped commands can be removed
+	this->command_queue.compact(time);
+
+	return command;
 }
 
 
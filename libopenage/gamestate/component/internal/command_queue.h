@@ -47,7 +47,9 @@ public:
 	curve::Queue<std::shared_ptr<command::Command>> &get_queue();
 
 	/**
-	 * Get the command in the front of the queue.
+	 * Get the command in the front of the queue and remove it.
+	 *
+	 * Commands that were popped at t <= time are discarded.
 	 *
 	 * @param time Time at which the command is retrieved.
 	 *
@@ -0,0 +1,107 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "demo_1.h"
+
+#include <vector>
+
+#include "coord/phys.h"
+#include "cvar/cvar.h"
+#include "error/error.h"
+#include "gamestate/component/internal/commands/types.h"
+#include "gamestate/replay/record.h"
+#include "gamestate/replay/replayer.h"
+#include "gamestate/simulation.h"
+#include "log/log.h"
+#include "time/time_loop.h"
+
+
+namespace openage::gamestate::tests {
+
+/**
+ * Number of entities spawned by the synthetic game.
+ */
+constexpr size_t demo_entity_count = 200;
+
+/**
+ * Number of move command rounds in the synthetic game.
+ */
+constexpr size_t demo_command_rounds = 50;
+
+void simulation_demo_1(const util::Path &path) {
+	// create the inputs of a synthetic game:
+	// spawn entities on a grid and let them walk between two waypoints
+	std::vector<replay::Record> records;
+	time::time_t time = 1;
+
+	std::vector<entity_id_t> ids;
+	for (size_t i = 0; i < demo_entity_count; ++i) {
+		replay::Record spawn{};
+		spawn.type = replay::record_t::SPAWN_ENTITY;
+		spawn.time = time;
+		spawn.player = i % 2;
+		spawn.position = coord::phys3{
+			coord::phys_t::from_int(1 + i % 18),
+			coord::phys_t::from_int(1 + (i / 18) % 18),
+			0};
+		records.push_back(spawn);
+
+		ids.push_back(i);
+		time += time::time_t::from_double(0.01);
+	}
+
+	for (size_t round = 0; round < demo_command_rounds; ++round) {
+		replay::Record command{};
+		command.type = replay::record_t::SEND_COMMAND;
+		command.time = time;
+		command.player = 0;
+		command.command = component::command::command_t::MOVE;
+		command.position = (round % 2 == 0) ? coord::phys3{2, 2, 0} : coord::phys3{17, 17, 0};
+		command.entity_ids = ids;
+		records.push_back(command);
+
+		time += 2;
+	}
+
+	auto cvar = std::make_shared<cvar::CVarManager>(path);
+
+	// replay the inputs in a fresh simulation
+	auto replay = [&]() {
+		auto time_loop = std::make_shared<time::TimeLoop>();
+		auto simulation = std::make_shared<GameSimulation>(path, cvar, time_loop);
+		simulation->set_modpacks({"engine"});
+
+		auto inputs = records;
+		replay::Replayer replayer{simulation, std::move(inputs), 1};
+		auto stats = replayer.run(time + 10);
+
+		log::log(INFO << "Replay demo: " << stats.inputs << " inputs, "
+		              << replayer.get_hashes().size() << " state hashes, "
+		              << "simulated t=" << stats.end_time
+		              << " in " << static_cast<double>(stats.duration) / 1e6 << "ms");
+
+		return replayer.get_hashes();
+	};
+
+	// the same inputs must always result in the same game,
+	// even if they are replayed in the same process
+	auto first = replay();
+	auto second = replay();
+
+	if (first.size() != second.size()) {
+		throw Error{MSG(err) << "Replay demo: runs computed " << first.size()
+		                     << " and " << second.size() << " state hashes."};
+	}
+	for (size_t i = 0; i < first.size(); ++i) {
+		if (first[i] != second[i]) {
+			throw Error{MSG(err) << "Replay demo: runs desync at t=" << first[i].first
+			                     << " (state hash " << first[i].second
+			                     << " != " << second[i].second << ")."};
+		}
+	}
+
+	if (not first.empty()) {
+		log::log(INFO << "Final state hash: " << first.back().second);
+	}
+}
+
+} // namespace openage::gamestate::tests
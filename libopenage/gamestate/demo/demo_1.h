@@ -0,0 +1,19 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include "util/path.h"
+
+
+namespace openage::gamestate::tests {
+
+/**
+ * Replay synthetic player inputs in a headless simulation as fast as possible
+ * and report the simulation throughput.
+ *
+ * The inputs are replayed twice in fresh simulations. Throws if the state
+ * hashes of both runs differ.
+ */
+void simulation_demo_1(const util::Path &path);
+
+} // namespace openage::gamestate::tests
@@ -1,4 +1,4 @@
-// Copyright 2023-2023 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "tests.h"
 
@@ -6,6 +6,7 @@
 #include "log/message.h"
 
 #include "gamestate/demo/demo_0.h"
+#include "gamestate/demo/demo_1.h"
 
 
 namespace openage::gamestate::tests {
@@ -16,6 +17,10 @@ void simulation_demo(int demo_id, const util::Path &path) {
 		simulation_demo_0(path);
 		break;
 
+	case 1:
+		simulation_demo_1(path);
+		break;
+
 	default:
 		log::log(MSG(err) << "Unknown renderer demo requested: " << demo_id << ".");
 		break;
@@ -214,7 +214,10 @@ void EntityFactory::init_components(const std::shared_ptr<openage::event::EventL
 		init_activity(loop, owner_db_view, entity, activity_ability.value());
 	}
 	else {
-		auto activity = std::make_shared<component::Activity>(loop, create_test_activity());
+		if (not this->default_activity) {
+			this->default_activity = create_test_activity();
+		}
+		auto activity = std::make_shared<component::Activity>(loop, this->default_activity);
 		entity->add_component(activity);
 	}
 }
@@ -256,6 +259,7 @@ void EntityFactory::init_activity(const std::shared_ptr<openage::event::EventLoo
 		// Create the node
 		switch (api::APIActivityNode::get_type(node)) {
 		case activity::node_t::END:
+			node_id_map[node_id] = std::make_shared<activity::EndNode>(node_id);
 			break;
 		case activity::node_t::START:
 			start_node = std::make_shared<activity::StartNode>(node_id);
@@ -1,4 +1,4 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -138,6 +138,13 @@ private:
 	 */
 	std::unordered_map<nyan::fqon_t, std::shared_ptr<activity::Activity>> activity_cache;
 
+	/**
+	 * Activity for game entities without an activity ability.
+	 *
+	 * Created on first use and shared by all these entities.
+	 */
+	std::shared_ptr<activity::Activity> default_activity;
+
 	/**
 	 * Mutex for thread safety.
 	 */
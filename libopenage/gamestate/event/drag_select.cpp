@@ -1,4 +1,4 @@
-// Copyright 2023-2023 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "drag_select.h"
 
@@ -7,6 +7,7 @@
 #include "coord/phys.h"
 #include "coord/pixel.h"
 #include "coord/scene.h"
+#include "curve/continuous.h"
 #include "curve/discrete.h"
 #include "gamestate/component/internal/ownership.h"
 #include "gamestate/component/internal/position.h"
@@ -51,7 +52,9 @@ void DragSelectHandler::invoke(openage::event::EventLoop & /* loop */,
 	log::log(SPAM << "\tLeft: " << left);
 	log::log(SPAM << "\tRight: " << right);
 
-	std::vector<entity_id_t> selected;
+	// Find the selectable entities of the controlled player
+	std::vector<entity_id_t> candidates;
+	std::vector<const curve::Interpolated<coord::phys3> *> position_curves;
 	for (auto &entity : gstate->get_game_entities()) {
 		if (not entity.second->has_component(component::component_t::SELECTABLE)) {
 			// skip entities that are not selectable
@@ -67,11 +70,20 @@ void DragSelectHandler::invoke(openage::event::EventLoop & /* loop */,
 			continue;
 		}
 
-		// Get the position of the entity in the viewport
 		auto pos = std::dynamic_pointer_cast<component::Position>(
 			entity.second->get_component(component::component_t::POSITION));
-		auto current_pos = pos->get_positions().get(time);
-		auto world_pos = current_pos.to_scene3().to_world_space();
+		candidates.push_back(entity.first);
+		position_curves.push_back(&pos->get_positions());
+	}
+
+	// Get the positions of all candidates at once
+	std::vector<coord::phys3> positions(position_curves.size(), coord::phys3{0, 0, 0});
+	curve::evaluate_all<coord::phys3>(position_curves, time, positions);
+
+	std::vector<entity_id_t> selected;
+	for (size_t i = 0; i < candidates.size(); ++i) {
+		// Get the position of the entity in the viewport
+		auto world_pos = positions[i].to_scene3().to_world_space();
 		Eigen::Vector4f clip_pos = cam_matrix * Eigen::Vector4f{world_pos.x(), world_pos.y(), world_pos.z(), 1};
 
 		// Check if the entity is in the rectangle
@@ -79,7 +91,7 @@ void DragSelectHandler::invoke(openage::event::EventLoop & /* loop */,
 		    and clip_pos.x() < right
 		    and clip_pos.y() > bottom
 		    and clip_pos.y() < top) {
-			selected.push_back(entity.first);
+			selected.push_back(candidates[i]);
 		}
 	}
 
@@ -1,4 +1,4 @@
-// Copyright 2023-2023 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "send_command.h"
 
@@ -11,6 +11,7 @@
 #include "gamestate/component/types.h"
 #include "gamestate/game_entity.h"
 #include "gamestate/game_state.h"
+#include "gamestate/replay/recorder.h"
 #include "gamestate/types.h"
 
 
@@ -39,8 +40,9 @@ std::string Commander::idstr() const {
 }
 
 
-SendCommandHandler::SendCommandHandler() :
-	openage::event::OnceEventHandler{"game.send_command"} {
+SendCommandHandler::SendCommandHandler(const std::shared_ptr<replay::Recorder> &recorder) :
+	openage::event::OnceEventHandler{"game.send_command"},
+	recorder{recorder} {
 }
 
 void SendCommandHandler::setup_event(const std::shared_ptr<openage::event::Event> & /* event */,
@@ -58,6 +60,18 @@ void SendCommandHandler::invoke(openage::event::EventLoop & /* loop */,
 	auto command_type = params.get("type", component::command::command_t::NONE);
 	std::vector<gamestate::entity_id_t> ids = params.get("entity_ids",
 	                                                     std::vector<gamestate::entity_id_t>{});
+
+	if (this->recorder) {
+		replay::Record record{};
+		record.type = replay::record_t::SEND_COMMAND;
+		record.time = time;
+		record.player = params.get<player_id_t>("owner", 0);
+		record.command = command_type;
+		record.position = params.get("target", coord::phys3{0, 0, 0});
+		record.entity_ids = ids;
+		this->recorder->record(record);
+	}
+
 	for (auto id : ids) {
 		auto entity = gstate->get_game_entity(id);
 		auto command_queue = std::dynamic_pointer_cast<component::CommandQueue>(
@@ -1,4 +1,4 @@
-// Copyright 2023-2023 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -18,7 +18,12 @@ class Event;
 class State;
 } // namespace event
 
-namespace gamestate::event {
+namespace gamestate {
+namespace replay {
+class Recorder;
+}
+
+namespace event {
 
 // TODO: This is only for testing
 class Commander : public openage::event::EventEntity {
@@ -35,7 +40,12 @@ public:
  */
 class SendCommandHandler : public openage::event::OnceEventHandler {
 public:
-	SendCommandHandler();
+	/**
+	 * Creates a new SendCommandHandler.
+	 *
+	 * @param recorder: Replay recorder that logs the commands (optional).
+	 */
+	SendCommandHandler(const std::shared_ptr<replay::Recorder> &recorder = nullptr);
 	~SendCommandHandler() = default;
 
 	void setup_event(const std::shared_ptr<openage::event::Event> &event,
@@ -50,7 +60,14 @@ public:
 	time::time_t predict_invoke_time(const std::shared_ptr<openage::event::EventEntity> &target,
 	                                 const std::shared_ptr<openage::event::State> &state,
 	                                 const time::time_t &at) override;
+
+private:
+	/**
+	 * Replay recorder. Can be \p nullptr.
+	 */
+	std::shared_ptr<replay::Recorder> recorder;
 };
 
-} // namespace gamestate::event
+} // namespace event
+} // namespace gamestate
 } // namespace openage
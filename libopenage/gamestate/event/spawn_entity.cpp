@@ -1,9 +1,10 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "spawn_entity.h"
 
 #include <cstdint>
 #include <functional>
+#include <mutex>
 #include <vector>
 
 #include <nyan/nyan.h>
@@ -20,6 +21,7 @@
 #include "gamestate/game_state.h"
 #include "gamestate/manager.h"
 #include "gamestate/map.h"
+#include "gamestate/replay/recorder.h"
 #include "gamestate/types.h"
 
 // TODO: Testing
@@ -81,6 +83,10 @@ static const std::vector<nyan::fqon_t> trial_test_entities = {
 // declared static so we only have to build the vector once
 static std::vector<nyan::fqon_t> test_entities;
 
+// the list is also requested by the renderer for prefetching assets,
+// which happens outside of the event loop thread
+static std::mutex test_entities_mutex;
+
 
 void build_test_entities(const std::shared_ptr<GameState> &gstate) {
 	auto modpack_ids = gstate->get_mod_manager()->get_load_order();
@@ -123,6 +129,17 @@ void build_test_entities(const std::shared_ptr<GameState> &gstate) {
 	}
 }
 
+const std::vector<nyan::fqon_t> &get_spawnable_entities(const std::shared_ptr<GameState> &gstate) {
+	std::unique_lock lock{test_entities_mutex};
+
+	// the list is never changed once it has been built, so the
+	// reference can be used without holding the lock
+	if (test_entities.empty()) {
+		build_test_entities(gstate);
+	}
+	return test_entities;
+}
+
 
 Spawner::Spawner(const std::shared_ptr<openage::event::EventLoop> &loop) :
 	EventEntity(loop) {
@@ -138,10 +155,13 @@ std::string Spawner::idstr() const {
 
 
 SpawnEntityHandler::SpawnEntityHandler(const std::shared_ptr<openage::event::EventLoop> &loop,
-                                       const std::shared_ptr<gamestate::EntityFactory> &factory) :
+                                       const std::shared_ptr<gamestate::EntityFactory> &factory,
+                                       const std::shared_ptr<replay::Recorder> &recorder) :
 	OnceEventHandler("game.spawn_entity"),
 	loop{loop},
-	factory{factory} {
+	factory{factory},
+	recorder{recorder},
+	next_entity{0} {
 }
 
 void SpawnEntityHandler::setup_event(const std::shared_ptr<openage::event::Event> & /* event */,
@@ -158,6 +178,7 @@ void SpawnEntityHandler::invoke(openage::event::EventLoop & /* loop */,
 
 	// Check if spawn position is on the map
 	auto pos = params.get("position", gamestate::WORLD_ORIGIN);
+
 	auto map_size = gstate->get_map()->get_size();
 	if (not(pos.ne >= 0
 	        and pos.ne < map_size[0]
@@ -175,24 +196,33 @@ void SpawnEntityHandler::invoke(openage::event::EventLoop & /* loop */,
 
 	auto game_entities = nyan_db->get_obj_children_all("engine.util.game_entity.GameEntity");
 
-	if (test_entities.empty()) {
-		build_test_entities(gstate);
+	auto &spawnable_entities = get_spawnable_entities(gstate);
 
-		// Do nothing if there are no test entities
-		if (test_entities.empty()) {
-			return;
-		}
+	// Do nothing if there are no test entities
+	if (spawnable_entities.empty()) {
+		return;
 	}
 
-	static uint8_t index = 0;
-	nyan::fqon_t nyan_entity = test_entities.at(index);
-	++index;
-	if (index >= test_entities.size()) {
-		index = 0;
+	// Replays pass the recorded entity type, otherwise cycle through the spawnable entities
+	nyan::fqon_t nyan_entity = params.get<nyan::fqon_t>("entity_type", "");
+	if (nyan_entity.empty()) {
+		nyan_entity = spawnable_entities.at(this->next_entity);
+		this->next_entity = (this->next_entity + 1) % spawnable_entities.size();
 	}
 
-	// Create entity
 	player_id_t owner_id = params.get("owner", 0);
+
+	if (this->recorder) {
+		replay::Record record{};
+		record.type = replay::record_t::SPAWN_ENTITY;
+		record.time = time;
+		record.player = owner_id;
+		record.position = pos;
+		record.entity_type = nyan_entity;
+		this->recorder->record(record);
+	}
+
+	// Create entity
 	auto entity = this->factory->add_game_entity(this->loop, gstate, owner_id, nyan_entity);
 
 	// Setup components
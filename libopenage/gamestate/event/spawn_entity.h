@@ -1,10 +1,13 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
+
+#include <nyan/nyan.h>
 
 #include "event/evententity.h"
 #include "event/eventhandler.h"
@@ -22,9 +25,25 @@ class State;
 namespace gamestate {
 
 class EntityFactory;
+class GameState;
+
+namespace replay {
+class Recorder;
+}
 
 namespace event {
 
+/**
+ * Get the game entities that the spawner can create for the loaded modpacks.
+ *
+ * TODO: This is only for testing
+ *
+ * @param gstate Game state with the mod manager of the loaded modpacks.
+ *
+ * @return fqons of the spawnable game entities.
+ */
+const std::vector<nyan::fqon_t> &get_spawnable_entities(const std::shared_ptr<GameState> &gstate);
+
 // TODO: This is only for testing
 class Spawner : public openage::event::EventEntity {
 public:
@@ -45,9 +64,11 @@ public:
 	 *
 	 * @param loop: Event loop that the components register on.
 	 * @param factory: Factory that is used to create the entity.
+	 * @param recorder: Replay recorder that logs the spawns (optional).
 	 */
 	SpawnEntityHandler(const std::shared_ptr<openage::event::EventLoop> &loop,
-	                   const std::shared_ptr<gamestate::EntityFactory> &factory);
+	                   const std::shared_ptr<gamestate::EntityFactory> &factory,
+	                   const std::shared_ptr<replay::Recorder> &recorder = nullptr);
 	~SpawnEntityHandler() = default;
 
 	/**
@@ -100,6 +121,17 @@ private:
 	 * The factory that is used to create the entity.
 	 */
 	std::shared_ptr<gamestate::EntityFactory> factory;
+
+	/**
+	 * Replay recorder. Can be \p nullptr.
+	 */
+	std::shared_ptr<replay::Recorder> recorder;
+
+	/**
+	 * Index of the spawnable entity that is created next if the event
+	 * does not specify the entity type.
+	 */
+	size_t next_entity;
 };
 
 } // namespace event
@@ -1,7 +1,10 @@
-// Copyright 2018-2024 the openage authors. See copying.md for legal info.
+// Copyright 2018-2025 the openage authors. See copying.md for legal info.
 
 #include "game.h"
 
+#include <chrono>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <nyan/nyan.h>
@@ -11,12 +14,21 @@
 
 #include "assets/mod_manager.h"
 #include "assets/modpack.h"
+#include "gamestate/api/ability.h"
+#include "gamestate/api/animation.h"
+#include "gamestate/api/property.h"
+#include "gamestate/api/types.h"
 #include "gamestate/entity_factory.h"
+#include "gamestate/event/spawn_entity.h"
 #include "gamestate/game_state.h"
 #include "gamestate/map.h"
 #include "gamestate/terrain.h"
 #include "gamestate/terrain_factory.h"
 #include "gamestate/universe.h"
+#include "job/job_manager.h"
+#include "renderer/render_factory.h"
+#include "util/file.h"
+#include "util/fslike/directory.h"
 #include "util/path.h"
 #include "util/strings.h"
 
@@ -55,60 +67,153 @@ const std::shared_ptr<GameState> &Game::get_state() const {
 void Game::attach_renderer(const std::shared_ptr<renderer::RenderFactory> &render_factory) {
 	this->universe->attach_renderer(render_factory);
 	this->state->get_map()->get_terrain()->attach_renderer(render_factory);
+
+	// Start loading the animations of all entities that can be spawned,
+	// so that they don't have to be loaded when the entities appear
+	std::vector<std::string> animation_paths;
+	auto db_view = this->state->get_db_view();
+	for (auto &entity_fqon : event::get_spawnable_entities(this->state)) {
+		auto entity_obj = db_view->get_object(entity_fqon);
+		nyan::set_t abilities = entity_obj.get_set("GameEntity.abilities");
+		for (const auto &ability_val : abilities) {
+			auto ability_fqon = std::dynamic_pointer_cast<nyan::ObjectValue>(ability_val.get_ptr())->get_name();
+			auto ability = db_view->get_object(ability_fqon);
+			if (api::APIAbility::check_property(ability, api::ability_property_t::ANIMATED)) {
+				auto property = api::APIAbility::get_property(ability, api::ability_property_t::ANIMATED);
+				auto animations = api::APIAbilityProperty::get_animations(property);
+				auto paths = api::APIAnimation::get_animation_paths(animations);
+				animation_paths.insert(animation_paths.end(), paths.begin(), paths.end());
+			}
+		}
+	}
+	render_factory->prefetch_animations(animation_paths);
 }
 
 void Game::load_data(const std::shared_ptr<assets::ModManager> &mod_manager) {
-	auto load_order = mod_manager->get_load_order();
+	// finding and reading the files is done on all cores, only adding
+	// them to the database happens one after another in load order
+	job::JobManager job_manager;
+	job_manager.start();
 
+	auto load_order = mod_manager->get_load_order();
 	for (auto &mod_id : load_order) {
 		auto mod = mod_manager->get_modpack(mod_id);
-		auto info = mod->get_info();
-
-		auto includes = info.includes;
-		for (const auto &include : includes) {
-			// handle wildcards
-			auto parts = util::split(include, '/');
-			auto last_part = parts.back();
-			bool recursive = false;
-			auto search = include;
-			if (last_part == "**") {
-				recursive = true;
-				if (parts.size() == 1) {
-					// include = "**"
-					// start in root directory
-					search = "";
-				}
-				else {
-					// include = "path/to/somewhere/**"
-					// remove the wildcard '**' and the slash '/'
-					search = include.substr(0, include.size() - 3);
-				}
+		this->load_modpack(mod->get_info(), job_manager);
+	}
+
+	job_manager.stop();
+}
+
+void Game::load_modpack(const assets::ModpackInfo &info,
+                        job::JobManager &job_manager) {
+	using clock = std::chrono::steady_clock;
+	auto start = clock::now();
+
+	// access the files natively, so that the jobs don't have to go through python
+	auto base_path = info.path.get_parent().resolve_native_path();
+	util::Path base_dir{std::make_shared<util::fslike::Directory>(base_path, false, true), {}};
+	auto mod_dir = info.path.get_name();
+
+	// search paths of the includes
+	std::vector<std::pair<std::string, bool>> searches;
+	for (const auto &include : info.includes) {
+		// handle wildcards
+		auto parts = util::split(include, '/');
+		auto last_part = parts.back();
+		bool recursive = false;
+		auto search = include;
+		if (last_part == "**") {
+			recursive = true;
+			if (parts.size() == 1) {
+				// include = "**"
+				// start in root directory
+				search = "";
 			}
+			else {
+				// include = "path/to/somewhere/**"
+				// remove the wildcard '**' and the slash '/'
+				search = include.substr(0, include.size() - 3);
+			}
+		}
 
-			this->load_path(info.path.get_parent(), info.path.get_name(), search, recursive);
+		searches.emplace_back(search, recursive);
+	}
+
+	// find the files of all includes
+	std::vector<std::vector<std::string>> include_files(searches.size());
+	job_manager.parallel_for(0, searches.size(), [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			auto &[search, recursive] = searches[i];
+			this->find_files(base_dir, mod_dir, search, recursive, include_files[i]);
 		}
+	});
+
+	std::vector<std::string> files;
+	for (auto &found : include_files) {
+		files.insert(files.end(), found.begin(), found.end());
 	}
-}
+	auto found = clock::now();
 
-void Game::load_path(const util::Path &base_dir,
-                     const std::string &mod_dir,
-                     const std::string &search,
-                     bool recursive) {
-	auto base_path = base_dir.resolve_native_path();
-	auto search_path = base_dir / mod_dir / search;
+	// read the files
+	std::vector<std::string> contents(files.size());
+	job_manager.parallel_for(0, files.size(), [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			contents[i] = (base_dir / files[i]).open_r().read();
+		}
+	});
+
+	std::unordered_map<std::string, size_t> file_index;
+	size_t file_bytes = 0;
+	for (size_t i = 0; i < files.size(); ++i) {
+		file_index.emplace(files[i], i);
+		file_bytes += contents[i].size();
+	}
+	auto read = clock::now();
+
+	auto fileload_func = [&](const std::string &filename) {
+		log::log(DBG << "Loading .nyan file: " << filename);
 
-	auto fileload_func = [&base_path](const std::string &filename) {
 		// nyan wants a string filepath, so we have to construct it from the
 		// path and subpath parameters
-		log::log(INFO << "Loading .nyan file: " << filename);
 		auto loc = base_path + "/" + filename;
+
+		auto it = file_index.find(filename);
+		if (it != file_index.end() and not contents[it->second].empty()) {
+			// the file has been read already. every file is only
+			// loaded once, so the contents can be moved
+			return std::make_shared<nyan::File>(loc, std::move(contents[it->second]));
+		}
+
 		return std::make_shared<nyan::File>(loc);
 	};
 
+	// add the files to the database
+	for (const auto &file : files) {
+		this->db->load(file, fileload_func);
+	}
+	auto loaded = clock::now();
+
+	std::chrono::duration<double> find_time = found - start;
+	std::chrono::duration<double> read_time = read - found;
+	std::chrono::duration<double> load_time = loaded - read;
+	log::log(INFO << "Loaded " << files.size() << " .nyan files ("
+	              << file_bytes / 1e3 << " kB) of modpack " << info.id << " in "
+	              << (find_time + read_time + load_time).count() << " s (find: "
+	              << find_time.count() << " s, read: "
+	              << read_time.count() << " s, load: "
+	              << load_time.count() << " s)");
+}
+
+void Game::find_files(const util::Path &base_dir,
+                      const std::string &mod_dir,
+                      const std::string &search,
+                      bool recursive,
+                      std::vector<std::string> &files) const {
+	auto search_path = base_dir / mod_dir / search;
+
 	// file loading
 	if (search_path.is_file() and search_path.get_suffix() == ".nyan") {
-		auto loc = mod_dir + "/" + search;
-		this->db->load(loc, fileload_func);
+		files.push_back(mod_dir + "/" + search);
 		return;
 	}
 
@@ -122,7 +227,7 @@ void Game::load_path(const util::Path &base_dir,
 			}
 
 			auto new_search = search + "/" + p.get_name();
-			this->load_path(base_dir, mod_dir, new_search, recursive);
+			this->find_files(base_dir, mod_dir, new_search, recursive, files);
 		}
 	}
 }
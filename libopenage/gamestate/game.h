@@ -1,9 +1,10 @@
-// Copyright 2018-2024 the openage authors. See copying.md for legal info.
+// Copyright 2018-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace nyan {
 class Database;
@@ -13,12 +14,17 @@ namespace openage {
 
 namespace assets {
 class ModManager;
+struct ModpackInfo;
 }
 
 namespace event {
 class EventLoop;
 }
 
+namespace job {
+class JobManager;
+}
+
 namespace renderer {
 class RenderFactory;
 }
@@ -81,7 +87,19 @@ private:
 	void load_data(const std::shared_ptr<assets::ModManager> &mod_manager);
 
 	/**
-	 * Load game data from the filesystem recursively.
+	 * Load the game data of a modpack into the database.
+	 *
+	 * Files are found and read in parallel. They are added to the
+	 * database in the same order as they are found.
+	 *
+	 * @param info Modpack information.
+	 * @param job_manager Job manager for finding and reading the files.
+	 */
+	void load_modpack(const assets::ModpackInfo &info,
+	                  job::JobManager &job_manager);
+
+	/**
+	 * Find the nyan files of game data in the filesystem recursively.
 	 *
 	 * TODO: Move this into nyan.
 	 *
@@ -89,11 +107,13 @@ private:
 	 * @param mod_dir Name of the mod directory.
 	 * @param search Search path relative to the mod directory.
 	 * @param recursive if true, recursively search subfolders if the the search path is a directory.
+	 * @param files Found files are appended to this list (relative to the base directory).
 	 */
-	void load_path(const util::Path &base_dir,
-	               const std::string &mod_dir,
-	               const std::string &search,
-	               bool recursive = false);
+	void find_files(const util::Path &base_dir,
+	                const std::string &mod_dir,
+	                const std::string &search,
+	                bool recursive,
+	                std::vector<std::string> &files) const;
 
 	/**
 	 * Generate the terrain for the current game.
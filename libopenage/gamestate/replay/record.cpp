@@ -0,0 +1,206 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "record.h"
+
+#include <cstring>
+
+#include "error/error.h"
+#include "log/log.h"
+
+
+namespace openage::gamestate::replay {
+
+namespace {
+
+/**
+ * Append an unsigned integer as little-endian bytes.
+ */
+template <typename T>
+void put(std::string &out, T value) {
+	auto bits = static_cast<uint64_t>(value);
+	for (size_t i = 0; i < sizeof(T); ++i) {
+		out.push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+	}
+}
+
+/**
+ * Read a little-endian integer from a buffer.
+ */
+template <typename T>
+T get(const std::string &data, size_t &offset) {
+	uint64_t bits = 0;
+	for (size_t i = 0; i < sizeof(T); ++i) {
+		bits |= static_cast<uint64_t>(static_cast<uint8_t>(data[offset + i])) << (8 * i);
+	}
+	offset += sizeof(T);
+	return static_cast<T>(bits);
+}
+
+void put_phys3(std::string &out, const coord::phys3 &pos) {
+	put<int64_t>(out, pos.ne.get_raw_value());
+	put<int64_t>(out, pos.se.get_raw_value());
+	put<int64_t>(out, pos.up.get_raw_value());
+}
+
+coord::phys3 get_phys3(const std::string &data, size_t &offset) {
+	auto ne = coord::phys_t::from_raw_value(get<int64_t>(data, offset));
+	auto se = coord::phys_t::from_raw_value(get<int64_t>(data, offset));
+	auto up = coord::phys_t::from_raw_value(get<int64_t>(data, offset));
+	return coord::phys3{ne, se, up};
+}
+
+/**
+ * Size of the fields every record starts with (type, time, player).
+ */
+constexpr size_t record_prefix_size = sizeof(uint8_t) + sizeof(int64_t) + sizeof(uint64_t);
+
+/**
+ * Size of an encoded phys3 coordinate.
+ */
+constexpr size_t phys3_size = 3 * sizeof(int64_t);
+
+} // namespace
+
+
+std::string encode_header() {
+	std::string out{REPLAY_MAGIC};
+	put<uint16_t>(out, REPLAY_VERSION);
+	return out;
+}
+
+
+size_t decode_header(const std::string &data) {
+	size_t magic_len = std::strlen(REPLAY_MAGIC);
+	if (data.size() < magic_len + sizeof(uint16_t)
+	    or data.compare(0, magic_len, REPLAY_MAGIC) != 0) {
+		throw Error{MSG(err) << "Replay stream has no valid header."};
+	}
+
+	size_t offset = magic_len;
+	auto version = get<uint16_t>(data, offset);
+	if (version != REPLAY_VERSION) {
+		throw Error{MSG(err) << "Unsupported replay format version " << version
+		                     << " (expected " << REPLAY_VERSION << ")."};
+	}
+
+	return offset;
+}
+
+
+void encode_record(const Record &record, std::string &out) {
+	put<uint8_t>(out, static_cast<uint8_t>(record.type));
+	put<int64_t>(out, record.time.get_raw_value());
+	put<uint64_t>(out, record.player);
+
+	switch (record.type) {
+	case record_t::SPAWN_ENTITY:
+		put_phys3(out, record.position);
+		put<uint32_t>(out, record.entity_type.size());
+		out.append(record.entity_type);
+		break;
+
+	case record_t::SEND_COMMAND:
+		put<uint8_t>(out, static_cast<uint8_t>(record.command));
+		put_phys3(out, record.position);
+		put<uint32_t>(out, record.entity_ids.size());
+		for (auto id : record.entity_ids) {
+			put<uint64_t>(out, id);
+		}
+		break;
+
+	case record_t::STATE_HASH:
+		put<uint64_t>(out, record.hash);
+		break;
+
+	default:
+		throw Error{MSG(err) << "Unknown replay record type."};
+	}
+}
+
+
+std::optional<Record> decode_record(const std::string &data, size_t &offset) {
+	auto truncated = [&](size_t needed) {
+		if (offset + needed <= data.size()) {
+			return false;
+		}
+
+		log::log(WARN << "Replay stream is truncated at byte " << offset
+		              << ", ignoring the incomplete record.");
+		offset = data.size();
+		return true;
+	};
+
+	if (offset >= data.size()) {
+		return std::nullopt;
+	}
+
+	if (truncated(record_prefix_size)) {
+		return std::nullopt;
+	}
+
+	Record record{};
+	record.type = static_cast<record_t>(get<uint8_t>(data, offset));
+	record.time = time::time_t::from_raw_value(get<int64_t>(data, offset));
+	record.player = get<uint64_t>(data, offset);
+
+	switch (record.type) {
+	case record_t::SPAWN_ENTITY: {
+		if (truncated(phys3_size + sizeof(uint32_t))) {
+			return std::nullopt;
+		}
+		record.position = get_phys3(data, offset);
+
+		auto length = get<uint32_t>(data, offset);
+		if (truncated(length)) {
+			return std::nullopt;
+		}
+		record.entity_type = data.substr(offset, length);
+		offset += length;
+	} break;
+
+	case record_t::SEND_COMMAND: {
+		if (truncated(sizeof(uint8_t) + phys3_size + sizeof(uint32_t))) {
+			return std::nullopt;
+		}
+		record.command = static_cast<component::command::command_t>(get<uint8_t>(data, offset));
+		record.position = get_phys3(data, offset);
+
+		auto count = get<uint32_t>(data, offset);
+		if (truncated(count * sizeof(uint64_t))) {
+			return std::nullopt;
+		}
+		record.entity_ids.reserve(count);
+		for (size_t i = 0; i < count; ++i) {
+			record.entity_ids.push_back(get<uint64_t>(data, offset));
+		}
+	} break;
+
+	case record_t::STATE_HASH:
+		if (truncated(sizeof(uint64_t))) {
+			return std::nullopt;
+		}
+		record.hash = get<uint64_t>(data, offset);
+		break;
+
+	default:
+		throw Error{MSG(err) << "Unknown replay record type "
+		                     << static_cast<int>(record.type)
+		                     << " at byte " << offset << "."};
+	}
+
+	return record;
+}
+
+
+std::vector<Record> decode_stream(const std::string &data) {
+	std::vector<Record> records;
+
+	size_t offset = decode_header(data);
+	while (auto record = decode_record(data, offset)) {
+		records.push_back(std::move(record.value()));
+	}
+
+	return records;
+}
+
+} // namespace openage::gamestate::replay
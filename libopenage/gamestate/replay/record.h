@@ -0,0 +1,157 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "coord/phys.h"
+#include "gamestate/component/internal/commands/types.h"
+#include "gamestate/types.h"
+#include "time/time.h"
+
+
+namespace openage::gamestate::replay {
+
+/**
+ * Magic bytes at the start of every replay stream.
+ */
+constexpr const char *REPLAY_MAGIC = "OAREPLAY";
+
+/**
+ * Version of the replay stream format.
+ *
+ * Increment this when the binary layout of records changes.
+ */
+constexpr uint16_t REPLAY_VERSION = 2;
+
+/**
+ * Types of replay records.
+ */
+enum class record_t : uint8_t {
+	/**
+	 * A player spawned a game entity.
+	 */
+	SPAWN_ENTITY = 0,
+
+	/**
+	 * A player sent a command to a set of game entities.
+	 */
+	SEND_COMMAND = 1,
+
+	/**
+	 * Hash of the game state at the record time. Used for desync detection.
+	 */
+	STATE_HASH = 2,
+};
+
+/**
+ * Single entry in a replay stream.
+ *
+ * Records are stored in the order in which they were executed by the
+ * event loop, so their times are monotonically increasing.
+ */
+struct Record {
+	/**
+	 * Type of the record.
+	 */
+	record_t type;
+
+	/**
+	 * Simulation time at which the record was executed.
+	 */
+	time::time_t time;
+
+	/**
+	 * ID of the player that issued the action.
+	 */
+	player_id_t player = 0;
+
+	/**
+	 * Spawn position (SPAWN_ENTITY) or command target (SEND_COMMAND).
+	 */
+	coord::phys3 position{0, 0, 0};
+
+	/**
+	 * fqon of the spawned game entity (SPAWN_ENTITY). If empty, the spawner
+	 * picks the entity type itself.
+	 */
+	std::string entity_type;
+
+	/**
+	 * Command type (SEND_COMMAND).
+	 */
+	component::command::command_t command = component::command::command_t::NONE;
+
+	/**
+	 * Entities the command was sent to (SEND_COMMAND).
+	 */
+	std::vector<entity_id_t> entity_ids;
+
+	/**
+	 * State hash (STATE_HASH).
+	 */
+	uint64_t hash = 0;
+
+	bool operator==(const Record &other) const = default;
+};
+
+
+/**
+ * Get the header that starts every replay stream.
+ *
+ * @return Encoded header bytes.
+ */
+std::string encode_header();
+
+/**
+ * Check the header of a replay stream.
+ *
+ * Throws if the magic bytes or the format version don't match.
+ *
+ * @param data Encoded replay stream.
+ *
+ * @return Offset of the first record in \p data.
+ */
+size_t decode_header(const std::string &data);
+
+/**
+ * Append the binary representation of a record to a buffer.
+ *
+ * All values are stored as little-endian integers, fixed point values
+ * are stored by their raw value. The encoding is therefore platform
+ * independent.
+ *
+ * @param record Record to encode.
+ * @param out Buffer the record is appended to.
+ */
+void encode_record(const Record &record, std::string &out);
+
+/**
+ * Decode the record at the given offset of a buffer.
+ *
+ * A truncated record at the end of the stream (e.g. because the game crashed
+ * while recording) is treated as the end of the stream. Throws if the record
+ * type is unknown.
+ *
+ * @param data Encoded replay stream.
+ * @param offset Offset of the record in \p data. Advanced to the next record
+ *               after decoding.
+ *
+ * @return Decoded record or \p std::nullopt if the end of the stream is reached.
+ */
+std::optional<Record> decode_record(const std::string &data, size_t &offset);
+
+/**
+ * Decode all records from a replay stream, including the header.
+ *
+ * @param data Encoded replay stream.
+ *
+ * @return Records in stream order.
+ */
+std::vector<Record> decode_stream(const std::string &data);
+
+} // namespace openage::gamestate::replay
@@ -0,0 +1,89 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "recorder.h"
+
+#include "gamestate/replay/state_hash.h"
+#include "log/log.h"
+#include "util/path.h"
+
+
+namespace openage::gamestate::replay {
+
+Recorder::Recorder(const util::Path &path,
+                   const time::time_t &hash_interval) :
+	Recorder{path.open_w(), hash_interval} {}
+
+
+Recorder::Recorder(const util::File &file,
+                   const time::time_t &hash_interval) :
+	file{file},
+	buffer{encode_header()},
+	hash_interval{hash_interval},
+	next_hash{time::TIME_ZERO},
+	record_count{0} {
+	log::log(INFO << "Recording replay to " << this->file);
+}
+
+
+Recorder::~Recorder() {
+	this->flush();
+}
+
+
+void Recorder::record(const Record &record) {
+	std::unique_lock lock{this->mutex};
+
+	encode_record(record, this->buffer);
+	this->record_count += 1;
+
+	if (this->buffer.size() >= flush_threshold) {
+		this->flush_buffer();
+	}
+}
+
+
+void Recorder::checkpoint(const std::shared_ptr<GameState> &state,
+                          const time::time_t &time) {
+	{
+		std::unique_lock lock{this->mutex};
+
+		if (time < this->next_hash) {
+			return;
+		}
+		this->next_hash = time + this->hash_interval;
+	}
+
+	Record hash_record{};
+	hash_record.type = record_t::STATE_HASH;
+	hash_record.time = time;
+	hash_record.hash = hash_state(state, time);
+
+	this->record(hash_record);
+}
+
+
+void Recorder::flush() {
+	std::unique_lock lock{this->mutex};
+
+	this->flush_buffer();
+}
+
+
+size_t Recorder::get_record_count() const {
+	std::unique_lock lock{this->mutex};
+
+	return this->record_count;
+}
+
+
+void Recorder::flush_buffer() {
+	if (this->buffer.empty()) {
+		return;
+	}
+
+	this->file.write(this->buffer);
+	this->file.flush();
+	this->buffer.clear();
+}
+
+} // namespace openage::gamestate::replay
@@ -0,0 +1,136 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "gamestate/replay/record.h"
+#include "time/time.h"
+#include "util/file.h"
+
+
+namespace openage {
+
+namespace util {
+class Path;
+}
+
+namespace gamestate {
+class GameState;
+
+namespace replay {
+
+/**
+ * Records player inputs that are executed by the game simulation into
+ * an append-only replay stream.
+ *
+ * The recorded stream can be fed into a headless simulation with the
+ * \p Replayer to reproduce the game.
+ */
+class Recorder {
+public:
+	/**
+	 * Create a new recorder that writes to a file.
+	 *
+	 * @param path Path of the replay file. Existing files are overwritten.
+	 * @param hash_interval Simulation time between two state hash records.
+	 */
+	Recorder(const util::Path &path,
+	         const time::time_t &hash_interval = 1);
+
+	/**
+	 * Create a new recorder that writes to an already opened file.
+	 *
+	 * @param file Writable file.
+	 * @param hash_interval Simulation time between two state hash records.
+	 */
+	Recorder(const util::File &file,
+	         const time::time_t &hash_interval = 1);
+
+	/**
+	 * Flushes all remaining records to the file.
+	 */
+	~Recorder();
+
+	Recorder(const Recorder &) = delete;
+	Recorder &operator=(const Recorder &) = delete;
+
+	/**
+	 * Append a record to the stream.
+	 *
+	 * @param record Record that is appended.
+	 */
+	void record(const Record &record);
+
+	/**
+	 * Append a state hash record if at least \p hash_interval simulation time
+	 * has passed since the last state hash was recorded.
+	 *
+	 * Should be called by the simulation after the event loop has reached \p time.
+	 *
+	 * @param state Game state.
+	 * @param time Current simulation time.
+	 */
+	void checkpoint(const std::shared_ptr<GameState> &state,
+	                const time::time_t &time);
+
+	/**
+	 * Write all buffered records to the file.
+	 */
+	void flush();
+
+	/**
+	 * Get the number of records written by this recorder.
+	 *
+	 * @return Number of records.
+	 */
+	size_t get_record_count() const;
+
+private:
+	/**
+	 * Write the buffered records without locking.
+	 */
+	void flush_buffer();
+
+	/**
+	 * Buffered records are written to the file once the buffer reaches this size.
+	 */
+	static constexpr size_t flush_threshold = 64 * 1024;
+
+	/**
+	 * File the replay stream is written to.
+	 */
+	util::File file;
+
+	/**
+	 * Encoded records that have not been written yet.
+	 */
+	std::string buffer;
+
+	/**
+	 * Simulation time between two state hash records.
+	 */
+	time::time_t hash_interval;
+
+	/**
+	 * Time at which the next state hash is recorded.
+	 */
+	time::time_t next_hash;
+
+	/**
+	 * Number of records written.
+	 */
+	size_t record_count;
+
+	/**
+	 * Mutex for protecting threaded access.
+	 */
+	mutable std::mutex mutex;
+};
+
+} // namespace replay
+} // namespace gamestate
+} // namespace openage
@@ -0,0 +1,139 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "replayer.h"
+
+#include <algorithm>
+
+#include "event/event_loop.h"
+#include "event/eventhandler.h"
+#include "gamestate/event/send_command.h"
+#include "gamestate/event/spawn_entity.h"
+#include "gamestate/game.h"
+#include "gamestate/game_state.h"
+#include "gamestate/replay/state_hash.h"
+#include "gamestate/simulation.h"
+#include "log/log.h"
+#include "util/file.h"
+#include "util/path.h"
+#include "util/timer.h"
+
+
+namespace openage::gamestate::replay {
+
+Replayer::Replayer(const std::shared_ptr<GameSimulation> &simulation,
+                   std::vector<Record> &&records,
+                   const time::time_t &hash_interval) :
+	simulation{simulation},
+	records{std::move(records)},
+	hash_interval{hash_interval},
+	hashes{} {}
+
+
+Replayer::Replayer(const std::shared_ptr<GameSimulation> &simulation,
+                   const util::Path &path,
+                   const time::time_t &hash_interval) :
+	Replayer{simulation, decode_stream(path.open_r().read()), hash_interval} {}
+
+
+replay_stats Replayer::run(const time::time_t &until) {
+	if (this->simulation->get_game() == nullptr) {
+		this->simulation->start();
+	}
+
+	auto loop = this->simulation->get_event_loop();
+	auto state = this->simulation->get_game()->get_state();
+	auto spawner = this->simulation->get_spawner();
+	auto commander = this->simulation->get_commander();
+
+	replay_stats stats{};
+	this->hashes.clear();
+
+	time::time_t next_hash = time::TIME_MAX;
+	if (this->hash_interval > 0) {
+		next_hash = time::TIME_ZERO;
+	}
+
+	// execute the simulation up to (and excluding) the given time
+	// while computing the periodic hashes on the way
+	auto advance = [&](const time::time_t &time) {
+		while (next_hash < time) {
+			loop->reach_time(next_hash, state);
+			this->hashes.emplace_back(next_hash, hash_state(state, next_hash));
+			next_hash += this->hash_interval;
+		}
+	};
+
+	util::Timer timer{false};
+
+	for (const auto &record : this->records) {
+		advance(record.time);
+
+		switch (record.type) {
+		case record_t::SPAWN_ENTITY: {
+			openage::event::EventHandler::param_map::map_t params{
+				{"position", record.position},
+				{"owner", record.player},
+				{"entity_type", record.entity_type},
+			};
+			loop->create_event("game.spawn_entity", spawner, state, record.time, params);
+			stats.inputs += 1;
+		} break;
+
+		case record_t::SEND_COMMAND: {
+			openage::event::EventHandler::param_map::map_t params{
+				{"type", record.command},
+				{"target", record.position},
+				{"entity_ids", record.entity_ids},
+				{"owner", record.player},
+			};
+			loop->create_event("game.send_command", commander, state, record.time, params);
+			stats.inputs += 1;
+		} break;
+
+		case record_t::STATE_HASH: {
+			loop->reach_time(record.time, state);
+			stats.hash_checks += 1;
+
+			auto hash = hash_state(state, record.time);
+			if (hash != record.hash) {
+				if (stats.desyncs == 0) {
+					stats.first_desync = record.time;
+					log::log(WARN << "Replay desync detected at t=" << record.time
+					              << ": recorded state hash " << record.hash
+					              << ", replayed state hash " << hash);
+				}
+				stats.desyncs += 1;
+			}
+		} break;
+
+		default:
+			break;
+		}
+
+		stats.end_time = record.time;
+	}
+
+	if (until > stats.end_time) {
+		advance(until);
+		stats.end_time = until;
+	}
+	loop->reach_time(stats.end_time, state);
+
+	stats.duration = timer.getval();
+
+	double seconds = static_cast<double>(stats.duration) / 1e9;
+	log::log(INFO << "Replayed " << stats.inputs << " inputs up to t=" << stats.end_time
+	              << " in " << seconds << "s"
+	              << " (" << stats.end_time.to_double() / std::max(seconds, 1e-9) << "x realtime)"
+	              << ", " << stats.hash_checks << " hash checks"
+	              << ", " << stats.desyncs << " desyncs");
+
+	return stats;
+}
+
+
+const std::vector<std::pair<time::time_t, uint64_t>> &Replayer::get_hashes() const {
+	return this->hashes;
+}
+
+} // namespace openage::gamestate::replay
@@ -0,0 +1,144 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gamestate/replay/record.h"
+#include "time/time.h"
+#include "util/timing.h"
+
+
+namespace openage {
+
+namespace util {
+class Path;
+}
+
+namespace gamestate {
+class GameSimulation;
+
+namespace replay {
+
+/**
+ * Statistics of a replay run.
+ */
+struct replay_stats {
+	/**
+	 * Number of player input records that were fed into the simulation.
+	 */
+	size_t inputs = 0;
+
+	/**
+	 * Number of recorded state hashes that were compared.
+	 */
+	size_t hash_checks = 0;
+
+	/**
+	 * Number of recorded state hashes that did not match the replayed state.
+	 */
+	size_t desyncs = 0;
+
+	/**
+	 * Time of the first desync or \p time::TIME_MAX if there was none.
+	 */
+	time::time_t first_desync = time::TIME_MAX;
+
+	/**
+	 * Simulation time that was reached at the end of the replay.
+	 */
+	time::time_t end_time = time::TIME_ZERO;
+
+	/**
+	 * Wall clock time used for the replay (in nanoseconds).
+	 */
+	time_nsec_t duration = 0;
+};
+
+
+/**
+ * Feeds a recorded replay stream into a headless game simulation as fast as possible.
+ *
+ * Recorded state hashes are compared against the replayed state to detect desyncs.
+ * Additionally, the replayer computes its own periodic state hashes which can be
+ * compared between replay runs (e.g. on different platforms or builds).
+ */
+class Replayer {
+public:
+	/**
+	 * Create a new replayer from decoded records.
+	 *
+	 * @param simulation Game simulation the records are fed into. It must not run
+	 *                   its own simulation loop and should have no renderer attached.
+	 * @param records Replay records in stream order.
+	 * @param hash_interval Simulation time between two periodic state hashes.
+	 *                      0 disables periodic hashing.
+	 */
+	Replayer(const std::shared_ptr<GameSimulation> &simulation,
+	         std::vector<Record> &&records,
+	         const time::time_t &hash_interval = 1);
+
+	/**
+	 * Create a new replayer from a replay file.
+	 *
+	 * @param simulation Game simulation the records are fed into. It must not run
+	 *                   its own simulation loop and should have no renderer attached.
+	 * @param path Path to the replay file.
+	 * @param hash_interval Simulation time between two periodic state hashes.
+	 *                      0 disables periodic hashing.
+	 */
+	Replayer(const std::shared_ptr<GameSimulation> &simulation,
+	         const util::Path &path,
+	         const time::time_t &hash_interval = 1);
+
+	~Replayer() = default;
+
+	/**
+	 * Replay all records.
+	 *
+	 * Starts the simulation if it has not been started yet.
+	 *
+	 * @param until Simulation time that should be reached after the last record.
+	 *              If it is before the last record, the simulation stops
+	 *              at the last record.
+	 *
+	 * @return Statistics of the replay run.
+	 */
+	replay_stats run(const time::time_t &until = time::TIME_MIN);
+
+	/**
+	 * Get the periodic state hashes computed by the last run.
+	 *
+	 * @return Pairs of simulation time and state hash.
+	 */
+	const std::vector<std::pair<time::time_t, uint64_t>> &get_hashes() const;
+
+private:
+	/**
+	 * Simulation the records are fed into.
+	 */
+	std::shared_ptr<GameSimulation> simulation;
+
+	/**
+	 * Replay records in stream order.
+	 */
+	std::vector<Record> records;
+
+	/**
+	 * Simulation time between two periodic state hashes.
+	 */
+	time::time_t hash_interval;
+
+	/**
+	 * Periodic state hashes of the last run.
+	 */
+	std::vector<std::pair<time::time_t, uint64_t>> hashes;
+};
+
+} // namespace replay
+} // namespace gamestate
+} // namespace openage
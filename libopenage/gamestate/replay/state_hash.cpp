@@ -0,0 +1,83 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "state_hash.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+#include "coord/phys.h"
+#include "curve/continuous.h"
+#include "curve/discrete.h"
+#include "curve/segmented.h"
+#include "gamestate/component/internal/ownership.h"
+#include "gamestate/component/internal/position.h"
+#include "gamestate/component/types.h"
+#include "gamestate/game_entity.h"
+#include "gamestate/game_state.h"
+#include "util/hash.h"
+
+
+namespace openage::gamestate::replay {
+
+namespace {
+
+/**
+ * Fixed hash key, so hashes stay comparable between program runs.
+ */
+constexpr std::array<uint8_t, 16> hash_key{
+	'o', 'p', 'e', 'n', 'a', 'g', 'e', '-',
+	'r', 'e', 'p', 'l', 'a', 'y', '-', '1'};
+
+void put(std::string &buf, uint64_t value) {
+	for (size_t i = 0; i < sizeof(value); ++i) {
+		buf.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+	}
+}
+
+} // namespace
+
+
+uint64_t hash_state(const std::shared_ptr<GameState> &state,
+                    const time::time_t &time) {
+	auto &entities = state->get_game_entities();
+
+	std::vector<entity_id_t> ids;
+	ids.reserve(entities.size());
+	for (auto &entity : entities) {
+		ids.push_back(entity.first);
+	}
+	std::sort(ids.begin(), ids.end());
+
+	std::string buf;
+	buf.reserve(ids.size() * 6 * sizeof(uint64_t));
+
+	for (auto id : ids) {
+		auto &entity = entities.at(id);
+		put(buf, id);
+
+		if (entity->has_component(component::component_t::POSITION)) {
+			auto position = std::dynamic_pointer_cast<component::Position>(
+				entity->get_component(component::component_t::POSITION));
+
+			auto pos = position->get_positions().get(time);
+			put(buf, pos.ne.get_raw_value());
+			put(buf, pos.se.get_raw_value());
+			put(buf, pos.up.get_raw_value());
+			put(buf, position->get_angles().get(time).get_raw_value());
+		}
+
+		if (entity->has_component(component::component_t::OWNERSHIP)) {
+			auto ownership = std::dynamic_pointer_cast<component::Ownership>(
+				entity->get_component(component::component_t::OWNERSHIP));
+
+			put(buf, ownership->get_owners().get(time));
+		}
+	}
+
+	util::Siphash hasher{hash_key};
+	return hasher.digest(reinterpret_cast<const uint8_t *>(buf.data()), buf.size());
+}
+
+} // namespace openage::gamestate::replay
@@ -0,0 +1,35 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "time/time.h"
+
+
+namespace openage::gamestate {
+class GameState;
+
+namespace replay {
+
+/**
+ * Calculate a platform independent hash of the game state at a given time.
+ *
+ * The hash covers the ID, position, angle and owner of every game entity.
+ * Entities are hashed in the order of their IDs, so the result does not
+ * depend on the iteration order of the game state's entity index.
+ *
+ * Two simulations that ran the same inputs must produce the same hash for
+ * the same time. Different hashes indicate a desync.
+ *
+ * @param state Game state.
+ * @param time Time at which the state is hashed.
+ *
+ * @return Hash of the game state.
+ */
+uint64_t hash_state(const std::shared_ptr<GameState> &state,
+                    const time::time_t &time);
+
+} // namespace replay
+} // namespace openage::gamestate
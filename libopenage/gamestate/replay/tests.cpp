@@ -0,0 +1,69 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include <string>
+#include <vector>
+
+#include "coord/phys.h"
+#include "gamestate/component/internal/commands/types.h"
+#include "gamestate/replay/record.h"
+#include "testing/testing.h"
+#include "time/time.h"
+
+
+namespace openage::gamestate::replay::tests {
+
+void record_stream() {
+	std::vector<Record> records;
+
+	Record spawn{};
+	spawn.type = record_t::SPAWN_ENTITY;
+	spawn.time = time::time_t::from_double(1.5);
+	spawn.player = 1;
+	spawn.position = coord::phys3{3.25, -2, 0};
+	spawn.entity_type = "engine.util.game_entity.GameEntity";
+	records.push_back(spawn);
+
+	Record command{};
+	command.type = record_t::SEND_COMMAND;
+	command.time = time::time_t::from_double(2.75);
+	command.player = 2;
+	command.command = component::command::command_t::MOVE;
+	command.position = coord::phys3{-10.5, 7, 1};
+	command.entity_ids = {1, 42, 0xffffffffffff};
+	records.push_back(command);
+
+	Record hash{};
+	hash.type = record_t::STATE_HASH;
+	hash.time = 3;
+	hash.hash = 0x0123456789abcdef;
+	records.push_back(hash);
+
+	std::string data = encode_header();
+	for (const auto &record : records) {
+		encode_record(record, data);
+	}
+
+	// roundtrip
+	auto decoded = decode_stream(data);
+	TESTEQUALS(decoded.size(), records.size());
+	for (size_t i = 0; i < records.size(); ++i) {
+		(decoded.at(i) == records.at(i)) or TESTFAILMSG("record " << i << " differs after decoding");
+	}
+
+	// a truncated record at the end of the stream is dropped
+	auto truncated = decode_stream(data.substr(0, data.size() - 3));
+	TESTEQUALS(truncated.size(), records.size() - 1);
+
+	// invalid headers are rejected
+	TESTTHROWS(decode_stream("OAREPLAX"));
+	std::string wrong_version = data;
+	wrong_version[8] = 0x7f;
+	TESTTHROWS(decode_stream(wrong_version));
+
+	// unknown record types are rejected
+	std::string unknown = encode_header();
+	unknown.append(std::string(17, '\x7f'));
+	TESTTHROWS(decode_stream(unknown));
+}
+
+} // namespace openage::gamestate::replay::tests
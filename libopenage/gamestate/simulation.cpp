@@ -1,8 +1,13 @@
-// Copyright 2013-2024 the openage authors. See copying.md for legal info.
+// Copyright 2013-2025 the openage authors. See copying.md for legal info.
 
 #include "simulation.h"
 
+#include <exception>
+#include <string>
+
 #include "assets/mod_manager.h"
+#include "cvar/cvar.h"
+#include "error/error.h"
 #include "event/event_loop.h"
 #include "gamestate/entity_factory.h"
 #include "gamestate/event/drag_select.h"
@@ -10,9 +15,11 @@
 #include "gamestate/event/send_command.h"
 #include "gamestate/event/spawn_entity.h"
 #include "gamestate/event/wait.h"
+#include "gamestate/replay/recorder.h"
 #include "gamestate/terrain_factory.h"
 #include "time/clock.h"
 #include "time/time_loop.h"
+#include "util/memory_tag.h"
 
 // TODO
 #include "gamestate/game.h"
@@ -32,12 +39,16 @@ GameSimulation::GameSimulation(const util::Path &root_dir,
 	terrain_factory{std::make_shared<gamestate::TerrainFactory>()},
 	mod_manager{std::make_shared<assets::ModManager>(this->root_dir / "assets" / "converted")},
 	spawner{std::make_shared<gamestate::event::Spawner>(this->event_loop)},
-	commander{std::make_shared<gamestate::event::Commander>(this->event_loop)} {
+	commander{std::make_shared<gamestate::event::Commander>(this->event_loop)},
+	memory_log_interval{std::make_shared<std::atomic<double>>(0.0)},
+	last_memory_log{std::chrono::steady_clock::now()} {
 	auto mods = mod_manager->enumerate_modpacks(root_dir / "assets" / "converted");
 	for (const auto &mod : mods) {
 		this->mod_manager->register_modpack(mod);
 	}
 
+	this->init_cvars();
+
 	log::log(MSG(info) << "Created game simulation");
 }
 
@@ -47,6 +58,12 @@ void GameSimulation::run() {
 	while (this->running) {
 		time::time_t current_time = this->time_loop->get_clock()->get_time();
 		this->event_loop->reach_time(current_time, this->game->get_state());
+
+		if (this->recorder) {
+			this->recorder->checkpoint(this->game->get_state(), current_time);
+		}
+
+		this->log_memory_stats();
 	}
 	log::log(MSG(info) << "Game simulation loop exited");
 }
@@ -74,6 +91,15 @@ void GameSimulation::stop() {
 
 	this->running = false;
 
+	if (this->recorder) {
+		this->recorder->flush();
+	}
+
+	// write a running event trace
+	if (this->cvar_manager and this->event_loop->get_profiler().is_tracing()) {
+		this->cvar_manager->set("event_trace", "");
+	}
+
 	log::log(MSG(info) << "Game simulation stopped");
 }
 
@@ -133,11 +159,22 @@ void GameSimulation::set_modpacks(const std::vector<std::string> &modpacks) {
 	// TODO: Prevent setting modpacks if a game is already running
 }
 
+void GameSimulation::set_recorder(const std::shared_ptr<replay::Recorder> &recorder) {
+	std::unique_lock lock{this->mutex};
+
+	if (this->game) {
+		throw Error{MSG(err) << "Replay recorder must be set before the simulation is started."};
+	}
+
+	this->recorder = recorder;
+}
+
 void GameSimulation::init_event_handlers() {
 	auto drag_select_handler = std::make_shared<gamestate::event::DragSelectHandler>();
 	auto spawn_handler = std::make_shared<gamestate::event::SpawnEntityHandler>(this->event_loop,
-	                                                                            this->entity_factory);
-	auto command_handler = std::make_shared<gamestate::event::SendCommandHandler>();
+	                                                                            this->entity_factory,
+	                                                                            this->recorder);
+	auto command_handler = std::make_shared<gamestate::event::SendCommandHandler>(this->recorder);
 	auto manager_handler = std::make_shared<gamestate::event::ProcessCommandHandler>();
 	auto wait_handler = std::make_shared<gamestate::event::WaitHandler>();
 	this->event_loop->add_event_handler(drag_select_handler);
@@ -147,4 +184,100 @@ void GameSimulation::init_event_handlers() {
 	this->event_loop->add_event_handler(wait_handler);
 }
 
+void GameSimulation::log_memory_stats() {
+	double interval = this->memory_log_interval->load(std::memory_order_relaxed);
+	if (interval <= 0) [[likely]] {
+		return;
+	}
+
+	auto now = std::chrono::steady_clock::now();
+	if (std::chrono::duration<double>(now - this->last_memory_log).count() < interval) {
+		return;
+	}
+
+	this->last_memory_log = now;
+	util::log_memory_stats();
+}
+
+void GameSimulation::init_cvars() {
+	if (not this->cvar_manager) {
+		return;
+	}
+
+	// the cvar manager may outlive the simulation
+	std::weak_ptr<openage::event::EventLoop> weak_loop = this->event_loop;
+
+	auto get_profiling = [weak_loop]() -> std::string {
+		auto loop = weak_loop.lock();
+		return (loop and loop->get_profiler().is_enabled()) ? "true" : "false";
+	};
+	auto set_profiling = [weak_loop](std::string value) {
+		auto loop = weak_loop.lock();
+		if (not loop) {
+			return;
+		}
+
+		auto &profiler = loop->get_profiler();
+		bool enable = (value == "true" or value == "1");
+		if (not enable and profiler.is_enabled()) {
+			profiler.set_enabled(false);
+			profiler.log_stats();
+		}
+		else {
+			profiler.set_enabled(enable);
+		}
+	};
+	this->cvar_manager->create("event_profiling", {get_profiling, set_profiling});
+
+	auto trace_path = std::make_shared<std::string>();
+	auto get_trace = [trace_path]() -> std::string {
+		return *trace_path;
+	};
+	auto set_trace = [weak_loop, trace_path](std::string value) {
+		auto loop = weak_loop.lock();
+		if (not loop) {
+			return;
+		}
+
+		auto &profiler = loop->get_profiler();
+		if (profiler.is_tracing()) {
+			profiler.stop_trace();
+			profiler.write_trace(*trace_path);
+		}
+
+		*trace_path = std::move(value);
+		if (not trace_path->empty()) {
+			profiler.start_trace();
+		}
+	};
+	this->cvar_manager->create("event_trace", {get_trace, set_trace});
+
+	auto get_memory_stats = []() -> std::string {
+		return util::get_memory_report();
+	};
+	auto set_memory_stats = [](std::string value) {
+		util::log_memory_stats();
+		if (value == "reset") {
+			util::reset_memory_peaks();
+		}
+	};
+	this->cvar_manager->create("memory_stats", {get_memory_stats, set_memory_stats});
+
+	auto memory_log_interval = this->memory_log_interval;
+	auto get_memory_log_interval = [memory_log_interval]() -> std::string {
+		return std::to_string(memory_log_interval->load(std::memory_order_relaxed));
+	};
+	auto set_memory_log_interval = [memory_log_interval](std::string value) {
+		double interval;
+		try {
+			interval = std::stod(value);
+		}
+		catch (const std::exception &) {
+			throw Error{MSG(err) << "Invalid memory log interval: " << value};
+		}
+		memory_log_interval->store(interval, std::memory_order_relaxed);
+	};
+	this->cvar_manager->create("memory_log_interval", {get_memory_log_interval, set_memory_log_interval});
+}
+
 } // namespace openage::gamestate
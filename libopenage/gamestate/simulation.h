@@ -1,7 +1,10 @@
-// Copyright 2013-2024 the openage authors. See copying.md for legal info.
+// Copyright 2013-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <shared_mutex>
 
 #include "util/path.h"
@@ -38,6 +41,10 @@ class Commander;
 class Spawner;
 } // namespace event
 
+namespace replay {
+class Recorder;
+} // namespace replay
+
 /**
  * Gameplay subsystem of the engine.
  *
@@ -136,6 +143,15 @@ public:
 	 */
 	void set_modpacks(const std::vector<std::string> &modpacks);
 
+	/**
+	 * Record the player inputs of the game into a replay.
+	 *
+	 * Must be called before the simulation is started.
+	 *
+	 * @param recorder Replay recorder.
+	 */
+	void set_recorder(const std::shared_ptr<replay::Recorder> &recorder);
+
 	/**
 	 * current simulation state variable.
 	 * to be set to false to stop the simulation loop.
@@ -148,6 +164,25 @@ private:
 	 */
 	void init_event_handlers();
 
+	/**
+	 * Log the memory usage of the subsystems if the memory log interval has passed.
+	 */
+	void log_memory_stats();
+
+	/**
+	 * Register the cvars of the simulation.
+	 *
+	 * - \p event_profiling: Collect statistics of the executed events ("true" or "false").
+	 *   The statistics are logged when profiling is switched off.
+	 * - \p event_trace: Capture the executed events. Setting an empty value writes
+	 *   the trace to the previously set path as Chrome trace JSON.
+	 * - \p memory_stats: Memory usage of the subsystems. Setting any value logs the
+	 *   usage, setting "reset" also resets the peak values.
+	 * - \p memory_log_interval: Seconds between logging the memory usage while
+	 *   the simulation runs. 0 disables logging.
+	 */
+	void init_cvars();
+
 	/**
 	 * The simulation root directory.
 	 * Uses the openage fslike path abstraction that can mount paths into one.
@@ -193,9 +228,26 @@ private:
 	std::shared_ptr<gamestate::event::Spawner> spawner;
 	std::shared_ptr<gamestate::event::Commander> commander;
 
+	/**
+	 * Replay recorder for player inputs. Can be \p nullptr.
+	 */
+	std::shared_ptr<replay::Recorder> recorder;
+
 	// TODO: The game run by the engine
 	std::shared_ptr<gamestate::Game> game;
 
+	/**
+	 * Seconds between logging the memory usage. 0 disables logging.
+	 *
+	 * Shared with the cvar, which may outlive the simulation.
+	 */
+	std::shared_ptr<std::atomic<double>> memory_log_interval;
+
+	/**
+	 * Time of the last memory usage log.
+	 */
+	std::chrono::steady_clock::time_point last_memory_log;
+
 	/**
 	 * Mutex for thread-safe access to the simulation.
 	 */
@@ -1,4 +1,4 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "activity.h"
 
@@ -9,13 +9,8 @@
 #include "error/error.h"
 #include "log/message.h"
 
-#include "gamestate/activity/node.h"
-#include "gamestate/activity/start_node.h"
-#include "gamestate/activity/task_node.h"
-#include "gamestate/activity/task_system_node.h"
+#include "gamestate/activity/node_table.h"
 #include "gamestate/activity/types.h"
-#include "gamestate/activity/xor_event_gate.h"
-#include "gamestate/activity/xor_gate.h"
 #include "gamestate/component/internal/activity.h"
 #include "gamestate/component/types.h"
 #include "gamestate/game_entity.h"
@@ -34,23 +29,35 @@ void Activity::advance(const time::time_t &start_time,
                        const std::optional<openage::event::EventHandler::param_map> &ev_params) {
 	auto activity_component = std::dynamic_pointer_cast<component::Activity>(
 		entity->get_component(component::component_t::ACTIVITY));
+	const auto &table = *activity_component->get_table();
 	auto current_node = activity_component->get_node(start_time);
 
-	if (current_node == nullptr) [[unlikely]] {
+	if (current_node >= table.size()) [[unlikely]] {
 		throw Error{ERR << "No node defined in activity graph for entity "
 		                << std::to_string(entity->get_id()) << " (t=" << start_time << ")"};
 	}
 
 	// TODO: this check should be moved to a more general pre-processing section
-	if (current_node->get_type() == activity::node_t::XOR_EVENT_GATE) {
+	if (table.get_node(current_node).type == activity::node_t::XOR_EVENT_GATE) {
 		// returning to a event gateway means that the event has been triggered
 		// move to the next node here
 		if (not ev_params.has_value()) {
 			throw Error{ERR << "XorEventGate: No event parameters given on continue"};
 		}
 
-		auto next_id = ev_params.value().get<size_t>("next");
-		current_node = current_node->next(next_id);
+		auto next_index = ev_params.value().get<size_t>("next");
+		auto next_node = activity::NO_NODE;
+		for (const auto &branch : table.get_branches(current_node)) {
+			if (branch.target == next_index) {
+				next_node = branch.target;
+				break;
+			}
+		}
+		if (next_node == activity::NO_NODE) [[unlikely]] {
+			throw Error{ERR << "XorEventGate " << table.get_node(current_node).id
+			                << " has no output with index " << next_index};
+		}
+		current_node = next_node;
 
 		// cancel all other events that the manager may have been waiting for
 		activity_component->cancel_events(start_time);
@@ -59,51 +66,52 @@ void Activity::advance(const time::time_t &start_time,
 	time::time_t event_wait_time = 0;
 	auto stop = false;
 	while (not stop) {
-		switch (current_node->get_type()) {
+		if (current_node == activity::NO_NODE) [[unlikely]] {
+			throw Error{ERR << "Activity graph of entity " << std::to_string(entity->get_id())
+			                << " has a node without output (t=" << start_time << ")"};
+		}
+
+		const auto &node = table.get_node(current_node);
+		switch (node.type) {
 		case activity::node_t::START: {
-			auto node = std::static_pointer_cast<activity::StartNode>(current_node);
-			auto next_id = node->get_next();
-			current_node = node->next(next_id);
+			current_node = node.next;
 		} break;
 		case activity::node_t::END: {
 			// TODO: if activities are nested, advance to parent activity
 			stop = true;
 		} break;
 		case activity::node_t::TASK_CUSTOM: {
-			auto node = std::static_pointer_cast<activity::TaskCustom>(current_node);
-			auto task = node->get_task_func();
+			const auto &task = table.get_task(node.task_id);
 			task(start_time, entity);
-			auto next_id = node->get_next();
-			current_node = node->next(next_id);
+
+			current_node = node.next;
 		} break;
 		case activity::node_t::TASK_SYSTEM: {
-			auto node = std::static_pointer_cast<activity::TaskSystemNode>(current_node);
-			auto task = node->get_system_id();
-			event_wait_time = Activity::handle_subsystem(start_time, entity, state, task);
-			auto next_id = node->get_next();
-			current_node = node->next(next_id);
+			event_wait_time = Activity::handle_subsystem(start_time, entity, state, node.system_id);
+
+			current_node = node.next;
 		} break;
 		case activity::node_t::XOR_GATE: {
-			auto node = std::static_pointer_cast<activity::XorGate>(current_node);
-			auto next_id = node->get_default()->get_id();
-			for (auto &condition : node->get_conditions()) {
-				auto condition_func = condition.second;
-				if (condition_func(start_time, entity)) {
-					next_id = condition.first;
+			// default output if no condition is true
+			auto next_node = node.next;
+			for (const auto &branch : table.get_branches(current_node)) {
+				if (table.get_condition(branch.func_id)(start_time, entity)) {
+					next_node = branch.target;
 					break;
 				}
 			}
-			current_node = node->next(next_id);
+
+			current_node = next_node;
 		} break;
 		case activity::node_t::XOR_EVENT_GATE: {
-			auto node = std::static_pointer_cast<activity::XorEventGate>(current_node);
-			auto event_primers = node->get_primers();
-			for (auto &primer : event_primers) {
-				auto ev = primer.second(start_time + event_wait_time,
-				                        entity,
-				                        loop,
-				                        state,
-				                        primer.first);
+			for (const auto &branch : table.get_branches(current_node)) {
+				// the branch target index is passed to the event,
+				// so that we can continue there when the event is executed
+				auto ev = table.get_primer(branch.func_id)(start_time + event_wait_time,
+				                                           entity,
+				                                           loop,
+				                                           state,
+				                                           branch.target);
 				activity_component->add_event(ev);
 			}
 
@@ -112,7 +120,7 @@ void Activity::advance(const time::time_t &start_time,
 			stop = true;
 		} break;
 		default:
-			throw Error{ERR << "Unhandled node type for node " << current_node->str()};
+			throw Error{ERR << "Unhandled node type for node " << node.id};
 		}
 	}
 
@@ -127,7 +127,8 @@ const time::time_t Move::move_default(const std::shared_ptr<gamestate::GameEntit
 	auto waypoints = find_path(pathfinder, grid_id, current_pos, destination, start_time);
 
 	// use waypoints for movement
-	double total_time = 0;
+	// all times are calculated with fixed point math to keep the simulation deterministic
+	time::time_t total_time = 0;
 	pos_component->set_position(start_time, current_pos);
 	for (size_t i = 1; i < waypoints.size(); ++i) {
 		auto prev_waypoint = waypoints[i - 1];
@@ -151,8 +152,10 @@ const time::time_t Move::move_default(const std::shared_ptr<gamestate::GameEntit
 
 			// Set an intermediate position keyframe to halt the game entity
 			// until the rotation is done
-			double turn_time = angle_diff.to_double() / turn_speed->get();
-			total_time += turn_time;
+			auto turn_speed_fp = time::time_t::from_double(turn_speed->get());
+			if (turn_speed_fp > 0) {
+				total_time += time::time_t::from_fixedpoint(angle_diff) / turn_speed_fp;
+			}
 			pos_component->set_position(start_time + total_time, prev_waypoint);
 
 			// update current angle for next waypoint
@@ -161,12 +164,12 @@ const time::time_t Move::move_default(const std::shared_ptr<gamestate::GameEntit
 		pos_component->set_angle(start_time + total_time, path_angle);
 
 		// movement
-		double move_time = 0;
 		if (not move_speed->is_infinite_positive()) {
-			auto distance = path_vector.length();
-			move_time = distance / move_speed->get();
+			auto move_speed_fp = time::time_t::from_double(move_speed->get());
+			if (move_speed_fp > 0) {
+				total_time += path_vector.length() / move_speed_fp;
+			}
 		}
-		total_time += move_time;
 
 		pos_component->set_position(start_time + total_time, cur_waypoint);
 	}
@@ -1,4 +1,4 @@
-// Copyright 2021-2023 the openage authors. See copying.md for legal info.
+// Copyright 2021-2025 the openage authors. See copying.md for legal info.
 
 #include "controller.h"
 
@@ -153,6 +153,7 @@ void setup_defaults(const std::shared_ptr<BindingContext> &ctx,
 			{"type", gamestate::component::command::command_t::MOVE},
 			{"target", mouse_pos},
 			{"entity_ids", controller->get_selected()},
+			{"owner", controller->get_controlled()},
 		};
 
 		auto event = simulation->get_event_loop()->create_event(
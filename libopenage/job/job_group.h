@@ -1,4 +1,4 @@
-// Copyright 2015-2024 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -8,6 +8,7 @@
 #include "abortable_job_state.h"
 #include "job.h"
 #include "job_state.h"
+#include "pool_allocator.h"
 #include "types.h"
 #include "worker.h"
 
@@ -46,7 +47,7 @@ public:
 	Job<T> enqueue(job_function_t<T> function,
 	               callback_function_t<T> callback = {}) {
 		ENSURE(this->parent_worker, "job group has no worker thread associated");
-		auto state = std::make_shared<JobState<T>>(function, callback);
+		auto state = make_pooled_state<JobState<T>>(function, callback);
 		this->parent_worker->enqueue(state);
 		return Job<T>{state};
 	}
@@ -67,7 +68,7 @@ public:
 	Job<T> enqueue(abortable_function_t<T> function,
 	               callback_function_t<T> callback = {}) {
 		ENSURE(this->parent_worker, "job group has no worker thread associated");
-		auto state = std::make_shared<AbortableJobState<T>>(function, callback);
+		auto state = make_pooled_state<AbortableJobState<T>>(function, callback);
 		this->parent_worker->enqueue(state);
 		return Job<T>{state};
 	}
@@ -1,7 +1,10 @@
-// Copyright 2014-2019 the openage authors. See copying.md for legal info.
+// Copyright 2014-2025 the openage authors. See copying.md for legal info.
 
 #include "job_manager.h"
 
+#include <algorithm>
+#include <exception>
+
 #include "../log/log.h"
 #include "../util/thread_id.h"
 #include "worker.h"
@@ -14,10 +17,15 @@ JobManager::JobManager(int number_of_workers)
 	:
 	number_of_workers{number_of_workers},
 	group_index{0},
+	queued_jobs{0},
 	is_running{false} {
 
-	for (int i = 0; i < number_of_workers; i++) {
-		this->workers.emplace_back(new Worker{this});
+	if (this->number_of_workers <= 0) {
+		this->number_of_workers = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	for (int i = 0; i < this->number_of_workers; i++) {
+		this->workers.emplace_back(new Worker{this, static_cast<size_t>(i)});
 	}
 }
 
@@ -55,6 +63,79 @@ void JobManager::stop() {
 }
 
 
+int JobManager::get_worker_count() const {
+	return this->number_of_workers;
+}
+
+
+void JobManager::parallel_for(size_t begin,
+                              size_t end,
+                              const range_function_t &function,
+                              size_t grain_size) {
+	if (end <= begin) {
+		return;
+	}
+
+	grain_size = std::max<size_t>(grain_size, 1);
+	size_t chunks = (end - begin + grain_size - 1) / grain_size;
+
+	// shared between the calling thread and the helper jobs. helpers may
+	// start after the loop is done, so they only hold on to this struct.
+	struct loop_state {
+		std::atomic<size_t> next_chunk{0};
+		std::atomic<size_t> done_chunks{0};
+		std::mutex mutex;
+		std::condition_variable all_done;
+		std::exception_ptr exception;
+	};
+	auto loop = std::make_shared<loop_state>();
+
+	// `function` is only accessed while chunks are left, and the calling
+	// thread does not return before all chunks are done
+	auto run_chunks = [loop, begin, end, grain_size, chunks, &function]() {
+		size_t chunk;
+		while ((chunk = loop->next_chunk.fetch_add(1)) < chunks) {
+			size_t chunk_begin = begin + chunk * grain_size;
+			size_t chunk_end = std::min(end, chunk_begin + grain_size);
+
+			try {
+				function(chunk_begin, chunk_end);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock{loop->mutex};
+				if (loop->exception == nullptr) {
+					loop->exception = std::current_exception();
+				}
+			}
+
+			if (loop->done_chunks.fetch_add(1) + 1 == chunks) {
+				std::lock_guard<std::mutex> lock{loop->mutex};
+				loop->all_done.notify_all();
+			}
+		}
+		return true;
+	};
+
+	if (this->is_running.load()) {
+		size_t helpers = std::min(chunks - 1, static_cast<size_t>(this->number_of_workers));
+		for (size_t i = 0; i < helpers; ++i) {
+			this->enqueue_state(make_pooled_state<JobState<bool>>(run_chunks, callback_function_t<bool>{}));
+		}
+	}
+
+	run_chunks();
+
+	std::unique_lock<std::mutex> lock{loop->mutex};
+	loop->all_done.wait(lock, [&]() {
+		return loop->done_chunks.load() == chunks;
+	});
+
+	if (loop->exception != nullptr) {
+		std::rethrow_exception(loop->exception);
+	}
+}
+
+
 void JobManager::execute_callbacks() {
 	// run callbacks for finished jobs on this thread id.
 	size_t id = util::get_current_thread_id();
@@ -87,33 +168,124 @@ JobGroup JobManager::create_job_group() {
 
 
 void JobManager::enqueue_state(const std::shared_ptr<JobStateBase> &state) {
-	std::lock_guard<std::mutex> lock{this->pending_jobs_mutex};
-	this->pending_jobs.push(state);
-	for (auto &worker : this->workers) {
-		worker->notify();
+	auto worker = Worker::current();
+	if (worker != nullptr and worker->manager == this) {
+		// spawned from a worker: keep it local, idle workers can steal it
+		worker->push_local(state);
+	}
+	else {
+		std::lock_guard<std::mutex> lock{this->pending_jobs_mutex};
+		this->pending_jobs.push(state);
 	}
+
+	this->queued_jobs.fetch_add(1);
+	this->wake_one();
 }
 
 
-std::shared_ptr<JobStateBase> JobManager::fetch_job() {
-	std::lock_guard<std::mutex> lock{this->pending_jobs_mutex};
-	if (this->pending_jobs.empty()) {
-		return std::shared_ptr<JobStateBase>{};
+void JobManager::enqueue_state_after(const std::shared_ptr<JobStateBase> &state,
+                                     const std::vector<std::shared_ptr<JobStateBase>> &dependencies) {
+	// one extra dependency so that the job is not released while the
+	// continuations are still registered
+	state->pending_dependencies.store(dependencies.size() + 1);
+
+	for (auto &dependency : dependencies) {
+		bool finished = true;
+		if (dependency != nullptr) {
+			std::lock_guard<std::mutex> lock{dependency->continuations_mutex};
+			finished = dependency->completed;
+			if (not finished) {
+				dependency->continuations.push_back(state);
+			}
+		}
+
+		if (finished) {
+			state->pending_dependencies.fetch_sub(1);
+		}
 	}
 
-	auto job = this->pending_jobs.front();
-	this->pending_jobs.pop();
-	return job;
+	if (state->pending_dependencies.fetch_sub(1) == 1) {
+		this->enqueue_state(state);
+	}
 }
 
 
-bool JobManager::has_job() {
-	std::lock_guard<std::mutex> lock(this->pending_jobs_mutex);
-	return not this->pending_jobs.empty();
+std::shared_ptr<JobStateBase> JobManager::fetch_job(size_t worker_index) {
+	if (this->queued_jobs.load() <= 0) {
+		return nullptr;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{this->pending_jobs_mutex};
+		if (not this->pending_jobs.empty()) {
+			auto job = std::move(this->pending_jobs.front());
+			this->pending_jobs.pop();
+			this->take_job();
+			return job;
+		}
+	}
+
+	// start with the next worker so that not every thief hits the same victim
+	for (size_t i = 1; i < this->workers.size(); ++i) {
+		auto &victim = this->workers[(worker_index + i) % this->workers.size()];
+		if (auto job = victim->steal()) {
+			this->take_job();
+			return job;
+		}
+	}
+
+	return nullptr;
+}
+
+
+void JobManager::take_job() {
+	this->queued_jobs.fetch_sub(1);
+}
+
+
+void JobManager::wait_for_job(const std::function<bool()> &predicate) {
+	std::unique_lock<std::mutex> lock{this->idle_mutex};
+	this->jobs_available.wait(lock, [&]() {
+		return this->queued_jobs.load() > 0 or predicate();
+	});
+}
+
+
+void JobManager::wake_one() {
+	// taking the lock ensures that a worker can't miss the notification
+	// between checking for jobs and starting to wait
+	std::unique_lock<std::mutex> lock{this->idle_mutex};
+	lock.unlock();
+	this->jobs_available.notify_one();
+}
+
+
+void JobManager::wake_all() {
+	std::unique_lock<std::mutex> lock{this->idle_mutex};
+	lock.unlock();
+	this->jobs_available.notify_all();
 }
 
 
 void JobManager::finish_job(const std::shared_ptr<JobStateBase> &job) {
+	std::vector<std::shared_ptr<JobStateBase>> continuations;
+	{
+		std::lock_guard<std::mutex> lock{job->continuations_mutex};
+		job->completed = true;
+		std::swap(continuations, job->continuations);
+	}
+
+	for (auto &continuation : continuations) {
+		if (continuation->pending_dependencies.fetch_sub(1) == 1) {
+			this->enqueue_state(continuation);
+		}
+	}
+
+	// jobs without callback don't have to be reported to their thread
+	if (not job->has_callback()) {
+		return;
+	}
+
 	std::lock_guard<std::mutex> lock{this->finished_jobs_mutex};
 	auto it = this->finished_jobs.find(job->get_thread_id());
 	// if there hasn't been a finished job for the thread_id, create a new
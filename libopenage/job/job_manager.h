@@ -1,20 +1,25 @@
-// Copyright 2014-2024 the openage authors. See copying.md for legal info.
+// Copyright 2014-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "abortable_job_state.h"
 #include "job.h"
 #include "job_group.h"
 #include "job_state.h"
 #include "job_state_base.h"
+#include "pool_allocator.h"
 #include "types.h"
 
 namespace openage {
@@ -25,6 +30,10 @@ class Worker;
 /**
  * A job manager can be used to execute functions within separate worker
  * threads.
+ *
+ * Each worker has its own job deque. Jobs enqueued from a worker thread go
+ * to that worker's deque, jobs enqueued from other threads go to a shared
+ * queue. Workers that run out of jobs steal from the other workers.
  */
 class JobManager {
 private:
@@ -43,9 +52,21 @@ private:
 	/** A mutex to synchronize accesses to the internal job queue. */
 	std::mutex pending_jobs_mutex;
 
-	/** A queue of jobs that are to be executed. */
+	/** A queue of jobs that were enqueued from outside of the worker threads. */
 	std::queue<std::shared_ptr<JobStateBase>> pending_jobs;
 
+	/**
+	 * Number of jobs in the shared queue and the workers' deques. May be
+	 * negative for a short time while a job is taken before it is counted.
+	 */
+	std::atomic<int64_t> queued_jobs;
+
+	/** A mutex for idle workers waiting for new jobs. */
+	std::mutex idle_mutex;
+
+	/** A condition variable to wait for new jobs. */
+	std::condition_variable jobs_available;
+
 	/** A mutex to synchronize the finished job map. */
 	std::mutex finished_jobs_mutex;
 
@@ -59,8 +80,11 @@ private:
 	std::atomic_bool is_running;
 
 public:
-	/** Create a new job manager with a specified number of worker threads. */
-	JobManager(int number_of_workers);
+	/**
+	 * Create a new job manager with a specified number of worker threads.
+	 * If the number is not positive, one worker per hardware thread is used.
+	 */
+	JobManager(int number_of_workers = 0);
 
 	/** Destructor that stops the job manager if it is still running. */
 	~JobManager();
@@ -80,6 +104,9 @@ public:
 	 */
 	void stop();
 
+	/** Returns the number of worker threads. */
+	int get_worker_count() const;
+
 	/**
 	 * Enqueues the given function into the job manager's queue, so that it will
 	 * be dispatched by one of the worker threads. A lightweight Job object is
@@ -92,7 +119,7 @@ public:
 	template <class T>
 	Job<T> enqueue(job_function_t<T> function,
 	               callback_function_t<T> callback = {}) {
-		auto state = std::make_shared<JobState<T>>(function, callback);
+		auto state = make_pooled_state<JobState<T>>(function, callback);
 		this->enqueue_state(state);
 		return Job<T>{state};
 	}
@@ -112,11 +139,65 @@ public:
 	template <class T>
 	Job<T> enqueue(abortable_function_t<T> function,
 	               callback_function_t<T> callback = {}) {
-		auto state = std::make_shared<AbortableJobState<T>>(function, callback);
+		auto state = make_pooled_state<AbortableJobState<T>>(function, callback);
 		this->enqueue_state(state);
 		return Job<T>{state};
 	}
 
+	/**
+	 * Enqueues the given function as continuation of other jobs. It is
+	 * dispatched after all dependencies have finished, including those that
+	 * finished with an exception. If a dependency is aborted, the
+	 * continuation is never executed.
+	 *
+	 * @param function the function that is executed as background job
+	 * @param dependencies jobs that have to finish first
+	 */
+	template <class T, class... D>
+	Job<T> enqueue_after(job_function_t<T> function,
+	                     const Job<D> &...dependencies) {
+		return this->enqueue_after<T>(function, callback_function_t<T>{}, dependencies...);
+	}
+
+	/**
+	 * Enqueues the given function as continuation of other jobs. It is
+	 * dispatched after all dependencies have finished, including those that
+	 * finished with an exception. If a dependency is aborted, the
+	 * continuation is never executed.
+	 *
+	 * @param function the function that is executed as background job
+	 * @param callback the callback function that is executed, when the background
+	 *        job has finished
+	 * @param dependencies jobs that have to finish first
+	 */
+	template <class T, class... D>
+	Job<T> enqueue_after(job_function_t<T> function,
+	                     callback_function_t<T> callback,
+	                     const Job<D> &...dependencies) {
+		auto state = make_pooled_state<JobState<T>>(function, callback);
+		this->enqueue_state_after(state, {dependencies.state...});
+		return Job<T>{state};
+	}
+
+	/**
+	 * Runs a function for all indices in [begin, end) on the worker threads
+	 * and blocks until all of them are processed. The range is split into
+	 * chunks of \p grain_size indices, the calling thread processes chunks
+	 * as well.
+	 *
+	 * Can be called from worker threads. If the function throws, the first
+	 * exception is rethrown after all chunks have been processed.
+	 *
+	 * @param begin first index
+	 * @param end index after the last index
+	 * @param function function that is called with the bounds of every chunk
+	 * @param grain_size number of indices per chunk
+	 */
+	void parallel_for(size_t begin,
+	                  size_t end,
+	                  const range_function_t &function,
+	                  size_t grain_size = 1);
+
 	/**
 	 * Creates a job group, in order to be able to execute multiple jobs on the
 	 * same worker thread.
@@ -130,19 +211,41 @@ public:
 	void execute_callbacks();
 
 private:
-	/** Enqueues the given job into the internal job queue. */
+	/**
+	 * Enqueues the given job. If called from a worker thread, the job is
+	 * pushed to that worker's deque, otherwise to the internal job queue.
+	 */
 	void enqueue_state(const std::shared_ptr<JobStateBase> &state);
 
+	/** Enqueues the given job after the given jobs have finished. */
+	void enqueue_state_after(const std::shared_ptr<JobStateBase> &state,
+	                         const std::vector<std::shared_ptr<JobStateBase>> &dependencies);
+
 	/**
-	 * Returns a job from the internal job queue. If the queue is empty, a
-	 * nullptr is returned.
+	 * Returns a job from the internal job queue or steals one from a worker
+	 * other than the given one. If no job is found, a nullptr is returned.
 	 */
-	std::shared_ptr<JobStateBase> fetch_job();
+	std::shared_ptr<JobStateBase> fetch_job(size_t worker_index);
+
+	/** Accounts for a job that a worker has taken from its own deque. */
+	void take_job();
 
-	/** Returns whether there are jobs to be executed. */
-	bool has_job();
+	/**
+	 * Blocks until there are queued jobs or the given predicate returns
+	 * true. The predicate is checked while holding the idle mutex.
+	 */
+	void wait_for_job(const std::function<bool()> &predicate);
 
-	/** Adds a finished job to the internal finished job map. */
+	/** Wakes up one idle worker. */
+	void wake_one();
+
+	/** Wakes up all idle workers. */
+	void wake_all();
+
+	/**
+	 * Releases the continuations of a finished job and adds it to the
+	 * internal finished job map if it has a callback.
+	 */
 	void finish_job(const std::shared_ptr<JobStateBase> &job);
 
 	/**
@@ -1,14 +1,21 @@
-// Copyright 2015-2024 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "types.h"
 
 namespace openage {
 namespace job {
 
+class JobManager;
+
 /**
  * An abstract base class for a shared state of a job. A job state keeps track
  * of its execution state and store's the job's result. Further it keeps track
@@ -36,6 +43,31 @@ public:
 
 	/** Returns the id of the thread that has created this job. */
 	virtual size_t get_thread_id() = 0;
+
+	/** Returns whether the job has a callback that has to be executed. */
+	virtual bool has_callback() const = 0;
+
+private:
+	/**
+	 * Number of jobs that have to finish before this job can be scheduled.
+	 * Managed by the job manager.
+	 */
+	std::atomic<size_t> pending_dependencies{0};
+
+	/** A mutex to synchronize the completion state and the continuations. */
+	std::mutex continuations_mutex;
+
+	/** Whether the job has been executed and its continuations were released. */
+	bool completed = false;
+
+	/** Jobs that wait for this job to finish. */
+	std::vector<std::shared_ptr<JobStateBase>> continuations;
+
+	/**
+	 * The job manager has to be a friend in order to resolve the job's
+	 * dependencies.
+	 */
+	friend class JobManager;
 };
 
 } // namespace job
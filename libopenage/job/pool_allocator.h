@@ -0,0 +1,188 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+
+namespace openage {
+namespace job {
+
+namespace pool {
+
+/** Granularity of the pool's size classes in bytes. */
+constexpr size_t block_granularity = 64;
+
+/** Number of size classes. Larger allocations bypass the pool. */
+constexpr size_t size_classes = 8;
+
+/** Maximum number of free blocks that are kept per size class and thread. */
+constexpr size_t max_cached_blocks = 256;
+
+
+/**
+ * Set when the cache of the current thread was destroyed.
+ *
+ * Trivially destructible, so it can still be read while the other
+ * thread-local objects of an exiting thread are destroyed.
+ */
+inline thread_local bool cache_destroyed = false;
+
+
+/**
+ * Per-thread cache of free memory blocks, grouped by size class.
+ *
+ * Blocks are plain memory from the global operator new, so a block may be
+ * returned to the cache of another thread than the one that allocated it.
+ * The blocks are released when the thread exits.
+ */
+class BlockCache {
+public:
+	BlockCache() = default;
+
+	~BlockCache() {
+		for (auto &blocks : this->free_blocks) {
+			for (void *block : blocks) {
+				::operator delete(block);
+			}
+		}
+		cache_destroyed = true;
+	}
+
+	BlockCache(const BlockCache &) = delete;
+	BlockCache &operator=(const BlockCache &) = delete;
+
+	/**
+	 * Get the cache of the current thread.
+	 *
+	 * Pooled objects may be freed after the cache of the thread was destroyed,
+	 * e.g. by other thread-local objects or during static destruction.
+	 *
+	 * @return Cache of the current thread or \p nullptr if it was already destroyed.
+	 */
+	static BlockCache *get() {
+		if (cache_destroyed) [[unlikely]] {
+			return nullptr;
+		}
+
+		thread_local BlockCache cache;
+		return &cache;
+	}
+
+	/**
+	 * Allocate a block for the given size class.
+	 */
+	void *allocate(size_t size_class) {
+		auto &blocks = this->free_blocks[size_class];
+		if (not blocks.empty()) {
+			void *block = blocks.back();
+			blocks.pop_back();
+			return block;
+		}
+
+		return ::operator new((size_class + 1) * block_granularity);
+	}
+
+	/**
+	 * Return a block of the given size class to the cache.
+	 */
+	void deallocate(void *block, size_t size_class) {
+		auto &blocks = this->free_blocks[size_class];
+		if (blocks.size() >= max_cached_blocks) {
+			::operator delete(block);
+			return;
+		}
+
+		blocks.push_back(block);
+	}
+
+private:
+	/** Free blocks for each size class. */
+	std::array<std::vector<void *>, size_classes> free_blocks;
+};
+
+} // namespace pool
+
+
+/**
+ * Allocator that recycles memory of small objects in thread-local free lists.
+ *
+ * It is used to allocate job states together with their shared pointer
+ * control block, so that enqueuing a job does not hit the global heap
+ * once the pool is warmed up.
+ *
+ * @param T Type of the allocated objects.
+ */
+template <typename T>
+class PoolAllocator {
+public:
+	using value_type = T;
+
+	PoolAllocator() noexcept = default;
+
+	template <typename U>
+	PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+	T *allocate(size_t n) {
+		size_t bytes = n * sizeof(T);
+		if (alignof(T) > alignof(std::max_align_t)
+		    or bytes > pool::size_classes * pool::block_granularity) {
+			return static_cast<T *>(::operator new(bytes));
+		}
+
+		auto cache = pool::BlockCache::get();
+		if (not cache) [[unlikely]] {
+			// blocks have the full size of their class, so they can be cached by another thread
+			return static_cast<T *>(::operator new((size_class(bytes) + 1) * pool::block_granularity));
+		}
+
+		return static_cast<T *>(cache->allocate(size_class(bytes)));
+	}
+
+	void deallocate(T *ptr, size_t n) noexcept {
+		size_t bytes = n * sizeof(T);
+		if (alignof(T) > alignof(std::max_align_t)
+		    or bytes > pool::size_classes * pool::block_granularity) {
+			::operator delete(ptr);
+			return;
+		}
+
+		auto cache = pool::BlockCache::get();
+		if (not cache) [[unlikely]] {
+			::operator delete(ptr);
+			return;
+		}
+
+		cache->deallocate(ptr, size_class(bytes));
+	}
+
+	template <typename U>
+	bool operator==(const PoolAllocator<U> &) const noexcept {
+		return true;
+	}
+
+private:
+	static constexpr size_t size_class(size_t bytes) {
+		return (bytes - 1) / pool::block_granularity;
+	}
+};
+
+
+/**
+ * Create a job state whose memory is taken from the job state pool.
+ *
+ * @param S Type of the job state.
+ * @param args Arguments passed to the constructor of the job state.
+ */
+template <typename S, typename... Args>
+std::shared_ptr<S> make_pooled_state(Args &&...args) {
+	return std::allocate_shared<S>(PoolAllocator<S>{}, std::forward<Args>(args)...);
+}
+
+} // namespace job
+} // namespace openage
@@ -1,4 +1,4 @@
-// Copyright 2015-2019 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #include "../log/log.h"
 #include "../testing/testing.h"
@@ -6,6 +6,9 @@
 #include "job_manager.h"
 
 #include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
 
 namespace openage {
 namespace job {
@@ -90,9 +93,148 @@ void test_simple_job_with_exception() {
 }
 
 
+void test_nested_jobs() {
+	JobManager manager{4};
+	manager.start();
+
+	// jobs spawned by jobs end up in the worker's deque and get stolen
+	int outer_jobs = 16;
+	int inner_jobs = 64;
+	std::atomic<int> executed(0);
+
+	for (int i = 0; i < outer_jobs; i++) {
+		manager.enqueue<int>([&]() {
+			for (int j = 0; j < inner_jobs; j++) {
+				manager.enqueue<int>([&]() {
+					executed++;
+					return 0;
+				});
+			}
+			return 0;
+		});
+	}
+
+	while (executed.load() < outer_jobs * inner_jobs) {
+		std::this_thread::yield();
+	}
+
+	manager.stop();
+}
+
+
+void test_continuation() {
+	JobManager manager{4};
+	manager.start();
+
+	std::atomic<int> first(0);
+	auto a = manager.enqueue<int>([&]() {
+		first++;
+		return 20;
+	});
+	auto b = manager.enqueue<int>([&]() {
+		first++;
+		return 22;
+	});
+
+	bool finished = false;
+	int sum = 0;
+	int seen = 0;
+	manager.enqueue_after<int>(
+		[&, a, b]() mutable {
+			seen = first.load();
+			return a.get_result() + b.get_result();
+		},
+		[&](const result_function_t<int> &get_result) {
+			sum = get_result();
+			finished = true;
+		},
+		a,
+		b);
+
+	while (not finished) {
+		manager.execute_callbacks();
+	}
+
+	manager.stop();
+
+	seen == 2 or TESTFAIL;
+	sum == 42 or TESTFAIL;
+}
+
+
+void test_parallel_for() {
+	JobManager manager{4};
+	manager.start();
+
+	std::vector<int> values(10000, 0);
+	manager.parallel_for(0, values.size(), [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			values[i] += static_cast<int>(i);
+		}
+	},
+	                     100);
+
+	for (size_t i = 0; i < values.size(); ++i) {
+		values[i] == static_cast<int>(i) or TESTFAIL;
+	}
+
+	// nested loops must not deadlock, even if all workers are busy
+	std::atomic<int> count(0);
+	manager.parallel_for(0, 8, [&](size_t, size_t) {
+		manager.parallel_for(0, 100, [&](size_t begin, size_t end) {
+			count += static_cast<int>(end - begin);
+		});
+	});
+	count.load() == 800 or TESTFAIL;
+
+	bool caught = false;
+	try {
+		manager.parallel_for(0, 10, [](size_t begin, size_t) {
+			if (begin == 5) {
+				throw "error string";
+			}
+		});
+	}
+	catch (const char *) {
+		caught = true;
+	}
+	caught or TESTFAIL;
+
+	manager.stop();
+}
+
+
+void test_pool_allocator() {
+	struct pooled_t {
+		std::shared_ptr<int> state;
+	};
+
+	// freed by a thread-local object after the cache of the thread was destroyed
+	std::thread{[]() {
+		thread_local pooled_t holder;
+
+		// let the cache of this thread own a buffer
+		make_pooled_state<int>(0).reset();
+		holder.state = make_pooled_state<int>(1);
+	}}.join();
+
+	// freed on another thread than it was allocated
+	std::shared_ptr<int> state;
+	std::thread{[&state]() {
+		state = make_pooled_state<int>(2);
+	}}.join();
+	*state == 2 or TESTFAIL;
+	state.reset();
+}
+
+
 void test_job_manager() {
 	test_simple_job();
 	test_simple_job_with_exception();
+	test_nested_jobs();
+	test_continuation();
+	test_parallel_for();
+	test_pool_allocator();
 }
 
 
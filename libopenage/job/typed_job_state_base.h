@@ -1,4 +1,4 @@
-// Copyright 2014-2024 the openage authors. See copying.md for legal info.
+// Copyright 2014-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -99,6 +99,10 @@ public:
 		return this->thread_id;
 	}
 
+	bool has_callback() const override {
+		return static_cast<bool>(this->callback);
+	}
+
 protected:
 	/**
 	 * Executes the job and returns the result. If an exception is thrown it
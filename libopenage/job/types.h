@@ -1,7 +1,8 @@
-// Copyright 2015-2024 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
 
 namespace openage {
@@ -48,5 +49,11 @@ using should_abort_t = std::function<bool()>;
 /** Type of a function that aborts a job. */
 using abort_t = std::function<void()>;
 
+/**
+ * Type of a function that processes the index range [begin, end) of a
+ * parallel loop.
+ */
+using range_function_t = std::function<void(size_t begin, size_t end)>;
+
 } // namespace job
 } // namespace openage
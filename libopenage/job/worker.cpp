@@ -1,4 +1,4 @@
-// Copyright 2015-2019 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #include "job_aborted_exception.h"
 #include "job_manager.h"
@@ -10,25 +10,31 @@
 namespace openage {
 namespace job {
 
+namespace {
 
-Worker::Worker(JobManager *manager)
+/** The worker executing the current thread. */
+thread_local Worker *current_worker = nullptr;
+
+} // namespace
+
+
+Worker::Worker(JobManager *manager, size_t index)
 	:
 	manager{manager},
+	index{index},
 	is_running{false} {
 }
 
 
 void Worker::start() {
-	this->is_running = true;
+	this->is_running.store(true);
 	this->executor = std::make_unique<std::thread>(&Worker::process, this);
 }
 
 
 void Worker::stop() {
-	std::unique_lock<std::mutex> lock{this->pending_jobs_mutex};
-	this->is_running = false;
-	lock.unlock();
-	this->notify();
+	this->is_running.store(false);
+	this->manager->wake_all();
 }
 
 
@@ -36,12 +42,14 @@ void Worker::enqueue(const std::shared_ptr<JobStateBase> &job) {
 	std::unique_lock<std::mutex> lock{this->pending_jobs_mutex};
 	this->pending_jobs.push(job);
 	lock.unlock();
-	this->notify();
+
+	// the waiting workers can't tell which of them is meant, so wake all
+	this->manager->wake_all();
 }
 
 
-void Worker::notify() {
-	this->jobs_available.notify_all();
+Worker *Worker::current() {
+	return current_worker;
 }
 
 
@@ -50,9 +58,64 @@ void Worker::join() {
 }
 
 
+bool Worker::has_pinned_job() {
+	std::lock_guard<std::mutex> lock{this->pending_jobs_mutex};
+	return not this->pending_jobs.empty();
+}
+
+
+void Worker::push_local(const std::shared_ptr<JobStateBase> &job) {
+	std::lock_guard<std::mutex> lock{this->local_jobs_mutex};
+	this->local_jobs.push_back(job);
+}
+
+
+std::shared_ptr<JobStateBase> Worker::pop_local() {
+	std::lock_guard<std::mutex> lock{this->local_jobs_mutex};
+	if (this->local_jobs.empty()) {
+		return nullptr;
+	}
+
+	auto job = std::move(this->local_jobs.back());
+	this->local_jobs.pop_back();
+	return job;
+}
+
+
+std::shared_ptr<JobStateBase> Worker::steal() {
+	std::lock_guard<std::mutex> lock{this->local_jobs_mutex};
+	if (this->local_jobs.empty()) {
+		return nullptr;
+	}
+
+	auto job = std::move(this->local_jobs.front());
+	this->local_jobs.pop_front();
+	return job;
+}
+
+
+std::shared_ptr<JobStateBase> Worker::fetch_job() {
+	{
+		std::lock_guard<std::mutex> lock{this->pending_jobs_mutex};
+		if (not this->pending_jobs.empty()) {
+			auto job = std::move(this->pending_jobs.front());
+			this->pending_jobs.pop();
+			return job;
+		}
+	}
+
+	if (auto job = this->pop_local()) {
+		this->manager->take_job();
+		return job;
+	}
+
+	return this->manager->fetch_job(this->index);
+}
+
+
 void Worker::execute_job(std::shared_ptr<JobStateBase> &job) {
 	auto should_abort = [this]() {
-		return not this->is_running;
+		return not this->is_running.load();
 	};
 
 	bool aborted = job->execute(should_abort);
@@ -65,55 +128,23 @@ void Worker::execute_job(std::shared_ptr<JobStateBase> &job) {
 
 
 void Worker::process() {
-	// as long as this worker thread is running repeat all steps
-	while (true) {
-		// lock the local thread queue
-		std::unique_lock<std::mutex> lock{this->pending_jobs_mutex};
-
-		// if this thread shall not run any longer, exit the loop
-		if (not this->is_running) {
-			return;
-		}
-
-		// as long as there are no jobs from the local queue or the job manager
-		while (this->pending_jobs.empty() and not this->manager->has_job()) {
-			// the thread should wait
-			this->jobs_available.wait(lock);
-
-			// when the thread is notified, first check if the thread should be
-			// stopped
-			if (not this->is_running) {
-				return;
-			}
-		}
+	current_worker = this;
 
-		// check if there are jobs in the local queue
-		if (not this->pending_jobs.empty()) {
-			// fetch the job
-			auto job = this->pending_jobs.front();
-			this->pending_jobs.pop();
-			// release the local queue lock
-			lock.unlock();
-			// and execute the job
+	// as long as this worker thread is running repeat all steps
+	while (this->is_running.load()) {
+		auto job = this->fetch_job();
+		if (job != nullptr) {
 			this->execute_job(job);
-		} else {
-			// otherwise just unlock the local queue
-			lock.unlock();
-		}
-
-		// after possibly executing a job from the local queue, check again if
-		// the thread should still continue running
-		if (not this->is_running) {
-			return;
+			continue;
 		}
 
-		// now try to fetch a job from the job manager
-		auto manager_job = this->manager->fetch_job();
-		if (manager_job.get() != nullptr) {
-			// and execute it
-			this->execute_job(manager_job);
-		}
+		// no job anywhere, so wait until there is something to do
+		this->manager->wait_for_job([this]() {
+			return not this->is_running.load() or this->has_pinned_job();
+		});
 	}
+
+	current_worker = nullptr;
 }
 
 
@@ -1,10 +1,12 @@
-// Copyright 2015-2024 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <atomic>
-#include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <thread>
 
@@ -18,14 +20,22 @@ class JobManager;
 /**
  * A worker encapsulates the execution of multiple jobs in a single background
  * thread.
+ *
+ * Every worker owns a deque of jobs. Jobs that are enqueued from the worker's
+ * own thread are pushed to the back of its deque and popped from there again,
+ * so nested jobs run while their data is still in the cache. Idle workers
+ * steal jobs from the front of the other workers' deques.
  */
 class Worker {
 private:
 	/** The parent job manager, this worker is fetching jobs from. */
 	JobManager *manager;
 
+	/** Index of this worker in the job manager. */
+	size_t index;
+
 	/** Whether this worker thread is still running. */
-	bool is_running;
+	std::atomic_bool is_running;
 
 	/** The executing thread. */
 	std::unique_ptr<std::thread> executor;
@@ -33,15 +43,21 @@ private:
 	/** A mutex to synchronize the internal pending jobs queue. */
 	std::mutex pending_jobs_mutex;
 
-	/** A queue of jobs that are to be executed. */
+	/**
+	 * A queue of jobs that must be executed by this worker, i.e. jobs from
+	 * a job group. These jobs are never stolen by other workers.
+	 */
 	std::queue<std::shared_ptr<JobStateBase>> pending_jobs;
 
-	/** A condition variable to wait for new jobs. */
-	std::condition_variable jobs_available;
+	/** A mutex to synchronize the local job deque. */
+	std::mutex local_jobs_mutex;
+
+	/** Jobs spawned by this worker that can be stolen by other workers. */
+	std::deque<std::shared_ptr<JobStateBase>> local_jobs;
 
 public:
 	/** Constructs a new worker with the parent job manager. */
-	Worker(JobManager *manager);
+	Worker(JobManager *manager, size_t index);
 
 	/** Default destructor. */
 	~Worker() = default;
@@ -55,16 +71,45 @@ public:
 	/** Joins the internal executing thread. */
 	void join();
 
-	/** Adds the given job to the internal pending job queue. */
+	/**
+	 * Adds the given job to the internal pending job queue. The job is only
+	 * executed by this worker.
+	 */
 	void enqueue(const std::shared_ptr<JobStateBase> &job);
 
 	/**
-	 * Notifies this worker, that new jobs are available. This method is
-	 * although called from the parent job manager.
+	 * Returns the worker that executes the current thread, or nullptr if the
+	 * current thread is not a worker thread.
 	 */
-	void notify();
+	static Worker *current();
 
 private:
+	/** Returns whether this worker has jobs in its pinned job queue. */
+	bool has_pinned_job();
+
+	/** Pushes a job to the back of the local job deque. */
+	void push_local(const std::shared_ptr<JobStateBase> &job);
+
+	/**
+	 * Pops the most recently pushed job from the local job deque. If the
+	 * deque is empty, a nullptr is returned.
+	 */
+	std::shared_ptr<JobStateBase> pop_local();
+
+	/**
+	 * Takes the oldest job from the local job deque. Called by other workers.
+	 * If the deque is empty, a nullptr is returned.
+	 */
+	std::shared_ptr<JobStateBase> steal();
+
+	/**
+	 * Returns the next job this worker should execute. Jobs are taken from
+	 * the pinned queue, the local deque, the job manager's queue and
+	 * finally stolen from other workers, in this order. If no job is
+	 * available, a nullptr is returned.
+	 */
+	std::shared_ptr<JobStateBase> fetch_job();
+
 	/**
 	 * Executes the given job and tells the parent job manager, when it has
 	 * finished.
@@ -72,11 +117,16 @@ private:
 	void execute_job(std::shared_ptr<JobStateBase> &job);
 
 	/**
-	 * Fetches pending jobs from the parent job manager and from the internal
-	 * pending job queue and executes them. If no jobs are available the
-	 * internal execution thread is wait using a condition variable.
+	 * Fetches and executes jobs. If no jobs are available the internal
+	 * execution thread waits on the job manager's condition variable.
 	 */
 	void process();
+
+	/**
+	 * The job manager has to be a friend in order to push jobs to the
+	 * local deque and to steal jobs.
+	 */
+	friend class JobManager;
 };
 
 } // namespace job
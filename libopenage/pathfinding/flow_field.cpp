@@ -1,4 +1,4 @@
-// Copyright 2024-2024 the openage authors. See copying.md for legal info.
+// Copyright 2024-2025 the openage authors. See copying.md for legal info.
 
 #include "flow_field.h"
 
@@ -247,7 +247,7 @@ void FlowField::build(const std::shared_ptr<IntegrationField> &integration_field
 	this->build(integration_field);
 }
 
-const std::vector<flow_t> &FlowField::get_cells() const {
+const FlowField::cells_t &FlowField::get_cells() const {
 	return this->cells;
 }
 
@@ -1,4 +1,4 @@
-// Copyright 2024-2024 the openage authors. See copying.md for legal info.
+// Copyright 2024-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -9,6 +9,7 @@
 
 #include "pathfinding/definitions.h"
 #include "pathfinding/types.h"
+#include "util/memory_tag.h"
 
 
 namespace openage {
@@ -22,6 +23,12 @@ class Portal;
 
 class FlowField {
 public:
+	/**
+	 * Storage of the field values, accounted to the pathfinding memory tag.
+	 */
+	using cells_t = std::vector<flow_t,
+	                            util::TaggedAllocator<flow_t, util::memory_tag::pathfinding>>;
+
 	/**
 	 * Create a square flow field with a specified size.
 	 *
@@ -124,7 +131,7 @@ public:
 	 *
 	 * @return Flow field values.
 	 */
-	const std::vector<flow_t> &get_cells() const;
+	const cells_t &get_cells() const;
 
 	/**
 	 * Reset the flow field values for rebuilding the field.
@@ -166,7 +173,7 @@ private:
 	/**
 	 * Flow field cells.
 	 */
-	std::vector<flow_t> cells;
+	cells_t cells;
 };
 
 } // namespace path
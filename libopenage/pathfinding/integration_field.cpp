@@ -1,4 +1,4 @@
-// Copyright 2024-2024 the openage authors. See copying.md for legal info.
+// Copyright 2024-2025 the openage authors. See copying.md for legal info.
 
 #include "integration_field.h"
 
@@ -446,7 +446,7 @@ void IntegrationField::integrate_cost(const std::shared_ptr<CostField> &cost_fie
 	}
 }
 
-const std::vector<integrated_t> &IntegrationField::get_cells() const {
+const IntegrationField::cells_t &IntegrationField::get_cells() const {
 	return this->cells;
 }
 
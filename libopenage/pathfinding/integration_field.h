@@ -1,4 +1,4 @@
-// Copyright 2024-2024 the openage authors. See copying.md for legal info.
+// Copyright 2024-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "pathfinding/types.h"
+#include "util/memory_tag.h"
 
 
 namespace openage {
@@ -25,6 +26,13 @@ class Portal;
  */
 class IntegrationField {
 public:
+	/**
+	 * Storage of the field values. Cached fields can take up a lot of memory,
+	 * so they are accounted to the pathfinding memory tag.
+	 */
+	using cells_t = std::vector<integrated_t,
+	                            util::TaggedAllocator<integrated_t, util::memory_tag::pathfinding>>;
+
 	/**
 	 * Create a square integration field with a specified size.
 	 *
@@ -155,7 +163,7 @@ public:
 	 *
 	 * @return Integration field values.
 	 */
-	const std::vector<integrated_t> &get_cells() const;
+	const cells_t &get_cells() const;
 
 	/**
 	 * Reset the integration field for a new integration.
@@ -229,7 +237,7 @@ private:
 	/**
 	 * Integration field values.
 	 */
-	std::vector<integrated_t> cells;
+	cells_t cells;
 };
 
 } // namespace path
@@ -1,4 +1,4 @@
-// Copyright 2014-2024 the openage authors. See copying.md for legal info.
+// Copyright 2014-2025 the openage authors. See copying.md for legal info.
 
 #include "heuristics.h"
 
@@ -22,7 +22,7 @@ cost_old_t chebyshev_cost(const coord::phys3 &start, const coord::phys3 &end) {
 }
 
 cost_old_t euclidean_cost(const coord::phys3 &start, const coord::phys3 &end) {
-	return (end - start).length();
+	return (end - start).length().to_float();
 }
 
 cost_old_t euclidean_squared_cost(const coord::phys3 &start, const coord::phys3 &end) {
@@ -1,4 +1,4 @@
-// Copyright 2014-2024 the openage authors. See copying.md for legal info.
+// Copyright 2014-2025 the openage authors. See copying.md for legal info.
 
 #include <cmath>
 
@@ -52,7 +52,7 @@ bool Node::operator==(const Node &other) const {
 
 cost_old_t Node::cost_to(const Node &other) const {
 	// ignore the up-position, thus convert to phys2
-	return ((this->position - other.position).to_phys2().length()
+	return ((this->position - other.position).to_phys2().length().to_float()
 	        * other.factor * this->factor);
 }
 
@@ -1,4 +1,4 @@
-// Copyright 2024-2024 the openage authors. See copying.md for legal info.
+// Copyright 2024-2025 the openage authors. See copying.md for legal info.
 
 #include "pathfinder.h"
 
@@ -458,14 +458,14 @@ int Pathfinder::heuristic_cost(const coord::tile &portal_pos,
 	auto target_phys_pos = target_pos.to_phys2();
 	auto delta = target_phys_pos - portal_phys_pos;
 
-	return delta.length();
+	return delta.length().to_int();
 }
 
 int Pathfinder::distance_cost(const coord::tile_delta &portal1_pos,
                               const coord::tile_delta &portal2_pos) {
 	auto delta = portal2_pos.to_phys2() - portal1_pos.to_phys2();
 
-	return delta.length();
+	return delta.length().to_int();
 }
 
 
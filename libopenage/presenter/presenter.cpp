@@ -1,4 +1,4 @@
-// Copyright 2019-2024 the openage authors. See copying.md for legal info.
+// Copyright 2019-2025 the openage authors. See copying.md for legal info.
 
 #include "presenter.h"
 
@@ -16,6 +16,7 @@
 #include "input/controller/hud/controller.h"
 #include "input/input_context.h"
 #include "input/input_manager.h"
+#include "job/job_manager.h"
 #include "log/log.h"
 #include "renderer/camera/camera.h"
 #include "renderer/gui/gui.h"
@@ -75,6 +76,8 @@ void Presenter::run(const renderer::window_settings window_settings) {
 		this->time_loop->stop();
 	}
 
+	this->job_manager->stop();
+
 	this->window->close();
 }
 
@@ -103,9 +106,13 @@ void Presenter::init_graphics(const renderer::window_settings &window_settings)
 	this->renderer = this->window->make_renderer();
 
 	// Asset mangement
+	this->job_manager = std::make_shared<job::JobManager>();
+	this->job_manager->start();
 	this->asset_manager = std::make_shared<renderer::resources::AssetManager>(
 		this->renderer,
-		this->root_dir / "assets" / "converted");
+		this->root_dir / "assets" / "converted",
+		this->job_manager);
+	this->asset_manager->set_binary_cache(this->root_dir / "assets" / "cache");
 	auto missing_tex = this->root_dir / "assets" / "test" / "textures" / "test_missing.sprite";
 	this->asset_manager->set_placeholder_animation(missing_tex);
 
@@ -309,6 +316,7 @@ void Presenter::init_final_render_pass() {
 
 void Presenter::render() {
 	// TODO: Pass current time to update() instead of fetching it in renderer
+	this->asset_manager->update();
 	this->camera_manager->update();
 	this->terrain_renderer->update();
 	this->world_renderer->update();
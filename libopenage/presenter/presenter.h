@@ -1,4 +1,4 @@
-// Copyright 2019-2024 the openage authors. See copying.md for legal info.
+// Copyright 2019-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -19,6 +19,10 @@ namespace gamestate {
 class GameSimulation;
 }
 
+namespace job {
+class JobManager;
+}
+
 namespace input {
 class InputManager;
 }
@@ -211,6 +215,11 @@ protected:
 	 */
 	std::shared_ptr<renderer::resources::AssetManager> asset_manager;
 
+	/**
+	 * Job manager for loading assets in the background.
+	 */
+	std::shared_ptr<job::JobManager> job_manager;
+
 	/**
 	 * Render passes in the openage renderer.
 	 */
@@ -0,0 +1,194 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "stresstest_2.h"
+
+#include <array>
+#include <cmath>
+
+#include <eigen3/Eigen/Dense>
+
+#include "coord/tile.h"
+#include "log/log.h"
+#include "renderer/camera/camera.h"
+#include "renderer/null/renderer.h"
+#include "renderer/null/stats.h"
+#include "renderer/null/window.h"
+#include "renderer/render_factory.h"
+#include "renderer/render_pass.h"
+#include "renderer/resources/assets/asset_manager.h"
+#include "renderer/stages/hud/render_stage.h"
+#include "renderer/stages/screen/render_stage.h"
+#include "renderer/stages/skybox/render_stage.h"
+#include "renderer/stages/terrain/render_entity.h"
+#include "renderer/stages/terrain/render_stage.h"
+#include "renderer/stages/world/render_entity.h"
+#include "renderer/stages/world/render_stage.h"
+#include "time/clock.h"
+#include "util/alloc_count.h"
+#include "util/timer.h"
+
+
+namespace openage::renderer::tests {
+
+void renderer_stresstest_2(const util::Path &path) {
+	// Invisible window and a renderer that only counts the GPU work
+	auto window = std::make_shared<null::NullWindow>(1024, 768);
+	auto renderer = std::dynamic_pointer_cast<null::NullRenderer>(window->make_renderer());
+	auto &stats = renderer->get_stats();
+
+	// Clock required by world renderer for timing animation frames
+	auto clock = std::make_shared<time::Clock>();
+
+	auto camera = std::make_shared<renderer::camera::Camera>(renderer, window->get_size());
+
+	auto asset_manager = std::make_shared<renderer::resources::AssetManager>(
+		renderer,
+		path["assets"]["test"]);
+
+	// Same stages as in the presenter, except for the GUI
+	auto skybox_renderer = std::make_shared<renderer::skybox::SkyboxRenderStage>(
+		window,
+		renderer,
+		path["assets"]["shaders"]);
+	auto terrain_renderer = std::make_shared<renderer::terrain::TerrainRenderStage>(
+		window,
+		renderer,
+		camera,
+		path["assets"]["shaders"],
+		asset_manager,
+		clock);
+	auto world_renderer = std::make_shared<renderer::world::WorldRenderStage>(
+		window,
+		renderer,
+		camera,
+		path["assets"]["shaders"],
+		asset_manager,
+		clock);
+	auto hud_renderer = std::make_shared<renderer::hud::HudRenderStage>(
+		window,
+		renderer,
+		camera,
+		path["assets"]["shaders"],
+		asset_manager,
+		clock);
+
+	std::vector<std::shared_ptr<RenderPass>> render_passes{
+		skybox_renderer->get_render_pass(),
+		terrain_renderer->get_render_pass(),
+		world_renderer->get_render_pass(),
+		hud_renderer->get_render_pass(),
+	};
+
+	auto screen_renderer = std::make_shared<renderer::screen::ScreenRenderStage>(
+		window,
+		renderer,
+		path["assets"]["shaders"]);
+	std::vector<std::shared_ptr<renderer::RenderTarget>> targets{};
+	for (auto &pass : render_passes) {
+		targets.push_back(pass->get_target());
+	}
+	screen_renderer->set_render_targets(targets);
+	render_passes.push_back(screen_renderer->get_render_pass());
+
+	auto render_factory = std::make_shared<RenderFactory>(terrain_renderer, world_renderer);
+
+	// Flat 32x32 terrain chunk
+	auto terrain_size = util::Vector2s{32, 32};
+	std::vector<std::pair<terrain::RenderEntity::terrain_elevation_t, std::string>> tiles{};
+	tiles.reserve(terrain_size[0] * terrain_size[1]);
+	for (size_t i = 0; i < terrain_size[0] * terrain_size[1]; ++i) {
+		tiles.emplace_back(0.0f, "./textures/test_terrain.terrain");
+	}
+	auto terrain0 = render_factory->add_terrain_render_entity(terrain_size,
+	                                                          coord::tile_delta{0, 0});
+	terrain0->update(terrain_size, tiles);
+
+	// Entities walk back and forth on the terrain, so that their
+	// position and animation change every frame
+	std::vector<std::shared_ptr<renderer::world::RenderEntity>> render_entities{};
+	auto add_world_entity = [&](const time::time_t time) {
+		const auto animation_path = "./textures/test_tank_mirrored.sprite";
+		size_t idx = render_entities.size();
+
+		auto initial_pos = coord::phys3((idx % 30) + 0.5, ((idx / 30) % 30) + 0.5, 0.0f);
+		auto position = curve::Continuous<coord::phys3>{nullptr, 0, "", nullptr, coord::phys3(0, 0, 0)};
+		position.set_insert(time, initial_pos);
+		position.set_insert(time + 10, initial_pos + coord::phys3_delta{1, 1, 0});
+		position.set_insert(time + 20, initial_pos);
+
+		auto angle = curve::Segmented<coord::phys_angle_t>{nullptr, 0};
+		angle.set_insert(time, coord::phys_angle_t::from_int(45));
+		angle.set_insert_jump(time + 10, coord::phys_angle_t::from_int(45), coord::phys_angle_t::from_int(225));
+
+		auto entity = render_factory->add_world_render_entity();
+		entity->update(idx,
+		               position,
+		               angle,
+		               animation_path,
+		               time);
+		render_entities.push_back(entity);
+	};
+
+	auto frame = [&]() {
+		clock->update_time();
+
+		terrain_renderer->update();
+		world_renderer->update();
+		hud_renderer->update();
+
+		for (auto &pass : render_passes) {
+			renderer->render(pass);
+		}
+	};
+
+	constexpr size_t warmup_frames = 10;
+	constexpr size_t measured_frames = 100;
+	constexpr std::array<size_t, 4> entity_counts{100, 1000, 5000, 20000};
+
+	log::log(INFO << "Headless render benchmark, "
+	              << (renderer::world::WorldRenderStage::ENABLE_INSTANCING ? "instanced" : "per-object")
+	              << " world rendering, " << measured_frames << " frames per step");
+
+	clock->start();
+
+	util::Timer timer;
+	for (auto count : entity_counts) {
+		while (render_entities.size() < count) {
+			add_world_entity(clock->get_time());
+		}
+
+		// the first frames load the animations and create the renderables
+		for (size_t i = 0; i < warmup_frames; ++i) {
+			frame();
+		}
+
+		stats.reset();
+		size_t allocs_before = util::get_alloc_count();
+		size_t alloc_bytes_before = util::get_alloc_bytes();
+		timer.reset(false);
+
+		for (size_t i = 0; i < measured_frames; ++i) {
+			frame();
+		}
+
+		auto elapsed = timer.getval();
+		size_t allocs = util::get_alloc_count() - allocs_before;
+		size_t alloc_bytes = util::get_alloc_bytes() - alloc_bytes_before;
+
+		log::log(INFO << count << " entities: "
+		              << elapsed / 1e6 / measured_frames << " ms/frame, "
+		              << stats.draw_calls / measured_frames << " draw calls/frame, "
+		              << stats.drawn_instances / measured_frames << " instances/frame, "
+		              << stats.uniform_updates / measured_frames << " uniform updates/frame, "
+		              << stats.texture_uploads / measured_frames << " texture uploads/frame, "
+		              << stats.geometry_upload_bytes / measured_frames << " geometry bytes/frame");
+		if (util::alloc_count_enabled()) {
+			log::log(INFO << "  " << allocs / measured_frames << " allocs/frame ("
+			              << alloc_bytes / measured_frames << " bytes)");
+		}
+	}
+
+	clock->stop();
+}
+
+} // namespace openage::renderer::tests
@@ -0,0 +1,21 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include "util/path.h"
+
+
+namespace openage::renderer::tests {
+
+/**
+ * Headless benchmark for the CPU side of the render stages.
+ *
+ * Drives the presenter's render stages with an increasing number of
+ * world entities on the null renderer and reports the frame time,
+ * heap allocations and renderer work per frame.
+ *
+ * @param path Path to the openage asset directory.
+ */
+void renderer_stresstest_2(const util::Path &path);
+
+} // namespace openage::renderer::tests
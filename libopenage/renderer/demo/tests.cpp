@@ -1,4 +1,4 @@
-// Copyright 2015-2024 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #include "tests.h"
 
@@ -14,6 +14,7 @@
 #include "renderer/demo/demo_6.h"
 #include "renderer/demo/stresstest_0.h"
 #include "renderer/demo/stresstest_1.h"
+#include "renderer/demo/stresstest_2.h"
 
 namespace openage::renderer::tests {
 
@@ -61,6 +62,9 @@ OAAPI void renderer_stresstest(int demo_id, const util::Path &path) {
 	case 1:
 		renderer_stresstest_1(path);
 		break;
+	case 2:
+		renderer_stresstest_2(path);
+		break;
 	default:
 		log::log(MSG(err) << "Unknown renderer stresstest requested: " << demo_id << ".");
 		break;
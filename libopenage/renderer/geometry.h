@@ -1,4 +1,4 @@
-// Copyright 2015-2024 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -38,6 +38,12 @@ public:
 	/// @throws if there is a size mismatch between the new and old vertex data
 	virtual void update_verts_offset(std::vector<uint8_t> const &verts, size_t offset) = 0;
 
+	/// In an instanced geometry, replaces the per-instance data. The data is a sequence of instances
+	/// laid out as described by the instance input info given on creation. The number of instances
+	/// may change between updates.
+	/// @throws if the geometry is not instanced
+	virtual void update_instances(std::vector<uint8_t> const &instances) = 0;
+
 protected:
 	/// Initialize the geometry to a given type.
 	explicit Geometry(geometry_t type);
@@ -0,0 +1,59 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "geometry.h"
+
+#include "error/error.h"
+#include "log/message.h"
+#include "renderer/null/stats.h"
+#include "renderer/resources/mesh_data.h"
+
+
+namespace openage::renderer::null {
+
+NullGeometry::NullGeometry(const std::shared_ptr<render_stats> &stats) :
+	Geometry{geometry_t::bufferless_quad},
+	stats{stats},
+	vert_size{0},
+	data_size{0},
+	instanced{false} {}
+
+NullGeometry::NullGeometry(const std::shared_ptr<render_stats> &stats,
+                           const resources::MeshData &mesh,
+                           bool instanced) :
+	Geometry{geometry_t::mesh},
+	stats{stats},
+	vert_size{mesh.get_info().vert_size()},
+	data_size{mesh.get_data().size()},
+	instanced{instanced} {
+	this->stats->geometry_uploads += 1;
+	this->stats->geometry_upload_bytes += this->data_size;
+}
+
+void NullGeometry::update_verts_offset(std::vector<uint8_t> const &verts, size_t offset) {
+	if (this->get_type() != geometry_t::mesh) {
+		throw Error(MSG(err) << "Cannot update vertex data for non-mesh NullGeometry.");
+	}
+
+	auto byte_offset = offset * this->vert_size;
+	if (byte_offset + verts.size() > this->data_size) {
+		throw Error(MSG(err) << "Size mismatch between old and new vertex data for NullGeometry.");
+	}
+
+	this->stats->geometry_uploads += 1;
+	this->stats->geometry_upload_bytes += verts.size();
+}
+
+void NullGeometry::update_instances(std::vector<uint8_t> const &instances) {
+	if (not this->instanced) [[unlikely]] {
+		throw Error(MSG(err) << "Cannot update instance data for non-instanced NullGeometry.");
+	}
+
+	this->stats->geometry_uploads += 1;
+	this->stats->geometry_upload_bytes += instances.size();
+}
+
+bool NullGeometry::is_instanced() const {
+	return this->instanced;
+}
+
+} // namespace openage::renderer::null
@@ -0,0 +1,57 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "renderer/geometry.h"
+
+
+namespace openage::renderer {
+
+namespace resources {
+class MeshData;
+} // namespace resources
+
+namespace null {
+
+struct render_stats;
+
+/// Geometry without GPU buffers. Vertex and instance uploads are only counted.
+class NullGeometry final : public Geometry {
+public:
+	/// Create a bufferless quad geometry.
+	explicit NullGeometry(const std::shared_ptr<render_stats> &stats);
+
+	/// Create a mesh geometry from the given mesh data.
+	/// If \p instanced is true, the geometry accepts instance data.
+	NullGeometry(const std::shared_ptr<render_stats> &stats,
+	             const resources::MeshData &mesh,
+	             bool instanced = false);
+
+	void update_verts_offset(std::vector<uint8_t> const &verts, size_t offset) override;
+
+	void update_instances(std::vector<uint8_t> const &instances) override;
+
+	/// Returns whether the geometry is drawn instanced.
+	bool is_instanced() const;
+
+private:
+	/// Counters of the renderer.
+	std::shared_ptr<render_stats> stats;
+
+	/// Size of a single vertex (in bytes).
+	size_t vert_size;
+
+	/// Size of the vertex data (in bytes).
+	size_t data_size;
+
+	/// Whether the geometry accepts instance data.
+	bool instanced;
+};
+
+} // namespace null
+} // namespace openage::renderer
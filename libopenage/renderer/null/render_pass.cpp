@@ -0,0 +1,12 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "render_pass.h"
+
+
+namespace openage::renderer::null {
+
+NullRenderPass::NullRenderPass(std::vector<Renderable> &&renderables,
+                               const std::shared_ptr<RenderTarget> &target) :
+	RenderPass{std::move(renderables), target} {}
+
+} // namespace openage::renderer::null
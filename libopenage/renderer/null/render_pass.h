@@ -0,0 +1,21 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "renderer/render_pass.h"
+#include "renderer/renderable.h"
+
+
+namespace openage::renderer::null {
+
+/// Render pass of the null renderer.
+class NullRenderPass final : public RenderPass {
+public:
+	NullRenderPass(std::vector<Renderable> &&renderables,
+	               const std::shared_ptr<RenderTarget> &target);
+};
+
+} // namespace openage::renderer::null
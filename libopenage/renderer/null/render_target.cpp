@@ -0,0 +1,42 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "render_target.h"
+
+#include "renderer/resources/texture_data.h"
+#include "renderer/resources/texture_info.h"
+#include "renderer/texture.h"
+
+
+namespace openage::renderer::null {
+
+NullRenderTarget::NullRenderTarget(size_t width, size_t height) :
+	size{width, height},
+	textures{} {}
+
+NullRenderTarget::NullRenderTarget(std::vector<std::shared_ptr<Texture2d>> const &textures) :
+	size{0, 0},
+	textures{textures} {
+	if (not this->textures.empty()) {
+		auto tex_size = this->textures.front()->get_info().get_size();
+		this->size = {tex_size.first, tex_size.second};
+	}
+}
+
+resources::Texture2dData NullRenderTarget::into_data() {
+	std::vector<uint8_t> pxdata(this->size.first * this->size.second * 4);
+
+	resources::Texture2dInfo info{this->size.first,
+	                              this->size.second,
+	                              resources::pixel_format::rgba8};
+	return resources::Texture2dData{info, std::move(pxdata)};
+}
+
+std::vector<std::shared_ptr<Texture2d>> NullRenderTarget::get_texture_targets() {
+	return this->textures;
+}
+
+void NullRenderTarget::resize(size_t width, size_t height) {
+	this->size = {width, height};
+}
+
+} // namespace openage::renderer::null
@@ -0,0 +1,65 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "renderer/render_target.h"
+
+
+namespace openage::renderer::null {
+
+/**
+ * Render target of the null renderer. It is either the display or
+ * a set of textures, but nothing is ever drawn into it.
+ */
+class NullRenderTarget final : public RenderTarget {
+public:
+	/**
+	 * Create a render target for the display.
+	 *
+	 * @param width Width of the display.
+	 * @param height Height of the display.
+	 */
+	NullRenderTarget(size_t width, size_t height);
+
+	/**
+	 * Create a render target for the given textures.
+	 *
+	 * @param textures Texture attachements.
+	 */
+	NullRenderTarget(std::vector<std::shared_ptr<Texture2d>> const &textures);
+
+	/**
+	 * Get zeroed RGBA data with the size of the render target.
+	 *
+	 * @return Texture data.
+	 */
+	resources::Texture2dData into_data() override;
+
+	std::vector<std::shared_ptr<Texture2d>> get_texture_targets() override;
+
+	/**
+	 * Resize the render target.
+	 *
+	 * @param width New width.
+	 * @param height New height.
+	 */
+	void resize(size_t width, size_t height);
+
+private:
+	/**
+	 * Size of the display or the texture targets.
+	 */
+	std::pair<size_t, size_t> size;
+
+	/**
+	 * Target textures. Empty for the display.
+	 */
+	std::vector<std::shared_ptr<Texture2d>> textures;
+};
+
+} // namespace openage::renderer::null
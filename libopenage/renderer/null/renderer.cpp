@@ -0,0 +1,141 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "renderer.h"
+
+#include "error/error.h"
+#include "log/message.h"
+#include "renderer/null/geometry.h"
+#include "renderer/null/render_pass.h"
+#include "renderer/null/render_target.h"
+#include "renderer/null/shader_program.h"
+#include "renderer/null/stats.h"
+#include "renderer/null/texture.h"
+#include "renderer/null/texture_array.h"
+#include "renderer/null/uniform_buffer.h"
+#include "renderer/resources/mesh_data.h"
+#include "renderer/resources/texture_data.h"
+
+
+namespace openage::renderer::null {
+
+NullRenderer::NullRenderer(const util::Vector2s &viewport_size) :
+	stats{std::make_shared<render_stats>()},
+	display{std::make_shared<NullRenderTarget>(viewport_size[0], viewport_size[1])} {}
+
+std::shared_ptr<Texture2d> NullRenderer::add_texture(const resources::Texture2dData &data) {
+	auto texture = std::make_shared<NullTexture2d>(this->stats, data.get_info());
+	texture->upload(data);
+	return texture;
+}
+
+std::shared_ptr<Texture2d> NullRenderer::add_texture(const resources::Texture2dInfo &info) {
+	return std::make_shared<NullTexture2d>(this->stats, info);
+}
+
+std::shared_ptr<Texture2dArray> NullRenderer::add_texture_array(const std::vector<resources::Texture2dData> &layers) {
+	if (layers.empty()) {
+		throw Error{MSG(err) << "Tried to create a texture array without layers."};
+	}
+
+	auto texture = std::make_shared<NullTexture2dArray>(this->stats, layers.size(), layers.front().get_info());
+	for (size_t i = 0; i < layers.size(); ++i) {
+		texture->upload(i, layers[i]);
+	}
+	return texture;
+}
+
+std::shared_ptr<ShaderProgram> NullRenderer::add_shader(std::vector<resources::ShaderSource> const & /* srcs */) {
+	return std::make_shared<NullShaderProgram>(this->stats);
+}
+
+std::shared_ptr<Geometry> NullRenderer::add_mesh_geometry(resources::MeshData const &mesh) {
+	return std::make_shared<NullGeometry>(this->stats, mesh);
+}
+
+std::shared_ptr<Geometry> NullRenderer::add_instanced_geometry(resources::MeshData const &mesh,
+                                                               resources::VertexInputInfo const & /* instance_info */) {
+	return std::make_shared<NullGeometry>(this->stats, mesh, true);
+}
+
+std::shared_ptr<Geometry> NullRenderer::add_bufferless_quad() {
+	return std::make_shared<NullGeometry>(this->stats);
+}
+
+std::shared_ptr<RenderPass> NullRenderer::add_render_pass(std::vector<Renderable> renderables,
+                                                          const std::shared_ptr<RenderTarget> &target) {
+	return std::make_shared<NullRenderPass>(std::move(renderables), target);
+}
+
+std::shared_ptr<RenderTarget> NullRenderer::create_texture_target(std::vector<std::shared_ptr<Texture2d>> const &textures) {
+	return std::make_shared<NullRenderTarget>(textures);
+}
+
+std::shared_ptr<RenderTarget> NullRenderer::get_display_target() {
+	return this->display;
+}
+
+std::shared_ptr<UniformBuffer> NullRenderer::add_uniform_buffer(resources::UniformBufferInfo const & /* info */) {
+	return std::make_shared<NullUniformBuffer>(this->stats);
+}
+
+std::shared_ptr<UniformBuffer> NullRenderer::add_uniform_buffer(std::shared_ptr<ShaderProgram> const & /* prog */,
+                                                                std::string const & /* block_name */) {
+	return std::make_shared<NullUniformBuffer>(this->stats);
+}
+
+resources::Texture2dData NullRenderer::display_into_data() {
+	return this->display->into_data();
+}
+
+void NullRenderer::resize_display_target(size_t width, size_t height) {
+	this->display->resize(width, height);
+}
+
+void NullRenderer::check_error() {
+	// there is no state that could be erroneous
+}
+
+void NullRenderer::render(const std::shared_ptr<RenderPass> &pass) {
+	auto &stats = *this->stats;
+	stats.render_passes += 1;
+
+	const auto &layers = pass->get_layers();
+	const auto &renderables = pass->get_renderables();
+
+	for (size_t i = 0; i < layers.size(); i++) {
+		const auto &layer = layers[i];
+		const auto &objects = renderables[i];
+
+		for (auto const &obj : objects) {
+			stats.uniform_uploads += 1;
+
+			if (obj.geometry == nullptr) {
+				stats.shader_updates += 1;
+			}
+			else {
+				stats.draw_calls += 1;
+
+				auto geom = std::static_pointer_cast<NullGeometry>(obj.geometry);
+				if (geom->is_instanced()) {
+					stats.drawn_instances += obj.instance_count;
+				}
+			}
+
+			if (stats.record_commands) {
+				stats.commands.push_back({obj.uniform->get_program().get(),
+				                          obj.geometry.get(),
+				                          layer.priority,
+				                          obj.instance_offset,
+				                          obj.instance_count,
+				                          obj.alpha_blending,
+				                          obj.depth_test});
+			}
+		}
+	}
+}
+
+render_stats &NullRenderer::get_stats() {
+	return *this->stats;
+}
+
+} // namespace openage::renderer::null
@@ -0,0 +1,78 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <memory>
+
+#include "renderer/renderer.h"
+#include "util/vector.h"
+
+
+namespace openage::renderer::null {
+
+class NullRenderTarget;
+struct render_stats;
+
+/// A renderer that does not use a graphics API. Instead of talking to the GPU,
+/// it counts the draw calls, uniform updates and uploads in \p render_stats and
+/// records the executed renderables.
+///
+/// Useful for measuring the CPU cost of the render stages and for running
+/// them where no GPU or display is available.
+class NullRenderer final : public Renderer {
+public:
+	/**
+	 * Create a new null renderer.
+	 *
+	 * @param viewport_size Size of the display target.
+	 */
+	NullRenderer(const util::Vector2s &viewport_size);
+
+	std::shared_ptr<Texture2d> add_texture(resources::Texture2dData const &) override;
+	std::shared_ptr<Texture2d> add_texture(resources::Texture2dInfo const &) override;
+	std::shared_ptr<Texture2dArray> add_texture_array(std::vector<resources::Texture2dData> const &) override;
+
+	std::shared_ptr<ShaderProgram> add_shader(std::vector<resources::ShaderSource> const &) override;
+
+	std::shared_ptr<Geometry> add_mesh_geometry(resources::MeshData const &) override;
+	std::shared_ptr<Geometry> add_instanced_geometry(resources::MeshData const &,
+	                                                 resources::VertexInputInfo const &) override;
+	std::shared_ptr<Geometry> add_bufferless_quad() override;
+
+	std::shared_ptr<RenderPass> add_render_pass(std::vector<Renderable>, const std::shared_ptr<RenderTarget> &) override;
+
+	std::shared_ptr<RenderTarget> create_texture_target(std::vector<std::shared_ptr<Texture2d>> const &) override;
+
+	std::shared_ptr<RenderTarget> get_display_target() override;
+
+	std::shared_ptr<UniformBuffer> add_uniform_buffer(resources::UniformBufferInfo const &) override;
+	std::shared_ptr<UniformBuffer> add_uniform_buffer(std::shared_ptr<ShaderProgram> const &,
+	                                                  std::string const &) override;
+
+	resources::Texture2dData display_into_data() override;
+
+	void resize_display_target(size_t width, size_t height);
+
+	void check_error() override;
+
+	void render(const std::shared_ptr<RenderPass> &) override;
+
+	/**
+	 * Get the counters and recorded commands.
+	 *
+	 * The counters are never reset by the renderer, call \p render_stats::reset()
+	 * to start a new measurement.
+	 *
+	 * @return Counters of this renderer.
+	 */
+	render_stats &get_stats();
+
+private:
+	/// Counters shared with the created objects.
+	std::shared_ptr<render_stats> stats;
+
+	/// The display as a render target.
+	std::shared_ptr<NullRenderTarget> display;
+};
+
+} // namespace openage::renderer::null
@@ -0,0 +1,175 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "shader_program.h"
+
+#include "renderer/null/stats.h"
+
+
+namespace openage::renderer::null {
+
+NullUniformInput::NullUniformInput(const std::shared_ptr<ShaderProgram> &prog) :
+	UniformInput{prog} {}
+
+bool NullUniformInput::is_complete() const {
+	return true;
+}
+
+
+NullShaderProgram::NullShaderProgram(const std::shared_ptr<render_stats> &stats) :
+	stats{stats} {}
+
+uniform_id_t NullShaderProgram::get_uniform_id(const char *name) {
+	auto [it, inserted] = this->uniform_ids.try_emplace(name, static_cast<uniform_id_t>(this->uniform_ids.size()));
+	return it->second;
+}
+
+bool NullShaderProgram::has_uniform(const char * /* name */) {
+	return true;
+}
+
+void NullShaderProgram::bind_uniform_buffer(const char * /* block_name */,
+                                            std::shared_ptr<UniformBuffer> const & /* buffer */) {
+	// no bindings without a GPU
+}
+
+std::map<size_t, resources::vertex_input_t> NullShaderProgram::vertex_attributes() const {
+	return {};
+}
+
+std::shared_ptr<UniformInput> NullShaderProgram::new_unif_in() {
+	return std::make_shared<NullUniformInput>(this->shared_from_this());
+}
+
+void NullShaderProgram::count_update() {
+	this->stats->uniform_updates += 1;
+}
+
+void NullShaderProgram::set_i32(UniformInput & /* in */, const char * /* unif */, int32_t /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_u32(UniformInput & /* in */, const char * /* unif */, uint32_t /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_f32(UniformInput & /* in */, const char * /* unif */, float /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_f64(UniformInput & /* in */, const char * /* unif */, double /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_bool(UniformInput & /* in */, const char * /* unif */, bool /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v2f32(UniformInput & /* in */, const char * /* unif */, Eigen::Vector2f const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v3f32(UniformInput & /* in */, const char * /* unif */, Eigen::Vector3f const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v4f32(UniformInput & /* in */, const char * /* unif */, Eigen::Vector4f const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v2i32(UniformInput & /* in */, const char * /* unif */, Eigen::Vector2i const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v3i32(UniformInput & /* in */, const char * /* unif */, Eigen::Vector3i const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v4i32(UniformInput & /* in */, const char * /* unif */, Eigen::Vector4i const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v2ui32(UniformInput & /* in */, const char * /* unif */, Eigen::Vector2<uint32_t> const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v3ui32(UniformInput & /* in */, const char * /* unif */, Eigen::Vector3<uint32_t> const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v4ui32(UniformInput & /* in */, const char * /* unif */, Eigen::Vector4<uint32_t> const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_m4f32(UniformInput & /* in */, const char * /* unif */, Eigen::Matrix4f const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_tex(UniformInput & /* in */, const char * /* unif */, std::shared_ptr<Texture2d> const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_i32(UniformInput & /* in */, uniform_id_t /* id */, int32_t /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_u32(UniformInput & /* in */, uniform_id_t /* id */, uint32_t /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_f32(UniformInput & /* in */, uniform_id_t /* id */, float /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_f64(UniformInput & /* in */, uniform_id_t /* id */, double /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_bool(UniformInput & /* in */, uniform_id_t /* id */, bool /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v2f32(UniformInput & /* in */, uniform_id_t /* id */, Eigen::Vector2f const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v3f32(UniformInput & /* in */, uniform_id_t /* id */, Eigen::Vector3f const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v4f32(UniformInput & /* in */, uniform_id_t /* id */, Eigen::Vector4f const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v2i32(UniformInput & /* in */, uniform_id_t /* id */, Eigen::Vector2i const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v3i32(UniformInput & /* in */, uniform_id_t /* id */, Eigen::Vector3i const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v4i32(UniformInput & /* in */, uniform_id_t /* id */, Eigen::Vector4i const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v2ui32(UniformInput & /* in */, uniform_id_t /* id */, Eigen::Vector2<uint32_t> const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v3ui32(UniformInput & /* in */, uniform_id_t /* id */, Eigen::Vector3<uint32_t> const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_v4ui32(UniformInput & /* in */, uniform_id_t /* id */, Eigen::Vector4<uint32_t> const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_m4f32(UniformInput & /* in */, uniform_id_t /* id */, Eigen::Matrix4f const & /* val */) {
+	this->count_update();
+}
+
+void NullShaderProgram::set_tex(UniformInput & /* in */, uniform_id_t /* id */, std::shared_ptr<Texture2d> const & /* val */) {
+	this->count_update();
+}
+
+} // namespace openage::renderer::null
@@ -0,0 +1,93 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "renderer/shader_program.h"
+#include "renderer/uniform_input.h"
+
+
+namespace openage::renderer::null {
+
+struct render_stats;
+
+/// Uniform input for a shader program of the null renderer. Values are not stored.
+class NullUniformInput final : public UniformInput {
+public:
+	NullUniformInput(const std::shared_ptr<ShaderProgram> &prog);
+
+	/// Always true, since the null shader program has no uniform information.
+	bool is_complete() const override;
+};
+
+
+/// A shader program that is not compiled. Setting uniform values is only counted.
+///
+/// Since the shader source is not parsed, the program accepts every uniform
+/// name and assigns IDs to them in the order they are looked up.
+class NullShaderProgram final : public ShaderProgram {
+public:
+	NullShaderProgram(const std::shared_ptr<render_stats> &stats);
+
+	uniform_id_t get_uniform_id(const char *name) override;
+
+	bool has_uniform(const char *name) override;
+
+	void bind_uniform_buffer(const char *block_name,
+	                         std::shared_ptr<UniformBuffer> const &) override;
+
+	std::map<size_t, resources::vertex_input_t> vertex_attributes() const override;
+
+protected:
+	std::shared_ptr<UniformInput> new_unif_in() override;
+
+	void set_i32(UniformInput &in, const char *, int32_t) override;
+	void set_u32(UniformInput &in, const char *, uint32_t) override;
+	void set_f32(UniformInput &in, const char *, float) override;
+	void set_f64(UniformInput &in, const char *, double) override;
+	void set_bool(UniformInput &in, const char *, bool) override;
+	void set_v2f32(UniformInput &in, const char *, Eigen::Vector2f const &) override;
+	void set_v3f32(UniformInput &in, const char *, Eigen::Vector3f const &) override;
+	void set_v4f32(UniformInput &in, const char *, Eigen::Vector4f const &) override;
+	void set_v2i32(UniformInput &in, const char *, Eigen::Vector2i const &) override;
+	void set_v3i32(UniformInput &in, const char *, Eigen::Vector3i const &) override;
+	void set_v4i32(UniformInput &in, const char *, Eigen::Vector4i const &) override;
+	void set_v2ui32(UniformInput &in, const char *, Eigen::Vector2<uint32_t> const &) override;
+	void set_v3ui32(UniformInput &in, const char *, Eigen::Vector3<uint32_t> const &) override;
+	void set_v4ui32(UniformInput &in, const char *, Eigen::Vector4<uint32_t> const &) override;
+	void set_m4f32(UniformInput &in, const char *, Eigen::Matrix4f const &) override;
+	void set_tex(UniformInput &in, const char *, std::shared_ptr<Texture2d> const &) override;
+
+	void set_i32(UniformInput &in, uniform_id_t, int32_t) override;
+	void set_u32(UniformInput &in, uniform_id_t, uint32_t) override;
+	void set_f32(UniformInput &in, uniform_id_t, float) override;
+	void set_f64(UniformInput &in, uniform_id_t, double) override;
+	void set_bool(UniformInput &in, uniform_id_t, bool) override;
+	void set_v2f32(UniformInput &in, uniform_id_t, Eigen::Vector2f const &) override;
+	void set_v3f32(UniformInput &in, uniform_id_t, Eigen::Vector3f const &) override;
+	void set_v4f32(UniformInput &in, uniform_id_t, Eigen::Vector4f const &) override;
+	void set_v2i32(UniformInput &in, uniform_id_t, Eigen::Vector2i const &) override;
+	void set_v3i32(UniformInput &in, uniform_id_t, Eigen::Vector3i const &) override;
+	void set_v4i32(UniformInput &in, uniform_id_t, Eigen::Vector4i const &) override;
+	void set_v2ui32(UniformInput &in, uniform_id_t, Eigen::Vector2<uint32_t> const &) override;
+	void set_v3ui32(UniformInput &in, uniform_id_t, Eigen::Vector3<uint32_t> const &) override;
+	void set_v4ui32(UniformInput &in, uniform_id_t, Eigen::Vector4<uint32_t> const &) override;
+	void set_m4f32(UniformInput &in, uniform_id_t, Eigen::Matrix4f const &) override;
+	void set_tex(UniformInput &in, uniform_id_t, std::shared_ptr<Texture2d> const &) override;
+
+private:
+	/// Count a uniform value update.
+	void count_update();
+
+	/// Counters of the renderer.
+	std::shared_ptr<render_stats> stats;
+
+	/// IDs of the uniforms that have been looked up so far.
+	std::unordered_map<std::string, uniform_id_t> uniform_ids;
+};
+
+} // namespace openage::renderer::null
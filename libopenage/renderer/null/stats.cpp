@@ -0,0 +1,23 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "stats.h"
+
+
+namespace openage::renderer::null {
+
+void render_stats::reset() {
+	this->render_passes = 0;
+	this->draw_calls = 0;
+	this->drawn_instances = 0;
+	this->shader_updates = 0;
+	this->uniform_uploads = 0;
+	this->uniform_updates = 0;
+	this->uniform_buffer_updates = 0;
+	this->texture_uploads = 0;
+	this->texture_upload_bytes = 0;
+	this->geometry_uploads = 0;
+	this->geometry_upload_bytes = 0;
+	this->commands.clear();
+}
+
+} // namespace openage::renderer::null
@@ -0,0 +1,93 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace openage::renderer {
+class Geometry;
+class ShaderProgram;
+
+namespace null {
+
+/**
+ * A renderable executed by the null renderer.
+ */
+struct draw_command {
+	/// Shader program of the renderable.
+	const ShaderProgram *program;
+	/// Drawn geometry. nullptr if the renderable only updates uniforms.
+	const Geometry *geometry;
+	/// Priority of the layer the renderable is in.
+	int64_t layer;
+	/// First drawn instance for instanced geometry.
+	size_t instance_offset;
+	/// Number of drawn instances for instanced geometry.
+	size_t instance_count;
+	/// Whether alpha blending is enabled.
+	bool alpha_blending;
+	/// Whether depth testing is enabled.
+	bool depth_test;
+};
+
+
+/**
+ * Counters for the work that the null renderer would have sent to the GPU.
+ *
+ * The renderer and all objects created by it share one instance. Like the
+ * OpenGL renderer, they must only be used from one thread.
+ */
+struct render_stats {
+	/// Number of executed render passes.
+	size_t render_passes = 0;
+
+	/// Number of draw calls, i.e. renderables with geometry.
+	size_t draw_calls = 0;
+
+	/// Number of instances drawn by instanced draw calls.
+	size_t drawn_instances = 0;
+
+	/// Number of renderables without geometry.
+	size_t shader_updates = 0;
+
+	/// Number of uniform inputs uploaded to a shader program.
+	size_t uniform_uploads = 0;
+
+	/// Number of uniform values set in uniform inputs.
+	size_t uniform_updates = 0;
+
+	/// Number of uniform buffer updates.
+	size_t uniform_buffer_updates = 0;
+
+	/// Number of texture uploads, including the creation of textures from data.
+	size_t texture_uploads = 0;
+
+	/// Size of the uploaded texture data (in bytes).
+	size_t texture_upload_bytes = 0;
+
+	/// Number of vertex and instance data uploads, including the creation of meshes.
+	size_t geometry_uploads = 0;
+
+	/// Size of the uploaded vertex and instance data (in bytes).
+	size_t geometry_upload_bytes = 0;
+
+	/// If true, every executed renderable is recorded in \p commands.
+	bool record_commands = true;
+
+	/// Executed renderables in the order they were executed.
+	std::vector<draw_command> commands;
+
+	/**
+	 * Reset all counters and clear the recorded commands.
+	 *
+	 * The memory for the commands is kept, so that recording them
+	 * does not allocate after the first frame.
+	 */
+	void reset();
+};
+
+} // namespace null
+} // namespace openage::renderer
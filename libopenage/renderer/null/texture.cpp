@@ -0,0 +1,33 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "texture.h"
+
+#include <vector>
+
+#include "error/error.h"
+#include "log/message.h"
+#include "renderer/null/stats.h"
+
+
+namespace openage::renderer::null {
+
+NullTexture2d::NullTexture2d(const std::shared_ptr<render_stats> &stats,
+                             const resources::Texture2dInfo &info) :
+	Texture2d{info},
+	stats{stats} {}
+
+resources::Texture2dData NullTexture2d::into_data() {
+	std::vector<uint8_t> data(this->info.get_data_size());
+	return resources::Texture2dData{this->info, std::move(data)};
+}
+
+void NullTexture2d::upload(resources::Texture2dData const &data) {
+	if (this->info != data.get_info()) {
+		throw Error(MSG(err) << "Tried to upload texture data of different format into an existing texture.");
+	}
+
+	this->stats->texture_uploads += 1;
+	this->stats->texture_upload_bytes += data.get_info().get_data_size();
+}
+
+} // namespace openage::renderer::null
@@ -0,0 +1,31 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <memory>
+
+#include "renderer/texture.h"
+
+
+namespace openage::renderer::null {
+
+struct render_stats;
+
+/// A texture without GPU storage. Uploads are only counted.
+class NullTexture2d final : public Texture2d {
+public:
+	/// Create an empty texture.
+	NullTexture2d(const std::shared_ptr<render_stats> &stats,
+	              const resources::Texture2dInfo &info);
+
+	/// Returns zeroed texture data of the texture's size and format.
+	resources::Texture2dData into_data() override;
+
+	void upload(resources::Texture2dData const &) override;
+
+private:
+	/// Counters of the renderer.
+	std::shared_ptr<render_stats> stats;
+};
+
+} // namespace openage::renderer::null
@@ -0,0 +1,34 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "texture_array.h"
+
+#include "error/error.h"
+#include "log/message.h"
+#include "renderer/null/stats.h"
+#include "renderer/resources/texture_data.h"
+
+
+namespace openage::renderer::null {
+
+NullTexture2dArray::NullTexture2dArray(const std::shared_ptr<render_stats> &stats,
+                                       size_t n_layers,
+                                       const resources::Texture2dInfo &layer_info) :
+	Texture2dArray{layer_info},
+	stats{stats},
+	n_layers{n_layers} {}
+
+void NullTexture2dArray::upload(size_t layer, resources::Texture2dData const &data) {
+	if (layer >= this->n_layers) {
+		throw Error(MSG(err) << "Cannot upload to layer " << layer << " in texture array with "
+		                     << this->n_layers << " layers.");
+	}
+
+	if (this->layer_info != data.get_info()) {
+		throw Error(MSG(err) << "Tried to upload texture data of different format into a texture array.");
+	}
+
+	this->stats->texture_uploads += 1;
+	this->stats->texture_upload_bytes += data.get_info().get_data_size();
+}
+
+} // namespace openage::renderer::null
@@ -0,0 +1,33 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "renderer/texture_array.h"
+
+
+namespace openage::renderer::null {
+
+struct render_stats;
+
+/// A texture array without GPU storage. Uploads are only counted.
+class NullTexture2dArray final : public Texture2dArray {
+public:
+	/// Create an array of \p n_layers empty layers with the given format.
+	NullTexture2dArray(const std::shared_ptr<render_stats> &stats,
+	                   size_t n_layers,
+	                   const resources::Texture2dInfo &layer_info);
+
+	void upload(size_t layer, resources::Texture2dData const &) override;
+
+private:
+	/// Counters of the renderer.
+	std::shared_ptr<render_stats> stats;
+
+	/// Number of layers in the array.
+	size_t n_layers;
+};
+
+} // namespace openage::renderer::null
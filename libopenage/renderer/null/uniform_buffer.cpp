@@ -0,0 +1,97 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "uniform_buffer.h"
+
+#include "renderer/null/stats.h"
+
+
+namespace openage::renderer::null {
+
+NullUniformBufferInput::NullUniformBufferInput(const std::shared_ptr<UniformBuffer> &buffer) :
+	UniformBufferInput{buffer} {}
+
+
+NullUniformBuffer::NullUniformBuffer(const std::shared_ptr<render_stats> &stats) :
+	stats{stats} {}
+
+void NullUniformBuffer::update_uniforms(std::shared_ptr<UniformBufferInput> const & /* unif_in */) {
+	this->stats->uniform_buffer_updates += 1;
+}
+
+bool NullUniformBuffer::has_uniform(const char * /* unif */) {
+	return true;
+}
+
+std::shared_ptr<UniformBufferInput> NullUniformBuffer::new_unif_in() {
+	return std::make_shared<NullUniformBufferInput>(this->shared_from_this());
+}
+
+void NullUniformBuffer::count_update() {
+	this->stats->uniform_updates += 1;
+}
+
+void NullUniformBuffer::set_i32(UniformBufferInput & /* in */, const char * /* unif */, int32_t /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_u32(UniformBufferInput & /* in */, const char * /* unif */, uint32_t /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_f32(UniformBufferInput & /* in */, const char * /* unif */, float /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_f64(UniformBufferInput & /* in */, const char * /* unif */, double /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_bool(UniformBufferInput & /* in */, const char * /* unif */, bool /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_v2f32(UniformBufferInput & /* in */, const char * /* unif */, Eigen::Vector2f const & /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_v3f32(UniformBufferInput & /* in */, const char * /* unif */, Eigen::Vector3f const & /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_v4f32(UniformBufferInput & /* in */, const char * /* unif */, Eigen::Vector4f const & /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_v2i32(UniformBufferInput & /* in */, const char * /* unif */, Eigen::Vector2i const & /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_v3i32(UniformBufferInput & /* in */, const char * /* unif */, Eigen::Vector3i const & /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_v4i32(UniformBufferInput & /* in */, const char * /* unif */, Eigen::Vector4i const & /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_v2ui32(UniformBufferInput & /* in */, const char * /* unif */, Eigen::Vector2<uint32_t> const & /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_v3ui32(UniformBufferInput & /* in */, const char * /* unif */, Eigen::Vector3<uint32_t> const & /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_v4ui32(UniformBufferInput & /* in */, const char * /* unif */, Eigen::Vector4<uint32_t> const & /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_m4f32(UniformBufferInput & /* in */, const char * /* unif */, Eigen::Matrix4f const & /* val */) {
+	this->count_update();
+}
+
+void NullUniformBuffer::set_tex(UniformBufferInput & /* in */, const char * /* unif */, std::shared_ptr<Texture2d> const & /* val */) {
+	this->count_update();
+}
+
+} // namespace openage::renderer::null
@@ -0,0 +1,60 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <memory>
+
+#include "renderer/uniform_buffer.h"
+#include "renderer/uniform_input.h"
+
+
+namespace openage::renderer::null {
+
+struct render_stats;
+
+/// Uniform input for a uniform buffer of the null renderer. Values are not stored.
+class NullUniformBufferInput final : public UniformBufferInput {
+public:
+	NullUniformBufferInput(const std::shared_ptr<UniformBuffer> &buffer);
+};
+
+
+/// A uniform buffer without GPU storage. Setting uniform values and updating
+/// the buffer is only counted.
+class NullUniformBuffer final : public UniformBuffer {
+public:
+	NullUniformBuffer(const std::shared_ptr<render_stats> &stats);
+
+	void update_uniforms(std::shared_ptr<UniformBufferInput> const &unif_in) override;
+
+	bool has_uniform(const char *unif) override;
+
+protected:
+	std::shared_ptr<UniformBufferInput> new_unif_in() override;
+
+	void set_i32(UniformBufferInput &in, const char *, int32_t) override;
+	void set_u32(UniformBufferInput &in, const char *, uint32_t) override;
+	void set_f32(UniformBufferInput &in, const char *, float) override;
+	void set_f64(UniformBufferInput &in, const char *, double) override;
+	void set_bool(UniformBufferInput &in, const char *, bool) override;
+	void set_v2f32(UniformBufferInput &in, const char *, Eigen::Vector2f const &) override;
+	void set_v3f32(UniformBufferInput &in, const char *, Eigen::Vector3f const &) override;
+	void set_v4f32(UniformBufferInput &in, const char *, Eigen::Vector4f const &) override;
+	void set_v2i32(UniformBufferInput &in, const char *, Eigen::Vector2i const &) override;
+	void set_v3i32(UniformBufferInput &in, const char *, Eigen::Vector3i const &) override;
+	void set_v4i32(UniformBufferInput &in, const char *, Eigen::Vector4i const &) override;
+	void set_v2ui32(UniformBufferInput &in, const char *, Eigen::Vector2<uint32_t> const &) override;
+	void set_v3ui32(UniformBufferInput &in, const char *, Eigen::Vector3<uint32_t> const &) override;
+	void set_v4ui32(UniformBufferInput &in, const char *, Eigen::Vector4<uint32_t> const &) override;
+	void set_m4f32(UniformBufferInput &in, const char *, Eigen::Matrix4f const &) override;
+	void set_tex(UniformBufferInput &in, const char *, std::shared_ptr<Texture2d> const &) override;
+
+private:
+	/// Count a uniform value update.
+	void count_update();
+
+	/// Counters of the renderer.
+	std::shared_ptr<render_stats> stats;
+};
+
+} // namespace openage::renderer::null
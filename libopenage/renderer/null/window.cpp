@@ -0,0 +1,35 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "window.h"
+
+#include "renderer/null/renderer.h"
+
+
+namespace openage::renderer::null {
+
+NullWindow::NullWindow(size_t width, size_t height) :
+	Window{width, height} {}
+
+void NullWindow::set_size(size_t width, size_t height) {
+	this->size = {width, height};
+
+	for (auto &cb : this->on_resize) {
+		cb(width, height, this->scale_dpr);
+	}
+}
+
+void NullWindow::update() {
+	// there are no events to process and nothing to display
+}
+
+std::shared_ptr<Renderer> NullWindow::make_renderer() {
+	auto renderer = std::make_shared<NullRenderer>(this->size);
+
+	this->add_resize_callback([renderer](size_t w, size_t h, double /*scale*/) {
+		renderer->resize_display_target(w, h);
+	});
+
+	return renderer;
+}
+
+} // namespace openage::renderer::null
@@ -0,0 +1,43 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "renderer/window.h"
+
+
+namespace openage::renderer::null {
+
+/**
+ * A window that is never shown. It only provides the size and
+ * resize callbacks that the render stages need.
+ */
+class NullWindow final : public Window {
+public:
+	/**
+	 * Create a new invisible window.
+	 *
+	 * @param width Width of the window in pixels.
+	 * @param height Height of the window in pixels.
+	 */
+	NullWindow(size_t width, size_t height);
+	~NullWindow() = default;
+
+	void set_size(size_t width, size_t height) override;
+
+	/**
+	 * Does nothing, as there are no window events.
+	 */
+	void update() override;
+
+	/**
+	 * Create a \p NullRenderer with the size of the window.
+	 *
+	 * @return The created renderer.
+	 */
+	std::shared_ptr<Renderer> make_renderer() override;
+};
+
+} // namespace openage::renderer::null
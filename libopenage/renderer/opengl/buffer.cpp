@@ -1,4 +1,4 @@
-// Copyright 2015-2023 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #include "buffer.h"
 
@@ -49,6 +49,16 @@ void GlBuffer::upload_data(const uint8_t *data, size_t offset, size_t size) {
 	glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
 }
 
+void GlBuffer::upload_stream(const uint8_t *data, size_t size) {
+	if (size > this->size) [[unlikely]] {
+		throw Error(MSG(err) << "Tried to upload more data to OpenGL buffer than can fit.");
+	}
+
+	this->bind(GL_COPY_WRITE_BUFFER);
+	glBufferData(GL_COPY_WRITE_BUFFER, this->size, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, 0, size, data);
+}
+
 void GlBuffer::bind(GLenum target) const {
 	if (!bool(this->handle)) [[unlikely]] {
 		throw Error(MSG(err) << "OpenGL buffer has been moved out of.");
@@ -1,4 +1,4 @@
-// Copyright 2015-2023 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -34,6 +34,12 @@ public:
 	/// Binds the GL_COPY_WRITE_BUFFER target.
 	void upload_data(const uint8_t *data, size_t offset, size_t size);
 
+	/// Replaces the whole content of a buffer that is rewritten every frame.
+	/// The old storage is orphaned first, so the driver does not have to wait
+	/// for draw calls that still use it. `size` has to be less than or equal
+	/// to `get_size()`. Binds the GL_COPY_WRITE_BUFFER target.
+	void upload_stream(const uint8_t *data, size_t size);
+
 	/// Bind this buffer to the specified GL target.
 	void bind(GLenum target) const;
 
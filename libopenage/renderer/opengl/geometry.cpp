@@ -2,6 +2,8 @@
 
 #include "geometry.h"
 
+#include <algorithm>
+
 #include <epoxy/gl.h>
 
 #include "../../datastructure/constexpr_map.h"
@@ -29,6 +31,7 @@ GlGeometry::GlGeometry(const std::shared_ptr<GlContext> &context, const resource
 		{},
 		mesh.get_data().size() / mesh.get_info().vert_size(),
 		GL_PRIMITIVE.get(mesh.get_info().get_primitive()),
+		mesh.get_info().vert_size(),
 	};
 
 	if (mesh.get_ids()) {
@@ -38,17 +41,85 @@ GlGeometry::GlGeometry(const std::shared_ptr<GlContext> &context, const resource
 	}
 }
 
+GlGeometry::GlGeometry(const std::shared_ptr<GlContext> &context,
+                       const resources::MeshData &mesh,
+                       const resources::VertexInputInfo &instance_info) :
+	GlGeometry(context, mesh) {
+	this->instances = GlInstances{
+		context,
+		instance_info,
+		static_cast<GLuint>(mesh.get_info().get_inputs().size()),
+		{},
+		0,
+	};
+}
+
 void GlGeometry::update_verts_offset(std::vector<uint8_t> const &verts, size_t offset) {
 	if (this->get_type() != geometry_t::mesh) {
 		throw Error(MSG(err) << "Cannot update vertex data for non-mesh GlGeometry.");
 	}
 
-	if (verts.size() != this->mesh->vertices.get_size()) {
+	auto byte_offset = offset * this->mesh->vert_size;
+	if (byte_offset + verts.size() > this->mesh->vertices.get_size()) {
 		throw Error(MSG(err) << "Size mismatch between old and new vertex data for GlGeometry.");
 	}
 
-	// TODO support offset updating
-	this->mesh->vertices.upload_data(verts.data(), offset, verts.size());
+	this->mesh->vertices.upload_data(verts.data(), byte_offset, verts.size());
+}
+
+void GlGeometry::update_instances(std::vector<uint8_t> const &data) {
+	if (not this->instances) [[unlikely]] {
+		throw Error(MSG(err) << "Cannot update instance data for non-instanced GlGeometry.");
+	}
+
+	auto &instances = *this->instances;
+	instances.count = data.size() / instances.info.vert_size();
+	if (data.empty()) {
+		return;
+	}
+
+	if (not instances.buffer or instances.buffer->get_size() < data.size()) {
+		// grow geometrically so that a slowly increasing number of instances
+		// does not reallocate the buffer every frame
+		size_t capacity = instances.buffer ? instances.buffer->get_size() : 0;
+		capacity = std::max(capacity * 2, data.size());
+		instances.buffer.emplace(instances.context, capacity, GL_STREAM_DRAW);
+	}
+
+	instances.buffer->upload_stream(data.data(), data.size());
+}
+
+bool GlGeometry::is_instanced() const {
+	return this->instances.has_value();
+}
+
+void GlGeometry::draw_instanced(size_t first, size_t count) const {
+	if (not this->instances) [[unlikely]] {
+		throw Error(MSG(err) << "Cannot draw non-instanced GlGeometry instanced.");
+	}
+
+	auto const &instances = *this->instances;
+	if (count == 0 or not instances.buffer) {
+		return;
+	}
+
+	if (first + count > instances.count) [[unlikely]] {
+		throw Error(MSG(err) << "Instance range exceeds the instance data of GlGeometry.");
+	}
+
+	auto const &mesh = *this->mesh;
+
+	// point the instance inputs at the first instance of the range
+	// this also binds the VAO
+	mesh.vao.set_instance_inputs(*instances.buffer, instances.info, instances.first_attrib, first);
+
+	if (mesh.indices) {
+		mesh.indices->bind(GL_ELEMENT_ARRAY_BUFFER);
+		glDrawElementsInstanced(mesh.primitive, mesh.vert_count, *mesh.index_type, nullptr, count);
+	}
+	else {
+		glDrawArraysInstanced(mesh.primitive, 0, mesh.vert_count, count);
+	}
 }
 
 void GlGeometry::draw() const {
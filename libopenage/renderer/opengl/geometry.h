@@ -1,4 +1,4 @@
-// Copyright 2015-2023 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -24,12 +24,28 @@ public:
 	/// Initialize a meshed geometry. Relatively costly, has to initialize GL buffers and copy vertex data.
 	explicit GlGeometry(const std::shared_ptr<GlContext> &context, resources::MeshData const &);
 
+	/// Initialize a meshed geometry that is drawn instanced. The per-instance inputs described by
+	/// `instance_info` follow the mesh inputs in the shader's attribute locations.
+	GlGeometry(const std::shared_ptr<GlContext> &context,
+	           resources::MeshData const &,
+	           resources::VertexInputInfo const &instance_info);
+
 	/// Executes a draw command for the geometry on the currently active context.
 	/// Assumes bound and valid shader program and all other necessary state.
 	void draw() const;
 
+	/// Executes an instanced draw command for `count` instances, starting with the
+	/// `first`-th instance of the instance data.
+	/// Assumes bound and valid shader program and all other necessary state.
+	void draw_instanced(size_t first, size_t count) const;
+
+	/// Returns whether the geometry has per-instance data.
+	bool is_instanced() const;
+
 	void update_verts_offset(std::vector<uint8_t> const &, size_t) override;
 
+	void update_instances(std::vector<uint8_t> const &) override;
+
 private:
 	/// All the pieces of OpenGL state that represent a mesh.
 	struct GlMesh {
@@ -39,11 +55,24 @@ private:
 		std::optional<GLenum> index_type;
 		size_t vert_count;
 		GLenum primitive;
+		size_t vert_size;
+	};
+
+	/// Per-instance data of an instanced mesh.
+	struct GlInstances {
+		std::shared_ptr<GlContext> context;
+		resources::VertexInputInfo info;
+		GLuint first_attrib;
+		std::optional<GlBuffer> buffer;
+		size_t count;
 	};
 
 	/// Data managing GPU memory and interpretation of mesh data.
 	/// Only present if the type is a mesh.
 	std::optional<GlMesh> mesh;
+
+	/// Streamed instance data. Only present if the geometry is instanced.
+	std::optional<GlInstances> instances;
 };
 
 } // namespace opengl
@@ -1,4 +1,4 @@
-// Copyright 2018-2024 the openage authors. See copying.md for legal info.
+// Copyright 2018-2025 the openage authors. See copying.md for legal info.
 
 // Lookup tables for translating between OpenGL-specific values and generic renderer values,
 // as well as mapping things like type sizes within OpenGL.
@@ -127,14 +127,18 @@ static constexpr auto GL_VERT_IN_TYPE = datastructure::create_const_map<GLenum,
 	std::pair(GL_FLOAT, resources::vertex_input_t::F32),
 	std::pair(GL_FLOAT_VEC2, resources::vertex_input_t::V2F32),
 	std::pair(GL_FLOAT_VEC3, resources::vertex_input_t::V3F32),
-	std::pair(GL_FLOAT_MAT3, resources::vertex_input_t::M3F32));
+	std::pair(GL_FLOAT_VEC4, resources::vertex_input_t::V4F32),
+	std::pair(GL_FLOAT_MAT3, resources::vertex_input_t::M3F32),
+	std::pair(GL_UNSIGNED_INT, resources::vertex_input_t::U32));
 
 /// The type of a single element in a per-vertex attribute.
 static constexpr auto GL_VERT_IN_ELEM_TYPE = datastructure::create_const_map<resources::vertex_input_t, GLenum>(
 	std::pair(resources::vertex_input_t::F32, GL_FLOAT),
 	std::pair(resources::vertex_input_t::V2F32, GL_FLOAT),
 	std::pair(resources::vertex_input_t::V3F32, GL_FLOAT),
-	std::pair(resources::vertex_input_t::M3F32, GL_FLOAT));
+	std::pair(resources::vertex_input_t::V4F32, GL_FLOAT),
+	std::pair(resources::vertex_input_t::M3F32, GL_FLOAT),
+	std::pair(resources::vertex_input_t::U32, GL_UNSIGNED_INT));
 
 /// Mapping from generic primitive types to GL types.
 static constexpr auto GL_PRIMITIVE = datastructure::create_const_map<resources::vertex_primitive_t, GLenum>(
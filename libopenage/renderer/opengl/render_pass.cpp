@@ -1,38 +1,132 @@
-// Copyright 2019-2024 the openage authors. See copying.md for legal info.
+// Copyright 2019-2025 the openage authors. See copying.md for legal info.
 
 #include "render_pass.h"
 
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
 #include "log/log.h"
+#include "renderer/opengl/geometry.h"
+#include "renderer/opengl/shader_program.h"
+#include "renderer/opengl/uniform_input.h"
 
 
 namespace openage::renderer::opengl {
 
+namespace {
+
+/**
+ * Get the handle of the first texture set in a uniform input.
+ *
+ * @param in Uniform input.
+ * @param program Shader program of the uniform input.
+ *
+ * @return Texture handle or 0 if the input sets no texture.
+ */
+GLuint first_texture(const GlUniformInput &in, const GlShaderProgram &program) {
+	const auto &uniforms = program.get_uniforms();
+	for (auto id : in.used_uniforms) {
+		if (uniforms[id].type == GL_SAMPLER_2D) {
+			GLuint handle;
+			std::memcpy(&handle, in.update_data.data() + in.update_offs[id].offset, sizeof(GLuint));
+			return handle;
+		}
+	}
+
+	return 0;
+}
+
+} // namespace
+
+
 GlRenderPass::GlRenderPass(std::vector<Renderable> &&renderables,
                            const std::shared_ptr<RenderTarget> &target) :
 	RenderPass(std::move(renderables), target),
-	is_optimized(false) {
+	compiled_revision{std::nullopt},
+	draw_list{},
+	draw_layers{} {
 }
 
-void GlRenderPass::set_renderables(std::vector<Renderable> &&renderables) {
-	RenderPass::set_renderables(std::move(renderables));
-	this->is_optimized = false;
+bool GlRenderPass::compile() {
+	if (this->compiled_revision == this->get_revision()
+	    and not (this->get_state_sorting() and this->textures_changed())) {
+		return false;
+	}
+
+	this->draw_list.clear();
+	this->draw_layers.clear();
+
+	const auto &layers = this->get_layers();
+	for (size_t i = 0; i < layers.size(); i++) {
+		size_t begin = this->draw_list.size();
+
+		for (const auto &obj : this->renderables[i]) {
+			auto in = std::dynamic_pointer_cast<GlUniformInput>(obj.uniform);
+			auto program = std::static_pointer_cast<GlShaderProgram>(in->get_program());
+			auto geometry = std::dynamic_pointer_cast<GlGeometry>(obj.geometry);
+
+			this->draw_list.push_back(GlDrawCommand{
+				in,
+				program.get(),
+				geometry.get(),
+				first_texture(*in, *program),
+				in->texture_revision,
+				obj.alpha_blending,
+				obj.depth_test,
+				&obj,
+			});
+		}
+
+		size_t end = this->draw_list.size();
+		if (this->get_state_sorting()) {
+			this->sort_by_state(begin, end);
+		}
+
+		this->draw_layers.push_back(GlDrawLayer{layers[i].clear_depth, begin, end});
+	}
+
+	this->compiled_revision = this->get_revision();
+
+	return true;
 }
 
-void GlRenderPass::add_renderables(std::vector<Renderable> &&renderables, int64_t priority) {
-	RenderPass::add_renderables(std::move(renderables), priority);
-	this->is_optimized = false;
+const std::vector<GlDrawCommand> &GlRenderPass::get_draw_list() const {
+	return this->draw_list;
 }
 
-void GlRenderPass::add_renderables(Renderable &&renderable, int64_t priority) {
-	RenderPass::add_renderables(std::move(renderable), priority);
-	this->is_optimized = false;
+const std::vector<GlDrawLayer> &GlRenderPass::get_draw_layers() const {
+	return this->draw_layers;
 }
 
-bool GlRenderPass::get_is_optimized() const {
-	return this->is_optimized;
+bool GlRenderPass::textures_changed() const {
+	return std::any_of(this->draw_list.begin(),
+	                   this->draw_list.end(),
+	                   [](const GlDrawCommand &cmd) {
+						   return cmd.uniform->texture_revision != cmd.texture_revision;
+					   });
 }
 
-void GlRenderPass::set_is_optimized(bool flag) {
-	this->is_optimized = flag;
+void GlRenderPass::sort_by_state(size_t begin, size_t end) {
+	auto compare = [](const GlDrawCommand &a, const GlDrawCommand &b) {
+		return std::make_tuple(a.program->get_handle(), a.texture, a.alpha_blending, a.depth_test)
+		       < std::make_tuple(b.program->get_handle(), b.texture, b.alpha_blending, b.depth_test);
+	};
+
+	// renderables without geometry only update uniforms that may be
+	// read by the following draw calls, so they must stay in place
+	size_t run_begin = begin;
+	for (size_t i = begin; i < end; i++) {
+		if (this->draw_list[i].geometry == nullptr) {
+			std::stable_sort(this->draw_list.begin() + run_begin,
+			                 this->draw_list.begin() + i,
+			                 compare);
+			run_begin = i + 1;
+		}
+	}
+	std::stable_sort(this->draw_list.begin() + run_begin,
+	                 this->draw_list.begin() + end,
+	                 compare);
 }
+
 } // namespace openage::renderer::opengl
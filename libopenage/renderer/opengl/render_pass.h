@@ -1,28 +1,96 @@
-// Copyright 2019-2024 the openage authors. See copying.md for legal info.
+// Copyright 2019-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <epoxy/gl.h>
+
 #include "renderer/render_pass.h"
 #include "renderer/renderable.h"
 
 
 namespace openage::renderer::opengl {
 
+class GlGeometry;
+class GlShaderProgram;
+class GlUniformInput;
+
+/// A renderable with its OpenGL objects already resolved.
+struct GlDrawCommand {
+	/// Uniform values of the renderable.
+	std::shared_ptr<GlUniformInput> uniform;
+	/// Shader program the uniform input belongs to.
+	GlShaderProgram *program;
+	/// Drawn geometry. nullptr if the renderable only updates uniforms.
+	GlGeometry *geometry;
+	/// Handle of the first texture set in the uniform input (0 if none).
+	/// Only used as sort key, the texture itself is bound by the program.
+	GLuint texture;
+	/// Texture revision of the uniform input when \p texture was read.
+	size_t texture_revision;
+	/// Whether alpha blending is enabled.
+	bool alpha_blending;
+	/// Whether depth testing is enabled.
+	bool depth_test;
+	/// Renderable the command was compiled from. Only valid until the pass is modified.
+	/// Instance ranges are read from it when drawing, because they can change
+	/// without a new revision of the pass.
+	const Renderable *source;
+};
+
+/// Slice of the draw list that belongs to one layer of the pass.
+struct GlDrawLayer {
+	/// Whether to clear the depth buffer before drawing the layer.
+	bool clear_depth;
+	/// Index of the first draw command of the layer.
+	size_t begin;
+	/// Index after the last draw command of the layer.
+	size_t end;
+};
+
 class GlRenderPass final : public RenderPass {
 public:
 	GlRenderPass(std::vector<Renderable> &&renderables,
 	             const std::shared_ptr<RenderTarget> &target);
 
-	void set_renderables(std::vector<Renderable> &&renderables);
-	void add_renderables(std::vector<Renderable> &&renderables, int64_t priority = LAYER_PRIORITY_MAX);
-	void add_renderables(Renderable &&renderable, int64_t priority = LAYER_PRIORITY_MAX);
+	/// Rebuild the draw list if the renderables of the pass have been
+	/// modified since the last compilation. Passes with state sorting are also
+	/// rebuilt if the texture of a renderable has changed, because it is
+	/// part of the sort key.
+	///
+	/// If state sorting is enabled for the pass, renderables inside each layer
+	/// are ordered by (shader, texture, blending, depth test). Renderables without
+	/// geometry act as barriers, nothing is moved across them.
+	///
+	/// @return true if the draw list was rebuilt, false if it was up to date.
+	bool compile();
+
+	/// Get the draw list created by the last call to \p compile().
+	const std::vector<GlDrawCommand> &get_draw_list() const;
 
-	void set_is_optimized(bool);
-	bool get_is_optimized() const;
+	/// Get the layer slices of the draw list created by the last call to \p compile().
+	const std::vector<GlDrawLayer> &get_draw_layers() const;
 
 private:
-	/// Whether the renderables order is optimised
-	bool is_optimized;
+	/// Check if a texture uniform of a draw command was changed after the last compilation.
+	bool textures_changed() const;
+
+	/// Stable sort the draw commands in [begin, end) by render state,
+	/// without moving commands across renderables that have no geometry.
+	void sort_by_state(size_t begin, size_t end);
+
+	/// Revision of the pass that the draw list was built from.
+	std::optional<size_t> compiled_revision;
+
+	/// Draw commands of all layers, in draw order.
+	std::vector<GlDrawCommand> draw_list;
+
+	/// Slices of the draw list per layer, in draw order.
+	std::vector<GlDrawLayer> draw_layers;
 };
 
 } // namespace openage::renderer::opengl
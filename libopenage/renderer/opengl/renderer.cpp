@@ -3,6 +3,7 @@
 #include "renderer.h"
 
 #include <algorithm>
+#include <optional>
 
 #include "error/error.h"
 #include "log/log.h"
@@ -13,6 +14,7 @@
 #include "renderer/opengl/render_target.h"
 #include "renderer/opengl/shader_program.h"
 #include "renderer/opengl/texture.h"
+#include "renderer/opengl/texture_array.h"
 #include "renderer/opengl/uniform_buffer.h"
 #include "renderer/opengl/uniform_input.h"
 #include "renderer/opengl/vertex_array.h"
@@ -56,6 +58,14 @@ std::shared_ptr<Texture2d> GlRenderer::add_texture(const resources::Texture2dInf
 	return std::make_shared<GlTexture2d>(this->gl_context, info);
 }
 
+std::shared_ptr<Texture2dArray> GlRenderer::add_texture_array(const std::vector<resources::Texture2dData> &layers) {
+	if (layers.empty()) {
+		throw Error{MSG(err) << "Tried to create a texture array without layers."};
+	}
+
+	return std::make_shared<GlTexture2dArray>(this->gl_context, layers);
+}
+
 std::shared_ptr<ShaderProgram> GlRenderer::add_shader(std::vector<resources::ShaderSource> const &srcs) {
 	return std::make_shared<GlShaderProgram>(this->gl_context, srcs);
 }
@@ -64,6 +74,11 @@ std::shared_ptr<Geometry> GlRenderer::add_mesh_geometry(resources::MeshData cons
 	return std::make_shared<GlGeometry>(this->gl_context, mesh);
 }
 
+std::shared_ptr<Geometry> GlRenderer::add_instanced_geometry(resources::MeshData const &mesh,
+                                                             resources::VertexInputInfo const &instance_info) {
+	return std::make_shared<GlGeometry>(this->gl_context, mesh, instance_info);
+}
+
 std::shared_ptr<Geometry> GlRenderer::add_bufferless_quad() {
 	return std::make_shared<GlGeometry>();
 }
@@ -146,22 +161,6 @@ void GlRenderer::resize_display_target(size_t width, size_t height) {
 	this->display->resize(width, height);
 }
 
-void GlRenderer::optimize(const std::shared_ptr<GlRenderPass> &pass) {
-	if (!pass->get_is_optimized()) {
-		pass->sort([](const Renderable &a, const Renderable &b) {
-			GLuint shader_a = std::dynamic_pointer_cast<GlShaderProgram>(
-								  std::dynamic_pointer_cast<GlUniformInput>(a.uniform)->get_program())
-			                      ->get_handle();
-			GLuint shader_b = std::dynamic_pointer_cast<GlShaderProgram>(
-								  std::dynamic_pointer_cast<GlUniformInput>(b.uniform)->get_program())
-			                      ->get_handle();
-			return shader_a < shader_b;
-		});
-
-		pass->set_is_optimized(true);
-	}
-}
-
 void GlRenderer::check_error() {
 	// thanks for the global state, opengl!
 	GlContext::check_error();
@@ -182,51 +181,79 @@ void GlRenderer::render(const std::shared_ptr<RenderPass> &pass) {
 	// glEnable(GL_CULL_FACE);
 
 	auto gl_pass = std::dynamic_pointer_cast<GlRenderPass>(pass);
-	// TODO: Optimization is disabled for now. Figure out how to do this without calling it every frame
-	// GlRenderer::optimize(gl_pass);
+	if (gl_pass->compile()) {
+		this->stats.pass_compiles += 1;
+	}
+	this->stats.render_passes += 1;
 
-	// render all objects in the pass
-	const auto &layers = gl_pass->get_layers();
-	const auto &renderables = gl_pass->get_renderables();
+	// GL state may have been changed outside of the renderer (e.g. by the GUI),
+	// so the first renderable of the pass always sets it
+	std::optional<bool> blend_enabled;
+	std::optional<bool> depth_test_enabled;
+	const GlShaderProgram *current_program = nullptr;
 
-	// Draw by layers
-	for (size_t i = 0; i < layers.size(); i++) {
-		const auto &layer = layers[i];
-		const auto &objects = renderables[i];
+	const auto &draw_list = gl_pass->get_draw_list();
 
+	// Draw by layers
+	for (const auto &layer : gl_pass->get_draw_layers()) {
 		if (layer.clear_depth) {
 			glClear(GL_DEPTH_BUFFER_BIT);
 		}
 
-		for (auto const &obj : objects) {
-			if (obj.alpha_blending) {
-				glEnable(GL_BLEND);
-			}
-			else {
-				glDisable(GL_BLEND);
+		for (size_t i = layer.begin; i < layer.end; i++) {
+			const auto &obj = draw_list[i];
+
+			if (blend_enabled != obj.alpha_blending) {
+				if (obj.alpha_blending) {
+					glEnable(GL_BLEND);
+				}
+				else {
+					glDisable(GL_BLEND);
+				}
+				blend_enabled = obj.alpha_blending;
+				this->stats.blend_changes += 1;
 			}
 
-			if (obj.depth_test) {
-				glEnable(GL_DEPTH_TEST);
-			}
-			else {
-				glDisable(GL_DEPTH_TEST);
+			if (depth_test_enabled != obj.depth_test) {
+				if (obj.depth_test) {
+					glEnable(GL_DEPTH_TEST);
+				}
+				else {
+					glDisable(GL_DEPTH_TEST);
+				}
+				depth_test_enabled = obj.depth_test;
+				this->stats.depth_test_changes += 1;
 			}
 
-			auto in = std::dynamic_pointer_cast<GlUniformInput>(obj.uniform);
-			auto program = std::static_pointer_cast<GlShaderProgram>(in->get_program());
+			if (current_program != obj.program) {
+				current_program = obj.program;
+				this->stats.program_changes += 1;
+			}
 
 			// this also calls program->use()
-			program->update_uniforms(in);
+			obj.program->update_uniforms(obj.uniform);
 
 			// draw the geometry
 			if (obj.geometry != nullptr) {
-				auto geom = std::dynamic_pointer_cast<GlGeometry>(obj.geometry);
 				// TODO read obj.blend + family
-				geom->draw();
+				if (obj.geometry->is_instanced()) {
+					obj.geometry->draw_instanced(obj.source->instance_offset, obj.source->instance_count);
+				}
+				else {
+					obj.geometry->draw();
+				}
+				this->stats.draw_calls += 1;
 			}
 		}
 	}
 }
 
+const GlRenderStats &GlRenderer::get_stats() const {
+	return this->stats;
+}
+
+void GlRenderer::reset_stats() {
+	this->stats = GlRenderStats{};
+}
+
 } // namespace openage::renderer::opengl
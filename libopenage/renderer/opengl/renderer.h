@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 #include "renderer/renderer.h"
@@ -20,6 +21,27 @@ class GlRenderTarget;
 class GlVertexArray;
 class GlWindow;
 
+/// Counters for the work done by \p GlRenderer::render().
+struct GlRenderStats {
+	/// Number of rendered passes.
+	size_t render_passes = 0;
+	/// Number of passes whose draw list had to be rebuilt.
+	size_t pass_compiles = 0;
+	/// Number of draw calls.
+	size_t draw_calls = 0;
+	/// Number of switches to a different shader program.
+	size_t program_changes = 0;
+	/// Number of times alpha blending was enabled or disabled.
+	size_t blend_changes = 0;
+	/// Number of times depth testing was enabled or disabled.
+	size_t depth_test_changes = 0;
+
+	/// Get the total number of render state changes.
+	size_t state_changes() const {
+		return this->program_changes + this->blend_changes + this->depth_test_changes;
+	}
+};
+
 /// The OpenGL specialization of the rendering interface.
 class GlRenderer final : public Renderer {
 public:
@@ -35,10 +57,13 @@ public:
 
 	std::shared_ptr<Texture2d> add_texture(resources::Texture2dData const &) override;
 	std::shared_ptr<Texture2d> add_texture(resources::Texture2dInfo const &) override;
+	std::shared_ptr<Texture2dArray> add_texture_array(std::vector<resources::Texture2dData> const &) override;
 
 	std::shared_ptr<ShaderProgram> add_shader(std::vector<resources::ShaderSource> const &) override;
 
 	std::shared_ptr<Geometry> add_mesh_geometry(resources::MeshData const &) override;
+	std::shared_ptr<Geometry> add_instanced_geometry(resources::MeshData const &,
+	                                                 resources::VertexInputInfo const &) override;
 	std::shared_ptr<Geometry> add_bufferless_quad() override;
 
 	std::shared_ptr<RenderPass> add_render_pass(std::vector<Renderable>, const std::shared_ptr<RenderTarget> &) override;
@@ -59,9 +84,17 @@ public:
 
 	void render(const std::shared_ptr<RenderPass> &) override;
 
+	/// Get the counters accumulated by \p render() since the last call to \p reset_stats().
+	///
+	/// Reset them once per frame to get per-frame values.
+	const GlRenderStats &get_stats() const;
+
+	/// Reset the render counters.
+	void reset_stats();
+
 private:
-	/// Optimize the render pass by reordering stuff
-	static void optimize(const std::shared_ptr<GlRenderPass> &pass);
+	/// Counters for the work done by \p render().
+	GlRenderStats stats;
 
 	/// The GL context.
 	std::shared_ptr<GlContext> gl_context;
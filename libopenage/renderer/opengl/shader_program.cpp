@@ -1,9 +1,10 @@
-// Copyright 2013-2024 the openage authors. See copying.md for legal info.
+// Copyright 2013-2025 the openage authors. See copying.md for legal info.
 
 #include "shader_program.h"
 
 #include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <unordered_set>
 
 #include "datastructure/constexpr_map.h"
@@ -228,6 +229,17 @@ GlShaderProgram::GlShaderProgram(const std::shared_ptr<GlContext> &context,
 	// to number of texture units used by the shader
 	this->textures_per_texunits.resize(tex_unit_id);
 
+	// Use the same layout for the uploaded values as uniform inputs
+	// use for their update data
+	size_t uploaded_size = 0;
+	this->uploaded_values.reserve(this->uniforms.size());
+	for (auto &uniform : this->uniforms) {
+		size_t size = GL_UNIFORM_TYPE_SIZE.get(uniform.type);
+		this->uploaded_values.push_back({uploaded_size, size, false});
+		uploaded_size += size;
+	}
+	this->uploaded_data.resize(uploaded_size);
+
 	// Extract vertex attribute descriptions.
 	for (GLuint i_attrib = 0; i_attrib < attrib_count; ++i_attrib) {
 		GLint size;
@@ -364,6 +376,19 @@ void GlShaderProgram::update_uniforms(std::shared_ptr<GlUniformInput> const &uni
 		const auto &unif = uniforms[unif_id];
 		auto loc = unif.location;
 
+		// texture units are shared between programs, so samplers are always bound
+		if (unif.type != GL_SAMPLER_2D) {
+			// skip values that the program already has
+			auto &uploaded = this->uploaded_values[unif_id];
+			uint8_t *uploaded_ptr = this->uploaded_data.data() + uploaded.offset;
+			if (uploaded.valid and std::memcmp(uploaded_ptr, ptr, uploaded.size) == 0) {
+				continue;
+			}
+
+			std::memcpy(uploaded_ptr, ptr, uploaded.size);
+			uploaded.valid = true;
+		}
+
 		switch (unif.type) {
 		case GL_INT:
 			glUniform1i(loc, *reinterpret_cast<const GLint *>(ptr));
@@ -521,6 +546,10 @@ void GlShaderProgram::set_unif(UniformInput &in,
 
 	auto &update_off = unif_in.update_offs[unif_id];
 	auto offset = update_off.offset;
+	if (type == GL_SAMPLER_2D
+	    and (not update_off.used or memcmp(unif_in.update_data.data() + offset, val, size) != 0)) {
+		unif_in.texture_revision += 1;
+	}
 	memcpy(unif_in.update_data.data() + offset, val, size);
 	if (not update_off.used) [[unlikely]] { // only true if the uniform value was not set before
 		auto lower_bound = std::lower_bound(
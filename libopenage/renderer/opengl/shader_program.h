@@ -1,7 +1,9 @@
-// Copyright 2015-2024 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 
@@ -51,6 +53,9 @@ public:
 	/**
 	 * Updates the uniform values with the given input specification.
 	 *
+	 * Values that are equal to the last uploaded value of the same uniform
+	 * are skipped, since the program keeps them across draw calls.
+	 *
 	 * @param input The uniform input specification.
 	 */
 	void update_uniforms(std::shared_ptr<GlUniformInput> const &unif_in);
@@ -194,6 +199,22 @@ private:
 	/// Maps per-vertex attribute names to their descriptions.
 	std::unordered_map<std::string, GlVertexAttrib> attribs;
 
+	/// Location of the last uploaded value of a uniform in \p uploaded_data.
+	struct GlUploadedValue {
+		/// Offset in the uploaded data buffer. Same as in the update data of uniform inputs.
+		size_t offset;
+		/// Size of the value (in bytes).
+		size_t size;
+		/// Whether a value has been uploaded yet.
+		bool valid;
+	};
+
+	/// Last uploaded values of the uniforms, by uniform ID.
+	std::vector<GlUploadedValue> uploaded_values;
+
+	/// Buffer with the last uploaded uniform values.
+	std::vector<uint8_t> uploaded_data;
+
 	/// Store which texture handles are currently bound to the shader's texture units.
 	/// A value of std::nullopt means the texture unit is unbound (no texture assigned).
 	std::vector<std::optional<GLuint>> textures_per_texunits;
@@ -1,4 +1,4 @@
-// Copyright 2015-2024 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -8,6 +8,7 @@
 #include "renderer/renderer.h"
 #include "renderer/types.h"
 #include "renderer/uniform_input.h"
+#include "util/memory_tag.h"
 
 
 namespace openage {
@@ -56,7 +57,13 @@ public:
 	/**
 	 * Buffer containing untyped uniform update data.
 	 */
-	std::vector<uint8_t> update_data;
+	std::vector<uint8_t, util::TaggedAllocator<uint8_t, util::memory_tag::renderer>> update_data;
+
+	/**
+	 * Incremented whenever a texture uniform is set to another texture.
+	 * Lets render passes detect that their texture sort keys are outdated.
+	 */
+	size_t texture_revision = 0;
 };
 
 /**
@@ -89,7 +96,7 @@ public:
 	/**
 	 * Buffer containing untyped uniform update data.
 	 */
-	std::vector<uint8_t> update_data;
+	std::vector<uint8_t, util::TaggedAllocator<uint8_t, util::memory_tag::renderer>> update_data;
 };
 
 } // namespace opengl
@@ -1,4 +1,4 @@
-// Copyright 2015-2023 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #include "vertex_array.h"
 
@@ -14,6 +14,34 @@ namespace openage {
 namespace renderer {
 namespace opengl {
 
+namespace {
+
+/**
+ * Set the pointer of a vertex attribute in the bound VAO. Integer inputs
+ * are passed to the shader as integers instead of being converted to float.
+ */
+void attrib_pointer(GLuint attrib, resources::vertex_input_t in, size_t stride, size_t offset) {
+	if (in == resources::vertex_input_t::U32) {
+		glVertexAttribIPointer(
+			attrib,
+			resources::vertex_input_count(in),
+			GL_VERT_IN_ELEM_TYPE.get(in),
+			stride,
+			reinterpret_cast<void *>(offset));
+		return;
+	}
+
+	glVertexAttribPointer(
+		attrib,
+		resources::vertex_input_count(in),
+		GL_VERT_IN_ELEM_TYPE.get(in),
+		GL_FALSE,
+		stride,
+		reinterpret_cast<void *>(offset));
+}
+
+} // namespace
+
 GlVertexArray::GlVertexArray(const std::shared_ptr<GlContext> &context,
                              std::vector<std::pair<GlBuffer const &,
                                                    resources::VertexInputInfo const &>> buffers) :
@@ -49,13 +77,7 @@ GlVertexArray::GlVertexArray(const std::shared_ptr<GlContext> &context,
 					}
 				}
 
-				glVertexAttribPointer(
-					mapping.second,
-					resources::vertex_input_count(in[mapping.first]),
-					GL_VERT_IN_ELEM_TYPE.get(in[mapping.first]),
-					GL_FALSE,
-					info.vert_size(),
-					reinterpret_cast<void *>(offset));
+				attrib_pointer(mapping.second, in[mapping.first], info.vert_size(), offset);
 
 				offset += resources::vertex_input_size(in[mapping.first]);
 				next_idx = mapping.first + 1;
@@ -72,13 +94,7 @@ GlVertexArray::GlVertexArray(const std::shared_ptr<GlContext> &context,
 					}
 				}
 
-				glVertexAttribPointer(
-					mapping.second,
-					resources::vertex_input_count(in[mapping.first]),
-					GL_VERT_IN_ELEM_TYPE.get(in[mapping.first]),
-					GL_FALSE,
-					0,
-					reinterpret_cast<void *>(offset));
+				attrib_pointer(mapping.second, in[mapping.first], 0, offset);
 
 				offset += resources::vertex_input_size(in[mapping.first]) * vert_count;
 				next_idx = mapping.first + 1;
@@ -107,13 +123,7 @@ GlVertexArray::GlVertexArray(const std::shared_ptr<GlContext> &context,
 				for (auto in : info.get_inputs()) {
 					glEnableVertexAttribArray(attrib);
 
-					glVertexAttribPointer(
-						attrib,
-						resources::vertex_input_count(in),
-						GL_VERT_IN_ELEM_TYPE.get(in),
-						GL_FALSE,
-						info.vert_size(),
-						reinterpret_cast<void *>(offset));
+					attrib_pointer(attrib, in, info.vert_size(), offset);
 
 					offset += resources::vertex_input_size(in);
 					attrib += 1;
@@ -126,13 +136,7 @@ GlVertexArray::GlVertexArray(const std::shared_ptr<GlContext> &context,
 				for (auto in : info.get_inputs()) {
 					glEnableVertexAttribArray(attrib);
 
-					glVertexAttribPointer(
-						attrib,
-						resources::vertex_input_count(in),
-						GL_VERT_IN_ELEM_TYPE.get(in),
-						GL_FALSE,
-						0,
-						reinterpret_cast<void *>(offset));
+					attrib_pointer(attrib, in, 0, offset);
 
 					offset += resources::vertex_input_size(in) * vert_count;
 					attrib += 1;
@@ -158,6 +162,29 @@ GlVertexArray::GlVertexArray(const std::shared_ptr<GlContext> &context) :
 	this->handle = handle;
 }
 
+void GlVertexArray::set_instance_inputs(GlBuffer const &buf,
+                                        resources::VertexInputInfo const &info,
+                                        GLuint first_attrib,
+                                        size_t first_instance) const {
+	if (info.get_layout() != resources::vertex_layout_t::AOS) [[unlikely]] {
+		throw Error(MSG(err) << "Instance inputs must use the AOS vertex layout.");
+	}
+
+	this->bind();
+	buf.bind(GL_ARRAY_BUFFER);
+
+	GLuint attrib = first_attrib;
+	size_t offset = first_instance * info.vert_size();
+	for (auto in : info.get_inputs()) {
+		glEnableVertexAttribArray(attrib);
+		attrib_pointer(attrib, in, info.vert_size(), offset);
+		glVertexAttribDivisor(attrib, 1);
+
+		offset += resources::vertex_input_size(in);
+		attrib += 1;
+	}
+}
+
 void GlVertexArray::bind() const {
 	glBindVertexArray(*this->handle);
 
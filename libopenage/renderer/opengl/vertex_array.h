@@ -1,4 +1,4 @@
-// Copyright 2015-2023 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -46,6 +46,16 @@ public:
 	/// This is useful for bufferless drawing.
 	GlVertexArray(const std::shared_ptr<GlContext> &context);
 
+	/// Attaches a buffer with per-instance data to this VAO. The inputs are assigned to
+	/// consecutive attributes starting at `first_attrib` and advance once per instance.
+	/// `first_instance` is the index of the instance that is passed to the first drawn
+	/// instance, which allows drawing a range of the buffer without base instance support.
+	/// The buffer must use the AOS layout. Binds this VAO.
+	void set_instance_inputs(GlBuffer const &buf,
+	                         resources::VertexInputInfo const &info,
+	                         GLuint first_attrib,
+	                         size_t first_instance = 0) const;
+
 	/// Make this vertex array object the current one.
 	void bind() const;
 };
@@ -1,4 +1,4 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #include "render_factory.h"
 
@@ -30,4 +30,8 @@ std::shared_ptr<world::RenderEntity> RenderFactory::add_world_render_entity() {
 	return entity;
 }
 
+void RenderFactory::prefetch_animations(const std::vector<std::string> &rel_paths) {
+	this->world_renderer->prefetch_animations(rel_paths);
+}
+
 } // namespace openage::renderer
@@ -1,8 +1,10 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "coord/tile.h"
 #include "util/vector.h"
@@ -57,6 +59,14 @@ public:
 	 */
 	std::shared_ptr<world::RenderEntity> add_world_render_entity();
 
+	/**
+	 * Start loading animations of game entities in the background, so that
+	 * they are ready when the entities are spawned.
+	 *
+	 * @param rel_paths Relative paths to the animation resources (from the asset base dir).
+	 */
+	void prefetch_animations(const std::vector<std::string> &rel_paths);
+
 private:
 	/**
 	 * Render stage for terrain drawing.
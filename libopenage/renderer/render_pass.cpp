@@ -1,7 +1,8 @@
-// Copyright 2024-2024 the openage authors. See copying.md for legal info.
+// Copyright 2024-2025 the openage authors. See copying.md for legal info.
 
 #include "render_pass.h"
 
+#include "error/error.h"
 #include "log/log.h"
 
 
@@ -11,7 +12,9 @@ RenderPass::RenderPass(std::vector<Renderable> &&renderables,
                        const std::shared_ptr<RenderTarget> &target) :
 	renderables{},
 	target{target},
-	layers{} {
+	layers{},
+	state_sorting{false},
+	revision{0} {
 	// Add a default layer with the lowest priority
 	this->add_layer(0, LAYER_PRIORITY_MAX);
 
@@ -48,6 +51,7 @@ void RenderPass::add_renderables(std::vector<Renderable> &&renderables, int64_t
 		this->renderables.back().insert(this->renderables.back().end(),
 		                                std::make_move_iterator(renderables.begin()),
 		                                std::make_move_iterator(renderables.end()));
+		this->revision += 1;
 		return;
 	}
 
@@ -77,12 +81,26 @@ void RenderPass::add_renderables(std::vector<Renderable> &&renderables, int64_t
 	this->renderables[layer_index].insert(this->renderables[layer_index].end(),
 	                                      std::make_move_iterator(renderables.begin()),
 	                                      std::make_move_iterator(renderables.end()));
+	this->revision += 1;
 }
 
 void RenderPass::add_renderables(Renderable &&renderable, int64_t priority) {
 	this->add_renderables(std::vector<Renderable>{std::move(renderable)}, priority);
 }
 
+void RenderPass::set_instance_range(int64_t priority, size_t index, size_t offset, size_t count) {
+	for (size_t i = 0; i < this->layers.size(); i++) {
+		if (this->layers[i].priority == priority) {
+			auto &renderable = this->renderables[i].at(index);
+			renderable.instance_offset = offset;
+			renderable.instance_count = count;
+			return;
+		}
+	}
+
+	throw Error{MSG(err) << "Render pass has no layer with priority " << priority};
+}
+
 void RenderPass::add_layer(int64_t priority, bool clear_depth) {
 	size_t layer_index = 0;
 	for (const auto &layer : this->layers) {
@@ -98,6 +116,7 @@ void RenderPass::add_layer(int64_t priority, bool clear_depth) {
 void RenderPass::add_layer(size_t index, int64_t priority, bool clear_depth) {
 	this->layers.insert(this->layers.begin() + index, Layer{priority, clear_depth});
 	this->renderables.insert(this->renderables.begin() + index, std::vector<Renderable>{});
+	this->revision += 1;
 }
 
 void RenderPass::clear_renderables() {
@@ -105,6 +124,7 @@ void RenderPass::clear_renderables() {
 	for (size_t i = 0; i < this->layers.size(); i++) {
 		this->renderables[i].clear();
 	}
+	this->revision += 1;
 }
 
 void RenderPass::sort(const compare_func &compare) {
@@ -113,6 +133,22 @@ void RenderPass::sort(const compare_func &compare) {
 		                 this->renderables[i].end(),
 		                 compare);
 	}
+	this->revision += 1;
+}
+
+void RenderPass::set_state_sorting(bool enable) {
+	if (this->state_sorting != enable) {
+		this->state_sorting = enable;
+		this->revision += 1;
+	}
+}
+
+bool RenderPass::get_state_sorting() const {
+	return this->state_sorting;
+}
+
+size_t RenderPass::get_revision() const {
+	return this->revision;
 }
 
 } // namespace openage::renderer
@@ -1,4 +1,4 @@
-// Copyright 2024-2024 the openage authors. See copying.md for legal info.
+// Copyright 2024-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -90,6 +90,19 @@ public:
 	void add_renderables(Renderable &&renderable,
 	                     int64_t priority = LAYER_PRIORITY_MAX);
 
+	/**
+	 * Change the range of instances that an instanced renderable draws.
+	 *
+	 * Unlike the other modifications, this does not change the revision of the pass,
+	 * so backends can keep the data they derived from the renderables.
+	 *
+	 * @param priority Priority of the layer that contains the renderable.
+	 * @param index Index of the renderable inside the layer.
+	 * @param offset Index of the first drawn instance.
+	 * @param count Number of drawn instances.
+	 */
+	void set_instance_range(int64_t priority, size_t index, size_t offset, size_t count);
+
 	/**
 	 * Add a new layer to the render pass.
 	 *
@@ -114,6 +127,39 @@ public:
 	 */
 	void sort(const compare_func &compare);
 
+	/**
+	 * Allow the renderer to reorder the renderables inside each layer, so that
+	 * renderables with the same render state (shader, texture, blending, depth
+	 * testing) are drawn one after another.
+	 *
+	 * Only enable this if the draw order within a layer does not matter, e.g.
+	 * because the renderables are depth tested and don't overlap where they are
+	 * blended. Renderables without geometry are never moved and nothing is moved
+	 * across them.
+	 *
+	 * Disabled by default.
+	 *
+	 * @param enable true to allow reordering, false to keep the insertion order.
+	 */
+	void set_state_sorting(bool enable);
+
+	/**
+	 * Check whether the renderer may reorder renderables inside a layer.
+	 *
+	 * @return true if reordering is allowed, else false.
+	 */
+	bool get_state_sorting() const;
+
+	/**
+	 * Get the revision of the render pass. The revision changes every time
+	 * the renderables, layers or sorting settings of the pass are modified.
+	 *
+	 * Backends can use this to cache data derived from the renderables.
+	 *
+	 * @return Current revision.
+	 */
+	size_t get_revision() const;
+
 protected:
 	/**
 	 * Create a new RenderPass. This is called from Renderer::add_render_pass,
@@ -155,6 +201,16 @@ private:
 	 * Sorted from lowest to highest priority.
 	 */
 	std::vector<Layer> layers;
+
+	/**
+	 * Whether the renderer may reorder renderables inside a layer.
+	 */
+	bool state_sorting;
+
+	/**
+	 * Incremented on every modification of the renderables or layers.
+	 */
+	size_t revision;
 };
 
 } // namespace renderer
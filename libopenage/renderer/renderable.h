@@ -1,7 +1,8 @@
-// Copyright 2024-2024 the openage authors. See copying.md for legal info.
+// Copyright 2024-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 
@@ -42,6 +43,10 @@ struct Renderable {
 	bool alpha_blending = true;
 	/// Whether to perform depth testing and discard occluded fragments.
 	bool depth_test = true;
+	/// For instanced geometry, the index of the first instance that is drawn.
+	size_t instance_offset = 0;
+	/// For instanced geometry, the number of instances that are drawn.
+	size_t instance_count = 0;
 };
 
 /**
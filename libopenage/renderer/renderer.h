@@ -1,4 +1,4 @@
-// Copyright 2015-2024 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -18,6 +18,7 @@ class Texture2dData;
 class Texture2dInfo;
 class ShaderSource;
 class MeshData;
+class VertexInputInfo;
 class UniformBufferInfo;
 } // namespace resources
 
@@ -26,6 +27,7 @@ class Geometry;
 class RenderPass;
 class RenderTarget;
 class Texture2d;
+class Texture2dArray;
 class UniformBuffer;
 class UniformInput;
 
@@ -43,6 +45,10 @@ public:
 	/// Creates a new empty texture with the given parameters on the graphics hardware.
 	virtual std::shared_ptr<Texture2d> add_texture(resources::Texture2dInfo const &) = 0;
 
+	/// Uploads the given texture data to graphics hardware as the layers of a texture array.
+	/// All layers must have the same size and format.
+	virtual std::shared_ptr<Texture2dArray> add_texture_array(std::vector<resources::Texture2dData> const &) = 0;
+
 	/// Compiles the given shader source code into a shader program. A shader program is the main tool used
 	/// for graphics rendering.
 	virtual std::shared_ptr<ShaderProgram> add_shader(std::vector<resources::ShaderSource> const &) = 0;
@@ -51,6 +57,12 @@ public:
 	/// The vertex attributes will be passed to the shader as described in the mesh data.
 	virtual std::shared_ptr<Geometry> add_mesh_geometry(resources::MeshData const &) = 0;
 
+	/// Creates a Geometry object from the given mesh data that is drawn instanced. The per-instance data
+	/// is set with Geometry::update_instances and described by the given input info. The instance inputs
+	/// are passed to the shader after the vertex attributes of the mesh.
+	virtual std::shared_ptr<Geometry> add_instanced_geometry(resources::MeshData const &,
+	                                                         resources::VertexInputInfo const &) = 0;
+
 	/// Adds a Geometry object that passes a simple 4-vertex drawing command with no vertex attributes to the shader.
 	/// Useful for generating positions in the vertex shader.
 	virtual std::shared_ptr<Geometry> add_bufferless_quad() = 0;
@@ -0,0 +1,94 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+
+namespace openage::renderer::resources {
+
+class AssetManager;
+
+/**
+ * Handle for an asset that is loaded in the background by the asset manager.
+ *
+ * Until loading has finished, the handle returns the placeholder asset that
+ * was set in the asset manager when the asset was requested. Handles are cheap
+ * to copy; all copies refer to the same load.
+ *
+ * @tparam T Asset type.
+ */
+template <typename T>
+class AssetHandle {
+public:
+	/**
+	 * Create an empty handle that does not refer to any asset.
+	 */
+	AssetHandle() = default;
+	~AssetHandle() = default;
+
+	/**
+	 * Check whether loading the asset has finished, i.e. the asset and
+	 * all textures it uses are available for rendering.
+	 *
+	 * Loads that failed are also finished. The handle then keeps returning
+	 * the placeholder.
+	 *
+	 * @return true if loading has finished, else false.
+	 */
+	bool is_ready() const {
+		return this->state and this->state->ready.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * Get the asset.
+	 *
+	 * @return Loaded asset if loading has finished successfully, else the placeholder.
+	 *         Can be \p nullptr if there is no placeholder.
+	 */
+	std::shared_ptr<T> get() const {
+		if (not this->state) {
+			return nullptr;
+		}
+
+		if (this->is_ready() and this->state->asset) {
+			return this->state->asset;
+		}
+
+		return this->state->placeholder;
+	}
+
+private:
+	friend class AssetManager;
+
+	/**
+	 * Load state shared between the handles, the asset manager and the loading job.
+	 */
+	struct shared_state {
+		/// Set by the loading job when the asset description has been parsed.
+		std::atomic<bool> parsed{false};
+		/// Set by the asset manager when the asset can be used for rendering.
+		std::atomic<bool> ready{false};
+		/// Loaded asset. nullptr if loading failed.
+		std::shared_ptr<T> asset;
+		/// Asset returned while loading.
+		std::shared_ptr<T> placeholder;
+	};
+
+	/**
+	 * Create a handle for a load.
+	 *
+	 * @param state Load state.
+	 */
+	explicit AssetHandle(std::shared_ptr<shared_state> state) :
+		state{std::move(state)} {}
+
+	/**
+	 * Load state. nullptr for empty handles.
+	 */
+	std::shared_ptr<shared_state> state;
+};
+
+} // namespace openage::renderer::resources
@@ -1,12 +1,14 @@
-// Copyright 2023-2023 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "asset_manager.h"
 
 #include "error/error.h"
+#include "job/job_manager.h"
 #include "log/log.h"
 #include "log/message.h"
 
 #include "renderer/resources/animation/animation_info.h"
+#include "renderer/resources/assets/binary_cache.h"
 #include "renderer/resources/assets/cache.h"
 #include "renderer/resources/assets/texture_manager.h"
 #include "renderer/resources/palette_info.h"
@@ -25,11 +27,13 @@
 namespace openage::renderer::resources {
 
 AssetManager::AssetManager(const std::shared_ptr<Renderer> &renderer,
-                           const util::Path &asset_base_dir) :
+                           const util::Path &asset_base_dir,
+                           const std::shared_ptr<job::JobManager> &job_manager) :
 	renderer{renderer},
 	cache{std::make_shared<AssetCache>()},
-	texture_manager{std::make_shared<TextureManager>(renderer)},
-	asset_base_dir{asset_base_dir} {
+	texture_manager{std::make_shared<TextureManager>(renderer, job_manager)},
+	asset_base_dir{asset_base_dir},
+	job_manager{job_manager} {
 	log::log(INFO << "Created asset manager");
 }
 
@@ -104,7 +108,7 @@ const std::shared_ptr<PaletteInfo> &AssetManager::request_palette(const util::Pa
 	try {
 		if (not this->cache->check_palette_cache(path)) {
 			// create if not loaded
-			info = std::make_shared<PaletteInfo>(parser::parse_palette_file(path));
+			info = std::make_shared<PaletteInfo>(parser::parse_palette_file(path, this->cache));
 			this->cache->add_palette(path, info);
 		}
 	}
@@ -148,7 +152,7 @@ const std::shared_ptr<Texture2dInfo> &AssetManager::request_texture(const util::
 	try {
 		if (not this->cache->check_texture_cache(path)) {
 			// create if not loaded
-			info = std::make_shared<Texture2dInfo>(parser::parse_texture_file(path));
+			info = std::make_shared<Texture2dInfo>(parser::parse_texture_file(path, this->cache));
 			this->cache->add_texture(path, info);
 		}
 	}
@@ -169,6 +173,106 @@ const std::shared_ptr<Animation2dInfo> &AssetManager::request_animation(const st
 	return this->request_animation(this->asset_base_dir / rel_path);
 }
 
+AssetHandle<Animation2dInfo> AssetManager::request_animation_async(const util::Path &path) {
+	using state_t = AssetHandle<Animation2dInfo>::shared_state;
+
+	if (not this->job_manager) {
+		auto state = std::make_shared<state_t>();
+		state->asset = this->request_animation(path);
+		state->parsed.store(true, std::memory_order_relaxed);
+		state->ready.store(true, std::memory_order_release);
+		return AssetHandle<Animation2dInfo>{state};
+	}
+
+	std::lock_guard<std::mutex> lock{this->async_mutex};
+
+	auto handle = this->animation_handles.find(path);
+	if (handle != this->animation_handles.end()) {
+		return handle->second;
+	}
+
+	auto state = std::make_shared<state_t>();
+	if (this->placeholder_animation) {
+		state->placeholder = (*this->placeholder_animation).second;
+	}
+
+	AssetHandle<Animation2dInfo> result{state};
+	this->animation_handles.emplace(path, result);
+	this->pending_animations.push_back(result);
+
+	this->job_manager->enqueue<bool>([this, path, state]() {
+		try {
+			std::shared_ptr<Animation2dInfo> info;
+			if (this->cache->check_animation_cache(path)) {
+				info = this->cache->get_animation(path);
+			}
+			else {
+				info = std::make_shared<Animation2dInfo>(parser::parse_sprite_file(path, this->cache));
+				this->cache->add_animation(path, info);
+			}
+
+			// decode the textures in parallel jobs
+			for (size_t i = 0; i < info->get_texture_count(); ++i) {
+				auto &image_path = info->get_texture(i)->get_image_path();
+				if (image_path) {
+					this->texture_manager->prefetch(image_path.value());
+				}
+			}
+
+			state->asset = info;
+		}
+		catch (const Error &err) {
+			log::log(MSG(warn) << "Failed to load animation file from: " << path
+			                   << " - using placeholder instead: " << err.what());
+		}
+
+		state->parsed.store(true, std::memory_order_release);
+		return true;
+	});
+
+	return result;
+}
+
+AssetHandle<Animation2dInfo> AssetManager::request_animation_async(const std::string &rel_path) {
+	return this->request_animation_async(this->asset_base_dir / rel_path);
+}
+
+void AssetManager::prefetch_animations(const std::vector<std::string> &rel_paths) {
+	if (not this->job_manager) {
+		return;
+	}
+
+	for (auto &rel_path : rel_paths) {
+		this->request_animation_async(rel_path);
+	}
+}
+
+void AssetManager::update() {
+	this->texture_manager->upload_decoded();
+
+	std::lock_guard<std::mutex> lock{this->async_mutex};
+	std::erase_if(this->pending_animations, [this](const AssetHandle<Animation2dInfo> &handle) {
+		auto &state = handle.state;
+		if (not state->parsed.load(std::memory_order_acquire)) {
+			return false;
+		}
+
+		if (state->asset) {
+			for (size_t i = 0; i < state->asset->get_texture_count(); ++i) {
+				auto &image_path = state->asset->get_texture(i)->get_image_path();
+				if (image_path
+				    and not this->texture_manager->is_loaded(image_path.value())
+				    and not this->texture_manager->is_failed(image_path.value())) {
+					return false;
+				}
+			}
+		}
+
+		state->ready.store(true, std::memory_order_release);
+		return true;
+	});
+}
+
 const std::shared_ptr<BlendPatternInfo> &AssetManager::request_blpattern(const std::string &rel_path) {
 	return this->request_blpattern(this->asset_base_dir / rel_path);
 }
@@ -214,7 +318,7 @@ void AssetManager::set_placeholder_palette(const util::Path &path) {
 	this->placeholder_palette = std::make_pair(
 		path,
 		std::make_shared<PaletteInfo>(
-			parser::parse_palette_file(path)));
+			parser::parse_palette_file(path, this->cache)));
 }
 
 void AssetManager::set_placeholder_terrain(const util::Path &path) {
@@ -228,7 +332,7 @@ void AssetManager::set_placeholder_texture(const util::Path &path) {
 	this->placeholder_texture = std::make_pair(
 		path,
 		std::make_shared<Texture2dInfo>(
-			parser::parse_texture_file(path)));
+			parser::parse_texture_file(path, this->cache)));
 }
 
 const AssetManager::placeholder_anim_t &AssetManager::get_placeholder_animation() {
@@ -259,4 +363,11 @@ const std::shared_ptr<TextureManager> &AssetManager::get_texture_manager() {
 	return this->texture_manager;
 }
 
+void AssetManager::set_binary_cache(const util::Path &cache_dir) {
+	auto binary_cache = std::make_shared<BinaryAssetCache>(cache_dir);
+	this->cache->set_binary_cache(binary_cache);
+	this->texture_manager->set_binary_cache(binary_cache);
+	log::log(INFO << "Using binary asset cache in " << cache_dir);
+}
+
 } // namespace openage::renderer::resources
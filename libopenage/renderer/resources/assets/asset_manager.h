@@ -1,16 +1,25 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "renderer/resources/assets/asset_handle.h"
 #include "util/path.h"
 
 
-namespace openage::renderer {
+namespace openage {
+namespace job {
+class JobManager;
+} // namespace job
+
+namespace renderer {
 class Renderer;
 
 namespace resources {
@@ -40,9 +49,12 @@ public:
 	 *
 	 * @param renderer The openage renderer instance.
 	 * @param asset_base_dir Base path for all assets.
+	 * @param job_manager Job manager for loading assets in the background.
+	 *                    If this is \p nullptr, assets are only loaded synchronously.
 	 */
 	AssetManager(const std::shared_ptr<Renderer> &renderer,
-	             const util::Path &asset_base_dir);
+	             const util::Path &asset_base_dir,
+	             const std::shared_ptr<job::JobManager> &job_manager = nullptr);
 	~AssetManager() = default;
 
 	/**
@@ -87,6 +99,49 @@ public:
 	const std::shared_ptr<TerrainInfo> &request_terrain(const std::string &rel_path);
 	const std::shared_ptr<Texture2dInfo> &request_texture(const std::string &rel_path);
 
+	/**
+	 * Load an animation and the textures it uses in the background.
+	 *
+	 * The animation is parsed in a job of the job manager and its textures are
+	 * decoded in parallel jobs. The returned handle provides the placeholder
+	 * animation until the animation is ready for rendering. Progress is
+	 * made by calling \p update() on the render thread.
+	 *
+	 * Without a job manager, the animation is loaded synchronously and the
+	 * returned handle is ready immediately.
+	 *
+	 * @param path Path to the animation resource.
+	 *
+	 * @return Handle for the animation.
+	 */
+	AssetHandle<Animation2dInfo> request_animation_async(const util::Path &path);
+
+	/**
+	 * Load an animation in the background (see \p request_animation_async(const util::Path &)).
+	 *
+	 * @param rel_path Relative path to the animation resource (from the asset base dir).
+	 *
+	 * @return Handle for the animation.
+	 */
+	AssetHandle<Animation2dInfo> request_animation_async(const std::string &rel_path);
+
+	/**
+	 * Start loading animations in the background, e.g. for all game entities of
+	 * the loaded modpacks when a game starts.
+	 *
+	 * Does nothing if there is no job manager. Can be called from any thread.
+	 *
+	 * @param rel_paths Relative paths to the animation resources (from the asset base dir).
+	 */
+	void prefetch_animations(const std::vector<std::string> &rel_paths);
+
+	/**
+	 * Upload textures loaded in the background and mark finished loads as ready.
+	 *
+	 * Must be called once per frame on the render thread.
+	 */
+	void update();
+
 	using placeholder_anim_t = std::optional<std::pair<util::Path, std::shared_ptr<Animation2dInfo>>>;
 	using placeholder_blpattern_t = std::optional<std::pair<util::Path, std::shared_ptr<BlendPatternInfo>>>;
 	using placeholder_bltable_t = std::optional<std::pair<util::Path, std::shared_ptr<BlendTableInfo>>>;
@@ -126,6 +181,16 @@ public:
 	 */
 	const std::shared_ptr<TextureManager> &get_texture_manager();
 
+	/**
+	 * Store the raw data of parsed asset files and decoded images in a binary
+	 * cache, so that they don't have to be parsed again on the next start.
+	 *
+	 * Must be called before any assets are requested.
+	 *
+	 * @param cache_dir Directory for the cache files.
+	 */
+	void set_binary_cache(const util::Path &cache_dir);
+
 private:
 	/**
 	 * openage renderer.
@@ -159,7 +224,28 @@ private:
 	placeholder_palette_t placeholder_palette;
 	placeholder_terrain_t placeholder_terrain;
 	placeholder_texture_t placeholder_texture;
+
+	/**
+	 * Job manager for loading assets in the background.
+	 */
+	std::shared_ptr<job::JobManager> job_manager;
+
+	/**
+	 * Mutex for the handles of background loads.
+	 */
+	std::mutex async_mutex;
+
+	/**
+	 * Handles of all animations requested for background loading.
+	 */
+	std::unordered_map<util::Path, AssetHandle<Animation2dInfo>> animation_handles;
+
+	/**
+	 * Handles of animations that are not ready yet.
+	 */
+	std::vector<AssetHandle<Animation2dInfo>> pending_animations;
 };
 
 } // namespace resources
-} // namespace openage::renderer
+} // namespace renderer
+} // namespace openage
@@ -0,0 +1,220 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "binary_cache.h"
+
+#include <array>
+#include <cinttypes>
+#include <sstream>
+
+#include "util/file.h"
+#include "util/hash.h"
+#include "util/strings.h"
+
+
+namespace openage::renderer::resources {
+
+namespace {
+
+/**
+ * Identifies asset cache files. The last character is the format version.
+ *
+ * Increase the version when the raw data of any asset format changes.
+ */
+constexpr std::array<char, 8> CACHE_MAGIC{'o', 'a', 'a', 's', 's', 'e', 't', '2'};
+
+/**
+ * Fixed key for hashing the asset paths, so that they stay the same across runs.
+ */
+constexpr std::array<uint8_t, 16> HASH_KEY{
+	0x6f, 0x70, 0x65, 0x6e, 0x61, 0x67, 0x65, 0x2d, 0x61, 0x73, 0x73, 0x65, 0x74, 0x00, 0x00, 0x01};
+
+/**
+ * Get the key of an asset file, i.e. its path including the filesystem it is on.
+ */
+std::string get_key(const util::Path &path) {
+	std::ostringstream key;
+	key << path;
+	return key.str();
+}
+
+} // namespace
+
+
+void BinaryWriter::write(bool value) {
+	this->write(static_cast<uint8_t>(value));
+}
+
+void BinaryWriter::write(const std::string &value) {
+	this->write(static_cast<uint64_t>(value.size()));
+	this->buffer.append(value);
+}
+
+const std::string &BinaryWriter::get_buffer() const {
+	return this->buffer;
+}
+
+
+BinaryReader::BinaryReader(const char *data, size_t size) :
+	data{data},
+	size{size},
+	offset{0} {}
+
+void BinaryReader::read(std::string &value) {
+	size_t length = this->read_count(1);
+	value.assign(this->data + this->offset, length);
+	this->offset += length;
+}
+
+void BinaryReader::read(bool &value) {
+	uint8_t raw;
+	this->read(raw);
+	if (raw > 1) [[unlikely]] {
+		throw Error{MSG(err) << "Binary data contains an invalid boolean value: "
+		                     << static_cast<uint32_t>(raw)};
+	}
+	value = raw == 1;
+}
+
+size_t BinaryReader::read_count(size_t min_size) {
+	uint64_t count;
+	this->read(count);
+	if (min_size > 0 and count > (this->size - this->offset) / min_size) [[unlikely]] {
+		throw Error{MSG(err) << "Binary data is truncated: " << count
+		                     << " elements do not fit into the remaining "
+		                     << this->size - this->offset << " bytes"};
+	}
+	return count;
+}
+
+void BinaryReader::skip(size_t size) {
+	this->check_remaining(size);
+	this->offset += size;
+}
+
+bool BinaryReader::at_end() const {
+	return this->offset == this->size;
+}
+
+void BinaryReader::check_remaining(size_t size) const {
+	if (size > this->size - this->offset) [[unlikely]] {
+		throw Error{MSG(err) << "Binary data is truncated: tried to read "
+		                     << size << " bytes at offset " << this->offset
+		                     << ", but the data is only " << this->size << " bytes long"};
+	}
+}
+
+
+BinaryCacheEntry::BinaryCacheEntry(util::File &&file,
+                                   std::string &&buffer,
+                                   size_t offset,
+                                   size_t size) :
+	file{std::move(file)},
+	buffer{std::move(buffer)},
+	offset{offset},
+	size{size} {}
+
+std::span<const std::byte> BinaryCacheEntry::get_payload() const {
+	// resolved on every call because moving the entry may move the buffer
+	auto view = this->file.get_fileobj()->get_view();
+	if (view) {
+		return view->subspan(this->offset, this->size);
+	}
+
+	auto data = reinterpret_cast<const std::byte *>(this->buffer.data());
+	return std::span<const std::byte>{data + this->offset, this->size};
+}
+
+
+BinaryAssetCache::BinaryAssetCache(const util::Path &cache_dir) :
+	cache_dir{cache_dir},
+	tmp_count{0} {
+	if (not this->cache_dir.is_dir()) {
+		this->cache_dir.mkdirs();
+	}
+}
+
+std::optional<BinaryCacheEntry> BinaryAssetCache::load(const util::Path &path) const {
+	auto key = get_key(path);
+	auto file = this->get_cache_file(key);
+	if (not file.is_file()) {
+		return std::nullopt;
+	}
+
+	std::string buf;
+	auto cache_file = file.open_r();
+	auto view = cache_file.get_view(buf);
+	BinaryReader reader{reinterpret_cast<const char *>(view.data()), view.size()};
+
+	std::array<char, 8> magic;
+	int64_t mtime;
+	uint64_t filesize;
+	std::string file_key;
+	size_t payload_size;
+	try {
+		reader.read(magic);
+		reader.read(mtime);
+		reader.read(filesize);
+		reader.read(file_key);
+
+		// the payload stays in place, it is only decoded by the caller
+		payload_size = reader.read_count(1);
+		reader.skip(payload_size);
+	}
+	catch (const Error &) {
+		log::log(WARN << "Ignoring invalid asset cache file " << file);
+		return std::nullopt;
+	}
+
+	if (magic != CACHE_MAGIC
+	    or file_key != key
+	    or not reader.at_end()) {
+		// written by another version or for another asset with the same hash
+		return std::nullopt;
+	}
+
+	if (mtime != path.get_mtime()
+	    or filesize != path.get_filesize()) {
+		// asset file has changed
+		return std::nullopt;
+	}
+
+	size_t payload_offset = view.size() - payload_size;
+	return std::make_optional<BinaryCacheEntry>(std::move(cache_file),
+	                                            std::move(buf),
+	                                            payload_offset,
+	                                            payload_size);
+}
+
+void BinaryAssetCache::store(const util::Path &path, const std::string &payload) {
+	auto key = get_key(path);
+
+	BinaryWriter writer;
+	writer.write(CACHE_MAGIC);
+	writer.write(static_cast<int64_t>(path.get_mtime()));
+	writer.write(static_cast<uint64_t>(path.get_filesize()));
+	writer.write(key);
+	writer.write(payload);
+
+	// write to a temporary file first, so that other threads
+	// never read a partially written cache file
+	auto file = this->get_cache_file(key);
+	auto tmp_file = this->cache_dir / util::sformat("%s.%" PRIu64 ".tmp",
+	                                                file.get_name().c_str(),
+	                                                this->tmp_count.fetch_add(1));
+	auto out = tmp_file.open_w();
+	out.write(writer.get_buffer());
+	out.close();
+
+	if (not tmp_file.rename(file)) {
+		log::log(WARN << "Could not write asset cache file " << file);
+		tmp_file.unlink();
+	}
+}
+
+util::Path BinaryAssetCache::get_cache_file(const std::string &key) const {
+	util::Siphash hasher{HASH_KEY};
+	uint64_t hash = hasher.digest(reinterpret_cast<const uint8_t *>(key.data()), key.size());
+	return this->cache_dir / util::sformat("%016" PRIx64 ".oacache", hash);
+}
+
+} // namespace openage::renderer::resources
@@ -0,0 +1,391 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "error/error.h"
+#include "log/log.h"
+#include "log/message.h"
+#include "util/file.h"
+#include "util/path.h"
+
+
+namespace openage::renderer::resources {
+
+/**
+ * Writes values into a flat binary buffer.
+ *
+ * Values are stored in native byte order, so the buffer is only
+ * meant to be read on the machine that wrote it.
+ *
+ * Only scalar values are written directly. Structs must be written field by field,
+ * so that their padding bytes don't end up in the buffer.
+ */
+class BinaryWriter {
+public:
+	BinaryWriter() = default;
+	~BinaryWriter() = default;
+
+	/**
+	 * Append an arithmetic or enum value.
+	 */
+	template <typename T>
+		requires std::is_arithmetic_v<T> or std::is_enum_v<T>
+	void write(const T &value) {
+		this->buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+	}
+
+	/**
+	 * Append a boolean value (as one byte).
+	 */
+	void write(bool value);
+
+	/**
+	 * Append a fixed-size array of arithmetic values.
+	 */
+	template <typename T, size_t N>
+		requires std::is_arithmetic_v<T>
+	void write(const std::array<T, N> &values) {
+		this->buffer.append(reinterpret_cast<const char *>(values.data()), N * sizeof(T));
+	}
+
+	/**
+	 * Append a string (length-prefixed).
+	 */
+	void write(const std::string &value);
+
+	/**
+	 * Append a vector of arithmetic values (length-prefixed).
+	 */
+	template <typename T>
+		requires std::is_arithmetic_v<T>
+	void write(const std::vector<T> &values) {
+		this->write(static_cast<uint64_t>(values.size()));
+		this->buffer.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+	}
+
+	/**
+	 * Get the written data.
+	 *
+	 * @return Buffer with all written values.
+	 */
+	const std::string &get_buffer() const;
+
+private:
+	/**
+	 * Written data.
+	 */
+	std::string buffer;
+};
+
+
+/**
+ * Reads values written by a \p BinaryWriter.
+ *
+ * The reader does not copy the data, so it must outlive the reader.
+ */
+class BinaryReader {
+public:
+	/**
+	 * Create a new reader.
+	 *
+	 * @param data Start of the data.
+	 * @param size Size of the data (in bytes).
+	 */
+	BinaryReader(const char *data, size_t size);
+	~BinaryReader() = default;
+
+	/**
+	 * Read an arithmetic value.
+	 *
+	 * @throw Error if there is not enough data left.
+	 */
+	template <typename T>
+		requires std::is_arithmetic_v<T>
+	void read(T &value) {
+		this->check_remaining(sizeof(T));
+		std::memcpy(&value, this->data + this->offset, sizeof(T));
+		this->offset += sizeof(T);
+	}
+
+	/**
+	 * Read a boolean value.
+	 *
+	 * @throw Error if there is not enough data left or the value is neither true nor false.
+	 */
+	void read(bool &value);
+
+	/**
+	 * Read an enum value.
+	 *
+	 * @param value Read value.
+	 * @param last Enum value with the largest integer value. Values from 0 to \p last are valid.
+	 *
+	 * @throw Error if there is not enough data left or the value is out of range.
+	 */
+	template <typename T>
+		requires std::is_enum_v<T>
+	void read(T &value, T last) {
+		using raw_t = std::make_unsigned_t<std::underlying_type_t<T>>;
+
+		// negative values become too large
+		raw_t raw;
+		this->read(raw);
+		if (raw > static_cast<raw_t>(last)) [[unlikely]] {
+			throw Error{MSG(err) << "Binary data contains an invalid enum value: "
+			                     << static_cast<uint64_t>(raw)};
+		}
+		value = static_cast<T>(raw);
+	}
+
+	/**
+	 * Read a fixed-size array of arithmetic values.
+	 *
+	 * @throw Error if there is not enough data left.
+	 */
+	template <typename T, size_t N>
+		requires std::is_arithmetic_v<T>
+	void read(std::array<T, N> &values) {
+		this->check_remaining(N * sizeof(T));
+		std::memcpy(values.data(), this->data + this->offset, N * sizeof(T));
+		this->offset += N * sizeof(T);
+	}
+
+	/**
+	 * Read a string.
+	 *
+	 * @throw Error if there is not enough data left.
+	 */
+	void read(std::string &value);
+
+	/**
+	 * Read a vector of arithmetic values.
+	 *
+	 * @throw Error if there is not enough data left.
+	 */
+	template <typename T>
+		requires std::is_arithmetic_v<T>
+	void read(std::vector<T> &values) {
+		size_t count = this->read_count(sizeof(T));
+		values.resize(count);
+		std::memcpy(values.data(), this->data + this->offset, count * sizeof(T));
+		this->offset += count * sizeof(T);
+	}
+
+	/**
+	 * Read the number of elements of a sequence that was written as \p uint64_t.
+	 *
+	 * @param min_size Minimum size of a single element (in bytes).
+	 *
+	 * @return Number of elements.
+	 * @throw Error if the data left is too short for that many elements.
+	 */
+	size_t read_count(size_t min_size);
+
+	/**
+	 * Skip over data without reading it.
+	 *
+	 * @param size Number of bytes to skip.
+	 *
+	 * @throw Error if there is not enough data left.
+	 */
+	void skip(size_t size);
+
+	/**
+	 * Check if all data has been read.
+	 *
+	 * @return true if there is no data left, else false.
+	 */
+	bool at_end() const;
+
+private:
+	/**
+	 * Throw if less than \p size bytes are left.
+	 */
+	void check_remaining(size_t size) const;
+
+	/**
+	 * Start of the data.
+	 */
+	const char *data;
+
+	/**
+	 * Size of the data (in bytes).
+	 */
+	size_t size;
+
+	/**
+	 * Current read position.
+	 */
+	size_t offset;
+};
+
+
+/**
+ * Valid cache entry of an asset file.
+ *
+ * The entry keeps its cache file open. For memory-mapped cache files, the payload
+ * is viewed directly in the mapping, so decoding it doesn't need another copy.
+ */
+class BinaryCacheEntry {
+public:
+	/**
+	 * Create a new cache entry.
+	 *
+	 * @param file Opened cache file.
+	 * @param buffer Contents of the cache file if it is not memory-mapped.
+	 * @param offset Offset of the payload in the cache file.
+	 * @param size Size of the payload (in bytes).
+	 */
+	BinaryCacheEntry(util::File &&file,
+	                 std::string &&buffer,
+	                 size_t offset,
+	                 size_t size);
+	~BinaryCacheEntry() = default;
+
+	/**
+	 * Get the raw data stored for the asset file.
+	 *
+	 * @return View of the payload. Only valid as long as the entry exists.
+	 */
+	std::span<const std::byte> get_payload() const;
+
+private:
+	/**
+	 * Opened cache file.
+	 */
+	util::File file;
+
+	/**
+	 * Contents of the cache file if it is not memory-mapped.
+	 */
+	std::string buffer;
+
+	/**
+	 * Offset of the payload in the cache file.
+	 */
+	size_t offset;
+
+	/**
+	 * Size of the payload (in bytes).
+	 */
+	size_t size;
+};
+
+
+/**
+ * Stores the raw data of parsed asset files in a binary format, so that text
+ * files don't have to be parsed again on the next start.
+ *
+ * There is one cache file per asset file. Cache entries are keyed by the path of the
+ * asset file and are only used if the modification time and size of the asset file
+ * match the values stored with the entry.
+ *
+ * Cache files are written atomically, so the cache can be used from multiple threads.
+ */
+class BinaryAssetCache {
+public:
+	/**
+	 * Create a new binary asset cache.
+	 *
+	 * @param cache_dir Directory for the cache files. Created if it doesn't exist.
+	 */
+	BinaryAssetCache(const util::Path &cache_dir);
+	~BinaryAssetCache() = default;
+
+	/**
+	 * Get the raw data of an asset file from the cache. If there is no valid cache
+	 * entry, the file is parsed and the result is added to the cache.
+	 *
+	 * The data type must have \p write_data(BinaryWriter &, const T &) and
+	 * \p read_data(BinaryReader &, T &) overloads.
+	 *
+	 * @param path Path to the asset file.
+	 * @param parse Function that parses the asset file.
+	 *
+	 * @return Raw data of the asset file.
+	 */
+	template <typename T>
+	T get_or_parse(const util::Path &path,
+	               const std::function<T(const util::Path &)> &parse) {
+		auto entry = this->load(path);
+		if (entry) {
+			try {
+				auto payload = entry->get_payload();
+				BinaryReader reader{reinterpret_cast<const char *>(payload.data()), payload.size()};
+				T data;
+				read_data(reader, data);
+				if (reader.at_end()) {
+					return data;
+				}
+			}
+			catch (const Error &) {
+				// fall through and parse the file again
+			}
+			log::log(WARN << "Ignoring invalid asset cache entry for " << path);
+		}
+
+		T data = parse(path);
+
+		BinaryWriter writer;
+		write_data(writer, data);
+		try {
+			this->store(path, writer.get_buffer());
+		}
+		catch (const Error &err) {
+			log::log(WARN << "Could not add " << path << " to the asset cache: " << err.what());
+		}
+
+		return data;
+	}
+
+	/**
+	 * Get the raw data stored for an asset file.
+	 *
+	 * @param path Path to the asset file.
+	 *
+	 * @return Cache entry with the stored data if it is valid, else \p std::nullopt.
+	 */
+	std::optional<BinaryCacheEntry> load(const util::Path &path) const;
+
+	/**
+	 * Store the raw data for an asset file.
+	 *
+	 * @param path Path to the asset file.
+	 * @param payload Raw data of the asset file.
+	 */
+	void store(const util::Path &path, const std::string &payload);
+
+private:
+	/**
+	 * Get the cache file for an asset file.
+	 *
+	 * @param key Key of the asset file.
+	 *
+	 * @return Path to the cache file.
+	 */
+	util::Path get_cache_file(const std::string &key) const;
+
+	/**
+	 * Directory for the cache files.
+	 */
+	util::Path cache_dir;
+
+	/**
+	 * Counter for naming temporary files.
+	 */
+	std::atomic<uint64_t> tmp_count;
+};
+
+} // namespace openage::renderer::resources
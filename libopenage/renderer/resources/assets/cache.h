@@ -1,8 +1,9 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -11,6 +12,7 @@
 
 namespace openage::renderer::resources {
 class Animation2dInfo;
+class BinaryAssetCache;
 class BlendPatternInfo;
 class BlendTableInfo;
 class PaletteInfo;
@@ -23,6 +25,9 @@ class Texture2dInfo;
  *
  * Using the asset manager allows quick access to already loaded assets and avoids
  * creating unnecessary duplicates.
+ *
+ * The cache can be accessed from multiple threads, e.g. by background loading jobs.
+ * References returned by the getters stay valid until the asset is removed.
  */
 class AssetCache {
 public:
@@ -88,6 +93,21 @@ public:
 	bool check_terrain_cache(const util::Path &path);
 	bool check_texture_cache(const util::Path &path);
 
+	/**
+	 * Set the binary cache that parsers use to store the raw data of asset files.
+	 * Must be set before assets are loaded.
+	 *
+	 * @param cache Binary asset cache.
+	 */
+	void set_binary_cache(const std::shared_ptr<BinaryAssetCache> &cache);
+
+	/**
+	 * Get the binary cache that parsers use to store the raw data of asset files.
+	 *
+	 * @return Binary asset cache. Can be \p nullptr if none is set.
+	 */
+	const std::shared_ptr<BinaryAssetCache> &get_binary_cache() const;
+
 private:
 	using anim_cache_t = std::unordered_map<util::Path, std::shared_ptr<Animation2dInfo>>;
 	using blpattern_cache_t = std::unordered_map<util::Path, std::shared_ptr<BlendPatternInfo>>;
@@ -125,6 +145,16 @@ private:
 	 * Cache of already loaded textures.
 	 */
 	texture_cache_t loaded_textures;
+
+	/**
+	 * Cache for the raw data of parsed asset files.
+	 */
+	std::shared_ptr<BinaryAssetCache> binary_cache;
+
+	/**
+	 * Mutex for accessing the caches.
+	 */
+	std::mutex mutex;
 };
 
 } // namespace openage::renderer::resources
@@ -1,22 +1,28 @@
-// Copyright 2022-2023 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #include "texture_manager.h"
 
+#include "error/error.h"
+#include "job/job_manager.h"
+#include "log/log.h"
 #include "renderer/renderer.h"
 #include "renderer/resources/texture_data.h"
 
 
 namespace openage::renderer::resources {
 
-TextureManager::TextureManager(const std::shared_ptr<Renderer> &renderer) :
+TextureManager::TextureManager(const std::shared_ptr<Renderer> &renderer,
+                               const std::shared_ptr<job::JobManager> &job_manager) :
 	renderer{renderer},
-	loaded{} {
+	loaded{},
+	job_manager{job_manager},
+	running_jobs{0} {
 }
 
 const std::shared_ptr<Texture2d> &TextureManager::request(const util::Path &path) {
 	if (not this->loaded.contains(path)) {
 		// create if not loaded
-		auto tex_data = resources::Texture2dData(path);
+		auto tex_data = resources::Texture2dData(path, this->binary_cache);
 		this->loaded.insert({path, this->renderer->add_texture(tex_data)});
 	}
 	return this->loaded.at(path);
@@ -25,7 +31,7 @@ const std::shared_ptr<Texture2d> &TextureManager::request(const util::Path &path
 void TextureManager::add(const util::Path &path) {
 	if (not this->loaded.contains(path)) {
 		// create if not loaded
-		auto tex_data = resources::Texture2dData(path);
+		auto tex_data = resources::Texture2dData(path, this->binary_cache);
 		this->loaded.insert({path, this->renderer->add_texture(tex_data)});
 	}
 }
@@ -41,7 +47,7 @@ void TextureManager::remove(const util::Path &path) {
 }
 
 void TextureManager::set_placeholder(const util::Path &path) {
-	auto tex_data = resources::Texture2dData(path);
+	auto tex_data = resources::Texture2dData(path, this->binary_cache);
 	this->placeholder = std::make_pair(path, this->renderer->add_texture(tex_data));
 }
 
@@ -49,4 +55,102 @@ const TextureManager::placeholder_t &TextureManager::get_placeholder() const {
 	return this->placeholder;
 }
 
+void TextureManager::set_binary_cache(const std::shared_ptr<BinaryAssetCache> &cache) {
+	this->binary_cache = cache;
+}
+
+void TextureManager::prefetch(const util::Path &path) {
+	if (not this->job_manager) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock{this->decode_mutex};
+		if (not this->requested.insert(path).second) {
+			// already loading or loaded
+			return;
+		}
+
+		if (not this->batch_start) {
+			this->batch_start = std::chrono::steady_clock::now();
+		}
+		this->running_jobs += 1;
+	}
+
+	this->job_manager->enqueue<bool>([this, path]() {
+		std::shared_ptr<Texture2dData> data;
+		try {
+			data = std::make_shared<Texture2dData>(path, this->binary_cache);
+		}
+		catch (const Error &err) {
+			log::log(WARN << "Failed to load texture from: " << path << " - " << err.what());
+		}
+
+		std::lock_guard<std::mutex> lock{this->decode_mutex};
+		if (data) {
+			this->decoded.emplace_back(path, std::move(data));
+		}
+		else {
+			this->failed.insert(path);
+		}
+		this->running_jobs -= 1;
+
+		return data != nullptr;
+	});
+}
+
+bool TextureManager::is_loaded(const util::Path &path) const {
+	return this->loaded.contains(path);
+}
+
+bool TextureManager::is_failed(const util::Path &path) {
+	std::lock_guard<std::mutex> lock{this->decode_mutex};
+	return this->failed.contains(path);
+}
+
+size_t TextureManager::upload_decoded() {
+	std::vector<std::pair<util::Path, std::shared_ptr<Texture2dData>>> uploads;
+	{
+		std::lock_guard<std::mutex> lock{this->decode_mutex};
+		if (not this->batch_start) {
+			return 0;
+		}
+		uploads.swap(this->decoded);
+	}
+
+	for (auto &[path, data] : uploads) {
+		if (not this->loaded.contains(path)) {
+			this->loaded.insert({path, this->renderer->add_texture(*data)});
+		}
+
+		this->batch_stats.textures += 1;
+		this->batch_stats.bytes += data->get_info().get_data_size();
+	}
+
+	std::lock_guard<std::mutex> lock{this->decode_mutex};
+	if (this->running_jobs == 0 and this->decoded.empty()) {
+		// batch finished, report how fast it was loaded
+		std::chrono::duration<double> duration = std::chrono::steady_clock::now() - *this->batch_start;
+		this->batch_stats.seconds = duration.count();
+
+		log::log(INFO << "Loaded " << this->batch_stats.textures << " textures ("
+		              << this->batch_stats.bytes / 1e6 << " MB) in "
+		              << this->batch_stats.seconds << " s: "
+		              << this->batch_stats.get_throughput() << " MB/s");
+
+		this->total_stats.textures += this->batch_stats.textures;
+		this->total_stats.bytes += this->batch_stats.bytes;
+		this->total_stats.seconds += this->batch_stats.seconds;
+
+		this->batch_stats = texture_load_stats{};
+		this->batch_start = std::nullopt;
+	}
+
+	return uploads.size();
+}
+
+const texture_load_stats &TextureManager::get_load_stats() const {
+	return this->total_stats;
+}
+
 } // namespace openage::renderer::resources
@@ -1,21 +1,51 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "util/path.h"
 
 
-namespace openage::renderer {
+namespace openage {
+namespace job {
+class JobManager;
+} // namespace job
+
+namespace renderer {
 class Renderer;
 class Texture2d;
 
 namespace resources {
+class BinaryAssetCache;
+class Texture2dData;
+
+/**
+ * Throughput of background texture loading.
+ */
+struct texture_load_stats {
+	/// Number of decoded textures.
+	size_t textures = 0;
+	/// Size of the decoded pixel data (in bytes).
+	size_t bytes = 0;
+	/// Time from the start of the first decode until the upload of the
+	/// last texture of each batch (in seconds).
+	double seconds = 0.0;
+
+	/// Get the load throughput (in MB/s).
+	double get_throughput() const {
+		return this->seconds > 0.0 ? this->bytes / this->seconds / 1e6 : 0.0;
+	}
+};
 
 /**
  * Loads and stores references to shared texture assets.
@@ -29,8 +59,11 @@ public:
 	 * Create a new texture manager.
 	 *
 	 * @param renderer The openage renderer instance.
+	 * @param job_manager Job manager for decoding images in the background.
+	 *                    If this is \p nullptr, images are only loaded synchronously.
 	 */
-	TextureManager(const std::shared_ptr<Renderer> &renderer);
+	TextureManager(const std::shared_ptr<Renderer> &renderer,
+	               const std::shared_ptr<job::JobManager> &job_manager = nullptr);
 	~TextureManager() = default;
 
 	/**
@@ -93,6 +126,60 @@ public:
 	 */
 	const placeholder_t &get_placeholder() const;
 
+	/**
+	 * Store decoded images in a binary cache, so that they don't have to
+	 * be decoded again on the next start.
+	 *
+	 * Must be set before textures are loaded.
+	 *
+	 * @param cache Binary asset cache.
+	 */
+	void set_binary_cache(const std::shared_ptr<BinaryAssetCache> &cache);
+
+	/**
+	 * Decode the image at the given path in a background job. The decoded
+	 * texture is uploaded by the next call to \p upload_decoded().
+	 *
+	 * Does nothing if the image is already being loaded or if there is no job manager.
+	 * Can be called from any thread.
+	 *
+	 * @param path Path to the texture resource.
+	 */
+	void prefetch(const util::Path &path);
+
+	/**
+	 * Check whether the texture at the given path is available for rendering.
+	 *
+	 * @param path Path to the texture resource.
+	 *
+	 * @return true if the texture has been uploaded, else false.
+	 */
+	bool is_loaded(const util::Path &path) const;
+
+	/**
+	 * Check whether decoding the image at the given path in a background job failed.
+	 *
+	 * @param path Path to the texture resource.
+	 *
+	 * @return true if the image could not be loaded, else false.
+	 */
+	bool is_failed(const util::Path &path);
+
+	/**
+	 * Upload all textures that have been decoded by background jobs. Must be called
+	 * from the render thread.
+	 *
+	 * @return Number of uploaded textures.
+	 */
+	size_t upload_decoded();
+
+	/**
+	 * Get the throughput of background loading since the texture manager was created.
+	 *
+	 * @return Load statistics.
+	 */
+	const texture_load_stats &get_load_stats() const;
+
 private:
 	/**
 	 * openage renderer.
@@ -110,7 +197,58 @@ private:
 	 * Placeholder texture to use if a texture could not be loaded.
 	 */
 	placeholder_t placeholder;
+
+	/**
+	 * Cache for decoded images. Can be \p nullptr.
+	 */
+	std::shared_ptr<BinaryAssetCache> binary_cache;
+
+	/**
+	 * Job manager for decoding images in the background.
+	 */
+	std::shared_ptr<job::JobManager> job_manager;
+
+	/**
+	 * Mutex for the members shared with the background jobs.
+	 */
+	std::mutex decode_mutex;
+
+	/**
+	 * Paths of all images that have been passed to \p prefetch().
+	 */
+	std::unordered_set<util::Path> requested;
+
+	/**
+	 * Paths of images that could not be decoded.
+	 */
+	std::unordered_set<util::Path> failed;
+
+	/**
+	 * Images that have been decoded, but not uploaded yet.
+	 */
+	std::vector<std::pair<util::Path, std::shared_ptr<Texture2dData>>> decoded;
+
+	/**
+	 * Number of decode jobs that have not finished yet.
+	 */
+	size_t running_jobs;
+
+	/**
+	 * Start of the current batch of background loads.
+	 */
+	std::optional<std::chrono::steady_clock::time_point> batch_start;
+
+	/**
+	 * Statistics of the current batch of background loads.
+	 */
+	texture_load_stats batch_stats;
+
+	/**
+	 * Statistics of all background loads.
+	 */
+	texture_load_stats total_stats;
 };
 
 } // namespace resources
-} // namespace openage::renderer
+} // namespace renderer
+} // namespace openage
@@ -0,0 +1,124 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "atlas_packer.h"
+
+#include <algorithm>
+#include <limits>
+
+
+namespace openage::renderer::resources {
+
+SkylinePacker::SkylinePacker(uint32_t width, uint32_t height) :
+	width{static_cast<int32_t>(width)},
+	height{static_cast<int32_t>(height)},
+	used_area{0},
+	skyline{skyline_segment{0, 0, static_cast<int32_t>(width)}} {}
+
+std::optional<Eigen::Vector2i> SkylinePacker::insert(uint32_t width, uint32_t height) {
+	if (width == 0 or height == 0) {
+		return Eigen::Vector2i{0, 0};
+	}
+
+	auto w = static_cast<int32_t>(width);
+	auto h = static_cast<int32_t>(height);
+
+	// find the position where the bottom edge of the rectangle is the lowest,
+	// prefer narrow segments on ties to leave wide gaps for wide rectangles
+	std::optional<size_t> best_index;
+	int32_t best_bottom = std::numeric_limits<int32_t>::max();
+	int32_t best_width = std::numeric_limits<int32_t>::max();
+	int32_t best_y = 0;
+	for (size_t i = 0; i < this->skyline.size(); ++i) {
+		auto y = this->fits(i, w, h);
+		if (not y) {
+			continue;
+		}
+
+		int32_t bottom = *y + h;
+		if (bottom < best_bottom
+		    or (bottom == best_bottom and this->skyline[i].width < best_width)) {
+			best_index = i;
+			best_bottom = bottom;
+			best_width = this->skyline[i].width;
+			best_y = *y;
+		}
+	}
+
+	if (not best_index) {
+		return std::nullopt;
+	}
+
+	int32_t x = this->skyline[*best_index].x;
+	this->add_segment(*best_index, x, best_bottom, w);
+	this->used_area += static_cast<size_t>(width) * height;
+
+	return Eigen::Vector2i{x, best_y};
+}
+
+uint32_t SkylinePacker::get_width() const {
+	return this->width;
+}
+
+uint32_t SkylinePacker::get_height() const {
+	return this->height;
+}
+
+size_t SkylinePacker::get_used_area() const {
+	return this->used_area;
+}
+
+std::optional<int32_t> SkylinePacker::fits(size_t index, int32_t width, int32_t height) const {
+	int32_t x = this->skyline[index].x;
+	if (x + width > this->width) {
+		return std::nullopt;
+	}
+
+	// the rectangle rests on the highest segment below it
+	int32_t y = 0;
+	int32_t width_left = width;
+	for (size_t i = index; width_left > 0; ++i) {
+		y = std::max(y, this->skyline[i].y);
+		if (y + height > this->height) {
+			return std::nullopt;
+		}
+		width_left -= this->skyline[i].width;
+	}
+
+	return y;
+}
+
+void SkylinePacker::add_segment(size_t index, int32_t x, int32_t y, int32_t width) {
+	this->skyline.insert(this->skyline.begin() + index, skyline_segment{x, y, width});
+
+	// shrink or remove the segments covered by the new segment
+	for (size_t i = index + 1; i < this->skyline.size();) {
+		auto &prev = this->skyline[i - 1];
+		auto &current = this->skyline[i];
+
+		int32_t overlap = prev.x + prev.width - current.x;
+		if (overlap <= 0) {
+			break;
+		}
+
+		current.x += overlap;
+		current.width -= overlap;
+		if (current.width > 0) {
+			break;
+		}
+
+		this->skyline.erase(this->skyline.begin() + i);
+	}
+
+	// merge neighbouring segments of the same height
+	for (size_t i = 1; i < this->skyline.size();) {
+		if (this->skyline[i - 1].y == this->skyline[i].y) {
+			this->skyline[i - 1].width += this->skyline[i].width;
+			this->skyline.erase(this->skyline.begin() + i);
+		}
+		else {
+			++i;
+		}
+	}
+}
+
+} // namespace openage::renderer::resources
@@ -0,0 +1,129 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <eigen3/Eigen/Dense>
+
+
+namespace openage::renderer::resources {
+
+/**
+ * Packs rectangles into a fixed size area using the skyline bottom-left heuristic.
+ *
+ * The packer keeps track of the top edge ("skyline") of the rectangles placed so
+ * far. New rectangles are placed at the position where their bottom edge is lowest,
+ * i.e. closest to the origin. Space below the skyline is never reused, which keeps
+ * insertion cheap while wasting little space when rectangles are inserted sorted by
+ * descending height.
+ *
+ * Coordinates have their origin in the top left corner of the area.
+ */
+class SkylinePacker {
+public:
+	/**
+	 * Create a new packer for an empty area.
+	 *
+	 * @param width Width of the area (in pixels).
+	 * @param height Height of the area (in pixels).
+	 */
+	SkylinePacker(uint32_t width, uint32_t height);
+
+	~SkylinePacker() = default;
+
+	/**
+	 * Place a rectangle in the area.
+	 *
+	 * @param width Width of the rectangle (in pixels).
+	 * @param height Height of the rectangle (in pixels).
+	 *
+	 * @return Position of the top left corner of the rectangle: (x, y).
+	 *         Empty if the rectangle does not fit into the remaining space.
+	 */
+	std::optional<Eigen::Vector2i> insert(uint32_t width, uint32_t height);
+
+	/**
+	 * Get the width of the area.
+	 *
+	 * @return Width (in pixels).
+	 */
+	uint32_t get_width() const;
+
+	/**
+	 * Get the height of the area.
+	 *
+	 * @return Height (in pixels).
+	 */
+	uint32_t get_height() const;
+
+	/**
+	 * Get the area covered by the placed rectangles.
+	 *
+	 * @return Area (in pixels).
+	 */
+	size_t get_used_area() const;
+
+private:
+	/**
+	 * Horizontal segment of the skyline.
+	 */
+	struct skyline_segment {
+		/// Left edge of the segment.
+		int32_t x;
+		/// Height of the skyline over the segment.
+		int32_t y;
+		/// Width of the segment.
+		int32_t width;
+	};
+
+	/**
+	 * Check whether a rectangle fits if its left edge is placed at the start
+	 * of the given skyline segment.
+	 *
+	 * @param index Index of the skyline segment.
+	 * @param width Width of the rectangle.
+	 * @param height Height of the rectangle.
+	 *
+	 * @return y coordinate of the top edge of the placed rectangle, or empty if
+	 *         the rectangle does not fit.
+	 */
+	std::optional<int32_t> fits(size_t index, int32_t width, int32_t height) const;
+
+	/**
+	 * Raise the skyline over a newly placed rectangle.
+	 *
+	 * @param index Index of the skyline segment where the rectangle starts.
+	 * @param x x coordinate of the rectangle.
+	 * @param y y coordinate of the bottom edge of the rectangle.
+	 * @param width Width of the rectangle.
+	 */
+	void add_segment(size_t index, int32_t x, int32_t y, int32_t width);
+
+	/**
+	 * Width of the area.
+	 */
+	int32_t width;
+
+	/**
+	 * Height of the area.
+	 */
+	int32_t height;
+
+	/**
+	 * Area covered by placed rectangles.
+	 */
+	size_t used_area;
+
+	/**
+	 * Segments of the skyline, sorted by x coordinate.
+	 *
+	 * The segments always cover the full width of the area.
+	 */
+	std::vector<skyline_segment> skyline;
+};
+
+} // namespace openage::renderer::resources
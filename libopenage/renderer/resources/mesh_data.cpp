@@ -1,4 +1,4 @@
-// Copyright 2017-2024 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
 #include "mesh_data.h"
 
@@ -19,13 +19,17 @@ static constexpr auto vin_size = datastructure::create_const_map<vertex_input_t,
 	std::make_pair(vertex_input_t::F32, 4),
 	std::make_pair(vertex_input_t::V2F32, 8),
 	std::make_pair(vertex_input_t::V3F32, 12),
-	std::make_pair(vertex_input_t::M3F32, 36));
+	std::make_pair(vertex_input_t::V4F32, 16),
+	std::make_pair(vertex_input_t::M3F32, 36),
+	std::make_pair(vertex_input_t::U32, 4));
 
 static constexpr auto vin_count = datastructure::create_const_map<vertex_input_t, size_t>(
 	std::make_pair(vertex_input_t::F32, 1),
 	std::make_pair(vertex_input_t::V2F32, 2),
 	std::make_pair(vertex_input_t::V3F32, 3),
-	std::make_pair(vertex_input_t::M3F32, 9));
+	std::make_pair(vertex_input_t::V4F32, 4),
+	std::make_pair(vertex_input_t::M3F32, 9),
+	std::make_pair(vertex_input_t::U32, 1));
 
 size_t vertex_input_size(vertex_input_t in) {
 	return vin_size.get(in);
@@ -101,6 +105,10 @@ std::vector<uint8_t> const &MeshData::get_data() const {
 	return this->data;
 }
 
+std::vector<uint8_t> &MeshData::get_data() {
+	return this->data;
+}
+
 std::optional<std::vector<uint8_t>> const &MeshData::get_ids() const {
 	return this->ids;
 }
@@ -1,4 +1,4 @@
-// Copyright 2017-2024 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -21,7 +21,10 @@ enum class vertex_input_t {
 	F32,
 	V2F32,
 	V3F32,
+	V4F32,
 	M3F32,
+	/// Unsigned integer, passed to the shader without conversion to float.
+	U32,
 };
 
 /// The primitive type that the vertices in a mesh combine into.
@@ -127,6 +130,9 @@ public:
 	/// Returns the raw vertex data.
 	std::vector<uint8_t> const &get_data() const;
 
+	/// Returns the raw vertex data for modification in place. The size of the data must not be changed.
+	std::vector<uint8_t> &get_data();
+
 	/// Returns the indices used for indexed drawing if they exist.
 	std::optional<std::vector<uint8_t>> const &get_ids() const;
 
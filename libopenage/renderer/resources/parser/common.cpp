@@ -1,4 +1,4 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "common.h"
 
@@ -29,4 +29,20 @@ float parse_scalefactor(const std::vector<std::string> &args) {
 	return std::stof(args[1]);
 }
 
+void write_data(BinaryWriter &writer, const std::vector<TextureData> &textures) {
+	writer.write(static_cast<uint64_t>(textures.size()));
+	for (const auto &texture : textures) {
+		writer.write(texture.texture_id);
+		writer.write(texture.path);
+	}
+}
+
+void read_data(BinaryReader &reader, std::vector<TextureData> &textures) {
+	textures.resize(reader.read_count(sizeof(size_t) + sizeof(uint64_t)));
+	for (auto &texture : textures) {
+		reader.read(texture.texture_id);
+		reader.read(texture.path);
+	}
+}
+
 } // namespace openage::renderer::resources::parser
@@ -1,11 +1,16 @@
-// Copyright 2023-2023 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <cstddef>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "renderer/resources/assets/binary_cache.h"
+#include "renderer/resources/assets/cache.h"
+
 /**
  * This file contains subparsers for arguments that work the
  * same across all formats.
@@ -63,4 +68,30 @@ TextureData parse_texture(const std::vector<std::string> &args);
  */
 float parse_scalefactor(const std::vector<std::string> &args);
 
+/**
+ * Serialization of raw data for the binary asset cache.
+ */
+void write_data(BinaryWriter &writer, const std::vector<TextureData> &textures);
+void read_data(BinaryReader &reader, std::vector<TextureData> &textures);
+
+/**
+ * Get the raw data of an asset file. If the asset cache has a binary cache,
+ * the data is loaded from there instead of parsing the file again.
+ *
+ * @param path Path to the asset file.
+ * @param cache Cache of already loaded assets (optional).
+ * @param read_file Function that parses the asset file.
+ *
+ * @return Raw data of the asset file.
+ */
+template <typename T>
+T read_file_data(const util::Path &path,
+                 const std::shared_ptr<AssetCache> &cache,
+                 const std::function<T(const util::Path &)> &read_file) {
+	if (cache and cache->get_binary_cache()) {
+		return cache->get_binary_cache()->get_or_parse<T>(path, read_file);
+	}
+	return read_file(path);
+}
+
 } // namespace openage::renderer::resources::parser
@@ -1,4 +1,4 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "parse_blendmask.h"
 
@@ -58,20 +58,11 @@ blending_mask parse_mask(const std::vector<std::string> &args) {
 	return mask;
 }
 
-BlendPatternInfo parse_blendmask_file(const util::Path &path,
-                                      const std::shared_ptr<AssetCache> &cache) {
-	if (not path.is_file()) [[unlikely]] {
-		throw Error(MSG(err) << "Reading .blmask file '"
-		                     << path.get_name()
-		                     << "' failed. Reason: File not found");
-	}
-
+BlendMaskFileData read_blendmask_file(const util::Path &path) {
 	auto file = path.open();
 	auto lines = file.get_lines();
 
-	float scalefactor = 1.0;
-	std::vector<TextureData> textures;
-	std::vector<blending_mask> masks;
+	BlendMaskFileData data;
 
 	auto keywordfuncs = std::unordered_map<std::string, std::function<void(const std::vector<std::string> &)>>{
 		std::make_pair("version", [&](const std::vector<std::string> &args) {
@@ -85,13 +76,13 @@ BlendPatternInfo parse_blendmask_file(const util::Path &path,
 			}
 		}),
 		std::make_pair("texture", [&](const std::vector<std::string> &args) {
-			textures.push_back(parse_texture(args));
+			data.textures.push_back(parse_texture(args));
 		}),
 		std::make_pair("scalefactor", [&](const std::vector<std::string> &args) {
-			scalefactor = parse_scalefactor(args);
+			data.scalefactor = parse_scalefactor(args);
 		}),
 		std::make_pair("mask", [&](const std::vector<std::string> &args) {
-			masks.push_back(parse_mask(args));
+			data.masks.push_back(parse_mask(args));
 		})};
 
 	for (auto line : lines) {
@@ -112,6 +103,44 @@ BlendPatternInfo parse_blendmask_file(const util::Path &path,
 		keywordfuncs[args[0]](args);
 	}
 
+	return data;
+}
+
+void write_data(BinaryWriter &writer, const BlendMaskFileData &data) {
+	writer.write(data.scalefactor);
+	write_data(writer, data.textures);
+	writer.write(static_cast<uint64_t>(data.masks.size()));
+	for (const auto &mask : data.masks) {
+		writer.write(mask.directions);
+		writer.write(mask.texture_id);
+		writer.write(mask.subtex_id);
+	}
+}
+
+void read_data(BinaryReader &reader, BlendMaskFileData &data) {
+	reader.read(data.scalefactor);
+	read_data(reader, data.textures);
+	data.masks.resize(reader.read_count(sizeof(char) + sizeof(size_t) * 2));
+	for (auto &mask : data.masks) {
+		reader.read(mask.directions);
+		reader.read(mask.texture_id);
+		reader.read(mask.subtex_id);
+	}
+}
+
+BlendPatternInfo parse_blendmask_file(const util::Path &path,
+                                      const std::shared_ptr<AssetCache> &cache) {
+	if (not path.is_file()) [[unlikely]] {
+		throw Error(MSG(err) << "Reading .blmask file '"
+		                     << path.get_name()
+		                     << "' failed. Reason: File not found");
+	}
+
+	auto data = read_file_data<BlendMaskFileData>(path, cache, read_blendmask_file);
+	float scalefactor = data.scalefactor;
+	auto &textures = data.textures;
+	auto &masks = data.masks;
+
 	// Order masks by directions value
 	std::sort(masks.begin(),
 	          masks.end(),
@@ -136,7 +165,7 @@ BlendPatternInfo parse_blendmask_file(const util::Path &path,
 		}
 		else {
 			// load (and cache if possible)
-			auto info = std::make_shared<Texture2dInfo>(parse_texture_file(texturepath));
+			auto info = std::make_shared<Texture2dInfo>(parse_texture_file(texturepath, cache));
 			texture_infos.push_back(info);
 			if (cache) {
 				cache->add_texture(texturepath, info);
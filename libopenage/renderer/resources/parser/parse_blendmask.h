@@ -1,9 +1,11 @@
-// Copyright 2023-2023 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <memory>
+#include <vector>
 
+#include "renderer/resources/parser/common.h"
 #include "renderer/resources/terrain/blendpattern_info.h"
 
 
@@ -14,9 +16,35 @@ class Path;
 
 namespace renderer::resources {
 class AssetCache;
+class BinaryReader;
+class BinaryWriter;
 
 namespace parser {
 
+/**
+ * Raw data of a .blmask format file.
+ */
+struct BlendMaskFileData {
+	float scalefactor{1.0};
+	std::vector<TextureData> textures;
+	std::vector<blending_mask> masks;
+};
+
+/**
+ * Read the raw data from a .blmask format file.
+ *
+ * @param file Path to the blendmask file.
+ *
+ * @return Raw data of the file.
+ */
+BlendMaskFileData read_blendmask_file(const util::Path &file);
+
+/**
+ * Serialization of the raw data for the binary asset cache.
+ */
+void write_data(BinaryWriter &writer, const BlendMaskFileData &data);
+void read_data(BinaryReader &reader, BlendMaskFileData &data);
+
 /**
  * Parse an blending table definition from a .blmask format file.
  *
@@ -1,4 +1,4 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "parse_blendtable.h"
 
@@ -67,19 +67,11 @@ PatternData parse_pattern(const std::vector<std::string> &args) {
 	return pattern;
 }
 
-BlendTableInfo parse_blendtable_file(const util::Path &path,
-                                     const std::shared_ptr<AssetCache> &cache) {
-	if (not path.is_file()) [[unlikely]] {
-		throw Error(MSG(err) << "Reading .bltable file '"
-		                     << path.get_name()
-		                     << "' failed. Reason: File not found");
-	}
-
+BlendTableFileData read_blendtable_file(const util::Path &path) {
 	auto file = path.open();
 	auto lines = file.get_lines();
 
-	std::vector<size_t> blendtable;
-	std::vector<PatternData> patterns;
+	BlendTableFileData data;
 
 	auto keywordfuncs = std::unordered_map<std::string, std::function<void(const std::vector<std::string> &)>>{
 		std::make_pair("version", [&](const std::vector<std::string> &args) {
@@ -93,10 +85,10 @@ BlendTableInfo parse_blendtable_file(const util::Path &path,
 			}
 		}),
 		std::make_pair("blendtable", [&](const std::vector<std::string> &args) {
-			blendtable = parse_table(args);
+			data.blendtable = parse_table(args);
 		}),
 		std::make_pair("pattern", [&](const std::vector<std::string> &args) {
-			patterns.push_back(parse_pattern(args));
+			data.patterns.push_back(parse_pattern(args));
 		})};
 
 	for (size_t i = 0; i < lines.size(); ++i) {
@@ -140,8 +132,39 @@ BlendTableInfo parse_blendtable_file(const util::Path &path,
 		}
 	}
 
+	return data;
+}
+
+void write_data(BinaryWriter &writer, const BlendTableFileData &data) {
+	writer.write(data.blendtable);
+	writer.write(static_cast<uint64_t>(data.patterns.size()));
+	for (const auto &pattern : data.patterns) {
+		writer.write(pattern.pattern_id);
+		writer.write(pattern.path);
+	}
+}
+
+void read_data(BinaryReader &reader, BlendTableFileData &data) {
+	reader.read(data.blendtable);
+	data.patterns.resize(reader.read_count(sizeof(size_t) + sizeof(uint64_t)));
+	for (auto &pattern : data.patterns) {
+		reader.read(pattern.pattern_id);
+		reader.read(pattern.path);
+	}
+}
+
+BlendTableInfo parse_blendtable_file(const util::Path &path,
+                                     const std::shared_ptr<AssetCache> &cache) {
+	if (not path.is_file()) [[unlikely]] {
+		throw Error(MSG(err) << "Reading .bltable file '"
+		                     << path.get_name()
+		                     << "' failed. Reason: File not found");
+	}
+
+	auto data = read_file_data<BlendTableFileData>(path, cache, read_blendtable_file);
+
 	std::vector<std::shared_ptr<BlendPatternInfo>> pattern_infos;
-	for (auto pattern : patterns) {
+	for (auto pattern : data.patterns) {
 		util::Path maskpath = (path.get_parent() / pattern.path);
 
 		if (cache && cache->check_blpattern_cache(maskpath)) {
@@ -150,7 +173,7 @@ BlendTableInfo parse_blendtable_file(const util::Path &path,
 		}
 		else {
 			// load (and cache if possible)
-			auto info = std::make_shared<BlendPatternInfo>(parse_blendmask_file(maskpath));
+			auto info = std::make_shared<BlendPatternInfo>(parse_blendmask_file(maskpath, cache));
 			pattern_infos.push_back(info);
 			if (cache) {
 				cache->add_blpattern(maskpath, info);
@@ -158,7 +181,7 @@ BlendTableInfo parse_blendtable_file(const util::Path &path,
 		}
 	}
 
-	return BlendTableInfo(blendtable, pattern_infos);
+	return BlendTableInfo(data.blendtable, pattern_infos);
 }
 
 } // namespace openage::renderer::resources::parser
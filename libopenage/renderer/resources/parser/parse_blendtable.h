@@ -1,10 +1,11 @@
-// Copyright 2023-2023 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "renderer/resources/terrain/blendtable_info.h"
 
@@ -15,6 +16,8 @@ class Path;
 
 namespace renderer::resources {
 class AssetCache;
+class BinaryReader;
+class BinaryWriter;
 
 namespace parser {
 
@@ -28,6 +31,29 @@ struct PatternData {
 	std::string path;
 };
 
+/**
+ * Raw data of a .bltable format file.
+ */
+struct BlendTableFileData {
+	std::vector<size_t> blendtable;
+	std::vector<PatternData> patterns;
+};
+
+/**
+ * Read the raw data from a .bltable format file.
+ *
+ * @param file Path to the blendtable file.
+ *
+ * @return Raw data of the file.
+ */
+BlendTableFileData read_blendtable_file(const util::Path &file);
+
+/**
+ * Serialization of the raw data for the binary asset cache.
+ */
+void write_data(BinaryWriter &writer, const BlendTableFileData &data);
+void read_data(BinaryReader &reader, BlendTableFileData &data);
+
 /**
  * Parse an blending table definition from a .bltable format file.
  *
@@ -1,4 +1,4 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "parse_palette.h"
 
@@ -63,18 +63,11 @@ std::vector<uint8_t> parse_colours(const std::vector<std::string> &lines) {
 	return entries;
 }
 
-PaletteInfo parse_palette_file(const util::Path &path) {
-	if (not path.is_file()) [[unlikely]] {
-		throw Error(MSG(err) << "Reading .opal file '"
-		                     << path.get_name()
-		                     << "' failed. Reason: File not found");
-	}
-
+PaletteFileData read_palette_file(const util::Path &path) {
 	auto file = path.open();
 	auto lines = file.get_lines();
 
-	size_t entries = 0;
-	std::vector<uint8_t> colours;
+	PaletteFileData data;
 
 	auto keywordfuncs = std::unordered_map<std::string, std::function<void(const std::vector<std::string> &)>>{
 		std::make_pair("version", [&](const std::vector<std::string> &args) {
@@ -88,10 +81,10 @@ PaletteInfo parse_palette_file(const util::Path &path) {
 			}
 		}),
 		std::make_pair("entries", [&](const std::vector<std::string> &args) {
-			entries = parse_entries(args);
+			data.entries = parse_entries(args);
 		}),
 		std::make_pair("colours", [&](const std::vector<std::string> &args) {
-			colours = parse_colours(args);
+			data.colours = parse_colours(args);
 		})};
 
 	for (size_t i = 0; i < lines.size(); ++i) {
@@ -135,7 +128,30 @@ PaletteInfo parse_palette_file(const util::Path &path) {
 		}
 	}
 
-	return PaletteInfo(colours);
+	return data;
+}
+
+void write_data(BinaryWriter &writer, const PaletteFileData &data) {
+	writer.write(data.entries);
+	writer.write(data.colours);
+}
+
+void read_data(BinaryReader &reader, PaletteFileData &data) {
+	reader.read(data.entries);
+	reader.read(data.colours);
+}
+
+PaletteInfo parse_palette_file(const util::Path &path,
+                               const std::shared_ptr<AssetCache> &cache) {
+	if (not path.is_file()) [[unlikely]] {
+		throw Error(MSG(err) << "Reading .opal file '"
+		                     << path.get_name()
+		                     << "' failed. Reason: File not found");
+	}
+
+	auto data = read_file_data<PaletteFileData>(path, cache, read_palette_file);
+
+	return PaletteInfo(data.colours);
 }
 
 } // namespace openage::renderer::resources::parser
@@ -1,7 +1,12 @@
-// Copyright 2023-2023 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "renderer/resources/palette_info.h"
 
 namespace openage {
@@ -9,16 +14,48 @@ namespace util {
 class Path;
 }
 
-namespace renderer::resources::parser {
+namespace renderer::resources {
+class AssetCache;
+class BinaryReader;
+class BinaryWriter;
+
+namespace parser {
+
+/**
+ * Raw data of a .opal format file.
+ */
+struct PaletteFileData {
+	size_t entries{0};
+	std::vector<uint8_t> colours;
+};
+
+/**
+ * Read the raw data from a .opal format file.
+ *
+ * @param file Path to the palette file.
+ *
+ * @return Raw data of the file.
+ */
+PaletteFileData read_palette_file(const util::Path &file);
+
+/**
+ * Serialization of the raw data for the binary asset cache.
+ */
+void write_data(BinaryWriter &writer, const PaletteFileData &data);
+void read_data(BinaryReader &reader, PaletteFileData &data);
 
 /**
  * Parse an palette definition from a .opal format file.
  *
  * @param file Path to the palette file.
+ * @param cache Cache of already loaded assets (optional). Only its binary
+ *              cache is used to avoid parsing the file again.
  *
  * @return The corresponding palette definition.
  */
-PaletteInfo parse_palette_file(const util::Path &file);
+PaletteInfo parse_palette_file(const util::Path &file,
+                               const std::shared_ptr<AssetCache> &cache = nullptr);
 
-} // namespace renderer::resources::parser
+} // namespace parser
+} // namespace renderer::resources
 } // namespace openage
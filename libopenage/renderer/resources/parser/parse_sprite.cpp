@@ -1,4 +1,4 @@
-// Copyright 2021-2024 the openage authors. See copying.md for legal info.
+// Copyright 2021-2025 the openage authors. See copying.md for legal info.
 
 #include "parse_sprite.h"
 
@@ -134,27 +134,11 @@ FrameData parse_frame(const std::vector<std::string> &args) {
 	return frame;
 }
 
-Animation2dInfo parse_sprite_file(const util::Path &path,
-                                  const std::shared_ptr<AssetCache> &cache) {
-	if (not path.is_file()) [[unlikely]] {
-		throw Error(MSG(err) << "Reading .sprite file '"
-		                     << path.get_name()
-		                     << "' failed. Reason: File not found");
-	}
-
+SpriteFileData read_sprite_file(const util::Path &path) {
 	auto file = path.open();
 	auto lines = file.get_lines();
 
-	float scalefactor = 1.0;
-	std::vector<TextureData> textures;
-	std::vector<LayerData> layers;
-	std::vector<AngleData> angles;
-
-	// largest frame index = total length of animation
-	size_t largest_frame_idx = 0;
-
-	// Map frame data to angle
-	std::unordered_map<size_t, std::vector<FrameData>> frames;
+	SpriteFileData data;
 
 	auto keywordfuncs = std::unordered_map<std::string, std::function<void(const std::vector<std::string> &)>>{
 		std::make_pair("version", [&](const std::vector<std::string> &args) {
@@ -168,30 +152,19 @@ Animation2dInfo parse_sprite_file(const util::Path &path,
 			}
 		}),
 		std::make_pair("texture", [&](const std::vector<std::string> &args) {
-			textures.push_back(parse_texture(args));
+			data.textures.push_back(parse_texture(args));
 		}),
 		std::make_pair("scalefactor", [&](const std::vector<std::string> &args) {
-			scalefactor = parse_scalefactor(args);
+			data.scalefactor = parse_scalefactor(args);
 		}),
 		std::make_pair("layer", [&](const std::vector<std::string> &args) {
-			layers.push_back(parse_layer(args));
+			data.layers.push_back(parse_layer(args));
 		}),
 		std::make_pair("angle", [&](const std::vector<std::string> &args) {
-			angles.push_back(parse_angle(args));
+			data.angles.push_back(parse_angle(args));
 		}),
 		std::make_pair("frame", [&](const std::vector<std::string> &args) {
-			auto frame = parse_frame(args);
-			if (frames.count(frame.angle) == 0) {
-				std::vector<FrameData> angle_frames{};
-				frames.emplace(std::make_pair(frame.angle, angle_frames));
-			}
-			frames.at(frame.angle).push_back(frame);
-
-			// check for the largest index, so we can use it to
-		    // interpolate the total animation length
-			if (frame.index > largest_frame_idx) {
-				largest_frame_idx = frame.index;
-			}
+			data.frames.push_back(parse_frame(args));
 		})};
 
 	for (auto line : lines) {
@@ -212,6 +185,96 @@ Animation2dInfo parse_sprite_file(const util::Path &path,
 		keywordfuncs[args[0]](args);
 	}
 
+	return data;
+}
+
+void write_data(BinaryWriter &writer, const SpriteFileData &data) {
+	writer.write(data.scalefactor);
+	write_data(writer, data.textures);
+
+	writer.write(static_cast<uint64_t>(data.layers.size()));
+	for (const auto &layer : data.layers) {
+		writer.write(layer.layer_id);
+		writer.write(layer.mode);
+		writer.write(layer.position);
+		writer.write(layer.time_per_frame);
+		writer.write(layer.replay_delay);
+	}
+
+	writer.write(static_cast<uint64_t>(data.angles.size()));
+	for (const auto &angle : data.angles) {
+		writer.write(angle.degree);
+		writer.write(angle.mirror_from);
+	}
+
+	writer.write(static_cast<uint64_t>(data.frames.size()));
+	for (const auto &frame : data.frames) {
+		writer.write(frame.index);
+		writer.write(frame.angle);
+		writer.write(frame.layer_id);
+		writer.write(frame.texture_id);
+		writer.write(frame.subtex_id);
+	}
+}
+
+void read_data(BinaryReader &reader, SpriteFileData &data) {
+	reader.read(data.scalefactor);
+	read_data(reader, data.textures);
+
+	data.layers.resize(reader.read_count(sizeof(size_t) * 2 + sizeof(display_mode) + sizeof(float) * 2));
+	for (auto &layer : data.layers) {
+		reader.read(layer.layer_id);
+		reader.read(layer.mode, display_mode::LOOP);
+		reader.read(layer.position);
+		reader.read(layer.time_per_frame);
+		reader.read(layer.replay_delay);
+	}
+
+	data.angles.resize(reader.read_count(sizeof(size_t) + sizeof(int)));
+	for (auto &angle : data.angles) {
+		reader.read(angle.degree);
+		reader.read(angle.mirror_from);
+	}
+
+	data.frames.resize(reader.read_count(sizeof(size_t) * 5));
+	for (auto &frame : data.frames) {
+		reader.read(frame.index);
+		reader.read(frame.angle);
+		reader.read(frame.layer_id);
+		reader.read(frame.texture_id);
+		reader.read(frame.subtex_id);
+	}
+}
+
+Animation2dInfo parse_sprite_file(const util::Path &path,
+                                  const std::shared_ptr<AssetCache> &cache) {
+	if (not path.is_file()) [[unlikely]] {
+		throw Error(MSG(err) << "Reading .sprite file '"
+		                     << path.get_name()
+		                     << "' failed. Reason: File not found");
+	}
+
+	auto data = read_file_data<SpriteFileData>(path, cache, read_sprite_file);
+	float scalefactor = data.scalefactor;
+	auto &textures = data.textures;
+	auto &layers = data.layers;
+	auto &angles = data.angles;
+
+	// largest frame index = total length of animation
+	size_t largest_frame_idx = 0;
+
+	// Map frame data to angle
+	std::unordered_map<size_t, std::vector<FrameData>> frames;
+	for (auto &frame : data.frames) {
+		frames[frame.angle].push_back(frame);
+
+		// check for the largest index, so we can use it to
+		// interpolate the total animation length
+		if (frame.index > largest_frame_idx) {
+			largest_frame_idx = frame.index;
+		}
+	}
+
 	// Order frames by index
 	for (auto angle_frames : frames) {
 		std::sort(angle_frames.second.begin(),
@@ -325,7 +388,7 @@ Animation2dInfo parse_sprite_file(const util::Path &path,
 		}
 		else {
 			// load (and cache if possible)
-			auto info = std::make_shared<Texture2dInfo>(parse_texture_file(texturepath));
+			auto info = std::make_shared<Texture2dInfo>(parse_texture_file(texturepath, cache));
 			texture_infos.push_back(info);
 			if (cache) {
 				cache->add_texture(texturepath, info);
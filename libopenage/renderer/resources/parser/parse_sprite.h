@@ -1,12 +1,14 @@
-// Copyright 2021-2024 the openage authors. See copying.md for legal info.
+// Copyright 2021-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <cstddef>
 #include <memory>
+#include <vector>
 
 #include "renderer/resources/animation/animation_info.h"
 #include "renderer/resources/animation/layer_info.h"
+#include "renderer/resources/parser/common.h"
 
 
 namespace openage {
@@ -16,6 +18,8 @@ class Path;
 
 namespace renderer::resources {
 class AssetCache;
+class BinaryReader;
+class BinaryWriter;
 
 namespace parser {
 
@@ -45,6 +49,32 @@ struct FrameData {
 	size_t subtex_id;
 };
 
+/**
+ * Raw data of a .sprite format file.
+ */
+struct SpriteFileData {
+	float scalefactor{1.0};
+	std::vector<TextureData> textures;
+	std::vector<LayerData> layers;
+	std::vector<AngleData> angles;
+	std::vector<FrameData> frames;
+};
+
+/**
+ * Read the raw data from a .sprite format file.
+ *
+ * @param file Path to the sprite file.
+ *
+ * @return Raw data of the file.
+ */
+SpriteFileData read_sprite_file(const util::Path &file);
+
+/**
+ * Serialization of the raw data for the binary asset cache.
+ */
+void write_data(BinaryWriter &writer, const SpriteFileData &data);
+void read_data(BinaryReader &reader, SpriteFileData &data);
+
 /**
  * Parse an Animation2d definition from a .sprite format file.
  *
@@ -1,4 +1,4 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "parse_terrain.h"
 
@@ -139,27 +139,11 @@ TerrainFrameData parse_terrain_frame(const std::vector<std::string> &args) {
 	return frame;
 }
 
-TerrainInfo parse_terrain_file(const util::Path &path,
-                               const std::shared_ptr<AssetCache> &cache) {
-	if (not path.is_file()) [[unlikely]] {
-		throw Error(MSG(err) << "Reading .terrain file '"
-		                     << path.get_name()
-		                     << "' failed. Reason: File not found");
-	}
-
+TerrainFileData read_terrain_file(const util::Path &path) {
 	auto file = path.open();
 	auto lines = file.get_lines();
 
-	float scalefactor = 1.0;
-	std::vector<TextureData> textures;
-	std::optional<BlendtableData> blendtable;
-	std::vector<TerrainLayerData> layers;
-
-	// largest frame index = total length of animation
-	size_t largest_frame_idx = 0;
-
-	// Map frame data to layer
-	std::unordered_map<size_t, std::vector<TerrainFrameData>> frames;
+	TerrainFileData data;
 
 	auto keywordfuncs = std::unordered_map<std::string, std::function<void(const std::vector<std::string> &)>>{
 		std::make_pair("version", [&](const std::vector<std::string> &args) {
@@ -173,30 +157,19 @@ TerrainInfo parse_terrain_file(const util::Path &path,
 			}
 		}),
 		std::make_pair("texture", [&](const std::vector<std::string> &args) {
-			textures.push_back(parse_texture(args));
+			data.textures.push_back(parse_texture(args));
 		}),
 		std::make_pair("blendtable", [&](const std::vector<std::string> &args) {
-			blendtable = parse_blendtable(args);
+			data.blendtable = parse_blendtable(args);
 		}),
 		std::make_pair("scalefactor", [&](const std::vector<std::string> &args) {
-			scalefactor = parse_scalefactor(args);
+			data.scalefactor = parse_scalefactor(args);
 		}),
 		std::make_pair("layer", [&](const std::vector<std::string> &args) {
-			layers.push_back(parse_terrain_layer(args));
+			data.layers.push_back(parse_terrain_layer(args));
 		}),
 		std::make_pair("frame", [&](const std::vector<std::string> &args) {
-			auto frame = parse_terrain_frame(args);
-			if (frames.count(frame.layer_id) == 0) {
-				std::vector<TerrainFrameData> layer_frames{};
-				frames.emplace(std::make_pair(frame.layer_id, layer_frames));
-			}
-			frames.at(frame.layer_id).push_back(frame);
-
-			// check for the largest index, so we can use it to
-		    // interpolate the total animation length
-			if (frame.index > largest_frame_idx) {
-				largest_frame_idx = frame.index;
-			}
+			data.frames.push_back(parse_terrain_frame(args));
 		})};
 
 	for (auto line : lines) {
@@ -217,6 +190,111 @@ TerrainInfo parse_terrain_file(const util::Path &path,
 		keywordfuncs[args[0]](args);
 	}
 
+	return data;
+}
+
+void write_data(BinaryWriter &writer, const TerrainFileData &data) {
+	writer.write(data.scalefactor);
+	write_data(writer, data.textures);
+	writer.write(data.blendtable.has_value());
+	if (data.blendtable) {
+		writer.write(data.blendtable->table_id);
+		writer.write(data.blendtable->path);
+	}
+
+	writer.write(static_cast<uint64_t>(data.layers.size()));
+	for (const auto &layer : data.layers) {
+		writer.write(layer.layer_id);
+		writer.write(layer.mode);
+		writer.write(layer.position);
+		writer.write(layer.time_per_frame);
+		writer.write(layer.replay_delay);
+	}
+
+	writer.write(static_cast<uint64_t>(data.frames.size()));
+	for (const auto &frame : data.frames) {
+		writer.write(frame.index);
+		writer.write(frame.layer_id);
+		writer.write(frame.texture_id);
+		writer.write(frame.subtex_id);
+		writer.write(frame.priority);
+		writer.write(frame.blend_mode.has_value());
+		if (frame.blend_mode) {
+			writer.write(*frame.blend_mode);
+		}
+	}
+}
+
+void read_data(BinaryReader &reader, TerrainFileData &data) {
+	reader.read(data.scalefactor);
+	read_data(reader, data.textures);
+	bool has_blendtable;
+	reader.read(has_blendtable);
+	if (has_blendtable) {
+		BlendtableData blendtable;
+		reader.read(blendtable.table_id);
+		reader.read(blendtable.path);
+		data.blendtable = blendtable;
+	}
+
+	data.layers.resize(reader.read_count(sizeof(size_t) * 2 + sizeof(terrain_display_mode) + sizeof(float) * 2));
+	for (auto &layer : data.layers) {
+		reader.read(layer.layer_id);
+		reader.read(layer.mode, terrain_display_mode::LOOP);
+		reader.read(layer.position);
+		reader.read(layer.time_per_frame);
+		reader.read(layer.replay_delay);
+	}
+
+	data.frames.resize(reader.read_count(sizeof(size_t) * 5 + sizeof(uint8_t)));
+	for (auto &frame : data.frames) {
+		reader.read(frame.index);
+		reader.read(frame.layer_id);
+		reader.read(frame.texture_id);
+		reader.read(frame.subtex_id);
+		reader.read(frame.priority);
+		bool has_blend_mode;
+		reader.read(has_blend_mode);
+		if (has_blend_mode) {
+			size_t blend_mode;
+			reader.read(blend_mode);
+			frame.blend_mode = blend_mode;
+		}
+		else {
+			frame.blend_mode = std::nullopt;
+		}
+	}
+}
+
+TerrainInfo parse_terrain_file(const util::Path &path,
+                               const std::shared_ptr<AssetCache> &cache) {
+	if (not path.is_file()) [[unlikely]] {
+		throw Error(MSG(err) << "Reading .terrain file '"
+		                     << path.get_name()
+		                     << "' failed. Reason: File not found");
+	}
+
+	auto data = read_file_data<TerrainFileData>(path, cache, read_terrain_file);
+	float scalefactor = data.scalefactor;
+	auto &textures = data.textures;
+	auto &blendtable = data.blendtable;
+	auto &layers = data.layers;
+
+	// largest frame index = total length of animation
+	size_t largest_frame_idx = 0;
+
+	// Map frame data to layer
+	std::unordered_map<size_t, std::vector<TerrainFrameData>> frames;
+	for (auto &frame : data.frames) {
+		frames[frame.layer_id].push_back(frame);
+
+		// check for the largest index, so we can use it to
+		// interpolate the total animation length
+		if (frame.index > largest_frame_idx) {
+			largest_frame_idx = frame.index;
+		}
+	}
+
 	// Order frames by index
 	for (auto angle_frames : frames) {
 		std::sort(angle_frames.second.begin(),
@@ -277,7 +355,7 @@ TerrainInfo parse_terrain_file(const util::Path &path,
 		}
 		else {
 			// load (and cache if possible)
-			auto info = std::make_shared<Texture2dInfo>(parse_texture_file(texturepath));
+			auto info = std::make_shared<Texture2dInfo>(parse_texture_file(texturepath, cache));
 			texture_infos.push_back(info);
 			if (cache) {
 				cache->add_texture(texturepath, info);
@@ -295,7 +373,7 @@ TerrainInfo parse_terrain_file(const util::Path &path,
 		}
 		else {
 			// load (and cache if possible)
-			blendtable_info = std::make_shared<BlendTableInfo>(parse_blendtable_file(tablepath));
+			blendtable_info = std::make_shared<BlendTableInfo>(parse_blendtable_file(tablepath, cache));
 			if (cache) {
 				cache->add_bltable(tablepath, blendtable_info);
 			}
@@ -1,4 +1,4 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -6,8 +6,10 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "renderer/resources/terrain/layer_info.h"
+#include "renderer/resources/parser/common.h"
 #include "renderer/resources/terrain/terrain_info.h"
 
 
@@ -18,6 +20,8 @@ class Path;
 
 namespace renderer::resources {
 class AssetCache;
+class BinaryReader;
+class BinaryWriter;
 
 namespace parser {
 
@@ -48,6 +52,32 @@ struct TerrainFrameData {
 	std::optional<size_t> blend_mode;
 };
 
+/**
+ * Raw data of a .terrain format file.
+ */
+struct TerrainFileData {
+	float scalefactor{1.0};
+	std::vector<TextureData> textures;
+	std::optional<BlendtableData> blendtable;
+	std::vector<TerrainLayerData> layers;
+	std::vector<TerrainFrameData> frames;
+};
+
+/**
+ * Read the raw data from a .terrain format file.
+ *
+ * @param file Path to the terrain file.
+ *
+ * @return Raw data of the file.
+ */
+TerrainFileData read_terrain_file(const util::Path &file);
+
+/**
+ * Serialization of the raw data for the binary asset cache.
+ */
+void write_data(BinaryWriter &writer, const TerrainFileData &data);
+void read_data(BinaryReader &reader, TerrainFileData &data);
+
 /**
  * Parse an Terrain definition from a .terrain format file.
  *
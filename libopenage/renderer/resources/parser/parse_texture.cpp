@@ -1,4 +1,4 @@
-// Copyright 2021-2024 the openage authors. See copying.md for legal info.
+// Copyright 2021-2025 the openage authors. See copying.md for legal info.
 
 #include "parse_texture.h"
 
@@ -139,20 +139,11 @@ SubtextureData parse_subtex(const std::vector<std::string> &args) {
 	return subtex;
 }
 
-Texture2dInfo parse_texture_file(const util::Path &path) {
-	if (not path.is_file()) [[unlikely]] {
-		throw Error(MSG(err) << "Reading .texture file '"
-		                     << path.get_name()
-		                     << "' failed. Reason: File not found");
-	}
-
+TextureFileData read_texture_file(const util::Path &path) {
 	auto file = path.open();
 	auto lines = file.get_lines();
 
-	std::string imagefile;
-	SizeData size;
-	PixelFormatData pxformat;
-	std::vector<SubtextureData> subtexs;
+	TextureFileData data;
 
 	auto keywordfuncs = std::unordered_map<std::string, std::function<void(const std::vector<std::string> &)>>{
 		std::make_pair("version", [&](const std::vector<std::string> &args) {
@@ -166,16 +157,16 @@ Texture2dInfo parse_texture_file(const util::Path &path) {
 			}
 		}),
 		std::make_pair("imagefile", [&](const std::vector<std::string> &args) {
-			imagefile = parse_imagefile(args);
+			data.imagefile = parse_imagefile(args);
 		}),
 		std::make_pair("size", [&](const std::vector<std::string> &args) {
-			size = parse_size(args);
+			data.size = parse_size(args);
 		}),
 		std::make_pair("pxformat", [&](const std::vector<std::string> &args) {
-			pxformat = parse_pxformat(args);
+			data.pxformat = parse_pxformat(args);
 		}),
 		std::make_pair("subtex", [&](const std::vector<std::string> &args) {
-			subtexs.push_back(parse_subtex(args));
+			data.subtexs.push_back(parse_subtex(args));
 		})};
 
 	for (auto line : lines) {
@@ -195,9 +186,57 @@ Texture2dInfo parse_texture_file(const util::Path &path) {
 		keywordfuncs[args[0]](args);
 	}
 
+	return data;
+}
+
+void write_data(BinaryWriter &writer, const TextureFileData &data) {
+	writer.write(data.imagefile);
+	writer.write(data.size.width);
+	writer.write(data.size.height);
+	writer.write(data.pxformat.format);
+	writer.write(data.pxformat.cbits);
+	writer.write(static_cast<uint64_t>(data.subtexs.size()));
+	for (const auto &subtex : data.subtexs) {
+		writer.write(subtex.xpos);
+		writer.write(subtex.ypos);
+		writer.write(subtex.xsize);
+		writer.write(subtex.ysize);
+		writer.write(subtex.xanchor);
+		writer.write(subtex.yanchor);
+	}
+}
+
+void read_data(BinaryReader &reader, TextureFileData &data) {
+	reader.read(data.imagefile);
+	reader.read(data.size.width);
+	reader.read(data.size.height);
+	reader.read(data.pxformat.format, pixel_format::rgba8ui);
+	reader.read(data.pxformat.cbits);
+	data.subtexs.resize(reader.read_count(sizeof(size_t) * 4 + sizeof(int) * 2));
+	for (auto &subtex : data.subtexs) {
+		reader.read(subtex.xpos);
+		reader.read(subtex.ypos);
+		reader.read(subtex.xsize);
+		reader.read(subtex.ysize);
+		reader.read(subtex.xanchor);
+		reader.read(subtex.yanchor);
+	}
+}
+
+Texture2dInfo parse_texture_file(const util::Path &path,
+                                 const std::shared_ptr<AssetCache> &cache) {
+	if (not path.is_file()) [[unlikely]] {
+		throw Error(MSG(err) << "Reading .texture file '"
+		                     << path.get_name()
+		                     << "' failed. Reason: File not found");
+	}
+
+	auto data = read_file_data<TextureFileData>(path, cache, read_texture_file);
+	auto &size = data.size;
+
 	std::vector<Texture2dSubInfo> subinfos;
 
-	for (auto subtex : subtexs) {
+	for (auto subtex : data.subtexs) {
 		subinfos.emplace_back(subtex.xpos,
 		                      subtex.ypos,
 		                      subtex.xsize,
@@ -208,10 +247,10 @@ Texture2dInfo parse_texture_file(const util::Path &path) {
 		                      size.height);
 	}
 
-	auto imagepath = path.get_parent() / imagefile;
+	auto imagepath = path.get_parent() / data.imagefile;
 
 	auto align = guess_row_alignment(size.width);
-	return Texture2dInfo(size.width, size.height, pxformat.format, imagepath, align, std::move(subinfos));
+	return Texture2dInfo(size.width, size.height, data.pxformat.format, imagepath, align, std::move(subinfos));
 }
 
 } // namespace openage::renderer::resources::parser
@@ -1,8 +1,11 @@
-// Copyright 2021-2023 the openage authors. See copying.md for legal info.
+// Copyright 2021-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "renderer/resources/texture_info.h"
 
@@ -12,7 +15,12 @@ namespace util {
 class Path;
 }
 
-namespace renderer::resources::parser {
+namespace renderer::resources {
+class AssetCache;
+class BinaryReader;
+class BinaryWriter;
+
+namespace parser {
 
 /**
  * Containers for the raw data.
@@ -38,14 +46,43 @@ struct SubtextureData {
 	int yanchor;
 };
 
+/**
+ * Raw data of a .texture format file.
+ */
+struct TextureFileData {
+	std::string imagefile;
+	SizeData size;
+	PixelFormatData pxformat;
+	std::vector<SubtextureData> subtexs;
+};
+
+/**
+ * Read the raw data from a .texture format file.
+ *
+ * @param file Path to the texture file.
+ *
+ * @return Raw data of the file.
+ */
+TextureFileData read_texture_file(const util::Path &file);
+
+/**
+ * Serialization of the raw data for the binary asset cache.
+ */
+void write_data(BinaryWriter &writer, const TextureFileData &data);
+void read_data(BinaryReader &reader, TextureFileData &data);
+
 /**
  * Parse a texture definition from a .texture format file.
  *
  * @param file Path to the texture file.
+ * @param cache Cache of already loaded assets (optional). Only its binary
+ *              cache is used to avoid parsing the file again.
  *
  * @return The corresponding texture definition.
  */
-Texture2dInfo parse_texture_file(const util::Path &file);
+Texture2dInfo parse_texture_file(const util::Path &file,
+                                 const std::shared_ptr<AssetCache> &cache = nullptr);
 
-} // namespace renderer::resources::parser
+} // namespace parser
+} // namespace renderer::resources
 } // namespace openage
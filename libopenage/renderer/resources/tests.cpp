@@ -0,0 +1,296 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "config.h"
+#include "renderer/resources/animation/angle_info.h"
+#include "renderer/resources/animation/animation_info.h"
+#include "renderer/resources/animation/frame_info.h"
+#include "renderer/resources/animation/layer_info.h"
+#include "renderer/resources/assets/binary_cache.h"
+#include "renderer/resources/assets/cache.h"
+#include "renderer/resources/parser/parse_sprite.h"
+#include "renderer/resources/parser/parse_texture.h"
+#include "renderer/resources/texture_data.h"
+#include "renderer/resources/texture_info.h"
+#include "renderer/resources/texture_subinfo.h"
+#include "testing/testing.h"
+#include "util/file.h"
+#include "util/fslike/directory.h"
+#include "util/path.h"
+
+#if WITH_TEXTURE_ATLAS
+	#include "renderer/resources/atlas_packer.h"
+	#include "renderer/resources/texture_atlas.h"
+#endif
+
+
+namespace openage::renderer::resources::tests {
+
+namespace {
+
+#if WITH_TEXTURE_ATLAS
+/**
+ * Create a single channel sprite sheet where every pixel stores the value
+ * of its subtexture. Subtextures are placed next to each other in one row.
+ */
+Texture2dData make_sheet(const std::vector<std::pair<uint32_t, uint32_t>> &sizes, uint16_t first_value) {
+	uint32_t width = 0;
+	uint32_t height = 0;
+	for (auto [w, h] : sizes) {
+		width += w;
+		height = std::max(height, h);
+	}
+
+	std::vector<Texture2dSubInfo> subs;
+	std::vector<uint8_t> data(width * height * sizeof(uint16_t));
+	uint32_t x = 0;
+	for (size_t i = 0; i < sizes.size(); ++i) {
+		auto [w, h] = sizes[i];
+		uint16_t value = first_value + i;
+		for (uint32_t row = 0; row < h; ++row) {
+			for (uint32_t col = 0; col < w; ++col) {
+				size_t offset = (row * width + x + col) * sizeof(uint16_t);
+				std::memcpy(data.data() + offset, &value, sizeof(uint16_t));
+			}
+		}
+		subs.emplace_back(x, 0, w, h, w / 2, h / 2, width, height);
+		x += w;
+	}
+
+	Texture2dInfo info{width, height, pixel_format::r16ui, std::nullopt, 2, std::move(subs)};
+	return Texture2dData{info, std::move(data)};
+}
+
+uint16_t layer_pixel(const Texture2dData &layer, int32_t x, int32_t y) {
+	uint16_t value;
+	size_t offset = y * layer.get_info().get_row_size() + x * sizeof(uint16_t);
+	std::memcpy(&value, layer.get_data() + offset, sizeof(uint16_t));
+	return value;
+}
+#endif
+
+void write_file(const util::Path &path, const std::string &content) {
+	auto file = path.open_w();
+	file.write(content);
+	file.close();
+}
+
+} // namespace
+
+
+void texture_atlas() {
+#if WITH_TEXTURE_ATLAS
+	// the skyline packer fills the area without overlaps
+	SkylinePacker packer{8, 8};
+	packer.insert(4, 4) == Eigen::Vector2i(0, 0) or TESTFAIL;
+	packer.insert(4, 2) == Eigen::Vector2i(4, 0) or TESTFAIL;
+	packer.insert(4, 2) == Eigen::Vector2i(4, 2) or TESTFAIL;
+	packer.insert(8, 4) == Eigen::Vector2i(0, 4) or TESTFAIL;
+	packer.get_used_area() == 64 or TESTFAIL;
+	(not packer.insert(1, 1)) or TESTFAIL;
+
+	// two sheets that don't fit into one layer
+	TextureAtlasBuilder builder{16, 16, 1};
+	builder.add(make_sheet({{10, 10}, {5, 5}}, 1)) == 0 or TESTFAIL;
+	builder.add(make_sheet({{12, 6}}, 3)) == 1 or TESTFAIL;
+
+	auto hash = builder.content_hash();
+	auto atlas = builder.build();
+
+	atlas.get_texture_count() == 2 or TESTFAIL;
+	atlas.get_layers().size() == 2 or TESTFAIL;
+
+	uint16_t value = 1;
+	for (size_t tex = 0; tex < atlas.get_texture_count(); ++tex) {
+		const auto &info = atlas.get_texture_info(tex);
+		(info.get_size() == std::make_pair(16, 16)) or TESTFAIL;
+
+		for (size_t sub_idx = 0; sub_idx < info.get_subtex_count(); ++sub_idx, ++value) {
+			const auto &sub = info.get_subtex_info(sub_idx);
+			const auto &layer = atlas.get_layers()[atlas.get_layer(tex, sub_idx)];
+
+			// anchors stay relative to the subtexture
+			(sub.get_anchor_pos() == Eigen::Vector2i(sub.get_size().x() / 2, sub.get_size().y() / 2)) or TESTFAIL;
+
+			// the rewritten coordinates point to the copied pixels
+			auto pos = sub.get_pos();
+			auto size = sub.get_size();
+			layer_pixel(layer, pos.x(), pos.y()) == value or TESTFAIL;
+			layer_pixel(layer, pos.x() + size.x() - 1, pos.y() + size.y() - 1) == value or TESTFAIL;
+		}
+	}
+
+	// the hash only depends on the content
+	TextureAtlasBuilder same{16, 16, 1};
+	same.add(make_sheet({{10, 10}, {5, 5}}, 1));
+	same.add(make_sheet({{12, 6}}, 3));
+	same.content_hash() == hash or TESTFAIL;
+
+	TextureAtlasBuilder changed{16, 16, 1};
+	changed.add(make_sheet({{10, 10}, {5, 5}}, 1));
+	changed.add(make_sheet({{12, 6}}, 4));
+	changed.content_hash() != hash or TESTFAIL;
+
+	// packed placements are cached
+	auto temp_dir = std::make_shared<util::fslike::Directory>(util::fslike::Directory::get_temp_directory());
+	util::Path root{temp_dir, {}};
+	auto cache_dir = root / "atlas";
+
+	TextureAtlasBuilder cached{16, 16, 1};
+	cached.add(make_sheet({{10, 10}, {5, 5}}, 1));
+	cached.add(make_sheet({{12, 6}}, 3));
+	cached.build(cache_dir).get_layers().size() == 2 or TESTFAIL;
+
+	auto cache_files = cache_dir.iterdir();
+	cache_files.size() == 1 or TESTFAIL;
+
+	// placements in layers that don't exist are rejected and packed again
+	std::string content = cache_files[0].open_r().read();
+	size_t first_layer = 8 + sizeof(uint64_t) * 2 + sizeof(uint32_t);
+	content.size() > first_layer + sizeof(uint32_t) or TESTFAIL;
+	std::memset(content.data() + first_layer, 0xff, sizeof(uint32_t));
+	write_file(cache_files[0], content);
+
+	TextureAtlasBuilder corrupted{16, 16, 1};
+	corrupted.add(make_sheet({{10, 10}, {5, 5}}, 1));
+	corrupted.add(make_sheet({{12, 6}}, 3));
+	auto repacked = corrupted.build(cache_dir);
+	repacked.get_layers().size() == 2 or TESTFAIL;
+
+	const auto &repacked_sub = repacked.get_texture_info(0).get_subtex_info(0);
+	const auto &repacked_layer = repacked.get_layers()[repacked.get_layer(0, 0)];
+	layer_pixel(repacked_layer, repacked_sub.get_pos().x(), repacked_sub.get_pos().y()) == 1 or TESTFAIL;
+
+	root.removerecursive();
+#endif
+}
+
+void binary_cache() {
+	auto temp_dir = std::make_shared<util::fslike::Directory>(util::fslike::Directory::get_temp_directory());
+	util::Path root{temp_dir, {}};
+
+	auto texture_path = root / "test.texture";
+	auto sprite_path = root / "test.sprite";
+	write_file(texture_path,
+	           "version 1\n"
+	           "imagefile \"test.png\"\n"
+	           "size 64 32\n"
+	           "pxformat rgba8 cbits=True\n"
+	           "subtex 0 0 32 32 16 16\n"
+	           "subtex 32 0 32 32 10 20\n");
+	write_file(sprite_path,
+	           "version 2\n"
+	           "texture 0 \"test.texture\"\n"
+	           "scalefactor 2.0\n"
+	           "layer 0 mode=loop time_per_frame=0.5\n"
+	           "angle 0\n"
+	           "angle 180 mirror_from=0\n"
+	           "frame 0 0 0 0 0\n"
+	           "frame 1 0 0 0 1\n");
+
+	auto cache = std::make_shared<AssetCache>();
+	cache->set_binary_cache(std::make_shared<BinaryAssetCache>(root / "cache"));
+	auto &binary_cache = cache->get_binary_cache();
+
+	// the first parse adds the raw data to the cache
+	(not binary_cache->load(sprite_path)) or TESTFAIL;
+	auto parsed = parser::parse_sprite_file(sprite_path);
+	parser::parse_sprite_file(sprite_path, cache);
+	binary_cache->load(sprite_path) or TESTFAIL;
+	binary_cache->load(texture_path) or TESTFAIL;
+
+	// parsing from the cache gives the same result
+	// use an empty asset cache, so that the texture is loaded again too
+	auto fresh_cache = std::make_shared<AssetCache>();
+	fresh_cache->set_binary_cache(binary_cache);
+	auto cached = parser::parse_sprite_file(sprite_path, fresh_cache);
+
+	cached.get_scalefactor() == parsed.get_scalefactor() or TESTFAIL;
+	cached.get_layer_count() == 1 or TESTFAIL;
+
+	auto &layer = cached.get_layer(0);
+	layer.get_display_mode() == display_mode::LOOP or TESTFAIL;
+	layer.get_time_per_frame() == 0.5f or TESTFAIL;
+	layer.get_angle_count() == 2 or TESTFAIL;
+	layer.get_angle(0)->get_frame_count() == 2 or TESTFAIL;
+	layer.get_angle(0)->get_frame(1)->get_subtexture_idx() == 1 or TESTFAIL;
+	layer.get_angle(1)->is_mirrored() or TESTFAIL;
+
+	auto &texture = cached.get_texture(0);
+	(texture->get_size() == std::make_pair(64, 32)) or TESTFAIL;
+	texture->get_subtex_count() == 2 or TESTFAIL;
+	(texture->get_subtex_info(1).get_anchor_pos() == Eigen::Vector2i(10, 20)) or TESTFAIL;
+	(texture->get_image_path() == root / "test.png") or TESTFAIL;
+
+	// entries of changed files are not used
+	write_file(texture_path,
+	           "version 1\n"
+	           "imagefile \"test.png\"\n"
+	           "size 64 32\n"
+	           "pxformat rgba8 cbits=True\n"
+	           "subtex 0 0 32 32 16 16\n");
+	(not binary_cache->load(texture_path)) or TESTFAIL;
+	parser::parse_texture_file(texture_path, cache).get_subtex_count() == 1 or TESTFAIL;
+
+	// enum and boolean values are range checked
+	BinaryWriter writer;
+	writer.write(display_mode::LOOP);
+	writer.write(static_cast<int>(display_mode::LOOP) + 1);
+	writer.write(uint8_t{2});
+	const auto &buffer = writer.get_buffer();
+	BinaryReader reader{buffer.data(), buffer.size()};
+
+	display_mode mode;
+	reader.read(mode, display_mode::LOOP);
+	mode == display_mode::LOOP or TESTFAIL;
+	TESTTHROWS(reader.read(mode, display_mode::LOOP));
+	bool flag;
+	TESTTHROWS(reader.read(flag));
+
+	root.removerecursive();
+}
+
+void texture_data() {
+	auto temp_dir = std::make_shared<util::fslike::Directory>(util::fslike::Directory::get_temp_directory());
+	util::Path root{temp_dir, {}};
+	auto image_path = root / "test.png";
+
+	// opaque 3x2 image with a different value in every channel
+	Texture2dInfo info{3, 2, pixel_format::rgba8};
+	std::vector<uint8_t> pixels(info.get_data_size());
+	for (size_t i = 0; i < pixels.size(); ++i) {
+		pixels[i] = (i % 4 == 3) ? 255 : i * 7;
+	}
+	Texture2dData{info, std::vector<uint8_t>{pixels}}.store(image_path);
+
+	Texture2dData loaded{image_path};
+	loaded.get_info().get_size() == std::make_pair(3, 2) or TESTFAIL;
+	loaded.get_info().get_format() == pixel_format::rgba8 or TESTFAIL;
+	std::memcmp(loaded.get_data(), pixels.data(), pixels.size()) == 0 or TESTFAIL;
+
+	// decode into padded rgb8 rows, the second time from the cache
+	Texture2dInfo rgb_info{3, 2, pixel_format::rgb8, image_path, 4};
+	auto cache = std::make_shared<BinaryAssetCache>(root / "cache");
+	for (size_t i = 0; i < 2; ++i) {
+		Texture2dData rgb{rgb_info, cache};
+		for (size_t y = 0; y < 2; ++y) {
+			for (size_t x = 0; x < 3; ++x) {
+				for (size_t c = 0; c < 3; ++c) {
+					rgb.get_data()[y * 12 + x * 3 + c] == pixels[y * 12 + x * 4 + c] or TESTFAIL;
+				}
+			}
+		}
+		cache->load(image_path).has_value() or TESTFAIL;
+	}
+
+	root.removerecursive();
+}
+
+} // namespace openage::renderer::resources::tests
@@ -0,0 +1,416 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "texture_atlas.h"
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstring>
+#include <string>
+
+#include "error/error.h"
+#include "job/job_manager.h"
+#include "log/log.h"
+#include "renderer/resources/atlas_packer.h"
+#include "renderer/resources/texture_subinfo.h"
+#include "util/file.h"
+#include "util/hash.h"
+#include "util/strings.h"
+
+
+namespace openage::renderer::resources {
+
+namespace {
+
+/**
+ * Identifies atlas cache files. The last character is the format version.
+ */
+constexpr std::array<char, 8> CACHE_MAGIC{'o', 'a', 'a', 't', 'l', 'a', 's', '2'};
+
+/**
+ * Fixed key for content hashes, so that they stay the same across runs.
+ */
+constexpr std::array<uint8_t, 16> HASH_KEY{
+	0x6f, 0x70, 0x65, 0x6e, 0x61, 0x67, 0x65, 0x2d, 0x61, 0x74, 0x6c, 0x61, 0x73, 0x00, 0x00, 0x01};
+
+/**
+ * Row alignment of the atlas layers.
+ */
+constexpr size_t LAYER_ROW_ALIGNMENT = 4;
+
+template <typename T>
+void write_value(std::string &buf, const T &value) {
+	buf.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+bool read_value(const std::string &buf, size_t &offset, T &value) {
+	if (offset + sizeof(T) > buf.size()) {
+		return false;
+	}
+	std::memcpy(&value, buf.data() + offset, sizeof(T));
+	offset += sizeof(T);
+	return true;
+}
+
+} // namespace
+
+
+TextureAtlas::TextureAtlas(std::vector<Texture2dData> &&layers,
+                           std::vector<Texture2dInfo> &&textures,
+                           std::vector<std::vector<size_t>> &&subtex_layers) :
+	layers{std::move(layers)},
+	textures{std::move(textures)},
+	subtex_layers{std::move(subtex_layers)} {}
+
+const std::vector<Texture2dData> &TextureAtlas::get_layers() const {
+	return this->layers;
+}
+
+size_t TextureAtlas::get_texture_count() const {
+	return this->textures.size();
+}
+
+const Texture2dInfo &TextureAtlas::get_texture_info(size_t texture_idx) const {
+	return this->textures.at(texture_idx);
+}
+
+size_t TextureAtlas::get_layer(size_t texture_idx, size_t subtex_idx) const {
+	return this->subtex_layers.at(texture_idx).at(subtex_idx);
+}
+
+
+TextureAtlasBuilder::TextureAtlasBuilder(uint32_t layer_width,
+                                         uint32_t layer_height,
+                                         uint32_t padding) :
+	layer_width{layer_width},
+	layer_height{layer_height},
+	padding{padding},
+	infos{},
+	textures{} {}
+
+size_t TextureAtlasBuilder::add(const Texture2dInfo &info) {
+	if (not info.get_image_path()) {
+		throw Error{MSG(err) << "Texture added to atlas has no image path."};
+	}
+
+	if (not this->infos.empty()
+	    and this->infos.front().get_format() != info.get_format()) {
+		throw Error{MSG(err) << "Texture " << info.get_image_path().value()
+		                     << " has a different pixel format than the other textures in the atlas."};
+	}
+
+	this->infos.push_back(info);
+	this->textures.emplace_back(std::nullopt);
+
+	return this->infos.size() - 1;
+}
+
+size_t TextureAtlasBuilder::add(Texture2dData &&data) {
+	if (not this->infos.empty()
+	    and this->infos.front().get_format() != data.get_info().get_format()) {
+		throw Error{MSG(err) << "Texture has a different pixel format than the other textures in the atlas."};
+	}
+
+	this->infos.push_back(data.get_info());
+	this->textures.emplace_back(std::move(data));
+
+	return this->infos.size() - 1;
+}
+
+TextureAtlas TextureAtlasBuilder::build(const std::optional<util::Path> &cache_dir) {
+	this->load_textures();
+
+	if (not cache_dir) {
+		return this->assemble(this->pack());
+	}
+
+	auto hash = this->content_hash();
+	util::Path dir = *cache_dir;
+	auto file = dir / util::sformat("%016" PRIx64 ".atlas", hash);
+
+	auto placements = this->load_cache(file, hash);
+	if (placements) {
+		log::log(DBG << "Loaded texture atlas placements from " << file);
+	}
+	else {
+		placements = this->pack();
+		dir.mkdirs();
+		this->store_cache(file, hash, *placements);
+	}
+
+	return this->assemble(*placements);
+}
+
+job::Job<std::shared_ptr<TextureAtlas>> TextureAtlasBuilder::build_async(const std::shared_ptr<job::JobManager> &job_mgr,
+                                                                         const std::optional<util::Path> &cache_dir) {
+	// job functions must be copyable, so the builder is shared with the job
+	auto builder = std::make_shared<TextureAtlasBuilder>(std::move(*this));
+	this->infos.clear();
+	this->textures.clear();
+
+	return job_mgr->enqueue<std::shared_ptr<TextureAtlas>>([builder, cache_dir]() {
+		return std::make_shared<TextureAtlas>(builder->build(cache_dir));
+	});
+}
+
+uint64_t TextureAtlasBuilder::content_hash() {
+	this->load_textures();
+
+	util::Siphash hasher{HASH_KEY};
+
+	// serialize everything that affects the packing result
+	std::string buf;
+	write_value(buf, CACHE_MAGIC);
+	write_value(buf, this->layer_width);
+	write_value(buf, this->layer_height);
+	write_value(buf, this->padding);
+	for (size_t i = 0; i < this->infos.size(); ++i) {
+		const auto &info = this->infos[i];
+		const auto &data = *this->textures[i];
+
+		write_value(buf, info.get_size());
+		write_value(buf, info.get_format());
+		write_value(buf, info.get_subtex_count());
+		for (size_t j = 0; j < info.get_subtex_count(); ++j) {
+			const auto &sub = info.get_subtex_info(j);
+			write_value(buf, sub.get_pos().x());
+			write_value(buf, sub.get_pos().y());
+			write_value(buf, sub.get_size().x());
+			write_value(buf, sub.get_size().y());
+		}
+
+		write_value(buf, hasher.digest(data.get_data(), data.get_info().get_data_size()));
+	}
+
+	return hasher.digest(reinterpret_cast<const uint8_t *>(buf.data()), buf.size());
+}
+
+void TextureAtlasBuilder::load_textures() {
+	for (size_t i = 0; i < this->infos.size(); ++i) {
+		if (not this->textures[i]) {
+			this->textures[i].emplace(this->infos[i]);
+		}
+	}
+}
+
+std::vector<TextureAtlasBuilder::placement> TextureAtlasBuilder::pack() const {
+	struct rect {
+		size_t index;
+		uint32_t width;
+		uint32_t height;
+	};
+
+	std::vector<rect> rects;
+	for (const auto &info : this->infos) {
+		for (size_t j = 0; j < info.get_subtex_count(); ++j) {
+			const auto &size = info.get_subtex_info(j).get_size();
+			uint32_t width = size.x() + this->padding;
+			uint32_t height = size.y() + this->padding;
+			if (width > this->layer_width or height > this->layer_height) {
+				throw Error{MSG(err) << "Subtexture " << j << " of size " << size.x() << "x" << size.y()
+				                     << " does not fit into a texture atlas layer of size "
+				                     << this->layer_width << "x" << this->layer_height << "."};
+			}
+			rects.push_back(rect{rects.size(), width, height});
+		}
+	}
+
+	// the skyline packer wastes the least space if high rectangles come first
+	std::sort(rects.begin(), rects.end(), [](const rect &a, const rect &b) {
+		if (a.height != b.height) {
+			return a.height > b.height;
+		}
+		if (a.width != b.width) {
+			return a.width > b.width;
+		}
+		return a.index < b.index;
+	});
+
+	std::vector<placement> placements(rects.size());
+	std::vector<SkylinePacker> layers;
+	for (const auto &r : rects) {
+		std::optional<Eigen::Vector2i> pos;
+		size_t layer = 0;
+		for (; layer < layers.size(); ++layer) {
+			pos = layers[layer].insert(r.width, r.height);
+			if (pos) {
+				break;
+			}
+		}
+
+		if (not pos) {
+			layers.emplace_back(this->layer_width, this->layer_height);
+			pos = layers.back().insert(r.width, r.height);
+		}
+
+		placements[r.index] = placement{
+			static_cast<uint32_t>(layer),
+			pos->x(),
+			pos->y(),
+		};
+	}
+
+	log::log(DBG << "Packed " << rects.size() << " subtextures into "
+	             << layers.size() << " texture atlas layers");
+
+	return placements;
+}
+
+std::optional<std::vector<TextureAtlasBuilder::placement>> TextureAtlasBuilder::load_cache(const util::Path &file,
+                                                                                         uint64_t hash) const {
+	if (not file.is_file()) {
+		return std::nullopt;
+	}
+
+	std::string buf = file.open_r().read();
+	size_t offset = 0;
+
+	std::array<char, 8> magic;
+	uint64_t file_hash;
+	uint64_t count;
+	uint32_t layer_count;
+	// packing never creates more layers than there are subtextures, which
+	// prevents huge allocations for corrupted files
+	if (not read_value(buf, offset, magic)
+	    or not read_value(buf, offset, file_hash)
+	    or not read_value(buf, offset, count)
+	    or not read_value(buf, offset, layer_count)
+	    or magic != CACHE_MAGIC
+	    or file_hash != hash
+	    or layer_count > count) {
+		log::log(WARN << "Ignoring invalid texture atlas cache file " << file);
+		return std::nullopt;
+	}
+
+	std::vector<placement> placements;
+	for (const auto &info : this->infos) {
+		for (size_t j = 0; j < info.get_subtex_count(); ++j) {
+			const auto &size = info.get_subtex_info(j).get_size();
+
+			placement p;
+			if (not read_value(buf, offset, p.layer)
+			    or not read_value(buf, offset, p.x)
+			    or not read_value(buf, offset, p.y)
+			    or p.layer >= layer_count
+			    or p.x < 0 or p.y < 0
+			    or p.x + size.x() > this->layer_width
+			    or p.y + size.y() > this->layer_height) {
+				log::log(WARN << "Ignoring invalid texture atlas cache file " << file);
+				return std::nullopt;
+			}
+			placements.push_back(p);
+		}
+	}
+
+	if (placements.size() != count) {
+		log::log(WARN << "Ignoring invalid texture atlas cache file " << file);
+		return std::nullopt;
+	}
+
+	return placements;
+}
+
+void TextureAtlasBuilder::store_cache(const util::Path &file,
+                                      uint64_t hash,
+                                      const std::vector<placement> &placements) const {
+	uint32_t layer_count = 0;
+	for (const auto &p : placements) {
+		layer_count = std::max(layer_count, p.layer + 1);
+	}
+
+	std::string buf;
+	write_value(buf, CACHE_MAGIC);
+	write_value(buf, hash);
+	write_value(buf, static_cast<uint64_t>(placements.size()));
+	write_value(buf, layer_count);
+	for (const auto &p : placements) {
+		write_value(buf, p.layer);
+		write_value(buf, p.x);
+		write_value(buf, p.y);
+	}
+
+	auto out = file.open_w();
+	out.write(buf);
+	out.close();
+}
+
+TextureAtlas TextureAtlasBuilder::assemble(const std::vector<placement> &placements) const {
+	auto format = this->infos.empty() ? pixel_format::rgba8 : this->infos.front().get_format();
+	size_t px_size = pixel_size(format);
+
+	Texture2dInfo layer_info{this->layer_width,
+	                         this->layer_height,
+	                         format,
+	                         std::nullopt,
+	                         LAYER_ROW_ALIGNMENT};
+	size_t layer_row_size = layer_info.get_row_size();
+
+	size_t layer_count = 0;
+	for (const auto &p : placements) {
+		layer_count = std::max<size_t>(layer_count, p.layer + 1);
+	}
+	std::vector<std::vector<uint8_t>> layer_data(layer_count,
+	                                             std::vector<uint8_t>(layer_info.get_data_size()));
+
+	std::vector<Texture2dInfo> packed_infos;
+	std::vector<std::vector<size_t>> subtex_layers;
+	size_t index = 0;
+	for (size_t i = 0; i < this->infos.size(); ++i) {
+		const auto &info = this->infos[i];
+		const auto &data = *this->textures[i];
+		auto src_size = info.get_size();
+		size_t src_row_size = data.get_info().get_row_size();
+
+		std::vector<Texture2dSubInfo> subs;
+		std::vector<size_t> layers;
+		for (size_t j = 0; j < info.get_subtex_count(); ++j, ++index) {
+			const auto &sub = info.get_subtex_info(j);
+			const auto &pos = sub.get_pos();
+			const auto &size = sub.get_size();
+			const auto &p = placements[index];
+
+			if (pos.x() < 0 or pos.y() < 0
+			    or pos.x() + size.x() > static_cast<uint32_t>(src_size.first)
+			    or pos.y() + size.y() > static_cast<uint32_t>(src_size.second)) {
+				throw Error{MSG(err) << "Subtexture " << j << " exceeds the bounds of its texture."};
+			}
+
+			// rows are stored top to bottom in both the texture and the layers
+			auto &dst = layer_data[p.layer];
+			for (uint32_t row = 0; row < size.y(); ++row) {
+				std::memcpy(dst.data() + (p.y + row) * layer_row_size + p.x * px_size,
+				            data.get_data() + (pos.y() + row) * src_row_size + pos.x() * px_size,
+				            size.x() * px_size);
+			}
+
+			subs.emplace_back(p.x,
+			                  p.y,
+			                  size.x(),
+			                  size.y(),
+			                  sub.get_anchor_pos().x(),
+			                  sub.get_anchor_pos().y(),
+			                  this->layer_width,
+			                  this->layer_height);
+			layers.push_back(p.layer);
+		}
+
+		packed_infos.emplace_back(this->layer_width,
+		                          this->layer_height,
+		                          format,
+		                          info.get_image_path(),
+		                          LAYER_ROW_ALIGNMENT,
+		                          std::move(subs));
+		subtex_layers.push_back(std::move(layers));
+	}
+
+	std::vector<Texture2dData> layers;
+	layers.reserve(layer_count);
+	for (auto &pixels : layer_data) {
+		layers.emplace_back(layer_info, std::move(pixels));
+	}
+
+	return TextureAtlas{std::move(layers), std::move(packed_infos), std::move(subtex_layers)};
+}
+
+} // namespace openage::renderer::resources
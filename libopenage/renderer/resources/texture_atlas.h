@@ -0,0 +1,263 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "job/job.h"
+#include "renderer/resources/texture_data.h"
+#include "renderer/resources/texture_info.h"
+#include "util/path.h"
+
+
+namespace openage {
+namespace job {
+class JobManager;
+} // namespace job
+
+namespace renderer::resources {
+
+/**
+ * Subtextures of multiple textures packed into the layers of a texture array.
+ */
+class TextureAtlas {
+public:
+	/**
+	 * Create a new texture atlas.
+	 *
+	 * @param layers Pixel data of the atlas layers. All layers have the same size and format.
+	 * @param textures Texture info of each packed texture with subtexture coordinates
+	 *                 relative to the layer they were placed in.
+	 * @param subtex_layers Layer index of each subtexture, by texture index.
+	 */
+	TextureAtlas(std::vector<Texture2dData> &&layers,
+	             std::vector<Texture2dInfo> &&textures,
+	             std::vector<std::vector<size_t>> &&subtex_layers);
+
+	~TextureAtlas() = default;
+
+	/**
+	 * Get the pixel data of the atlas layers, e.g. for uploading them
+	 * with \p Renderer::add_texture_array().
+	 *
+	 * @return Layers of the atlas.
+	 */
+	const std::vector<Texture2dData> &get_layers() const;
+
+	/**
+	 * Get the number of packed textures.
+	 *
+	 * @return Number of textures added to the atlas builder.
+	 */
+	size_t get_texture_count() const;
+
+	/**
+	 * Get the texture info of a packed texture. The size of the info is the layer size
+	 * and the subtexture coordinates point into the layer of the subtexture.
+	 *
+	 * @param texture_idx Index of the texture in the atlas builder.
+	 *
+	 * @return Texture info with atlas coordinates.
+	 */
+	const Texture2dInfo &get_texture_info(size_t texture_idx) const;
+
+	/**
+	 * Get the layer that a subtexture was placed in.
+	 *
+	 * @param texture_idx Index of the texture in the atlas builder.
+	 * @param subtex_idx Index of the subtexture in the texture.
+	 *
+	 * @return Layer index.
+	 */
+	size_t get_layer(size_t texture_idx, size_t subtex_idx) const;
+
+private:
+	/**
+	 * Pixel data of the layers.
+	 */
+	std::vector<Texture2dData> layers;
+
+	/**
+	 * Texture infos with rewritten subtexture coordinates, by texture index.
+	 */
+	std::vector<Texture2dInfo> textures;
+
+	/**
+	 * Layer of each subtexture, by texture index and subtexture index.
+	 */
+	std::vector<std::vector<size_t>> subtex_layers;
+};
+
+
+/**
+ * Packs the subtextures of multiple textures (e.g. sprite sheets) into
+ * a texture atlas, so that they can be drawn from a single texture array.
+ *
+ * Subtextures are packed with a skyline packer. The resulting placements can be
+ * cached on disk, keyed by a hash of the texture contents, so that unchanged
+ * textures do not have to be packed again.
+ *
+ * Only compiled with the texture-atlas feature (WITH_TEXTURE_ATLAS), since
+ * the renderer doesn't draw from atlases yet.
+ */
+class TextureAtlasBuilder {
+public:
+	/**
+	 * Create a new atlas builder.
+	 *
+	 * @param layer_width Width of the atlas layers (in pixels).
+	 * @param layer_height Height of the atlas layers (in pixels).
+	 * @param padding Empty space between subtextures (in pixels). Prevents texture
+	 *                filtering from sampling neighbouring subtextures.
+	 */
+	TextureAtlasBuilder(uint32_t layer_width,
+	                    uint32_t layer_height,
+	                    uint32_t padding = 1);
+
+	~TextureAtlasBuilder() = default;
+
+	TextureAtlasBuilder(TextureAtlasBuilder &&) = default;
+	TextureAtlasBuilder &operator=(TextureAtlasBuilder &&) = default;
+
+	/**
+	 * Add a texture to the atlas. The image is loaded when the atlas is built.
+	 *
+	 * All textures must have the same pixel format.
+	 *
+	 * @param info Texture info with the image path and subtextures.
+	 *
+	 * @return Index of the texture in the atlas.
+	 */
+	size_t add(const Texture2dInfo &info);
+
+	/**
+	 * Add an already loaded texture to the atlas.
+	 *
+	 * All textures must have the same pixel format.
+	 *
+	 * @param data Texture data.
+	 *
+	 * @return Index of the texture in the atlas.
+	 */
+	size_t add(Texture2dData &&data);
+
+	/**
+	 * Pack all added textures into an atlas.
+	 *
+	 * @param cache_dir Directory for cached packing results. If set, the placements
+	 *                  are loaded from there if the same textures were packed before,
+	 *                  and stored there after packing otherwise.
+	 *
+	 * @return Packed texture atlas.
+	 */
+	TextureAtlas build(const std::optional<util::Path> &cache_dir = std::nullopt);
+
+	/**
+	 * Pack all added textures into an atlas in a background job. The textures are
+	 * moved into the job, so the builder is empty afterwards.
+	 *
+	 * @param job_mgr Job manager that runs the job.
+	 * @param cache_dir Directory for cached packing results (see \p build()).
+	 *
+	 * @return Job that results in the packed texture atlas.
+	 */
+	job::Job<std::shared_ptr<TextureAtlas>> build_async(const std::shared_ptr<job::JobManager> &job_mgr,
+	                                                    const std::optional<util::Path> &cache_dir = std::nullopt);
+
+	/**
+	 * Get a hash of the layer settings and the contents of all added textures.
+	 *
+	 * Loads the textures that have not been loaded yet.
+	 *
+	 * @return Content hash.
+	 */
+	uint64_t content_hash();
+
+private:
+	/**
+	 * Position of a subtexture in the atlas.
+	 */
+	struct placement {
+		/// Layer index.
+		uint32_t layer;
+		/// Position of the top left corner in the layer.
+		int32_t x;
+		int32_t y;
+	};
+
+	/**
+	 * Load the image data of all added textures.
+	 */
+	void load_textures();
+
+	/**
+	 * Place the subtextures of all textures in the atlas layers.
+	 *
+	 * @return Placements of the subtextures, ordered by texture and subtexture index.
+	 */
+	std::vector<placement> pack() const;
+
+	/**
+	 * Load cached placements.
+	 *
+	 * @param file Cache file.
+	 * @param hash Content hash of the textures.
+	 *
+	 * @return Placements of the subtextures or nothing if the file does not exist
+	 *         or does not match the added textures.
+	 */
+	std::optional<std::vector<placement>> load_cache(const util::Path &file,
+	                                                 uint64_t hash) const;
+
+	/**
+	 * Store placements in a cache file.
+	 *
+	 * @param file Cache file.
+	 * @param hash Content hash of the textures.
+	 * @param placements Placements of the subtextures.
+	 */
+	void store_cache(const util::Path &file,
+	                 uint64_t hash,
+	                 const std::vector<placement> &placements) const;
+
+	/**
+	 * Copy the subtextures into the atlas layers.
+	 *
+	 * @param placements Placements of the subtextures.
+	 *
+	 * @return Packed texture atlas.
+	 */
+	TextureAtlas assemble(const std::vector<placement> &placements) const;
+
+	/**
+	 * Width of the atlas layers.
+	 */
+	uint32_t layer_width;
+
+	/**
+	 * Height of the atlas layers.
+	 */
+	uint32_t layer_height;
+
+	/**
+	 * Empty space between subtextures.
+	 */
+	uint32_t padding;
+
+	/**
+	 * Infos of the added textures.
+	 */
+	std::vector<Texture2dInfo> infos;
+
+	/**
+	 * Image data of the added textures. Empty until the texture is loaded.
+	 */
+	std::vector<std::optional<Texture2dData>> textures;
+};
+
+} // namespace renderer::resources
+} // namespace openage
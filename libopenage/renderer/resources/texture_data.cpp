@@ -1,4 +1,4 @@
-// Copyright 2015-2023 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #include "texture_data.h"
 
@@ -7,12 +7,14 @@
 #include <optional>
 #include <string>
 
-#include <QImage>
+#include <png.h>
 
 #include "error/error.h"
 #include "log/log.h"
+#include "renderer/resources/assets/binary_cache.h"
 #include "renderer/resources/texture_info.h"
 #include "renderer/resources/texture_subinfo.h"
+#include "util/file.h"
 #include "util/path.h"
 
 
@@ -57,42 +59,143 @@ static constexpr size_t guess_row_alignment(size_t width, pixel_format fmt, size
 	return 4;
 }
 
-Texture2dData::Texture2dData(const util::Path &path) {
-	std::string native_path = path.resolve_native_path();
-
-	// TODO: use QImageIOHandler to directly create the correct surface format.
-	QImage image{native_path.c_str()};
-	image.convertTo(QImage::Format_RGBA8888);
-
-	log::log(MSG(dbg) << "Texture has been loaded from " << native_path);
-
-	auto surf_fmt = image.format();
-
-	pixel_format pix_fmt;
-	switch (surf_fmt) {
-	case QImage::Format_RGB32:
-		throw Error{MSG(err) << "Qt ARGB format not supported, needs conversion first."};
-	case QImage::Format_RGB888:
-		pix_fmt = pixel_format::rgb8;
-		break;
-	case QImage::Format_BGR888:
-		pix_fmt = pixel_format::bgr8;
-		break;
-	case QImage::Format_RGBA8888:
-		pix_fmt = pixel_format::rgba8;
-		break;
+namespace {
+
+/// Decoded pixel data of an image file. Also stored in the binary asset cache.
+struct ImageData {
+	uint32_t width = 0;
+	uint32_t height = 0;
+	pixel_format format = pixel_format::rgba8;
+	uint64_t row_size = 0;
+	std::vector<uint8_t> pixels;
+};
+
+void write_data(BinaryWriter &writer, const ImageData &data) {
+	writer.write(data.width);
+	writer.write(data.height);
+	writer.write(data.format);
+	writer.write(data.row_size);
+	writer.write(data.pixels);
+}
+
+void read_data(BinaryReader &reader, ImageData &data) {
+	reader.read(data.width);
+	reader.read(data.height);
+	reader.read(data.format, pixel_format::rgba8ui);
+	reader.read(data.row_size);
+	reader.read(data.pixels);
+
+	if (data.pixels.size() != data.row_size * data.height) {
+		throw Error{MSG(err) << "Cached image data has the wrong size."};
+	}
+}
+
+/// Get the size of an image row including the padding for the given alignment.
+size_t get_row_size(size_t width, pixel_format fmt, size_t row_alignment) {
+	size_t row_size = width * pixel_size(fmt);
+	if (row_size % row_alignment != 0) {
+		row_size += row_alignment - (row_size % row_alignment);
+	}
+	return row_size;
+}
+
+/// Get the libpng format that decodes into the given pixel format.
+png_uint_32 get_png_format(pixel_format fmt) {
+	switch (fmt) {
+	case pixel_format::rgb8:
+		return PNG_FORMAT_RGB;
+	case pixel_format::bgr8:
+		return PNG_FORMAT_BGR;
+	case pixel_format::rgba8:
+	case pixel_format::rgba8ui:
+		return PNG_FORMAT_RGBA;
 	default:
-		throw Error(MSG(err) << "Texture " << native_path << " uses an unsupported format: " << static_cast<int>(surf_fmt));
+		throw Error(MSG(err) << "Images can't be decoded into pixel format " << static_cast<int>(fmt));
 	}
+}
 
-	auto w = uint32_t(image.width());
-	auto h = uint32_t(image.height());
+/// Frees the libpng state of an image when it goes out of scope.
+struct PngImageGuard {
+	png_image &image;
+
+	~PngImageGuard() {
+		png_image_free(&this->image);
+	}
+};
+
+/// Decode a PNG file. libpng converts the pixels to the requested format while
+/// decoding, so they are written into the final buffer without another copy.
+/// @param path Path to the image file.
+/// @param fmt Pixel format of the decoded data.
+/// @param row_alignment Byte alignment of the decoded rows.
+ImageData decode_png(const util::Path &path, pixel_format fmt, size_t row_alignment) {
+	auto png_format = get_png_format(fmt);
+
+	std::string buf;
+	auto file = path.open_r();
+	auto file_data = file.get_view(buf);
+
+	png_image image;
+	std::memset(&image, 0, sizeof(image));
+	image.version = PNG_IMAGE_VERSION;
+
+	if (not png_image_begin_read_from_memory(&image, file_data.data(), file_data.size())) {
+		throw Error(MSG(err) << "Could not read image " << path << ": " << image.message);
+	}
+	PngImageGuard guard{image};
 
-	size_t data_size = image.sizeInBytes();
+	image.format = png_format;
 
-	// copy pixel data from surface
-	this->data = std::vector<uint8_t>(data_size);
-	std::memcpy(this->data.data(), image.bits(), data_size);
+	ImageData data;
+	data.width = image.width;
+	data.height = image.height;
+	data.format = fmt;
+	data.row_size = get_row_size(image.width, fmt, row_alignment);
+	data.pixels.resize(data.row_size * data.height);
+
+	// the row stride is counted in components, which are one byte each for 8-bit formats
+	if (not png_image_finish_read(&image, nullptr, data.pixels.data(), data.row_size, nullptr)) {
+		throw Error(MSG(err) << "Could not decode image " << path << ": " << image.message);
+	}
+
+	log::log(MSG(dbg) << "Texture has been loaded from " << path);
+
+	return data;
+}
+
+/// Load the pixel data of an image file, either from the cache or by decoding it.
+ImageData load_image(const util::Path &path,
+                     pixel_format fmt,
+                     size_t row_alignment,
+                     const std::shared_ptr<BinaryAssetCache> &cache) {
+	auto decode = [&](const util::Path &image_path) {
+		return decode_png(image_path, fmt, row_alignment);
+	};
+
+	if (not cache) {
+		return decode(path);
+	}
+
+	auto data = cache->get_or_parse<ImageData>(path, decode);
+	if (data.format != fmt
+	    or data.row_size != get_row_size(data.width, fmt, row_alignment)) {
+		// image was cached with another layout
+		return decode(path);
+	}
+
+	return data;
+}
+
+} // namespace
+
+Texture2dData::Texture2dData(const util::Path &path,
+                             const std::shared_ptr<BinaryAssetCache> &cache) {
+	auto image = load_image(path, pixel_format::rgba8, 1, cache);
+	auto w = image.width;
+	auto h = image.height;
+
+	this->data = std::move(image.pixels);
+	this->memory.set(this->data.capacity());
 
 	std::vector<Texture2dSubInfo> subtextures;
 	// we don't have a texture description file.
@@ -101,29 +204,33 @@ Texture2dData::Texture2dData(const util::Path &path) {
 
 	subtextures.push_back(s);
 
-	size_t align = guess_row_alignment(w, pix_fmt, image.bytesPerLine());
-	this->info = Texture2dInfo(w, h, pix_fmt, path, align, std::move(subtextures));
+	size_t align = guess_row_alignment(w, pixel_format::rgba8, image.row_size);
+	this->info = Texture2dInfo(w, h, pixel_format::rgba8, path, align, std::move(subtextures));
 }
 
-Texture2dData::Texture2dData(Texture2dInfo const &info) :
+Texture2dData::Texture2dData(Texture2dInfo const &info,
+                             const std::shared_ptr<BinaryAssetCache> &cache) :
 	info{info} {
-	std::string native_path = info.get_image_path().value().resolve_native_path();
-
-	// TODO: use QImageIOHandler to directly create the correct surface format.
-	QImage image{native_path.c_str()};
-	image.convertTo(QImage::Format_RGBA8888);
-
-	log::log(MSG(dbg) << "Texture has been loaded from " << native_path);
-
-	size_t data_size = image.sizeInBytes();
+	auto image_path = info.get_image_path().value();
+	auto image = load_image(image_path,
+	                        info.get_format(),
+	                        info.get_row_alignment(),
+	                        cache);
+
+	auto size = info.get_size();
+	if (static_cast<int>(image.width) != size.first
+	    or static_cast<int>(image.height) != size.second) {
+		throw Error(MSG(err) << "Image " << image_path << " has size "
+		                     << image.width << "x" << image.height << ", but the texture info expects "
+		                     << size.first << "x" << size.second);
+	}
 
-	// copy pixel data from surface
-	this->data = std::vector<uint8_t>(data_size);
-	std::memcpy(this->data.data(), image.bits(), data_size);
+	this->data = std::move(image.pixels);
+	this->memory.set(this->data.capacity());
 }
 
 Texture2dData::Texture2dData(Texture2dInfo const &info, std::vector<uint8_t> &&data) :
-	info(info), data(std::move(data)) {}
+	info(info), data(std::move(data)), memory{util::memory_tag::assets, this->data.capacity()} {}
 
 Texture2dData Texture2dData::flip_y() {
 	size_t row_size = this->info.get_row_size();
@@ -136,6 +243,7 @@ Texture2dData Texture2dData::flip_y() {
 	}
 
 	this->data = new_data;
+	this->memory.set(this->data.capacity());
 
 	Texture2dInfo new_info(this->info);
 
@@ -153,33 +261,31 @@ const uint8_t *Texture2dData::get_data() const {
 void Texture2dData::store(const util::Path &file) const {
 	log::log(MSG(info) << "Saving texture data to " << file);
 
-	if (this->info.get_format() != pixel_format::rgba8) {
-		throw Error(MSG(err) << "Storing 2D textures into files is unimplemented. PRs welcome :D");
-	}
-
 	auto size = this->info.get_size();
 
-	QImage::Format pix_fmt;
-	pixel_format fmt = this->info.get_format();
-	switch (fmt) {
-	case pixel_format::rgb8:
-		pix_fmt = QImage::Format_RGB888;
-		break;
-	case pixel_format::bgr8:
-		pix_fmt = QImage::Format_BGR888;
-		break;
-	case pixel_format::rgba8:
-		pix_fmt = QImage::Format_RGBA8888;
-		break;
-	default:
-		throw Error(MSG(err) << "Texture uses an unsupported format.");
+	png_image image;
+	std::memset(&image, 0, sizeof(image));
+	image.version = PNG_IMAGE_VERSION;
+	image.width = size.first;
+	image.height = size.second;
+	image.format = get_png_format(this->info.get_format());
+
+	// query the size of the encoded image first
+	png_alloc_size_t png_size = 0;
+	auto row_size = this->info.get_row_size();
+	if (not png_image_write_to_memory(&image, nullptr, &png_size, 0, this->data.data(), row_size, nullptr)) {
+		throw Error(MSG(err) << "Could not encode texture: " << image.message);
 	}
 
-	QImage image{this->data.data(), size.first, size.second, pix_fmt};
+	std::string png_data(png_size, '\0');
+	if (not png_image_write_to_memory(&image, png_data.data(), &png_size, 0, this->data.data(), row_size, nullptr)) {
+		throw Error(MSG(err) << "Could not encode texture: " << image.message);
+	}
+	png_data.resize(png_size);
 
-	// Call QImage for saving the screenshot to PNG
-	std::string path = file.resolve_native_path_w();
-	image.save(path.c_str());
+	auto out = file.open_w();
+	out.write(png_data);
+	out.close();
 }
 
 } // namespace openage::renderer::resources
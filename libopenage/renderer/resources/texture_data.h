@@ -1,14 +1,16 @@
-// Copyright 2017-2023 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "error/error.h"
 #include "log/message.h"
+#include "util/memory_tag.h"
 
 #include "texture_info.h"
 
@@ -18,22 +20,25 @@ namespace util {
 class Path;
 }
 namespace renderer::resources {
+class BinaryAssetCache;
 
 /// Stores 2D texture data in a CPU-accessible byte buffer. Provides methods for loading from
 /// and storing onto disk, as well as sending to and receiving from graphics hardware.
 class Texture2dData {
 public:
-	/// Create a texture from an image file.
+	/// Create a texture from a PNG file. The image is decoded in the rgba8 format.
 	/// @param path Path to the image file.
-	///
-	/// Uses QImage internally.
-	Texture2dData(const util::Path &path);
-
-	/// Create a texture from info.
-	///
-	/// Uses QImage internally. For supported image file types,
-	/// see the QImage initialization in the engine.
-	Texture2dData(Texture2dInfo const &info);
+	/// @param cache Cache for the decoded pixel data. If the image has been decoded
+	///              before, the pixel data is read from the cache instead. Can be \p nullptr.
+	Texture2dData(const util::Path &path,
+	              const std::shared_ptr<BinaryAssetCache> &cache = nullptr);
+
+	/// Create a texture from info. The image file referenced by the info is
+	/// decoded directly in the pixel format and row alignment of the info.
+	/// @param info Texture info with an image path.
+	/// @param cache Cache for the decoded pixel data. Can be \p nullptr.
+	Texture2dData(Texture2dInfo const &info,
+	              const std::shared_ptr<BinaryAssetCache> &cache = nullptr);
 
 	/// Construct by moving the information and raw texture data from somewhere else.
 	Texture2dData(Texture2dInfo const &info, std::vector<uint8_t> &&data);
@@ -67,6 +72,7 @@ public:
 	}
 
 	/// Stores this texture data in the given file in the PNG format.
+	/// Only the rgb8, bgr8 and rgba8 pixel formats are supported.
 	void store(const util::Path &file) const;
 
 private:
@@ -75,6 +81,9 @@ private:
 
 	/// The raw texture data.
 	std::vector<uint8_t> data;
+
+	/// Accounts the texture data to the assets memory tag.
+	util::MemoryCharge memory{util::memory_tag::assets};
 };
 
 } // namespace renderer::resources
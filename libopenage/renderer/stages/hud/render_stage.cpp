@@ -1,9 +1,8 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "render_stage.h"
 
 #include "renderer/camera/camera.h"
-#include "renderer/opengl/context.h"
 #include "renderer/render_pass.h"
 #include "renderer/render_target.h"
 #include "renderer/resources/assets/asset_manager.h"
@@ -29,7 +28,7 @@ HudRenderStage::HudRenderStage(const std::shared_ptr<Window> &window,
 	asset_manager{asset_manager},
 	drag_object{nullptr},
 	clock{clock} {
-	renderer::opengl::GlContext::check_error();
+	this->renderer->check_error();
 
 	auto size = window->get_size();
 	this->initialize_render_pass(size[0], size[1], shaderdir);
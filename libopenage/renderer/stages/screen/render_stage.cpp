@@ -1,8 +1,7 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #include "render_stage.h"
 
-#include "renderer/opengl/context.h"
 #include "renderer/render_pass.h"
 #include "renderer/render_target.h"
 #include "renderer/renderer.h"
@@ -23,7 +22,7 @@ ScreenRenderStage::ScreenRenderStage(const std::shared_ptr<Window> & /* window *
 	renderer{renderer},
 	render_targets{},
 	pass_outputs{} {
-	renderer::opengl::GlContext::check_error();
+	this->renderer->check_error();
 
 	this->initialize_render_pass(shaderdir);
 
@@ -1,8 +1,7 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #include "render_stage.h"
 
-#include "renderer/opengl/context.h"
 #include "renderer/render_pass.h"
 #include "renderer/render_target.h"
 #include "renderer/renderer.h"
@@ -22,7 +21,7 @@ SkyboxRenderStage::SkyboxRenderStage(const std::shared_ptr<Window> &window,
 	renderer{renderer},
 	bg_color{0.0, 0.0, 0.0, 1.0} // black
 {
-	renderer::opengl::GlContext::check_error();
+	this->renderer->check_error();
 
 	auto size = window->get_size();
 	this->initialize_render_pass(size[0], size[1], shaderdir);
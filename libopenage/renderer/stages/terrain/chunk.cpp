@@ -1,7 +1,12 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #include "chunk.h"
 
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
 #include "renderer/resources/assets/asset_manager.h"
 #include "renderer/resources/mesh_data.h"
 #include "renderer/stages/terrain/mesh.h"
@@ -15,7 +20,10 @@ TerrainChunk::TerrainChunk(const std::shared_ptr<renderer::resources::AssetManag
                            const coord::scene2_delta offset) :
 	size{size},
 	offset{offset},
-	asset_manager{asset_manager} {}
+	asset_manager{asset_manager},
+	render_entity{nullptr},
+	pending_build{},
+	rebuild_queued{false} {}
 
 void TerrainChunk::set_render_entity(const std::shared_ptr<RenderEntity> &entity) {
 	this->render_entity = entity;
@@ -27,34 +35,33 @@ void TerrainChunk::fetch_updates(const time::time_t & /* time */) {
 		return;
 	}
 
+	// Replace the meshes if a rebuild has finished
+	if (this->pending_build.valid()
+	    and this->pending_build.wait_for(std::chrono::seconds{0}) == std::future_status::ready) {
+		this->set_meshes(this->pending_build.get());
+
+		if (this->rebuild_queued) {
+			this->rebuild_queued = false;
+			this->request_rebuild();
+		}
+	}
+
 	// Check render entity for updates
 	if (not this->render_entity->is_changed()) {
 		return;
 	}
 
-	// Get the terrain data from the render entity
-	auto terrain_size = this->render_entity->get_size();
-	auto terrain_paths = this->render_entity->get_terrain_paths();
-	auto tiles = this->render_entity->get_tiles();
-	auto heightmap_verts = this->render_entity->get_vertices();
+	// This also indicates to the render entity that its updates have been processed.
+	auto region = this->render_entity->fetch_dirty_region();
 
-	// Recreate the mesh data
-	// TODO: Change mesh instead of recreating it
-	// TODO: Multiple meshes
-	this->meshes.clear();
-	for (const auto &terrain_path : terrain_paths) {
-		auto new_mesh = this->create_mesh(terrain_size, tiles, heightmap_verts, terrain_path);
-		new_mesh->create_model_matrix(this->offset);
-		this->meshes.push_back(new_mesh);
+	// A running rebuild uses an older snapshot of the terrain, so
+	// in-place changes would be lost when its meshes replace the current ones.
+	if (region.rebuild or this->meshes.empty() or this->pending_build.valid()) {
+		this->request_rebuild();
+		return;
 	}
 
-	// auto new_mesh = this->create_mesh();
-	// new_mesh->create_model_matrix(this->offset);
-	// this->meshes.clear();
-	// this->meshes.push_back(new_mesh);
-
-	// Indicate to the render entity that its updates have been processed.
-	this->render_entity->clear_changed_flag();
+	this->patch_meshes(region);
 }
 
 void TerrainChunk::update_uniforms(const time::time_t &time) {
@@ -67,10 +74,10 @@ const std::vector<std::shared_ptr<TerrainRenderMesh>> &TerrainChunk::get_meshes(
 	return this->meshes;
 }
 
-std::shared_ptr<TerrainRenderMesh> TerrainChunk::create_mesh(const util::Vector2s vert_size,
-                                                             const RenderEntity::tiles_t &tiles,
-                                                             const std::vector<coord::scene3> &heightmap_verts,
-                                                             const std::string &texture_path) {
+TerrainChunk::mesh_build_t TerrainChunk::create_mesh(const util::Vector2s vert_size,
+                                                     const RenderEntity::tiles_t &tiles,
+                                                     const std::vector<coord::scene3> &heightmap_verts,
+                                                     const std::string &terrain_path) {
 	auto v_width = vert_size[0];
 	auto v_height = vert_size[1];
 
@@ -78,15 +85,16 @@ std::shared_ptr<TerrainRenderMesh> TerrainChunk::create_mesh(const util::Vector2
 	std::vector<float> mesh_verts{};
 
 	// vertex indices for the mesh
-	std::vector<uint16_t> idxs{};
+	std::vector<uint32_t> idxs{};
 
 	// maps indices of verts in the heightmap to indices in the vertex data vector
-	std::unordered_map<size_t, size_t> index_map;
+	std::vector<uint32_t> vert_map(heightmap_verts.size(), TerrainRenderMesh::no_vertex);
+	uint32_t vert_count = 0;
 
 	for (size_t i = 0; i < v_width - 1; ++i) {
 		for (size_t j = 0; j < v_height - 1; ++j) {
-			auto tile = tiles.at(j + i * (v_height - 1));
-			if (tile.second != texture_path) {
+			const auto &tile = tiles.at(j + i * (v_height - 1));
+			if (tile.second != terrain_path) {
 				// Skip tiles with different textures
 				continue;
 			}
@@ -103,58 +111,114 @@ std::shared_ptr<TerrainRenderMesh> TerrainChunk::create_mesh(const util::Vector2
 			// add the vertices of the current tile to the vertex data vector
 			for (size_t v_idx : tile_verts) {
 				// skip if the vertex is already in the vertex data vector
-				if (not index_map.contains(v_idx)) {
-					auto v = heightmap_verts[v_idx];
-					auto v_vec = v.to_world_space();
-					mesh_verts.push_back(v_vec[0]);
-					mesh_verts.push_back(v_vec[1]);
-					mesh_verts.push_back(v_vec[2]);
-					mesh_verts.push_back((v.ne / 10).to_float());
-					mesh_verts.push_back((v.se / 10).to_float());
-
-					// update the index map
-					// since new verts are added to the end of the vertex data vector
-					// the mapped index is the current size of the index map
-					index_map[v_idx] = index_map.size();
+				if (vert_map[v_idx] == TerrainRenderMesh::no_vertex) {
+					auto v_data = TerrainRenderMesh::vertex_data(heightmap_verts[v_idx]);
+					mesh_verts.insert(mesh_verts.end(), v_data.begin(), v_data.end());
+
+					// new verts are added to the end of the vertex data vector
+					vert_map[v_idx] = vert_count;
+					vert_count += 1;
 				}
 			}
 
 			// first triangle
-			idxs.push_back(index_map[tile_verts[0]]); // top left
-			idxs.push_back(index_map[tile_verts[1]]); // bottom left
-			idxs.push_back(index_map[tile_verts[2]]); // bottom right
+			idxs.push_back(vert_map[tile_verts[0]]); // top left
+			idxs.push_back(vert_map[tile_verts[1]]); // bottom left
+			idxs.push_back(vert_map[tile_verts[2]]); // bottom right
 
 			// second triangle
-			idxs.push_back(index_map[tile_verts[0]]); // top left
-			idxs.push_back(index_map[tile_verts[2]]); // bottom right
-			idxs.push_back(index_map[tile_verts[3]]); // top right
+			idxs.push_back(vert_map[tile_verts[0]]); // top left
+			idxs.push_back(vert_map[tile_verts[2]]); // bottom right
+			idxs.push_back(vert_map[tile_verts[3]]); // top right
 		}
 	}
 
+	// only use 32-bit indices if the mesh is too large for 16-bit indices
+	bool use_u16 = vert_count <= std::numeric_limits<uint16_t>::max();
+
 	resources::VertexInputInfo info{
 		{resources::vertex_input_t::V3F32, resources::vertex_input_t::V2F32},
 		resources::vertex_layout_t::AOS,
 		resources::vertex_primitive_t::TRIANGLES,
-		resources::index_t::U16};
+		use_u16 ? resources::index_t::U16 : resources::index_t::U32};
 
 	auto const vert_data_size_new = mesh_verts.size() * sizeof(float);
 	std::vector<uint8_t> vert_data_new(vert_data_size_new);
 	std::memcpy(vert_data_new.data(), mesh_verts.data(), vert_data_size_new);
 
-	auto const idx_data_size = idxs.size() * sizeof(uint16_t);
-	std::vector<uint8_t> idx_data(idx_data_size);
-	std::memcpy(idx_data.data(), idxs.data(), idx_data_size);
+	std::vector<uint8_t> idx_data;
+	if (use_u16) {
+		std::vector<uint16_t> idxs_u16(idxs.begin(), idxs.end());
+		idx_data.resize(idxs_u16.size() * sizeof(uint16_t));
+		std::memcpy(idx_data.data(), idxs_u16.data(), idx_data.size());
+	}
+	else {
+		idx_data.resize(idxs.size() * sizeof(uint32_t));
+		std::memcpy(idx_data.data(), idxs.data(), idx_data.size());
+	}
 
-	resources::MeshData meshdata{std::move(vert_data_new), std::move(idx_data), info};
+	return mesh_build_t{
+		terrain_path,
+		resources::MeshData{std::move(vert_data_new), std::move(idx_data), info},
+		std::move(vert_map),
+	};
+}
 
-	// Create the terrain mesh
-	auto terrain_info = this->asset_manager->request_terrain(texture_path);
-	auto terrain_mesh = std::make_shared<TerrainRenderMesh>(
-		this->asset_manager,
-		terrain_info,
-		std::move(meshdata));
+void TerrainChunk::request_rebuild() {
+	if (this->pending_build.valid()) {
+		this->rebuild_queued = true;
+		return;
+	}
+
+	// Take a snapshot of the terrain data for the worker
+	auto terrain_size = this->render_entity->get_size();
+	auto terrain_paths = this->render_entity->get_terrain_paths();
+	auto tiles = this->render_entity->get_tiles();
+	auto heightmap_verts = this->render_entity->get_vertices();
+
+	this->pending_build = std::async(
+		std::launch::async,
+		[terrain_size,
+	     terrain_paths = std::move(terrain_paths),
+	     tiles = std::move(tiles),
+	     heightmap_verts = std::move(heightmap_verts)]() {
+			std::vector<mesh_build_t> builds;
+			builds.reserve(terrain_paths.size());
+			for (const auto &terrain_path : terrain_paths) {
+				builds.push_back(TerrainChunk::create_mesh(terrain_size, tiles, heightmap_verts, terrain_path));
+			}
+			return builds;
+		});
+}
+
+void TerrainChunk::set_meshes(std::vector<mesh_build_t> &&builds) {
+	// TODO: Multiple meshes
+	this->meshes.clear();
+	for (auto &build : builds) {
+		auto terrain_info = this->asset_manager->request_terrain(build.terrain_path);
+		auto new_mesh = std::make_shared<TerrainRenderMesh>(
+			this->asset_manager,
+			terrain_info,
+			std::move(build.mesh));
+		new_mesh->set_vertex_map(std::move(build.vert_map));
+		new_mesh->create_model_matrix(this->offset);
+		this->meshes.push_back(new_mesh);
+	}
+}
+
+void TerrainChunk::patch_meshes(const RenderEntity::dirty_region_t &region) {
+	auto v_height = this->render_entity->get_size()[1];
 
-	return terrain_mesh;
+	size_t region_idx = 0;
+	for (size_t i = region.ne_min; i <= region.ne_max; ++i) {
+		for (size_t j = region.se_min; j <= region.se_max; ++j) {
+			const auto &vert = region.vertices[region_idx];
+			for (auto &mesh : this->meshes) {
+				mesh->update_vertex(j + i * v_height, vert);
+			}
+			region_idx += 1;
+		}
+	}
 }
 
 util::Vector2s &TerrainChunk::get_size() {
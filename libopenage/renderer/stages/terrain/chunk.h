@@ -1,12 +1,16 @@
-// Copyright 2023-2024 the openage authors. See copying.md for legal info.
+// Copyright 2023-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <future>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "coord/scene.h"
+#include "renderer/resources/mesh_data.h"
 #include "renderer/stages/terrain/render_entity.h"
 #include "time/time.h"
 #include "util/vector.h"
@@ -49,6 +53,10 @@ public:
 	/**
 	 * Fetch updates from the render entity.
 	 *
+	 * Height changes are patched into the existing meshes. If the layout of the
+	 * meshes changes, they are rebuilt on a worker thread and replaced
+	 * once the build is done.
+	 *
 	 * @param time Current simulation time.
 	 */
 	void fetch_updates(const time::time_t &time = 0.0);
@@ -83,19 +91,62 @@ public:
 
 private:
 	/**
-	 * Create a terrain mesh from the data provided by the render entity.
+	 * Mesh data for a single terrain texture.
+	 */
+	struct mesh_build_t {
+		/**
+		 * Path to the terrain definition.
+		 */
+		std::string terrain_path;
+
+		/**
+		 * Vertex and index data of the mesh.
+		 */
+		renderer::resources::MeshData mesh;
+
+		/**
+		 * Mesh vertex index for every heightmap vertex.
+		 */
+		std::vector<uint32_t> vert_map;
+	};
+
+	/**
+	 * Create the data of a terrain mesh from the data provided by the render entity.
+	 *
+	 * Does not access the chunk, so it can run on a worker thread.
 	 *
 	 * @param vert_size Size of the terrain in vertices.
 	 * @param tiles Data for each tile (elevation, terrain path).
 	 * @param heightmap_verts Position of each vertex in the chunk.
-	 * @param texture_path Path to the texture for the terrain.
+	 * @param terrain_path Path to the terrain definition.
+	 *
+	 * @return Mesh data for the terrain.
+	 */
+	static mesh_build_t create_mesh(const util::Vector2s vert_size,
+	                                const RenderEntity::tiles_t &tiles,
+	                                const std::vector<coord::scene3> &heightmap_verts,
+	                                const std::string &terrain_path);
+
+	/**
+	 * Start rebuilding all meshes on a worker thread.
 	 *
-	 * @return New terrain mesh.
+	 * If a build is already running, the rebuild is started after it finishes.
 	 */
-	std::shared_ptr<TerrainRenderMesh> create_mesh(const util::Vector2s vert_size,
-	                                               const RenderEntity::tiles_t &tiles,
-	                                               const std::vector<coord::scene3> &heightmap_verts,
-	                                               const std::string &texture_path);
+	void request_rebuild();
+
+	/**
+	 * Replace the meshes of the chunk with the results of a build.
+	 *
+	 * @param builds Mesh data for each terrain texture.
+	 */
+	void set_meshes(std::vector<mesh_build_t> &&builds);
+
+	/**
+	 * Patch a changed region of the heightmap into the existing meshes.
+	 *
+	 * @param region Changed region.
+	 */
+	void patch_meshes(const RenderEntity::dirty_region_t &region);
 
 	/**
 	 * Size of the chunk in tiles (width x height).
@@ -123,6 +174,16 @@ private:
 	 * our render vertex mesh when \p update() is called.
 	 */
 	std::shared_ptr<RenderEntity> render_entity;
+
+	/**
+	 * Mesh build running on a worker thread.
+	 */
+	std::future<std::vector<mesh_build_t>> pending_build;
+
+	/**
+	 * Whether another rebuild is required after the pending build finishes.
+	 */
+	bool rebuild_queued;
 };
 
 
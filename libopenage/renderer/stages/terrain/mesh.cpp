@@ -1,11 +1,14 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #include "mesh.h"
 
+#include <algorithm>
+#include <cstring>
 #include <functional>
 #include <optional>
 #include <utility>
 
+#include "renderer/geometry.h"
 #include "renderer/resources/assets/asset_manager.h"
 #include "renderer/resources/assets/texture_manager.h"
 #include "renderer/resources/terrain/terrain_info.h"
@@ -22,7 +25,11 @@ TerrainRenderMesh::TerrainRenderMesh(const std::shared_ptr<renderer::resources::
 	asset_manager{asset_manager},
 	terrain_info{nullptr},
 	uniforms{nullptr},
-	mesh{renderer::resources::MeshData::make_quad()} {
+	mesh{renderer::resources::MeshData::make_quad()},
+	geometry{nullptr},
+	vert_map{},
+	changed_first{1},
+	changed_last{0} {
 }
 
 TerrainRenderMesh::TerrainRenderMesh(const std::shared_ptr<renderer::resources::AssetManager> &asset_manager,
@@ -33,10 +40,25 @@ TerrainRenderMesh::TerrainRenderMesh(const std::shared_ptr<renderer::resources::
 	asset_manager{asset_manager},
 	terrain_info{nullptr},
 	uniforms{nullptr},
-	mesh{std::move(mesh)} {
+	mesh{std::move(mesh)},
+	geometry{nullptr},
+	vert_map{},
+	changed_first{1},
+	changed_last{0} {
 	this->set_terrain_info(info);
 }
 
+std::array<float, TerrainRenderMesh::vert_floats> TerrainRenderMesh::vertex_data(const coord::scene3 &vert) {
+	auto v_vec = vert.to_world_space();
+	return {
+		v_vec[0],
+		v_vec[1],
+		v_vec[2],
+		(vert.ne / 10).to_float(),
+		(vert.se / 10).to_float(),
+	};
+}
+
 void TerrainRenderMesh::set_mesh(renderer::resources::MeshData &&mesh) {
 	this->mesh = mesh;
 	this->require_renderable = true;
@@ -47,6 +69,61 @@ const renderer::resources::MeshData &TerrainRenderMesh::get_mesh() {
 	return this->mesh;
 }
 
+void TerrainRenderMesh::set_vertex_map(std::vector<uint32_t> &&vert_map) {
+	this->vert_map = std::move(vert_map);
+}
+
+void TerrainRenderMesh::update_vertex(size_t heightmap_idx, const coord::scene3 &vert) {
+	if (heightmap_idx >= this->vert_map.size()) [[unlikely]] {
+		return;
+	}
+
+	auto mesh_idx = this->vert_map[heightmap_idx];
+	if (mesh_idx == no_vertex) {
+		return;
+	}
+
+	auto data = vertex_data(vert);
+	auto &verts = this->mesh.get_data();
+	std::memcpy(verts.data() + mesh_idx * sizeof(data), data.data(), sizeof(data));
+
+	if (this->changed_first > this->changed_last) {
+		this->changed_first = mesh_idx;
+		this->changed_last = mesh_idx;
+	}
+	else {
+		this->changed_first = std::min<size_t>(this->changed_first, mesh_idx);
+		this->changed_last = std::max<size_t>(this->changed_last, mesh_idx);
+	}
+}
+
+void TerrainRenderMesh::set_geometry(const std::shared_ptr<renderer::Geometry> &geometry) {
+	this->geometry = geometry;
+
+	// the new geometry already contains all changes
+	this->changed_first = 1;
+	this->changed_last = 0;
+}
+
+void TerrainRenderMesh::update_geometry() {
+	if (this->changed_first > this->changed_last) [[likely]] {
+		return;
+	}
+
+	if (this->geometry == nullptr) [[unlikely]] {
+		return;
+	}
+
+	constexpr size_t vert_size = vert_floats * sizeof(float);
+	const auto &verts = this->mesh.get_data();
+	std::vector<uint8_t> changed_verts(verts.begin() + this->changed_first * vert_size,
+	                                   verts.begin() + (this->changed_last + 1) * vert_size);
+	this->geometry->update_verts_offset(changed_verts, this->changed_first);
+
+	this->changed_first = 1;
+	this->changed_last = 0;
+}
+
 void TerrainRenderMesh::set_terrain_info(const std::shared_ptr<renderer::resources::TerrainInfo> &info) {
 	this->changed = true;
 	this->terrain_info = info;
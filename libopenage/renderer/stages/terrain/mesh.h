@@ -1,9 +1,14 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <eigen3/Eigen/Dense>
 
@@ -14,6 +19,7 @@
 
 
 namespace openage::renderer {
+class Geometry;
 class UniformInput;
 
 namespace resources {
@@ -28,6 +34,25 @@ namespace terrain {
  */
 class TerrainRenderMesh {
 public:
+	/**
+	 * Number of floats per vertex in the terrain mesh (position, uv).
+	 */
+	static constexpr size_t vert_floats = 5;
+
+	/**
+	 * Marks heightmap vertices that are not part of the mesh in the vertex map.
+	 */
+	static constexpr uint32_t no_vertex = std::numeric_limits<uint32_t>::max();
+
+	/**
+	 * Get the vertex data of a heightmap vertex in the layout used by the mesh.
+	 *
+	 * @param vert Heightmap vertex.
+	 *
+	 * @return Vertex data (position, uv).
+	 */
+	static std::array<float, vert_floats> vertex_data(const coord::scene3 &vert);
+
 	/**
 	 * Create a new terrain render mesh with empty values.
 	 *
@@ -80,6 +105,40 @@ public:
 	 */
 	const renderer::resources::MeshData &get_mesh();
 
+	/**
+	 * Set the mapping from vertex indices in the chunk heightmap to vertex
+	 * indices in this mesh. Required for \p update_vertex().
+	 *
+	 * @param vert_map Mesh vertex index for every heightmap vertex, or \p no_vertex
+	 *                 if the heightmap vertex is not part of this mesh.
+	 */
+	void set_vertex_map(std::vector<uint32_t> &&vert_map);
+
+	/**
+	 * Update a single vertex of the mesh in place.
+	 *
+	 * Does nothing if the vertex is not part of this mesh. Changed vertices
+	 * are uploaded to the geometry on the next call of \p update_geometry().
+	 *
+	 * @param heightmap_idx Index of the vertex in the chunk heightmap.
+	 * @param vert New vertex position.
+	 */
+	void update_vertex(size_t heightmap_idx, const coord::scene3 &vert);
+
+	/**
+	 * Set the geometry that was created from this mesh for the render pass.
+	 *
+	 * @param geometry Geometry of the mesh's renderable.
+	 */
+	void set_geometry(const std::shared_ptr<renderer::Geometry> &geometry);
+
+	/**
+	 * Upload the vertices changed by \p update_vertex() to the geometry.
+	 *
+	 * Only the range between the first and last changed vertex is uploaded.
+	 */
+	void update_geometry();
+
 	/**
 	 * Set the terrain info that is drawn onto the mesh.
 	 *
@@ -165,6 +224,23 @@ private:
 	 * Transformation matrix for the terrain model.
 	 */
 	Eigen::Matrix4f model_matrix;
+
+	/**
+	 * Geometry of the mesh's renderable.
+	 */
+	std::shared_ptr<renderer::Geometry> geometry;
+
+	/**
+	 * Maps vertex indices in the chunk heightmap to vertex indices in the mesh.
+	 */
+	std::vector<uint32_t> vert_map;
+
+	/**
+	 * First and last vertex changed since the last geometry update.
+	 * If first > last, no vertices were changed.
+	 */
+	size_t changed_first;
+	size_t changed_last;
 };
 } // namespace terrain
 } // namespace openage::renderer
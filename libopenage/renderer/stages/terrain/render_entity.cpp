@@ -1,11 +1,12 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #include "render_entity.h"
 
 #include <algorithm>
-#include <array>
 #include <mutex>
 
+#include "error/error.h"
+
 
 namespace openage::renderer::terrain {
 
@@ -14,7 +15,9 @@ RenderEntity::RenderEntity() :
 	size{0, 0},
 	tiles{},
 	terrain_paths{},
-	vertices{} {
+	vertices{},
+	dirty{},
+	has_dirty{false} {
 }
 
 void RenderEntity::update_tile(const util::Vector2s size,
@@ -28,17 +31,24 @@ void RenderEntity::update_tile(const util::Vector2s size,
 		throw Error(MSG(err) << "Cannot update tile: Vertices have not been initialized yet.");
 	}
 
-	// find the postion of the tile in the vertex array
-	auto left_corner = pos.ne * size[0] + pos.se;
-
-	// update the 4 vertices of the tile
-	this->vertices[left_corner].up = elevation.to_float();                 // left corner
-	this->vertices[left_corner + 1].up = elevation.to_float();             // bottom corner
-	this->vertices[left_corner + (size[0] + 1)].up = elevation.to_float(); // top corner
-	this->vertices[left_corner + (size[0] + 2)].up = elevation.to_float(); // right corner
+	auto ne = static_cast<size_t>(pos.ne);
+	auto se = static_cast<size_t>(pos.se);
 
 	// update tile
-	this->tiles[left_corner] = {elevation, terrain_path};
+	auto &tile = this->tiles[ne * size[1] + se];
+	if (tile.second != terrain_path) {
+		// the tile moves to the mesh of another texture
+		this->dirty.rebuild = true;
+	}
+	tile = {elevation, terrain_path};
+
+	// update the 4 vertices of the tile
+	for (size_t i = ne; i <= ne + 1; ++i) {
+		for (size_t j = se; j <= se + 1; ++j) {
+			this->vertices[i * this->size[1] + j].up = this->vertex_height(i, j);
+		}
+	}
+	this->mark_dirty(ne, se, ne + 1, se + 1);
 
 	// update the last update time
 	this->last_update = time;
@@ -56,43 +66,26 @@ void RenderEntity::update(const util::Vector2s size,
 
 	// increase by 1 in every dimension because tiles
 	// size is number of tiles, but we want number of vertices
-	util::Vector2i tile_size{size[0], size[1]};
 	this->size = util::Vector2s{size[0] + 1, size[1] + 1};
 
+	// update tiles
+	this->tiles = tiles;
+
 	// transfer mesh
 	auto vert_count = this->size[0] * this->size[1];
 	this->vertices.clear();
 	this->vertices.reserve(vert_count);
-	for (int j = 0; j < (int)this->size[1]; ++j) {
-		for (int i = 0; i < (int)this->size[0]; ++i) {
-			// for each vertex, compare the surrounding tiles
-			std::vector<float> surround{};
-			if (j - 1 >= 0 and i - 1 >= 0) {
-				surround.push_back(tiles[(i - 1) * size[1] + j - 1].first.to_float());
-			}
-			if (j < tile_size[1] and i - 1 >= 0) {
-				surround.push_back(tiles[(i - 1) * size[1] + j].first.to_float());
-			}
-			if (j < tile_size[1] and i < tile_size[0]) {
-				surround.push_back(tiles[i * size[1] + j].first.to_float());
-			}
-			if (j - 1 >= 0 and i < tile_size[0]) {
-				surround.push_back(tiles[i * size[1] + j - 1].first.to_float());
-			}
-			// select the height of the highest surrounding tile
-			auto max_height = *std::max_element(surround.begin(), surround.end());
+	for (size_t i = 0; i < this->size[0]; ++i) {
+		for (size_t j = 0; j < this->size[1]; ++j) {
 			coord::scene3 v{
 				static_cast<float>(i),
 				static_cast<float>(j),
-				max_height,
+				this->vertex_height(i, j),
 			};
 			this->vertices.push_back(v);
 		}
 	}
 
-	// update tiles
-	this->tiles = tiles;
-
 	// update the last update time
 	this->last_update = time;
 
@@ -102,9 +95,45 @@ void RenderEntity::update(const util::Vector2s size,
 		this->terrain_paths.insert(tile.second);
 	}
 
+	// the size may have changed, so the mesh has to be recreated
+	this->dirty.rebuild = true;
+	this->has_dirty = true;
+
 	this->changed = true;
 }
 
+RenderEntity::dirty_region_t RenderEntity::fetch_dirty_region() {
+	std::unique_lock lock{this->mutex};
+
+	dirty_region_t region{};
+	if (not this->has_dirty) {
+		this->changed = false;
+		return region;
+	}
+
+	region.rebuild = this->dirty.rebuild;
+	if (not region.rebuild) {
+		region.ne_min = this->dirty.ne_min;
+		region.ne_max = this->dirty.ne_max;
+		region.se_min = this->dirty.se_min;
+		region.se_max = this->dirty.se_max;
+
+		region.vertices.reserve((region.ne_max - region.ne_min + 1)
+		                        * (region.se_max - region.se_min + 1));
+		for (size_t i = region.ne_min; i <= region.ne_max; ++i) {
+			for (size_t j = region.se_min; j <= region.se_max; ++j) {
+				region.vertices.push_back(this->vertices[i * this->size[1] + j]);
+			}
+		}
+	}
+
+	this->dirty = dirty_region_t{};
+	this->has_dirty = false;
+	this->changed = false;
+
+	return region;
+}
+
 const std::vector<coord::scene3> RenderEntity::get_vertices() {
 	std::shared_lock lock{this->mutex};
 
@@ -129,4 +158,36 @@ const util::Vector2s RenderEntity::get_size() {
 	return this->size;
 }
 
+float RenderEntity::vertex_height(size_t ne, size_t se) const {
+	// tiles surrounding the vertex are the ones at
+	// (ne - 1, se - 1), (ne - 1, se), (ne, se), (ne, se - 1)
+	auto tiles_ne = this->size[0] - 1;
+	auto tiles_se = this->size[1] - 1;
+
+	float max_height = 0.0f;
+	for (size_t i = (ne > 0 ? ne - 1 : 0); i <= ne and i < tiles_ne; ++i) {
+		for (size_t j = (se > 0 ? se - 1 : 0); j <= se and j < tiles_se; ++j) {
+			max_height = std::max(max_height, this->tiles[i * tiles_se + j].first.to_float());
+		}
+	}
+
+	return max_height;
+}
+
+void RenderEntity::mark_dirty(size_t ne_min, size_t se_min, size_t ne_max, size_t se_max) {
+	if (not this->has_dirty) {
+		this->dirty.ne_min = ne_min;
+		this->dirty.se_min = se_min;
+		this->dirty.ne_max = ne_max;
+		this->dirty.se_max = se_max;
+		this->has_dirty = true;
+		return;
+	}
+
+	this->dirty.ne_min = std::min(this->dirty.ne_min, ne_min);
+	this->dirty.se_min = std::min(this->dirty.se_min, se_min);
+	this->dirty.ne_max = std::max(this->dirty.ne_max, ne_max);
+	this->dirty.se_max = std::max(this->dirty.se_max, se_max);
+}
+
 } // namespace openage::renderer::terrain
@@ -1,4 +1,4 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -26,6 +26,35 @@ public:
 	using terrain_elevation_t = util::FixedPoint<uint64_t, 16>;
 	using tiles_t = std::vector<std::pair<terrain_elevation_t, std::string>>;
 
+	/**
+	 * Region of the terrain that changed since the last fetch.
+	 */
+	struct dirty_region_t {
+		/**
+		 * Whether the mesh has to be rebuilt from scratch, e.g. because
+		 * the size or the textures of the terrain changed. If true, the
+		 * other members are not set.
+		 */
+		bool rebuild = false;
+
+		/**
+		 * First and last changed vertex on the ne axis (inclusive).
+		 */
+		size_t ne_min = 0;
+		size_t ne_max = 0;
+
+		/**
+		 * First and last changed vertex on the se axis (inclusive).
+		 */
+		size_t se_min = 0;
+		size_t se_max = 0;
+
+		/**
+		 * Changed vertices in the region, ordered ne-major.
+		 */
+		std::vector<coord::scene3> vertices;
+	};
+
 	/**
 	 * Update a single tile of the displayed terrain (chunk) with information from the
 	 * gamestate.
@@ -58,6 +87,16 @@ public:
 	            const tiles_t tiles,
 	            const time::time_t time = 0.0);
 
+	/**
+	 * Get the region that changed since the last call of this method
+	 * and reset the changed flag.
+	 *
+	 * Accessing the dirty region is thread-safe.
+	 *
+	 * @return Changed region of the terrain.
+	 */
+	dirty_region_t fetch_dirty_region();
+
 	/**
 	 * Get the vertices of the terrain.
 	 *
@@ -95,6 +134,26 @@ public:
 	const util::Vector2s get_size();
 
 private:
+	/**
+	 * Get the height of a vertex from its surrounding tiles.
+	 *
+	 * @param ne Position of the vertex on the ne axis.
+	 * @param se Position of the vertex on the se axis.
+	 *
+	 * @return Height of the highest surrounding tile.
+	 */
+	float vertex_height(size_t ne, size_t se) const;
+
+	/**
+	 * Add vertices to the dirty region.
+	 *
+	 * @param ne_min First changed vertex on the ne axis.
+	 * @param se_min First changed vertex on the se axis.
+	 * @param ne_max Last changed vertex on the ne axis.
+	 * @param se_max Last changed vertex on the se axis.
+	 */
+	void mark_dirty(size_t ne_min, size_t se_min, size_t ne_max, size_t se_max);
+
 	/**
 	 * Chunk dimensions (width x height).
 	 */
@@ -111,8 +170,19 @@ private:
 	std::unordered_set<std::string> terrain_paths;
 
 	/**
-	 * Terrain vertices (ingame coordinates).
+	 * Terrain vertices (ingame coordinates), ordered ne-major like the tiles.
 	 */
 	std::vector<coord::scene3> vertices;
+
+	/**
+	 * Region changed since the last fetch. The vertices are only
+	 * filled in by \p fetch_dirty_region().
+	 */
+	dirty_region_t dirty;
+
+	/**
+	 * Whether \p dirty contains any changes.
+	 */
+	bool has_dirty;
 };
 } // namespace openage::renderer::terrain
@@ -1,9 +1,8 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #include "render_stage.h"
 
 #include "renderer/camera/camera.h"
-#include "renderer/opengl/context.h"
 #include "renderer/render_pass.h"
 #include "renderer/render_target.h"
 #include "renderer/renderer.h"
@@ -30,7 +29,7 @@ TerrainRenderStage::TerrainRenderStage(const std::shared_ptr<Window> &window,
 	render_entity{nullptr},
 	model{std::make_shared<TerrainRenderModel>(asset_manager)},
 	clock{clock} {
-	renderer::opengl::GlContext::check_error();
+	this->renderer->check_error();
 
 	auto size = window->get_size();
 	this->initialize_render_pass(size[0], size[1], shaderdir);
@@ -81,6 +80,11 @@ void TerrainRenderStage::update() {
 				mesh->clear_requires_renderable();
 
 				mesh->set_uniforms(transform_unifs);
+				mesh->set_geometry(geometry);
+			}
+			else {
+				// upload vertices that were changed in place
+				mesh->update_geometry();
 			}
 		}
 	}
@@ -120,6 +124,9 @@ void TerrainRenderStage::initialize_render_pass(size_t width,
 
 	auto fbo = this->renderer->create_texture_target({this->output_texture, this->depth_texture});
 	this->render_pass = this->renderer->add_render_pass({}, fbo);
+
+	// terrain chunks are depth tested and don't overlap, so they can be grouped by render state
+	this->render_pass->set_state_sorting(true);
 }
 
 } // namespace openage::renderer::terrain
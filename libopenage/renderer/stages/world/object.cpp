@@ -1,7 +1,8 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #include "object.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <functional>
@@ -33,14 +34,21 @@ namespace openage::renderer::world {
 WorldObject::WorldObject(const std::shared_ptr<renderer::resources::AssetManager> &asset_manager) :
 	require_renderable{true},
 	changed{false},
+	pending_assets{},
+	pending_start{time::TIME_MAX},
 	asset_manager{asset_manager},
 	render_entity{nullptr},
 	ref_id{0},
 	position{nullptr, 0, "", nullptr, SCENE_ORIGIN},
 	angle{nullptr, 0, "", nullptr, 0},
+	animation_path{nullptr, 0},
 	animation_info{nullptr, 0},
 	layer_uniforms{},
-	last_update{0.0} {
+	last_update{0.0},
+	cached_animation{nullptr},
+	cached_textures{},
+	uniform_position{Eigen::Vector3f::Zero()},
+	uniform_frames{} {
 }
 
 void WorldObject::set_render_entity(const std::shared_ptr<RenderEntity> &entity) {
@@ -56,18 +64,46 @@ void WorldObject::fetch_updates(const time::time_t &time) {
 		this->require_renderable = true;
 	}
 
-	if (not this->render_entity->is_changed()) {
+	// only resync the animations once one of the pending ones has been loaded
+	bool assets_loaded = std::any_of(this->pending_assets.begin(),
+	                                 this->pending_assets.end(),
+	                                 [](const auto &asset) {
+										 return asset.second.is_ready();
+									 });
+
+	auto update = this->render_entity->fetch_update();
+	if (not update and not assets_loaded) {
 		// exit early because there is nothing to update
 		return;
 	}
 
-	// Get data from render entity
-	this->ref_id = this->render_entity->get_id();
+	// Animations that were still loading are replaced by resyncing the curve
+	// from the first keyframe that used one of them
+	auto animation_sync_start = this->last_update;
+	if (assets_loaded) {
+		animation_sync_start = std::min(animation_sync_start, this->pending_start);
+		this->pending_assets.clear();
+		this->pending_start = time::TIME_MAX;
+	}
+
+	// Apply all changes made by the gamestate since the last fetch
+	while (update) {
+		this->ref_id = update->ref_id;
+		this->position.sync(update->position.keyframes,
+		                    update->position.start_value,
+		                    update->position.start);
+		if (update->angle) {
+			this->angle.sync(update->angle->keyframes,
+			                 update->angle->start_value,
+			                 update->angle->start);
+		}
+		this->animation_path.set_last(update->time, update->animation_path);
+
+		update = this->render_entity->fetch_update();
+	}
 
-	// Thread-safe access to curves needs a lock on the render entity's mutex
-	auto read_lock = this->render_entity->get_read_lock();
-	this->position.sync(this->render_entity->get_position());
-	this->animation_info.sync(this->render_entity->get_animation_path(),
+	bool found_pending = false;
+	this->animation_info.sync(this->animation_path,
 	                          std::function<std::shared_ptr<renderer::resources::Animation2dInfo>(const std::string &)>(
 								  [&](const std::string &path) {
 									  if (path.empty()) {
@@ -77,100 +113,118 @@ void WorldObject::fetch_updates(const time::time_t &time) {
 										  }
 										  return std::shared_ptr<renderer::resources::Animation2dInfo>{nullptr};
 									  }
-									  return this->asset_manager->request_animation(path);
+									  auto handle = this->asset_manager->request_animation_async(path);
+									  if (not handle.is_ready()) {
+										  this->pending_assets.try_emplace(path, handle);
+										  found_pending = true;
+									  }
+									  return handle.get();
 								  }),
-	                          this->last_update);
-	this->angle.sync(this->render_entity->get_angle(), this->last_update);
+	                          animation_sync_start);
 
-	// Unlock mutex of the render entity
-	read_lock.unlock();
+	if (found_pending) {
+		// the value at the sync start may come from an earlier keyframe
+		if (this->pending_assets.contains(this->animation_path.get(animation_sync_start))) {
+			this->pending_start = std::min(this->pending_start, animation_sync_start);
+		}
+		else {
+			for (const auto &keyframe : this->animation_path.get_container()) {
+				if (keyframe.time() >= animation_sync_start
+				    and this->pending_assets.contains(keyframe.val())) {
+					this->pending_start = std::min(this->pending_start, keyframe.time());
+					break;
+				}
+			}
+		}
+	}
 
 	// Set self to changed so that world renderer can update the renderable
 	this->changed = true;
-	this->render_entity->clear_changed_flag();
 	this->last_update = time;
 }
 
-void WorldObject::update_uniforms(const time::time_t &time) {
-	// TODO: Only update uniforms that changed since last update
+void WorldObject::update_uniforms(const Eigen::Vector3f &position,
+                                  const time::time_t &time) {
 	if (this->layer_uniforms.empty()) [[unlikely]] {
 		return;
 	}
 
+	// Animation information
+	auto [last_update, animation_info] = this->animation_info.frame(time);
+	this->set_cached_animation(animation_info);
+
+	// Set all values if the uniforms are new
+	bool set_all = this->uniform_frames.size() != this->layer_uniforms.size();
+	if (set_all) {
+		this->uniform_frames.assign(this->layer_uniforms.size(), layer_frame{});
+	}
+
 	// Object world position
-	auto current_pos = this->position.get(time);
+	bool position_changed = set_all or position != this->uniform_position;
+	this->uniform_position = position;
 
 	// Direction angle the object is facing towards currently
 	auto angle_degrees = this->angle.get(time).to_float();
 
-	// Animation information
-	auto [last_update, animation_info] = this->animation_info.frame(time);
-
 	for (size_t layer_idx = 0; layer_idx < this->layer_uniforms.size(); ++layer_idx) {
 		auto &layer_unifs = this->layer_uniforms.at(layer_idx);
-		layer_unifs->update(this->obj_world_position, current_pos.to_world_space());
-
-		// Frame subtexture
-		auto &layer = animation_info->get_layer(layer_idx);
-		auto &angle = layer.get_direction_angle(angle_degrees);
-
-		// Flip subtexture horizontally if angle is mirrored
-		if (angle->is_mirrored()) {
-			layer_unifs->update(this->flip_x, true);
-		}
-		else {
-			layer_unifs->update(this->flip_x, false);
+		if (position_changed) {
+			layer_unifs->update(this->obj_world_position, position);
 		}
 
-		// Current frame index considering current time
-		size_t frame_idx;
-		switch (layer.get_display_mode()) {
-		case renderer::resources::display_mode::ONCE:
-		case renderer::resources::display_mode::LOOP: {
-			// ONCE and LOOP are animated based on time
-			auto &timing = layer.get_frame_timing();
-			frame_idx = timing->get_frame(time, last_update);
-		} break;
-		case renderer::resources::display_mode::OFF:
-		default:
-			// OFF only shows the first frame
-			frame_idx = 0;
-			break;
+		// The other uniforms only depend on the displayed frame
+		auto frame = this->get_layer_frame(*animation_info,
+		                                   layer_idx,
+		                                   angle_degrees,
+		                                   time,
+		                                   last_update);
+		if (frame == this->uniform_frames[layer_idx]) {
+			continue;
 		}
+		this->uniform_frames[layer_idx] = frame;
 
-		// Index of texture and subtexture where the frame's pixels are located
-		auto &frame_info = angle->get_frame(frame_idx);
-		auto tex_idx = frame_info->get_texture_idx();
-		auto subtex_idx = frame_info->get_subtexture_idx();
+		auto sprite = this->get_frame_sprite(*animation_info, frame);
+		auto &texture = this->get_texture(frame.frame->get_texture_idx());
 
-		auto &tex_info = animation_info->get_texture(tex_idx);
-		auto &tex_manager = this->asset_manager->get_texture_manager();
-		auto &texture = tex_manager->request(tex_info->get_image_path().value());
+		layer_unifs->update(this->flip_x, sprite.flip[0] > 0.0f);
 		layer_unifs->update(this->tex, texture);
+		layer_unifs->update(this->tile_params,
+		                    Eigen::Vector4f{sprite.tile_params[0],
+		                                    sprite.tile_params[1],
+		                                    sprite.tile_params[2],
+		                                    sprite.tile_params[3]});
+		layer_unifs->update(this->scale, sprite.scale);
+		layer_unifs->update(this->subtex_size,
+		                    Eigen::Vector2f{sprite.subtex_size[0], sprite.subtex_size[1]});
+		layer_unifs->update(this->anchor_offset,
+		                    Eigen::Vector2f{sprite.anchor_offset[0], sprite.anchor_offset[1]});
+	}
+}
 
-		// Subtexture coordinates.inside texture
-		auto coords = tex_info->get_subtex_info(subtex_idx).get_subtex_coords();
-		layer_unifs->update(this->tile_params, coords);
-
-		// Animation scale factor
-		// Scales the subtex up or down in the shader
-		auto scale = animation_info->get_scalefactor();
-		layer_unifs->update(this->scale, scale);
+void WorldObject::add_sprites(SpriteBatch &batch,
+                              const Eigen::Vector3f &position,
+                              const time::time_t &time) {
+	auto [last_update, animation_info] = this->animation_info.frame(time);
+	if (not animation_info) [[unlikely]] {
+		return;
+	}
+	this->set_cached_animation(animation_info);
 
-		// Subtexture size in pixels
-		auto subtex_size = tex_info->get_subtex_info(subtex_idx).get_size();
-		Eigen::Vector2f subtex_size_vec{
-			static_cast<float>(subtex_size[0]),
-			static_cast<float>(subtex_size[1])};
-		layer_unifs->update(this->subtex_size, subtex_size_vec);
+	auto angle_degrees = this->angle.get(time).to_float();
 
-		// Anchor point offset (in pixels)
-		// moves the subtex in the shader so that the anchor point is at the object's position
-		auto anchor = tex_info->get_subtex_info(subtex_idx).get_anchor_params();
-		Eigen::Vector2f anchor_offset{
-			static_cast<float>(anchor[0]),
-			static_cast<float>(anchor[1])};
-		layer_unifs->update(this->anchor_offset, anchor_offset);
+	for (size_t layer_idx = 0; layer_idx < animation_info->get_layer_count(); ++layer_idx) {
+		auto frame = this->get_layer_frame(*animation_info,
+		                                   layer_idx,
+		                                   angle_degrees,
+		                                   time,
+		                                   last_update);
+		auto sprite = this->get_frame_sprite(*animation_info, frame);
+		sprite.position = {position[0], position[1], position[2]};
+		sprite.id = this->ref_id;
+
+		batch.add(animation_info->get_layer(layer_idx).get_position(),
+		          this->get_texture(frame.frame->get_texture_idx()),
+		          sprite);
 	}
 }
 
@@ -178,6 +232,10 @@ uint32_t WorldObject::get_id() {
 	return this->ref_id;
 }
 
+const curve::Continuous<coord::scene3> &WorldObject::get_position() const {
+	return this->position;
+}
+
 const renderer::resources::MeshData WorldObject::get_mesh() {
 	return resources::MeshData::make_quad();
 }
@@ -228,17 +286,104 @@ void WorldObject::clear_changed_flag() {
 
 void WorldObject::set_uniforms(std::vector<std::shared_ptr<renderer::UniformInput>> &&uniforms) {
 	this->layer_uniforms = std::move(uniforms);
+	this->uniform_frames.clear();
 }
 
 bool WorldObject::is_visible(const camera::Frustum2d &frustum,
+                             const Eigen::Vector3f &position,
                              const time::time_t &time) {
 	static const Eigen::Matrix4f model_matrix = this->get_model_matrix();
-	Eigen::Vector3f current_pos = this->position.get(time).to_world_space();
 	auto animation_info = this->animation_info.get(time);
-	return frustum.in_frustum(current_pos,
+	return frustum.in_frustum(position,
 	                          model_matrix,
 	                          animation_info->get_scalefactor(),
 	                          animation_info->get_max_bounds());
 }
 
+WorldObject::layer_frame WorldObject::get_layer_frame(const renderer::resources::Animation2dInfo &animation_info,
+                                                      size_t layer_idx,
+                                                      float angle_degrees,
+                                                      const time::time_t &time,
+                                                      const time::time_t &last_update) const {
+	auto &layer = animation_info.get_layer(layer_idx);
+	auto &angle = layer.get_direction_angle(angle_degrees);
+
+	// Current frame index considering current time
+	size_t frame_idx;
+	switch (layer.get_display_mode()) {
+	case renderer::resources::display_mode::ONCE:
+	case renderer::resources::display_mode::LOOP: {
+		// ONCE and LOOP are animated based on time
+		auto &timing = layer.get_frame_timing();
+		frame_idx = timing->get_frame(time, last_update);
+	} break;
+	case renderer::resources::display_mode::OFF:
+	default:
+		// OFF only shows the first frame
+		frame_idx = 0;
+		break;
+	}
+
+	return layer_frame{angle->get_frame(frame_idx).get(), angle->is_mirrored()};
+}
+
+sprite_instance WorldObject::get_frame_sprite(const renderer::resources::Animation2dInfo &animation_info,
+                                              const layer_frame &frame) const {
+	sprite_instance sprite{};
+
+	// Flip subtexture horizontally if angle is mirrored
+	sprite.flip = {frame.mirrored ? 1.0f : 0.0f, 0.0f};
+
+	// Index of texture and subtexture where the frame's pixels are located
+	auto tex_idx = frame.frame->get_texture_idx();
+	auto subtex_idx = frame.frame->get_subtexture_idx();
+
+	auto &tex_info = animation_info.get_texture(tex_idx);
+	auto &subtex_info = tex_info->get_subtex_info(subtex_idx);
+
+	// Subtexture coordinates.inside texture
+	auto &coords = subtex_info.get_subtex_coords();
+	sprite.tile_params = {coords[0], coords[1], coords[2], coords[3]};
+
+	// Animation scale factor
+	// Scales the subtex up or down in the shader
+	sprite.scale = animation_info.get_scalefactor();
+
+	// Subtexture size in pixels
+	auto &subtex_size = subtex_info.get_size();
+	sprite.subtex_size = {static_cast<float>(subtex_size[0]),
+	                      static_cast<float>(subtex_size[1])};
+
+	// Anchor point offset (in pixels)
+	// moves the subtex in the shader so that the anchor point is at the object's position
+	auto &anchor = subtex_info.get_anchor_params();
+	sprite.anchor_offset = {static_cast<float>(anchor[0]),
+	                        static_cast<float>(anchor[1])};
+
+	return sprite;
+}
+
+const std::shared_ptr<Texture2d> &WorldObject::get_texture(size_t tex_idx) {
+	auto &texture = this->cached_textures.at(tex_idx);
+	if (texture == nullptr) [[unlikely]] {
+		auto &tex_info = this->cached_animation->get_texture(tex_idx);
+		auto &tex_manager = this->asset_manager->get_texture_manager();
+		texture = tex_manager->request(tex_info->get_image_path().value());
+	}
+
+	return texture;
+}
+
+void WorldObject::set_cached_animation(const std::shared_ptr<renderer::resources::Animation2dInfo> &animation_info) {
+	if (animation_info == this->cached_animation) [[likely]] {
+		return;
+	}
+
+	this->cached_animation = animation_info;
+	this->cached_textures.assign(animation_info ? animation_info->get_texture_count() : 0, nullptr);
+
+	// frames of the old animation must not be compared to the new ones
+	this->uniform_frames.clear();
+}
+
 } // namespace openage::renderer::world
@@ -1,4 +1,4 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
@@ -6,17 +6,24 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <eigen3/Eigen/Dense>
 
 #include "coord/scene.h"
 #include "curve/continuous.h"
 #include "curve/discrete.h"
 #include "curve/segmented.h"
+#include "renderer/resources/assets/asset_handle.h"
 #include "renderer/resources/mesh_data.h"
+#include "renderer/stages/world/sprite_batch.h"
 #include "renderer/types.h"
 #include "time/time.h"
 
 
 namespace openage::renderer {
+class Texture2d;
 class UniformInput;
 
 namespace camera {
@@ -26,6 +33,7 @@ class Frustum2d;
 namespace resources {
 class AssetManager;
 class Animation2dInfo;
+class FrameInfo;
 } // namespace resources
 
 namespace world {
@@ -61,9 +69,28 @@ public:
 	/**
 	 * Update the uniforms of the renderable associated with this object.
 	 *
+	 * Only uniforms whose values changed since the last call are updated.
+	 * The position is compared by value, the sprite uniforms of a layer
+	 * are only updated if the displayed frame changed.
+	 *
+	 * @param position Current position of the object in world space.
+	 * @param time Current simulation time.
+	 */
+	void update_uniforms(const Eigen::Vector3f &position,
+	                     const time::time_t &time = 0.0);
+
+	/**
+	 * Add the sprite layers of this object at the given time to a sprite batch.
+	 *
+	 * Used for instanced drawing instead of \p update_uniforms().
+	 *
+	 * @param batch Sprite batch of the current frame.
+	 * @param position Current position of the object in world space.
 	 * @param time Current simulation time.
 	 */
-	void update_uniforms(const time::time_t &time = 0.0);
+	void add_sprites(SpriteBatch &batch,
+	                 const Eigen::Vector3f &position,
+	                 const time::time_t &time = 0.0);
 
 	/**
 	 * Get the ID of the corresponding game entity.
@@ -72,6 +99,15 @@ public:
 	 */
 	uint32_t get_id();
 
+	/**
+	 * Get the position of the object.
+	 *
+	 * Allows evaluating the positions of many objects at once.
+	 *
+	 * @return Position curve.
+	 */
+	const curve::Continuous<coord::scene3> &get_position() const;
+
 	/**
 	 * Get the quad for creating the geometry.
 	 *
@@ -127,7 +163,7 @@ public:
 
 	/**
 	 * Set the uniform inputs for the layers of this object.
-	 * Layer uniforms are updated on every update call.
+	 * All values of new layer uniforms are set on the next update call.
 	 *
 	 * @param uniforms Uniform inputs of this object's layers.
 	 */
@@ -137,11 +173,13 @@ public:
 	 * Check whether the object is visible in the camera view.
 	 *
 	 * @param frustum Camera frustum for culling.
+	 * @param position Current position of the object in world space.
 	 * @param time Current simulation time.
 	 *
 	 * @return true if the object is visible, else false.
 	 */
 	bool is_visible(const camera::Frustum2d &frustum,
+	                const Eigen::Vector3f &position,
 	                const time::time_t &time);
 
 	/**
@@ -157,6 +195,72 @@ public:
 	inline static uniform_id_t anchor_offset;
 
 private:
+	/**
+	 * Frame of an animation layer.
+	 */
+	struct layer_frame {
+		/**
+		 * Displayed frame. nullptr if no frame has been displayed yet.
+		 */
+		const resources::FrameInfo *frame = nullptr;
+
+		/**
+		 * Whether the frame is mirrored horizontally.
+		 */
+		bool mirrored = false;
+
+		bool operator==(const layer_frame &other) const = default;
+	};
+
+	/**
+	 * Get the frame of an animation layer that is displayed at the given time.
+	 *
+	 * @param animation_info Animation of the object.
+	 * @param layer_idx Index of the layer.
+	 * @param angle_degrees Direction angle the object is facing towards.
+	 * @param time Current simulation time.
+	 * @param last_update Time when the animation was set.
+	 *
+	 * @return Frame of the layer.
+	 */
+	layer_frame get_layer_frame(const renderer::resources::Animation2dInfo &animation_info,
+	                            size_t layer_idx,
+	                            float angle_degrees,
+	                            const time::time_t &time,
+	                            const time::time_t &last_update) const;
+
+	/**
+	 * Get the sprite data of a frame.
+	 *
+	 * @param animation_info Animation of the object.
+	 * @param frame Frame of a layer of the animation.
+	 *
+	 * @return Sprite data of the frame. The position and ID are not set.
+	 */
+	sprite_instance get_frame_sprite(const renderer::resources::Animation2dInfo &animation_info,
+	                                 const layer_frame &frame) const;
+
+	/**
+	 * Get the texture of the current animation with the given index.
+	 *
+	 * Textures are requested from the texture manager only once per
+	 * animation and then cached in the object.
+	 *
+	 * @param tex_idx Index of the texture in the animation.
+	 *
+	 * @return Texture.
+	 */
+	const std::shared_ptr<Texture2d> &get_texture(size_t tex_idx);
+
+	/**
+	 * Set the animation for the texture and uniform caches.
+	 *
+	 * Resets the caches if the animation is different from the cached one.
+	 *
+	 * @param animation_info Current animation of the object.
+	 */
+	void set_cached_animation(const std::shared_ptr<renderer::resources::Animation2dInfo> &animation_info);
+
 	/**
 	 * Stores whether a new renderable for this object needs to be created
 	 * for the render pass.
@@ -168,6 +272,17 @@ private:
 	 */
 	bool changed;
 
+	/**
+	 * Animations of the object that are still loaded in the background, by path.
+	 * Once one of them is ready, the animations are resynced from \p pending_start.
+	 */
+	std::unordered_map<std::string, resources::AssetHandle<resources::Animation2dInfo>> pending_assets;
+
+	/**
+	 * Time of the earliest animation keyframe that uses a pending animation.
+	 */
+	time::time_t pending_start;
+
 	/**
 	 * Asset manager for central accessing and loading asset resources.
 	 */
@@ -195,6 +310,11 @@ private:
 	 */
 	curve::Segmented<coord::phys_angle_t> angle;
 
+	/**
+	 * Paths to the animation definitions requested by the gamestate.
+	 */
+	curve::Discrete<std::string> animation_path;
+
 	/**
 	 * Animation information for the layers.
 	 */
@@ -210,6 +330,28 @@ private:
 	 * Time of the last update call.
 	 */
 	time::time_t last_update;
+
+	/**
+	 * Animation that the cached textures and frames belong to.
+	 */
+	std::shared_ptr<renderer::resources::Animation2dInfo> cached_animation;
+
+	/**
+	 * Textures of the cached animation, by texture index.
+	 * nullptr if the texture has not been requested yet.
+	 */
+	std::vector<std::shared_ptr<Texture2d>> cached_textures;
+
+	/**
+	 * World position that was last set in the layer uniforms.
+	 */
+	Eigen::Vector3f uniform_position;
+
+	/**
+	 * Frames that were last set in the layer uniforms, by layer index.
+	 * Empty if the layer uniforms have not been set yet.
+	 */
+	std::vector<layer_frame> uniform_frames;
 };
 } // namespace world
 } // namespace openage::renderer
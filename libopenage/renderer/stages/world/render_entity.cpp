@@ -1,21 +1,55 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #include "render_entity.h"
 
+#include <algorithm>
 #include <functional>
+#include <memory>
 #include <mutex>
-
-#include "renderer/definitions.h"
+#include <utility>
 
 
 namespace openage::renderer::world {
 
-RenderEntity::RenderEntity() :
+namespace {
+
+/**
+ * Get the changes of a curve since a point in time.
+ *
+ * @param curve Curve of the gamestate.
+ * @param converter Converts the values to the type used by the renderer.
+ * @param start Time of the last update.
+ *
+ * @return Keyframes with t >= start and the value at \p start.
+ */
+template <typename T, typename O>
+RenderEntity::curve_update_t<T> get_curve_update(const curve::BaseCurve<O> &curve,
+                                                 const std::function<T(const O &)> &converter,
+                                                 const time::time_t &start) {
+	RenderEntity::curve_update_t<T> update{start, converter(curve.get(start)), {}};
+
+	// skip the default element at t = -inf
+	const auto &container = curve.get_container();
+	for (size_t i = std::max<size_t>(container.last_before(start) + 1, 1); i < container.size(); ++i) {
+		const auto &keyframe = container.get(i);
+		update.keyframes.emplace_back(keyframe.time(), converter(keyframe.val()));
+	}
+
+	return update;
+}
+
+} // namespace
+
+
+RenderEntity::RenderEntity(size_t queue_size, size_t max_queue_size) :
 	renderer::RenderEntity{},
-	ref_id{0},
-	position{nullptr, 0, "", nullptr, SCENE_ORIGIN},
-	angle{nullptr, 0, "", nullptr, 0},
-	animation_path{nullptr, 0} {
+	updates{queue_size, max_queue_size},
+	resync{nullptr},
+	resync_start{time::TIME_MIN} {
+}
+
+RenderEntity::~RenderEntity() {
+	delete this->resync.load(std::memory_order_acquire);
 }
 
 void RenderEntity::update(const uint32_t ref_id,
@@ -23,20 +57,28 @@ void RenderEntity::update(const uint32_t ref_id,
                           const curve::Segmented<coord::phys_angle_t> &angle,
                           const std::string animation_path,
                           const time::time_t time) {
-	std::unique_lock lock{this->mutex};
+	// only the gamestate writes the update time, so reading it needs no lock
+	auto start = this->last_update;
 
-	this->ref_id = ref_id;
 	std::function<coord::scene3(const coord::phys3 &)> to_scene3 = [](const coord::phys3 &pos) {
 		return pos.to_scene3();
 	};
-	this->position.sync(position,
-	                    std::function<coord::scene3(const coord::phys3 &)>([](const coord::phys3 &pos) {
-							return pos.to_scene3();
-						}),
-	                    this->last_update);
-	this->angle.sync(angle, this->last_update);
-	this->animation_path.set_last(time, animation_path);
-	this->changed = true;
+	std::function<coord::phys_angle_t(const coord::phys_angle_t &)> identity = [](const coord::phys_angle_t &a) {
+		return a;
+	};
+
+	auto make_update = [&](const time::time_t &from) {
+		return update_t{
+			ref_id,
+			get_curve_update(position, to_scene3, from),
+			get_curve_update(angle, identity, from),
+			animation_path,
+			time,
+		};
+	};
+	this->publish(make_update(start), start, make_update);
+
+	std::unique_lock lock{this->mutex};
 	this->last_update = time;
 }
 
@@ -44,37 +86,52 @@ void RenderEntity::update(const uint32_t ref_id,
                           const coord::phys3 position,
                           const std::string animation_path,
                           const time::time_t time) {
-	std::unique_lock lock{this->mutex};
+	// the update contains the whole state, so merging just replaces the pending update
+	auto make_update = [&](const time::time_t & /* from */) {
+		return update_t{
+			ref_id,
+			{time, position.to_scene3(), {}},
+			std::nullopt,
+			animation_path,
+			time,
+		};
+	};
+	this->publish(make_update(time), time, make_update);
 
-	this->ref_id = ref_id;
-	this->position.set_last(time, position.to_scene3());
-	this->animation_path.set_last(time, animation_path);
-	this->changed = true;
+	std::unique_lock lock{this->mutex};
 	this->last_update = time;
 }
 
-uint32_t RenderEntity::get_id() {
-	std::shared_lock lock{this->mutex};
+std::optional<RenderEntity::update_t> RenderEntity::fetch_update() {
+	auto update = this->updates.try_pop();
+	if (update) [[likely]] {
+		return update;
+	}
 
-	return this->ref_id;
-}
+	// the merged update is newer than everything in the queue
+	std::unique_ptr<update_t> pending{this->resync.exchange(nullptr, std::memory_order_acq_rel)};
+	if (pending) {
+		return std::move(*pending);
+	}
 
-const curve::Continuous<coord::scene3> &RenderEntity::get_position() {
-	std::shared_lock lock{this->mutex};
-
-	return this->position;
+	return std::nullopt;
 }
 
-const curve::Segmented<coord::phys_angle_t> &RenderEntity::get_angle() {
-	std::shared_lock lock{this->mutex};
-
-	return this->angle;
-}
-
-const curve::Discrete<std::string> &RenderEntity::get_animation_path() {
-	std::shared_lock lock{this->mutex};
-
-	return this->animation_path;
+void RenderEntity::publish(update_t &&update,
+                           const time::time_t &start,
+                           const std::function<update_t(const time::time_t &)> &make_resync) {
+	// while a merged update is pending, newer updates must not overtake it in the queue
+	if (this->resync.load(std::memory_order_acquire) == nullptr) [[likely]] {
+		if (this->updates.push(std::move(update))) [[likely]] {
+			return;
+		}
+		this->resync_start = start;
+	}
+
+	// the renderer may have taken the previous merged update in the meantime,
+	// which is fine because the new one contains all of its changes
+	auto merged = new update_t{make_resync(this->resync_start)};
+	delete this->resync.exchange(merged, std::memory_order_acq_rel);
 }
 
 } // namespace openage::renderer::world
@@ -1,15 +1,21 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "coord/phys.h"
 #include "coord/scene.h"
 #include "curve/continuous.h"
-#include "curve/discrete.h"
+#include "curve/keyframe.h"
 #include "curve/segmented.h"
+#include "datastructure/spsc_queue.h"
 #include "renderer/stages/render_entity.h"
 
 
@@ -17,16 +23,63 @@ namespace openage::renderer::world {
 
 /**
  * Render entity for pushing updates to the World renderer.
+ *
+ * The gamestate publishes the keyframes that changed since its last update
+ * and the renderer applies them to its own curves. Updates are passed through
+ * a lock-free queue, so neither side ever waits for the other.
+ *
+ * The queue has a fixed maximum size. If it is full, e.g. because the renderer
+ * stalls, further updates are merged into a single pending update that contains
+ * the curves from the start of the first merged update. It is passed to the
+ * renderer once the queue is empty.
  */
 class RenderEntity final : public renderer::RenderEntity {
 public:
-	RenderEntity();
-	~RenderEntity() = default;
+	/**
+	 * Keyframes that replace all keyframes of a curve at t >= start.
+	 */
+	template <typename T>
+	struct curve_update_t {
+		/// Start time at which keyframes are replaced.
+		time::time_t start;
+		/// Value of the curve at \p start.
+		T start_value;
+		/// Keyframes with t >= start.
+		std::vector<curve::Keyframe<T>> keyframes;
+	};
+
+	/**
+	 * Changes of a single \p update() call.
+	 */
+	struct update_t {
+		/// Game entity ID.
+		uint32_t ref_id;
+		/// Changes of the position curve.
+		curve_update_t<coord::scene3> position;
+		/// Changes of the angle curve (if the angle was updated).
+		std::optional<curve_update_t<coord::phys_angle_t>> angle;
+		/// Path to the animation definition.
+		std::string animation_path;
+		/// Simulation time of the update.
+		time::time_t time;
+	};
+
+	/**
+	 * Create a new render entity.
+	 *
+	 * @param queue_size Initial number of updates that can be passed to the renderer
+	 *                   before the queue has to grow.
+	 * @param max_queue_size Maximum number of updates in the queue. Further updates
+	 *                       are merged until the renderer fetched them.
+	 */
+	RenderEntity(size_t queue_size = 64,
+	             size_t max_queue_size = 1024);
+	~RenderEntity();
 
 	/**
 	 * Update the render entity with information from the gamestate.
 	 *
-	 * Updating the render entity with this method is thread-safe.
+	 * Never blocks. Must not be called from multiple threads at the same time.
 	 *
 	 * @param ref_id Game entity ID.
 	 * @param position Position of the game entity inside the game world.
@@ -45,7 +98,7 @@ public:
 	 *
 	 * Update the render entity with information from the gamestate.
 	 *
-	 * Updating the render entity with this method is thread-safe.
+	 * Never blocks. Must not be called from multiple threads at the same time.
 	 *
 	 * @param ref_id Game entity ID.
 	 * @param position Position of the game entity inside the game world.
@@ -58,63 +111,42 @@ public:
 	            const time::time_t time = 0.0);
 
 	/**
-	 * Get the ID of the corresponding game entity.
-	 *
-	 * Accessing the game entity ID is thread-safe.
-	 *
-	 * @return Game entity ID.
-	 */
-	uint32_t get_id();
-
-	/**
-	 * Get the position of the entity inside the game world.
+	 * Take the oldest update that the renderer has not fetched yet.
 	 *
-	 * Accessing the position curve REQUIRES a read lock on the render entity
-	 * (using \p get_read_lock()) to ensure thread safety.
+	 * Never blocks. Must not be called from multiple threads at the same time.
 	 *
-	 * @return Position curve of the entity.
+	 * @return Update or \p std::nullopt if there are no new updates.
 	 */
-	const curve::Continuous<coord::scene3> &get_position();
-
-	/**
-	 * Get the angle of the entity inside the game world.
-	 *
-	 * Accessing the angle curve REQUIRES a read lock on the render entity
-	 * (using \p get_read_lock()) to ensure thread safety.
-	 *
-	 * @return Angle curve of the entity.
-	 */
-	const curve::Segmented<coord::phys_angle_t> &get_angle();
-
-	/**
-	 * Get the animation definition path.
-	 *
-	 * Accessing the animation path curve requires a read lock on the render entity
-	 * (using \p get_read_lock()) to ensure thread safety.
-	 *
-	 * @return Path to the animation definition file.
-	 */
-	const curve::Discrete<std::string> &get_animation_path();
+	std::optional<update_t> fetch_update();
 
 private:
 	/**
-	 * ID of the game entity in the gamestate.
+	 * Pass an update to the renderer.
+	 *
+	 * @param update Update with the changes since \p start.
+	 * @param start Start of the changes in \p update.
+	 * @param make_resync Creates an update with all changes since a given time.
+	 *                    Used if the update has to be merged with pending updates.
 	 */
-	uint32_t ref_id;
+	void publish(update_t &&update,
+	             const time::time_t &start,
+	             const std::function<update_t(const time::time_t &)> &make_resync);
 
 	/**
-	 * Position inside the game world.
+	 * Updates for the renderer.
 	 */
-	curve::Continuous<coord::scene3> position;
+	datastructure::SPSCQueue<update_t> updates;
 
 	/**
-	 * Angle of the entity inside the game world.
+	 * Update that merges all updates which didn't fit into the queue.
+	 * Set by the gamestate, taken by the renderer after the queue is empty.
 	 */
-	curve::Segmented<coord::phys_angle_t> angle;
+	std::atomic<update_t *> resync;
 
 	/**
-	 * Path to the animation definition file.
+	 * Start of the changes in \p resync. Only accessed by the gamestate.
 	 */
-	curve::Discrete<std::string> animation_path;
+	time::time_t resync_start;
 };
+
 } // namespace openage::renderer::world
@@ -1,18 +1,23 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #include "render_stage.h"
 
+#include <algorithm>
+
+#include "curve/continuous.h"
 #include "renderer/camera/camera.h"
 #include "renderer/camera/frustum_3d.h"
-#include "renderer/opengl/context.h"
+#include "renderer/geometry.h"
 #include "renderer/render_pass.h"
 #include "renderer/render_target.h"
+#include "renderer/renderer.h"
 #include "renderer/resources/assets/asset_manager.h"
 #include "renderer/resources/shader_source.h"
 #include "renderer/resources/texture_info.h"
 #include "renderer/shader_program.h"
 #include "renderer/stages/world/object.h"
 #include "renderer/texture.h"
+#include "renderer/uniform_input.h"
 #include "renderer/window.h"
 #include "time/clock.h"
 
@@ -20,6 +25,7 @@
 namespace openage::renderer::world {
 
 bool WorldRenderStage::ENABLE_FRUSTUM_CULLING = false;
+bool WorldRenderStage::ENABLE_INSTANCING = true;
 
 WorldRenderStage::WorldRenderStage(const std::shared_ptr<Window> &window,
                                    const std::shared_ptr<renderer::Renderer> &renderer,
@@ -32,8 +38,13 @@ WorldRenderStage::WorldRenderStage(const std::shared_ptr<Window> &window,
 	asset_manager{asset_manager},
 	render_objects{},
 	clock{clock},
-	default_geometry{this->renderer->add_mesh_geometry(WorldObject::get_mesh())} {
-	renderer::opengl::GlContext::check_error();
+	default_geometry{this->renderer->add_mesh_geometry(WorldObject::get_mesh())},
+	instanced_geometry{this->renderer->add_instanced_geometry(WorldObject::get_mesh(),
+	                                                          SpriteBatch::get_instance_info())},
+	sprite_batch{},
+	batch_uniforms{},
+	batch_keys{} {
+	this->renderer->check_error();
 
 	auto size = window->get_size();
 	this->initialize_render_pass(size[0], size[1], shaderdir);
@@ -58,15 +69,46 @@ void WorldRenderStage::add_render_entity(const std::shared_ptr<RenderEntity> ent
 	this->render_objects.push_back(world_object);
 }
 
+void WorldRenderStage::prefetch_animations(const std::vector<std::string> &rel_paths) {
+	this->asset_manager->prefetch_animations(rel_paths);
+}
+
 void WorldRenderStage::update() {
 	std::unique_lock lock{this->mutex};
 	auto current_time = this->clock->get_real_time();
-	auto &camera_frustum = this->camera->get_frustum_2d();
+
+	if (WorldRenderStage::ENABLE_INSTANCING) {
+		this->update_batches(current_time);
+	}
+	else {
+		this->update_renderables(current_time);
+	}
+}
+
+void WorldRenderStage::update_positions(const time::time_t &current_time) {
+	this->position_curves.clear();
 	for (auto &obj : this->render_objects) {
 		obj->fetch_updates(current_time);
+		this->position_curves.push_back(&obj->get_position());
+	}
+
+	this->positions.resize(this->position_curves.size(), coord::scene3{0, 0, 0});
+	curve::evaluate_all<coord::scene3>(this->position_curves,
+	                                   current_time,
+	                                   this->positions,
+	                                   this->position_buffers);
+}
+
+void WorldRenderStage::update_renderables(const time::time_t &current_time) {
+	this->update_positions(current_time);
+
+	auto &camera_frustum = this->camera->get_frustum_2d();
+	for (size_t i = 0; i < this->render_objects.size(); ++i) {
+		auto &obj = this->render_objects[i];
+		auto position = this->positions[i].to_world_space();
 
 		if (WorldRenderStage::ENABLE_FRUSTUM_CULLING
-		    and not obj->is_visible(camera_frustum, current_time)) {
+		    and not obj->is_visible(camera_frustum, position, current_time)) {
 			continue;
 		}
 
@@ -104,10 +146,104 @@ void WorldRenderStage::update() {
 				obj->set_uniforms(std::move(transform_unifs));
 			}
 		}
-		obj->update_uniforms(current_time);
+		obj->update_uniforms(position, current_time);
+	}
+}
+
+void WorldRenderStage::update_batches(const time::time_t &current_time) {
+	this->update_positions(current_time);
+
+	auto &camera_frustum = this->camera->get_frustum_2d();
+
+	this->sprite_batch.clear();
+	for (size_t i = 0; i < this->render_objects.size(); ++i) {
+		auto &obj = this->render_objects[i];
+		auto position = this->positions[i].to_world_space();
+
+		if (WorldRenderStage::ENABLE_FRUSTUM_CULLING
+		    and not obj->is_visible(camera_frustum, position, current_time)) {
+			continue;
+		}
+
+		obj->add_sprites(this->sprite_batch, position, current_time);
+	}
+
+	this->sprite_batch.build();
+	this->instanced_geometry->update_instances(this->sprite_batch.get_instance_data());
+
+	const auto &batches = this->sprite_batch.get_batches();
+	bool batches_changed = batches.size() != this->batch_keys.size();
+	for (size_t i = 0; i < batches.size() and not batches_changed; ++i) {
+		batches_changed = batches[i].layer != this->batch_keys[i].first
+		                  or batches[i].texture.get() != this->batch_keys[i].second;
+	}
+
+	if (batches_changed) {
+		this->rebuild_batch_renderables();
+		return;
+	}
+
+	// usually only the number of sprites per batch changes, which
+	// doesn't require the render pass to be compiled again
+	size_t index = 0;
+	for (size_t i = 0; i < batches.size(); ++i) {
+		if (i > 0 and batches[i].layer != batches[i - 1].layer) {
+			index = 0;
+		}
+		this->render_pass->set_instance_range(batches[i].layer,
+		                                      index,
+		                                      batches[i].offset,
+		                                      batches[i].count);
+		index += 1;
 	}
 }
 
+void WorldRenderStage::rebuild_batch_renderables() {
+	const auto &batches = this->sprite_batch.get_batches();
+
+	this->render_pass->clear_renderables();
+	this->batch_keys.clear();
+
+	// the renderables of each layer are added at once
+	std::vector<Renderable> layer_batches;
+	for (size_t i = 0; i < batches.size(); ++i) {
+		const auto &batch = batches[i];
+		layer_batches.push_back(Renderable{
+			this->get_batch_uniforms(batch.texture),
+			this->instanced_geometry,
+			true,
+			true,
+			batch.offset,
+			batch.count,
+		});
+		this->batch_keys.emplace_back(batch.layer, batch.texture.get());
+
+		if (i + 1 == batches.size() or batches[i + 1].layer != batch.layer) {
+			this->render_pass->add_renderables(std::move(layer_batches), batch.layer);
+			layer_batches.clear();
+		}
+	}
+
+	// release the textures that are not drawn anymore
+	std::erase_if(this->batch_uniforms, [&](const auto &entry) {
+		return std::none_of(this->batch_keys.begin(),
+		                    this->batch_keys.end(),
+		                    [&](const auto &key) {
+								return key.second == entry.first.get();
+							});
+	});
+}
+
+const std::shared_ptr<renderer::UniformInput> &WorldRenderStage::get_batch_uniforms(const std::shared_ptr<renderer::Texture2d> &texture) {
+	auto it = this->batch_uniforms.find(texture);
+	if (it == this->batch_uniforms.end()) {
+		auto uniforms = this->instanced_shader->new_uniform_input("tex", texture);
+		it = this->batch_uniforms.emplace(texture, std::move(uniforms)).first;
+	}
+
+	return it->second;
+}
+
 void WorldRenderStage::resize(size_t width, size_t height) {
 	this->output_texture = renderer->add_texture(resources::Texture2dInfo(width, height, resources::pixel_format::rgba8));
 	this->depth_texture = renderer->add_texture(resources::Texture2dInfo(width, height, resources::pixel_format::depth24));
@@ -141,6 +277,23 @@ void WorldRenderStage::initialize_render_pass(size_t width,
 	this->display_shader = this->renderer->add_shader({vert_shader_src, frag_shader_src});
 	this->display_shader->bind_uniform_buffer("camera", this->camera->get_uniform_buffer());
 
+	auto inst_vert_shader_file = (shaderdir / "world2d_instanced.vert.glsl").open();
+	auto inst_vert_shader_src = renderer::resources::ShaderSource(
+		resources::shader_lang_t::glsl,
+		resources::shader_stage_t::vertex,
+		inst_vert_shader_file.read());
+	inst_vert_shader_file.close();
+
+	auto inst_frag_shader_file = (shaderdir / "world2d_instanced.frag.glsl").open();
+	auto inst_frag_shader_src = renderer::resources::ShaderSource(
+		resources::shader_lang_t::glsl,
+		resources::shader_stage_t::fragment,
+		inst_frag_shader_file.read());
+	inst_frag_shader_file.close();
+
+	this->instanced_shader = this->renderer->add_shader({inst_vert_shader_src, inst_frag_shader_src});
+	this->instanced_shader->bind_uniform_buffer("camera", this->camera->get_uniform_buffer());
+
 	auto fbo = this->renderer->create_texture_target({this->output_texture, this->depth_texture, this->id_texture});
 	this->render_pass = this->renderer->add_render_pass({}, fbo);
 }
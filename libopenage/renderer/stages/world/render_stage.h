@@ -1,11 +1,18 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <memory>
 #include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "coord/scene.h"
+#include "curve/interpolated.h"
+#include "renderer/stages/world/sprite_batch.h"
+#include "time/time.h"
 #include "util/path.h"
 
 namespace openage {
@@ -20,6 +27,7 @@ class Renderer;
 class RenderPass;
 class ShaderProgram;
 class Texture2d;
+class UniformInput;
 class Window;
 
 namespace camera {
@@ -44,6 +52,14 @@ public:
 	 */
 	static bool ENABLE_FRUSTUM_CULLING;
 
+	/**
+	 * Draw the world objects with one instanced draw call per layer and texture
+	 * instead of one draw call per sprite layer (default = true).
+	 *
+	 * Must be set before the first call to \p update().
+	 */
+	static bool ENABLE_INSTANCING;
+
 	/**
 	 * Create a new render stage for the game world.
 	 *
@@ -76,6 +92,13 @@ public:
 	 */
 	void add_render_entity(const std::shared_ptr<RenderEntity> entity);
 
+	/**
+	 * Start loading animations in the background before they are used by render entities.
+	 *
+	 * @param rel_paths Relative paths to the animation resources (from the asset base dir).
+	 */
+	void prefetch_animations(const std::vector<std::string> &rel_paths);
+
 	/**
 	 * Update the render entities and render positions.
 	 */
@@ -111,6 +134,49 @@ private:
 	 */
 	void init_uniform_ids();
 
+	/**
+	 * Fetch the updates of all render objects and evaluate their
+	 * positions at once.
+	 *
+	 * The positions are stored in \p positions.
+	 *
+	 * @param time Current time.
+	 */
+	void update_positions(const time::time_t &time);
+
+	/**
+	 * Update the render objects and their per-layer renderables.
+	 *
+	 * @param time Current time.
+	 */
+	void update_renderables(const time::time_t &time);
+
+	/**
+	 * Update the render objects, collect their sprites in the sprite batch and
+	 * draw each batch with one renderable of the render pass.
+	 *
+	 * The renderables are only replaced if the layers or textures of the batches
+	 * changed. Otherwise, only their instance ranges are updated.
+	 *
+	 * @param time Current time.
+	 */
+	void update_batches(const time::time_t &time);
+
+	/**
+	 * Replace the renderables of the render pass with one renderable per batch
+	 * and remove the uniform inputs of textures that are no longer drawn.
+	 */
+	void rebuild_batch_renderables();
+
+	/**
+	 * Get the uniform input for drawing a batch with the given texture.
+	 *
+	 * @param texture Texture of the batch.
+	 *
+	 * @return Uniform input of the instanced shader.
+	 */
+	const std::shared_ptr<renderer::UniformInput> &get_batch_uniforms(const std::shared_ptr<renderer::Texture2d> &texture);
+
 	/**
 	 * Reference to the openage renderer.
 	 */
@@ -141,6 +207,11 @@ private:
 	 */
 	std::shared_ptr<renderer::ShaderProgram> display_shader;
 
+	/**
+	 * Shader for drawing the world objects instanced.
+	 */
+	std::shared_ptr<renderer::ShaderProgram> instanced_shader;
+
 	/**
 	 * Simulation clock for timing animations.
 	 */
@@ -155,6 +226,46 @@ private:
 	 */
 	const std::shared_ptr<renderer::Geometry> default_geometry;
 
+	/**
+	 * Quad geometry with the sprite data of the current frame as instances.
+	 */
+	const std::shared_ptr<renderer::Geometry> instanced_geometry;
+
+	/**
+	 * Position curves of the render objects (same order as \p render_objects).
+	 */
+	std::vector<const curve::Interpolated<coord::scene3> *> position_curves;
+
+	/**
+	 * Positions of the render objects in the current frame.
+	 */
+	std::vector<coord::scene3> positions;
+
+	/**
+	 * Buffers for evaluating the position curves, reused between frames.
+	 */
+	curve::evaluate_buffers<coord::scene3> position_buffers;
+
+	/**
+	 * Sprites of the current frame, grouped into batches.
+	 */
+	SpriteBatch sprite_batch;
+
+	/**
+	 * Uniform inputs of the instanced shader for each texture of the current batches.
+	 */
+	std::unordered_map<std::shared_ptr<renderer::Texture2d>,
+	                   std::shared_ptr<renderer::UniformInput>>
+		batch_uniforms;
+
+	/**
+	 * Layer and texture of the batches that the renderables of the
+	 * render pass were created for, in draw order.
+	 *
+	 * The textures are kept alive by \p batch_uniforms.
+	 */
+	std::vector<std::pair<int64_t, const renderer::Texture2d *>> batch_keys;
+
 	/**
 	 * Output texture.
 	 */
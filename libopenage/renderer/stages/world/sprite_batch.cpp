@@ -0,0 +1,96 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "sprite_batch.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace openage::renderer::world {
+
+resources::VertexInputInfo SpriteBatch::get_instance_info() {
+	return resources::VertexInputInfo{
+		{
+			resources::vertex_input_t::V3F32, // position
+			resources::vertex_input_t::V4F32, // tile_params
+			resources::vertex_input_t::F32,   // scale
+			resources::vertex_input_t::V2F32, // subtex_size
+			resources::vertex_input_t::V2F32, // anchor_offset
+			resources::vertex_input_t::V2F32, // flip
+			resources::vertex_input_t::U32,   // id
+		},
+		resources::vertex_layout_t::AOS,
+		resources::vertex_primitive_t::TRIANGLE_STRIP,
+	};
+}
+
+void SpriteBatch::clear() {
+	this->entries.clear();
+	this->instances.clear();
+	this->textures.clear();
+	this->texture_keys.clear();
+	this->batches.clear();
+	this->instance_data.clear();
+}
+
+void SpriteBatch::add(int64_t layer,
+                      const std::shared_ptr<Texture2d> &texture,
+                      const sprite_instance &instance) {
+	auto [it, inserted] = this->texture_keys.try_emplace(texture.get(),
+	                                                     static_cast<uint32_t>(this->textures.size()));
+	if (inserted) {
+		this->textures.push_back(texture);
+	}
+
+	this->entries.push_back({layer,
+	                         it->second,
+	                         static_cast<uint32_t>(this->instances.size())});
+	this->instances.push_back(instance);
+}
+
+void SpriteBatch::build() {
+	// the index makes the order unique, so an unstable sort is enough
+	std::sort(this->entries.begin(),
+	          this->entries.end(),
+	          [](const entry &a, const entry &b) {
+				  if (a.layer != b.layer) {
+					  return a.layer < b.layer;
+				  }
+				  if (a.texture != b.texture) {
+					  return a.texture < b.texture;
+				  }
+				  return a.index < b.index;
+			  });
+
+	this->batches.clear();
+	this->instance_data.resize(this->entries.size() * sizeof(sprite_instance));
+
+	auto out = this->instance_data.data();
+	for (size_t i = 0; i < this->entries.size(); ++i) {
+		const auto &current = this->entries[i];
+		std::memcpy(out + i * sizeof(sprite_instance),
+		            &this->instances[current.index],
+		            sizeof(sprite_instance));
+
+		if (this->batches.empty()
+		    or this->batches.back().layer != current.layer
+		    or this->batches.back().texture != this->textures[current.texture]) {
+			this->batches.push_back({current.layer, this->textures[current.texture], i, 0});
+		}
+		this->batches.back().count += 1;
+	}
+}
+
+size_t SpriteBatch::size() const {
+	return this->instances.size();
+}
+
+const std::vector<SpriteBatch::batch_t> &SpriteBatch::get_batches() const {
+	return this->batches;
+}
+
+const std::vector<uint8_t> &SpriteBatch::get_instance_data() const {
+	return this->instance_data;
+}
+
+} // namespace openage::renderer::world
@@ -0,0 +1,202 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "renderer/resources/mesh_data.h"
+#include "util/memory_tag.h"
+
+
+namespace openage::renderer {
+class Texture2d;
+
+namespace world {
+
+/**
+ * Per-instance data of a single sprite layer.
+ *
+ * This is uploaded to the GPU as is, so the layout must match the
+ * instance inputs of the instanced world shader (see \p SpriteBatch::get_instance_info()).
+ */
+struct sprite_instance {
+	/**
+	 * Position of the object in world space.
+	 */
+	std::array<float, 3> position;
+
+	/**
+	 * Position and size of the subtexture inside the texture: (x, y, width, height).
+	 */
+	std::array<float, 4> tile_params;
+
+	/**
+	 * Animation scale factor.
+	 */
+	float scale;
+
+	/**
+	 * Size of the subtexture (in pixels).
+	 */
+	std::array<float, 2> subtex_size;
+
+	/**
+	 * Offset of the subtexture anchor point from the subtexture center (in pixels).
+	 */
+	std::array<float, 2> anchor_offset;
+
+	/**
+	 * Flip the subtexture horizontally/vertically (0.0 or 1.0).
+	 */
+	std::array<float, 2> flip;
+
+	/**
+	 * ID of the object, written to the ID texture.
+	 */
+	uint32_t id;
+};
+
+static_assert(sizeof(sprite_instance) == 15 * 4, "sprite instance must be tightly packed");
+
+
+/**
+ * Collects the sprite layers of all visible world objects for a frame
+ * and groups them into batches that can be drawn with one instanced
+ * draw call each.
+ *
+ * Batches are ordered by layer first and then by texture. Within a batch,
+ * the sprites keep the order in which they were added. Textures are
+ * ordered by their first appearance in the frame, so the result only
+ * depends on the order of the added sprites.
+ *
+ * The batch does not access the GPU and can be used without a renderer.
+ */
+class SpriteBatch {
+public:
+	/**
+	 * Range of instances that use the same layer and texture.
+	 */
+	struct batch_t {
+		/**
+		 * Layer (render pass priority) of the sprites.
+		 */
+		int64_t layer;
+
+		/**
+		 * Texture of the sprites.
+		 */
+		std::shared_ptr<Texture2d> texture;
+
+		/**
+		 * Index of the first instance in the instance data.
+		 */
+		size_t offset;
+
+		/**
+		 * Number of instances.
+		 */
+		size_t count;
+	};
+
+	SpriteBatch() = default;
+	~SpriteBatch() = default;
+
+	/**
+	 * Get the vertex input info for the instance data.
+	 *
+	 * @return Info describing the layout of \p sprite_instance.
+	 */
+	static resources::VertexInputInfo get_instance_info();
+
+	/**
+	 * Remove all sprites and batches.
+	 *
+	 * Allocated memory is kept for the next frame.
+	 */
+	void clear();
+
+	/**
+	 * Add a sprite layer.
+	 *
+	 * @param layer Layer (render pass priority) of the sprite.
+	 * @param texture Texture the sprite is drawn from.
+	 * @param instance Instance data of the sprite.
+	 */
+	void add(int64_t layer,
+	         const std::shared_ptr<Texture2d> &texture,
+	         const sprite_instance &instance);
+
+	/**
+	 * Sort the added sprites and pack them into the instance data.
+	 */
+	void build();
+
+	/**
+	 * Get the number of added sprites.
+	 *
+	 * @return Number of sprites.
+	 */
+	size_t size() const;
+
+	/**
+	 * Get the batches created by \p build().
+	 *
+	 * @return Batches in draw order.
+	 */
+	const std::vector<batch_t> &get_batches() const;
+
+	/**
+	 * Get the packed instance data created by \p build().
+	 *
+	 * @return Instance data in batch order.
+	 */
+	const std::vector<uint8_t> &get_instance_data() const;
+
+private:
+	/**
+	 * Sort key of an added sprite.
+	 */
+	struct entry {
+		int64_t layer;
+		uint32_t texture;
+		uint32_t index;
+	};
+
+	/**
+	 * Sort keys of the added sprites.
+	 */
+	std::vector<entry, util::TaggedAllocator<entry, util::memory_tag::renderer>> entries;
+
+	/**
+	 * Instance data of the added sprites, in the order they were added.
+	 */
+	std::vector<sprite_instance, util::TaggedAllocator<sprite_instance, util::memory_tag::renderer>> instances;
+
+	/**
+	 * Textures used in the current frame, by order of first appearance.
+	 */
+	std::vector<std::shared_ptr<Texture2d>> textures;
+
+	/**
+	 * Lookup for the index of a texture in \p textures.
+	 */
+	std::unordered_map<const Texture2d *, uint32_t> texture_keys;
+
+	/**
+	 * Batches in draw order.
+	 */
+	std::vector<batch_t> batches;
+
+	/**
+	 * Packed instance data in draw order.
+	 */
+	std::vector<uint8_t> instance_data;
+};
+
+} // namespace world
+} // namespace openage::renderer
@@ -0,0 +1,318 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "coord/phys.h"
+#include "coord/scene.h"
+#include "curve/continuous.h"
+#include "curve/segmented.h"
+#include "error/error.h"
+#include "log/log.h"
+#include "renderer/definitions.h"
+#include "renderer/resources/texture_info.h"
+#include "renderer/stages/world/render_entity.h"
+#include "renderer/stages/world/sprite_batch.h"
+#include "renderer/texture.h"
+#include "testing/testing.h"
+
+
+namespace openage::renderer::world::tests {
+
+namespace {
+
+/**
+ * Texture without GPU storage. Only its address matters for batching.
+ */
+class DummyTexture final : public Texture2d {
+public:
+	DummyTexture() :
+		Texture2d{resources::Texture2dInfo{1, 1, resources::pixel_format::rgba8}} {}
+
+	resources::Texture2dData into_data() override {
+		throw Error{MSG(err) << "Dummy texture has no data"};
+	}
+
+	void upload(resources::Texture2dData const &) override {
+		throw Error{MSG(err) << "Dummy texture has no data"};
+	}
+};
+
+sprite_instance make_sprite(uint32_t id) {
+	sprite_instance sprite{};
+	sprite.position = {static_cast<float>(id), 0.0f, 0.0f};
+	sprite.id = id;
+	return sprite;
+}
+
+uint32_t id_at(const SpriteBatch &batch, size_t index) {
+	sprite_instance sprite;
+	std::memcpy(&sprite,
+	            batch.get_instance_data().data() + index * sizeof(sprite_instance),
+	            sizeof(sprite_instance));
+	return sprite.id;
+}
+
+/**
+ * Curves of a game entity that moves every simulation step.
+ */
+struct simulated_entity {
+	curve::Continuous<coord::phys3> position{nullptr, 0, "", nullptr, coord::phys3(0, 0, 0)};
+	curve::Segmented<coord::phys_angle_t> angle{nullptr, 0};
+
+	/**
+	 * Advance the entity by one step.
+	 *
+	 * Also plans a keyframe ahead that is replaced in the next step, so that
+	 * updates overwrite keyframes that were already passed to the renderer.
+	 */
+	void step(int i) {
+		time::time_t time = i;
+		this->position.set_last(time, coord::phys3(i, 2 * i, 0));
+		this->position.set_insert(time + 5, coord::phys3(i, 0, 0));
+		if (i % 10 == 0) {
+			this->angle.set_insert_jump(time, i % 360, (i + 90) % 360);
+		}
+	}
+};
+
+/**
+ * Curves of the renderer that are synced with a simulated entity.
+ */
+struct rendered_entity {
+	curve::Continuous<coord::scene3> position{nullptr, 0, "", nullptr, SCENE_ORIGIN};
+	curve::Segmented<coord::phys_angle_t> angle{nullptr, 0, "", nullptr, 0};
+
+	void apply(const RenderEntity::update_t &update) {
+		this->position.sync(update.position.keyframes,
+		                    update.position.start_value,
+		                    update.position.start);
+		if (update.angle) {
+			this->angle.sync(update.angle->keyframes,
+			                 update.angle->start_value,
+			                 update.angle->start);
+		}
+	}
+};
+
+} // namespace
+
+
+void sprite_batch() {
+	std::shared_ptr<Texture2d> tex_a = std::make_shared<DummyTexture>();
+	std::shared_ptr<Texture2d> tex_b = std::make_shared<DummyTexture>();
+
+	// instance layout matches the vertex input info
+	(SpriteBatch::get_instance_info().vert_size() == sizeof(sprite_instance)) or TESTFAIL;
+
+	SpriteBatch batch;
+	batch.add(1, tex_b, make_sprite(0));
+	batch.add(0, tex_a, make_sprite(1));
+	batch.add(1, tex_a, make_sprite(2));
+	batch.add(1, tex_b, make_sprite(3));
+	batch.add(0, tex_a, make_sprite(4));
+	batch.build();
+
+	batch.size() == 5 or TESTFAIL;
+
+	// sorted by layer, then by first appearance of the texture
+	const auto &batches = batch.get_batches();
+	batches.size() == 3 or TESTFAIL;
+
+	(batches[0].layer == 0 and batches[0].texture == tex_a) or TESTFAIL;
+	(batches[0].offset == 0 and batches[0].count == 2) or TESTFAIL;
+
+	(batches[1].layer == 1 and batches[1].texture == tex_b) or TESTFAIL;
+	(batches[1].offset == 2 and batches[1].count == 2) or TESTFAIL;
+
+	(batches[2].layer == 1 and batches[2].texture == tex_a) or TESTFAIL;
+	(batches[2].offset == 4 and batches[2].count == 1) or TESTFAIL;
+
+	// sprites keep their submission order inside a batch
+	std::vector<uint32_t> expected{1, 4, 0, 3, 2};
+	batch.get_instance_data().size() == expected.size() * sizeof(sprite_instance) or TESTFAIL;
+	for (size_t i = 0; i < expected.size(); ++i) {
+		id_at(batch, i) == expected[i] or TESTFAIL;
+	}
+
+	// next frame starts empty
+	batch.clear();
+	batch.build();
+	batch.size() == 0 or TESTFAIL;
+	batch.get_batches().empty() or TESTFAIL;
+	batch.get_instance_data().empty() or TESTFAIL;
+}
+
+
+void render_entity() {
+	constexpr int steps = 20000;
+
+	// tiny initial queue, so the queue grows while the renderer lags behind
+	RenderEntity entity{2};
+	simulated_entity simulated;
+	rendered_entity rendered;
+
+	std::atomic<bool> running{true};
+	std::atomic<bool> out_of_order{false};
+
+	// both sides run at full speed
+	std::thread renderer{[&]() {
+		time::time_t last_time = 0;
+		while (true) {
+			bool finished = not running.load();
+			while (auto update = entity.fetch_update()) {
+				if (update->time <= last_time) {
+					out_of_order = true;
+				}
+				last_time = update->time;
+				rendered.apply(*update);
+			}
+			if (finished) {
+				break;
+			}
+		}
+	}};
+
+	for (int i = 1; i <= steps; ++i) {
+		simulated.step(i);
+		entity.update(0, simulated.position, simulated.angle, "", i);
+	}
+	running = false;
+	renderer.join();
+
+	TESTEQUALS(out_of_order.load(), false);
+	TESTEQUALS(entity.get_update_time(), time::time_t{steps});
+
+	// curves match at every keyframe
+	for (int i = 0; i <= steps + 5; ++i) {
+		rendered.position.get(i) == simulated.position.get(i).to_scene3() or TESTFAIL;
+		rendered.angle.get(i) == simulated.angle.get(i) or TESTFAIL;
+	}
+
+	// the renderer stalls: updates that don't fit into the capped queue are merged
+	RenderEntity stalled{2, 4};
+	simulated_entity stalled_simulated;
+	rendered_entity stalled_rendered;
+	for (int i = 1; i <= 100; ++i) {
+		stalled_simulated.step(i);
+		stalled.update(0, stalled_simulated.position, stalled_simulated.angle, "", i);
+	}
+
+	// 6 queued updates and the merged one
+	size_t fetched = 0;
+	time::time_t last_time = 0;
+	while (auto update = stalled.fetch_update()) {
+		(update->time > last_time) or TESTFAIL;
+		last_time = update->time;
+		stalled_rendered.apply(*update);
+		fetched += 1;
+	}
+	TESTEQUALS(fetched, 7);
+	TESTEQUALS(last_time, time::time_t{100});
+
+	for (int i = 0; i <= 105; ++i) {
+		stalled_rendered.position.get(i) == stalled_simulated.position.get(i).to_scene3() or TESTFAIL;
+		stalled_rendered.angle.get(i) == stalled_simulated.angle.get(i) or TESTFAIL;
+	}
+
+	// updates are queued again once the renderer caught up
+	stalled_simulated.step(101);
+	stalled.update(0, stalled_simulated.position, stalled_simulated.angle, "", 101);
+	auto next = stalled.fetch_update();
+	(next and next->time == time::time_t{101}) or TESTFAIL;
+	stalled.fetch_update().has_value() and TESTFAIL;
+}
+
+
+void render_entity_benchmark() {
+	using clock = std::chrono::steady_clock;
+	constexpr int steps = 10000;
+
+	std::function<coord::scene3(const coord::phys3 &)> to_scene3 = [](const coord::phys3 &pos) {
+		return pos.to_scene3();
+	};
+
+	// previous approach: the simulation syncs the render entity's curves
+	// under a lock that the renderer holds while copying them
+	std::chrono::nanoseconds locked_total{0};
+	std::chrono::nanoseconds locked_wait{0};
+	{
+		std::shared_mutex mutex;
+		rendered_entity shared;
+		time::time_t last_update = 0;
+
+		simulated_entity simulated;
+		rendered_entity rendered;
+		std::atomic<bool> running{true};
+
+		std::thread renderer{[&]() {
+			time::time_t last_fetch = 0;
+			while (running.load(std::memory_order_relaxed)) {
+				std::shared_lock lock{mutex};
+				rendered.position.sync(shared.position, last_fetch);
+				rendered.angle.sync(shared.angle, last_fetch);
+				last_fetch = last_update;
+			}
+		}};
+
+		for (int i = 1; i <= steps; ++i) {
+			simulated.step(i);
+
+			auto start = clock::now();
+			std::unique_lock lock{mutex};
+			auto locked = clock::now();
+			shared.position.sync(simulated.position, to_scene3, last_update);
+			shared.angle.sync(simulated.angle, last_update);
+			last_update = i;
+			lock.unlock();
+			auto end = clock::now();
+
+			locked_wait += locked - start;
+			locked_total += end - start;
+		}
+		running = false;
+		renderer.join();
+	}
+
+	// lock-free handoff of the changed keyframes
+	std::chrono::nanoseconds handoff_total{0};
+	{
+		RenderEntity entity;
+		simulated_entity simulated;
+		rendered_entity rendered;
+		std::atomic<bool> running{true};
+
+		std::thread renderer{[&]() {
+			while (running.load(std::memory_order_relaxed)) {
+				while (auto update = entity.fetch_update()) {
+					rendered.apply(*update);
+				}
+			}
+		}};
+
+		for (int i = 1; i <= steps; ++i) {
+			simulated.step(i);
+
+			auto start = clock::now();
+			entity.update(0, simulated.position, simulated.angle, "", i);
+			handoff_total += clock::now() - start;
+		}
+		running = false;
+		renderer.join();
+	}
+
+	log::log(INFO << "Simulation time per render entity update (" << steps << " updates): "
+	              << "locked " << locked_total.count() / steps << " ns "
+	              << "(" << locked_wait.count() / steps << " ns waiting for the lock), "
+	              << "handoff " << handoff_total.count() / steps << " ns");
+}
+
+} // namespace openage::renderer::world::tests
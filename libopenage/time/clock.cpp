@@ -1,4 +1,4 @@
-// Copyright 2022-2023 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #include "clock.h"
 
@@ -17,63 +17,46 @@ Clock::Clock() :
 	start_time{simclock_t::now()},
 	sim_time{0},
 	sim_real_time{0} {
+	this->publish();
 }
 
 ClockState Clock::get_state() {
-	std::shared_lock lock{this->mutex};
-	return this->state;
+	return this->snapshot.load().state;
 }
 
 void Clock::update_time() {
-	if (this->state == ClockState::RUNNING) {
+	bool passed;
+	{
 		std::unique_lock lock{this->mutex};
+		passed = this->advance();
+	}
 
-		auto now = simclock_t::now();
-		auto passed = std::chrono::duration_cast<std::chrono::milliseconds>(now - this->last_check);
-		if (passed.count() == 0) {
-			// prevent the clock from stalling the thread forever
-			std::this_thread::sleep_for(std::chrono::milliseconds(1));
-		}
-		else if (passed.count() > this->max_tick_time) {
-			// if too much real time passes between two time updates, we only advance time by a small amount
-			// this prevents the simulation from getting out of control during unplanned stops,
-			// e.g. when debugging or if you close your laptop lid
-			this->sim_time += this->speed * this->max_tick_time;
-			this->sim_real_time += this->max_tick_time;
-		}
-		else {
-			this->sim_time += this->speed * passed.count();
-			this->sim_real_time += passed.count();
-		}
-		this->last_check = now;
-		// TODO: Stop clock if it reaches 0.0s with negative speed?
+	if (not passed) {
+		// prevent the clock from stalling the thread forever
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
 	}
 }
 
 time::time_t Clock::get_time() {
-	std::shared_lock lock{this->mutex};
-
 	// convert time unit from milliseconds to seconds
-	return this->sim_time / 1000;
+	return time::time_t::from_raw_value(this->snapshot.load().sim_time) / 1000;
 }
 
 time::time_t Clock::get_real_time() {
-	std::shared_lock lock{this->mutex};
-
 	// convert time unit from milliseconds to seconds
-	return this->sim_real_time / 1000;
+	return time::time_t::from_raw_value(this->snapshot.load().sim_real_time) / 1000;
 }
 
 speed_t Clock::get_speed() {
-	std::shared_lock lock{this->mutex};
-	return this->speed;
+	return speed_t::from_raw_value(this->snapshot.load().speed);
 }
 
 void Clock::set_speed(speed_t speed) {
-	this->update_time();
-
 	std::unique_lock lock{this->mutex};
+	this->advance();
+
 	this->speed = speed;
+	this->publish();
 
 	log::log(MSG(info) << "Clock speed set to " << this->speed);
 }
@@ -85,15 +68,15 @@ void Clock::start() {
 	this->start_time = now;
 	this->last_check = now;
 	this->state = ClockState::RUNNING;
+	this->publish();
 }
 
 void Clock::stop() {
-	if (this->state == ClockState::RUNNING) [[likely]] {
-		this->update_time();
-	}
-
 	std::unique_lock lock{this->mutex};
+	this->advance();
+
 	this->state = ClockState::STOPPED;
+	this->publish();
 
 	log::log(MSG(info) << "Clock stopped at "
 	                   << this->sim_time << "ms (simulated) / "
@@ -101,12 +84,11 @@ void Clock::stop() {
 }
 
 void Clock::pause() {
-	if (this->state == ClockState::RUNNING) [[likely]] {
-		this->update_time();
-	}
-
 	std::unique_lock lock{this->mutex};
+	this->advance();
+
 	this->state = ClockState::PAUSED;
+	this->publish();
 
 	log::log(MSG(info) << "Clock paused at "
 	                   << this->sim_time << "ms (simulated) / "
@@ -119,6 +101,7 @@ void Clock::resume() {
 	if (this->state == ClockState::PAUSED) [[likely]] {
 		this->last_check = simclock_t::now();
 		this->state = ClockState::RUNNING;
+		this->publish();
 	}
 
 	log::log(MSG(info) << "Clock resumed at "
@@ -126,4 +109,42 @@ void Clock::resume() {
 	                   << this->sim_real_time << "ms (real)");
 }
 
+bool Clock::advance() {
+	if (this->state != ClockState::RUNNING) {
+		return true;
+	}
+
+	auto now = simclock_t::now();
+	auto passed = std::chrono::duration_cast<std::chrono::milliseconds>(now - this->last_check);
+	if (passed.count() == 0) {
+		this->last_check = now;
+		return false;
+	}
+	else if (passed.count() > this->max_tick_time) {
+		// if too much real time passes between two time updates, we only advance time by a small amount
+		// this prevents the simulation from getting out of control during unplanned stops,
+		// e.g. when debugging or if you close your laptop lid
+		this->sim_time += this->speed * this->max_tick_time;
+		this->sim_real_time += this->max_tick_time;
+	}
+	else {
+		this->sim_time += this->speed * passed.count();
+		this->sim_real_time += passed.count();
+	}
+	this->last_check = now;
+	// TODO: Stop clock if it reaches 0.0s with negative speed?
+
+	this->publish();
+	return true;
+}
+
+void Clock::publish() {
+	this->snapshot.store(snapshot_t{
+		this->state,
+		this->speed.get_raw_value(),
+		this->sim_time.get_raw_value(),
+		this->sim_real_time.get_raw_value(),
+	});
+}
+
 } // namespace openage::time
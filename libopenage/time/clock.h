@@ -1,10 +1,11 @@
-// Copyright 2022-2024 the openage authors. See copying.md for legal info.
+// Copyright 2022-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <chrono>
-#include <shared_mutex>
+#include <mutex>
 
+#include "datastructure/seqlock.h"
 #include "time/time.h"
 
 
@@ -31,6 +32,10 @@ enum class ClockState {
  *
  * Time values have a precision of milliseconds which should
  * be accurate enough for all applications.
+ *
+ * Getters read a snapshot of the clock values without taking a lock,
+ * so they can be called from any thread as often as needed. Changes
+ * to the clock are serialized and never block readers.
  */
 class Clock {
 public:
@@ -108,6 +113,33 @@ public:
 	void resume();
 
 private:
+	/**
+	 * Advance the simulation time if the clock is running.
+	 *
+	 * The mutex must be held by the caller.
+	 *
+	 * @return false if less than a millisecond has passed since the last update, else true.
+	 */
+	bool advance();
+
+	/**
+	 * Make the current clock values visible to readers.
+	 *
+	 * The mutex must be held by the caller.
+	 */
+	void publish();
+
+	/**
+	 * Clock values that are visible to readers. Fixed-point
+	 * values are stored raw, so that the struct is trivially copyable.
+	 */
+	struct snapshot_t {
+		ClockState state;
+		int64_t speed;
+		int64_t sim_time;
+		int64_t sim_real_time;
+	};
+
 	/**
 	 * Status of the clock (init, running, stopped, ...).
 	 */
@@ -145,9 +177,15 @@ private:
 	time::time_t sim_real_time;
 
 	/**
-	 * Mutex for protecting threaded access.
+	 * Mutex for serializing changes to the clock. Readers
+	 * use the snapshot instead.
+	 */
+	std::mutex mutex;
+
+	/**
+	 * Latest published clock values.
 	 */
-	std::shared_mutex mutex;
+	datastructure::SeqLock<snapshot_t> snapshot;
 };
 
 } // namespace openage::time
@@ -0,0 +1,114 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "datastructure/seqlock.h"
+#include "log/log.h"
+#include "time/clock.h"
+
+
+namespace openage::time::tests {
+
+namespace {
+
+/**
+ * Run one writer and the given number of readers for a fixed duration.
+ *
+ * @return Reads per second of all readers.
+ */
+double run_contention(size_t readers,
+                      const std::function<void()> &write,
+                      const std::function<void()> &read) {
+	constexpr auto duration = std::chrono::milliseconds(200);
+
+	std::atomic<bool> running{true};
+	std::atomic<size_t> total_reads{0};
+
+	std::thread writer{[&]() {
+		while (running.load(std::memory_order_relaxed)) {
+			write();
+		}
+	}};
+
+	std::vector<std::thread> reader_threads;
+	for (size_t i = 0; i < readers; ++i) {
+		reader_threads.emplace_back([&]() {
+			size_t reads = 0;
+			while (running.load(std::memory_order_relaxed)) {
+				read();
+				reads += 1;
+			}
+			total_reads += reads;
+		});
+	}
+
+	std::this_thread::sleep_for(duration);
+	running = false;
+
+	writer.join();
+	for (auto &thread : reader_threads) {
+		thread.join();
+	}
+
+	return total_reads / std::chrono::duration<double>(duration).count();
+}
+
+} // namespace
+
+
+void clock_benchmark() {
+	size_t max_readers = std::max(2u, std::thread::hardware_concurrency()) - 1;
+
+	for (size_t readers = 1; readers <= max_readers; readers *= 2) {
+		// clock that is updated like in the time loop
+		Clock clock;
+		clock.start();
+		double clock_reads = run_contention(
+			readers,
+			[&]() { clock.update_time(); },
+			[&]() { clock.get_time(); });
+
+		// worst case: the writer changes the value all the time
+		datastructure::SeqLock<std::array<int64_t, 2>> seqlock;
+		int64_t seqlock_value = 0;
+		double seqlock_reads = run_contention(
+			readers,
+			[&]() {
+				seqlock_value += 1;
+				seqlock.store({seqlock_value, seqlock_value});
+			},
+			[&]() { seqlock.load(); });
+
+		// same with a reader-writer lock for comparison
+		std::shared_mutex mutex;
+		std::array<int64_t, 2> locked_value{0, 0};
+		double mutex_reads = run_contention(
+			readers,
+			[&]() {
+				std::unique_lock lock{mutex};
+				locked_value[0] += 1;
+				locked_value[1] += 1;
+			},
+			[&]() {
+				std::shared_lock lock{mutex};
+				volatile auto value = locked_value;
+				(void)value;
+			});
+
+		log::log(INFO << "1 writer, " << readers << " readers: "
+		              << "clock " << clock_reads / 1e6 << " M reads/s, "
+		              << "seqlock " << seqlock_reads / 1e6 << " M reads/s, "
+		              << "shared_mutex " << mutex_reads / 1e6 << " M reads/s");
+	}
+}
+
+} // namespace openage::time::tests
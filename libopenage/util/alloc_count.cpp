@@ -0,0 +1,134 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "alloc_count.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "config.h"
+
+
+namespace openage::util {
+
+namespace {
+
+std::atomic<size_t> alloc_count{0};
+std::atomic<size_t> alloc_bytes{0};
+
+} // namespace
+
+
+// counting replaces the global allocation functions, so it is only
+// compiled in when requested (WANT_ALLOC_COUNT). MSVC has no aligned_alloc
+// and replaced allocation functions in a DLL don't apply to other modules,
+// so allocations are not counted there.
+#if WITH_ALLOC_COUNT && !defined(_MSC_VER)
+
+namespace {
+
+/**
+ * Allocate memory for the replaced `operator new` and count the allocation.
+ */
+void *counted_alloc(size_t size, size_t alignment = 0) {
+	alloc_count.fetch_add(1, std::memory_order_relaxed);
+	alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+
+	// malloc(0) may return nullptr, but new must return a unique pointer
+	if (size == 0) {
+		size = 1;
+	}
+
+	void *ptr;
+	if (alignment > alignof(std::max_align_t)) {
+		// aligned_alloc requires the size to be a multiple of the alignment
+		ptr = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+	}
+	else {
+		ptr = std::malloc(size);
+	}
+
+	if (ptr == nullptr) [[unlikely]] {
+		throw std::bad_alloc{};
+	}
+	return ptr;
+}
+
+} // namespace
+
+#endif
+
+
+bool alloc_count_enabled() {
+#if WITH_ALLOC_COUNT && !defined(_MSC_VER)
+	return true;
+#else
+	return false;
+#endif
+}
+
+size_t get_alloc_count() {
+	return alloc_count.load(std::memory_order_relaxed);
+}
+
+size_t get_alloc_bytes() {
+	return alloc_bytes.load(std::memory_order_relaxed);
+}
+
+} // namespace openage::util
+
+
+#if WITH_ALLOC_COUNT && !defined(_MSC_VER)
+
+// replacements of the global allocation functions.
+// the nothrow variants of the standard library forward to these.
+
+void *operator new(std::size_t size) {
+	return openage::util::counted_alloc(size);
+}
+
+void *operator new[](std::size_t size) {
+	return openage::util::counted_alloc(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+	return openage::util::counted_alloc(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+	return openage::util::counted_alloc(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept {
+	std::free(ptr);
+}
+
+#endif
@@ -0,0 +1,40 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+
+
+namespace openage::util {
+
+/**
+ * Check if allocations are counted in this build.
+ *
+ * @return true if the `alloc-count` feature is enabled, else false.
+ */
+bool alloc_count_enabled();
+
+/**
+ * Get the number of heap allocations done with `operator new` since
+ * the program started, summed over all threads.
+ *
+ * Take the difference of two readings to get the allocations of a code section.
+ *
+ * Counting replaces the global `operator new`, so it is only enabled in builds
+ * configured with the `alloc-count` feature (`WANT_ALLOC_COUNT`). Otherwise,
+ * and in MSVC builds, the count is always 0.
+ *
+ * @return Number of allocations.
+ */
+size_t get_alloc_count();
+
+/**
+ * Get the number of bytes requested with `operator new` since the
+ * program started, summed over all threads. Frees are not subtracted.
+ * Only counted in builds with the `alloc-count` feature, like \p get_alloc_count().
+ *
+ * @return Allocated bytes.
+ */
+size_t get_alloc_bytes();
+
+} // namespace openage::util
@@ -1,4 +1,4 @@
-// Copyright 2013-2024 the openage authors. See copying.md for legal info.
+// Copyright 2013-2025 the openage authors. See copying.md for legal info.
 
 #include "file.h"
 
@@ -109,6 +109,20 @@ std::vector<std::string> File::get_lines() {
 }
 
 
+std::span<const std::byte> File::get_view(std::string &buffer) {
+	auto view = this->filelike->get_view();
+	if (view) {
+		return *view;
+	}
+
+	if (this->seekable()) {
+		this->seek(0);
+	}
+	buffer = this->read();
+	return std::as_bytes(std::span{buffer});
+}
+
+
 std::shared_ptr<filelike::FileLike> File::get_fileobj() const {
 	return this->filelike;
 }
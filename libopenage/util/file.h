@@ -1,9 +1,11 @@
-// Copyright 2013-2024 the openage authors. See copying.md for legal info.
+// Copyright 2013-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
+#include <cstddef>
 // pxd: from libcpp.memory cimport shared_ptr
 #include <memory>
+#include <span>
 // pxd: from libcpp.string cimport string
 #include <string>
 #include <vector>
@@ -98,6 +100,14 @@ public:
 	void flush();
 	ssize_t size();
 	std::vector<std::string> get_lines();
+
+	/**
+	 * Get the whole file contents.
+	 * Memory-mapped files are viewed directly, all other files
+	 * are read into the given buffer, which the view refers to then.
+	 */
+	std::span<const std::byte> get_view(std::string &buffer);
+
 	std::shared_ptr<filelike::FileLike> get_fileobj() const;
 
 	static File get_temp_file(bool executable = false);
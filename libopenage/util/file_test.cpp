@@ -0,0 +1,78 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "file.h"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "../testing/testing.h"
+#include "fslike/directory.h"
+#include "path.h"
+
+
+namespace openage::util::tests {
+
+void mmap_file() {
+	auto temp_dir = std::make_shared<fslike::Directory>(fslike::Directory::get_temp_directory());
+	std::ostringstream dir_path;
+	temp_dir->repr(dir_path);
+
+	Path root{temp_dir, {}};
+	Path mapped_root{std::make_shared<fslike::Directory>(dir_path.str(), false, true), {}};
+
+	// only files of a minimum size are mapped
+	std::string content = "openage\nmemory-mapped\n"
+	                      + std::string(fslike::Directory::MMAP_MIN_SIZE, '-')
+	                      + "\nfile\n";
+	auto out = (root / "test.txt").open_w();
+	out.write(content);
+	out.close();
+
+	for (auto &path : {root / "test.txt", mapped_root / "test.txt"}) {
+		auto file = path.open_r();
+		file.size() == static_cast<ssize_t>(content.size()) or TESTFAIL;
+
+		file.read(8) == "openage\n" or TESTFAIL;
+		file.tell() == 8 or TESTFAIL;
+
+		char buf[16];
+		file.read_to(buf, 6) == 6 or TESTFAIL;
+		std::string(buf, 6) == "memory" or TESTFAIL;
+
+		file.seek(-5, File::seek_t::END);
+		file.read() == "file\n" or TESTFAIL;
+		file.read() == "" or TESTFAIL;
+
+		// only the mapped file is viewed without a copy
+		std::string buffer;
+		auto view = file.get_view(buffer);
+		view.size() == content.size() or TESTFAIL;
+		std::memcmp(view.data(), content.data(), content.size()) == 0 or TESTFAIL;
+		buffer.empty() == (path.get_fsobj() == mapped_root.get_fsobj()) or TESTFAIL;
+
+		file.seek(0);
+		file.get_lines().size() == 4 or TESTFAIL;
+	}
+
+	// small files are read through a stream instead
+	auto small_out = (root / "small.txt").open_w();
+	small_out.write("openage\n");
+	small_out.close();
+
+	std::string small_buffer;
+	auto small = (mapped_root / "small.txt").open_r();
+	small.get_view(small_buffer).size() == 8 or TESTFAIL;
+	small_buffer == "openage\n" or TESTFAIL;
+
+	// empty files can't be mapped, but can be opened
+	(root / "empty.txt").touch();
+	auto empty = (mapped_root / "empty.txt").open_r();
+	empty.read() == "" or TESTFAIL;
+
+	root.removerecursive();
+}
+
+} // namespace openage::util::tests
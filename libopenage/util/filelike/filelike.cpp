@@ -1,4 +1,4 @@
-// Copyright 2017-2019 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
 #include "filelike.h"
 
@@ -7,6 +7,10 @@ namespace openage::util::filelike {
 
 FileLike::FileLike() = default;
 
+std::optional<std::span<const std::byte>> FileLike::get_view() {
+	return std::nullopt;
+}
+
 bool FileLike::is_python_native() const noexcept {
 	return false;
 }
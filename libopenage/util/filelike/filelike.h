@@ -1,10 +1,13 @@
-// Copyright 2017-2024 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 // pxd: from libcpp cimport bool
 
+#include <cstddef>
 #include <iostream>
+#include <optional>
+#include <span>
 // pxd: from libcpp.string cimport string
 #include <string>
 
@@ -86,6 +89,13 @@ public:
 	virtual void flush() = 0;
 	virtual ssize_t get_size() = 0;
 
+	/**
+	 * Get the whole file contents without copying them.
+	 *
+	 * Returns std::nullopt if the file is not in memory.
+	 */
+	virtual std::optional<std::span<const std::byte>> get_view();
+
 	virtual bool is_python_native() const noexcept;
 
 	/** string representation of the filelike */
@@ -0,0 +1,175 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "mmap.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifndef _WIN32
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+#include "../../error/error.h"
+
+
+namespace openage::util::filelike {
+
+Mmap::Mmap(const std::string &path) :
+	path{path},
+	data{nullptr},
+	size{0},
+	pos{0} {
+#ifdef _WIN32
+	throw Error{ERR << "memory-mapped files are not supported on this platform: " << path};
+#else
+	int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		throw Error{ERR << "file not found: " << path};
+	}
+
+	struct stat buf;
+	if (::fstat(fd, &buf) != 0 or not S_ISREG(buf.st_mode)) {
+		::close(fd);
+		throw Error{ERR << "can't map file that is not a regular file: " << path};
+	}
+
+	this->size = buf.st_size;
+
+	// empty files can't be mapped
+	if (this->size > 0) {
+		void *mapping = ::mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapping == MAP_FAILED) {
+			::close(fd);
+			throw Error{ERR << "could not map file: " << path};
+		}
+
+		// request the whole file right away, which saves round trips
+		// on high latency (e.g. network) filesystems
+		::posix_madvise(mapping, this->size, POSIX_MADV_WILLNEED);
+
+		this->data = static_cast<const std::byte *>(mapping);
+	}
+
+	// the mapping stays valid after the file is closed
+	::close(fd);
+#endif
+}
+
+
+Mmap::~Mmap() {
+	this->close();
+}
+
+
+std::string Mmap::read(ssize_t max) {
+	size_t count = this->get_remaining(max);
+	std::string ret(reinterpret_cast<const char *>(this->data) + this->pos, count);
+	this->pos += count;
+	return ret;
+}
+
+
+size_t Mmap::read_to(void *buf, ssize_t max) {
+	size_t count = this->get_remaining(max);
+	if (count > 0) {
+		std::memcpy(buf, this->data + this->pos, count);
+		this->pos += count;
+	}
+	return count;
+}
+
+
+bool Mmap::readable() {
+	return true;
+}
+
+
+void Mmap::write(const std::string & /* data */) {
+	throw Error{ERR << "can't write to memory-mapped file: " << this->path};
+}
+
+
+bool Mmap::writable() {
+	return false;
+}
+
+
+void Mmap::seek(ssize_t offset, seek_t how) {
+	ssize_t base;
+
+	switch (how) {
+	case seek_t::SET:
+		base = 0;
+		break;
+	case seek_t::CUR:
+		base = this->pos;
+		break;
+	case seek_t::END:
+		base = this->size;
+		break;
+	default:
+		throw Error{ERR << "invalid seek mode"};
+	}
+
+	if (base + offset < 0) {
+		throw Error{ERR << "can't seek before the start of " << this->path};
+	}
+
+	this->pos = base + offset;
+}
+
+
+bool Mmap::seekable() {
+	return true;
+}
+
+
+size_t Mmap::tell() {
+	return this->pos;
+}
+
+
+void Mmap::close() {
+#ifndef _WIN32
+	if (this->data != nullptr) {
+		::munmap(const_cast<std::byte *>(this->data), this->size);
+	}
+#endif
+
+	this->data = nullptr;
+	this->size = 0;
+	this->pos = 0;
+}
+
+
+void Mmap::flush() {}
+
+
+ssize_t Mmap::get_size() {
+	return this->size;
+}
+
+
+std::optional<std::span<const std::byte>> Mmap::get_view() {
+	return std::span<const std::byte>{this->data, this->size};
+}
+
+
+std::ostream &Mmap::repr(std::ostream &stream) {
+	stream << "Mmap(" << this->path << ")";
+	return stream;
+}
+
+
+size_t Mmap::get_remaining(ssize_t max) const {
+	size_t remaining = this->pos < this->size ? this->size - this->pos : 0;
+	if (max < 0) {
+		return remaining;
+	}
+	return std::min(static_cast<size_t>(max), remaining);
+}
+
+} // namespace openage::util::filelike
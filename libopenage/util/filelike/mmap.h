@@ -0,0 +1,83 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+
+#include "filelike.h"
+
+
+namespace openage {
+namespace util {
+namespace filelike {
+
+/**
+ * Read-only file-like class that maps the whole file into memory.
+ *
+ * Reads are plain copies from the mapping, and the contents can be
+ * accessed without any copy through get_view().
+ */
+class Mmap : public FileLike {
+public:
+	/**
+	 * Map a file into memory.
+	 *
+	 * @throw Error if the file can't be mapped, e.g. because it
+	 *        is not a regular file.
+	 */
+	Mmap(const std::string &path);
+	virtual ~Mmap();
+
+	Mmap(const Mmap &) = delete;
+	Mmap &operator=(const Mmap &) = delete;
+
+	std::string read(ssize_t max) override;
+	size_t read_to(void *buf, ssize_t max) override;
+
+	bool readable() override;
+
+	void write(const std::string &data) override;
+
+	bool writable() override;
+
+	void seek(ssize_t offset, seek_t how = seek_t::SET) override;
+	bool seekable() override;
+	size_t tell() override;
+	void close() override;
+	void flush() override;
+	ssize_t get_size() override;
+
+	std::optional<std::span<const std::byte>> get_view() override;
+
+	std::ostream &repr(std::ostream &) override;
+
+protected:
+	/**
+	 * Get the number of bytes that can be read from the current position.
+	 */
+	size_t get_remaining(ssize_t max) const;
+
+	std::string path;
+
+	/**
+	 * Start of the mapped file. \p nullptr for empty or closed files.
+	 */
+	const std::byte *data;
+
+	/**
+	 * Size of the mapped file (in bytes).
+	 */
+	size_t size;
+
+	/**
+	 * Current read position.
+	 */
+	size_t pos;
+};
+
+} // namespace filelike
+} // namespace util
+} // namespace openage
@@ -1,4 +1,4 @@
-// Copyright 2017-2019 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
 #include "native.h"
 
@@ -55,15 +55,14 @@ std::string Native::read(ssize_t max) {
 	if (max < 0) {
 		std::string ret;
 
-		// get remaining size and prepare the string size
-		// to avoid resizing
+		// get remaining size and read it in one go
 		size_t pos = this->file.tellg();
 		this->file.seekg(0, std::ios::end);
-		ret.reserve(static_cast<size_t>(this->file.tellg()) - pos);
+		ret.resize(static_cast<size_t>(this->file.tellg()) - pos);
 		this->file.seekg(pos, std::ios::beg);
 
-		ret.assign(std::istreambuf_iterator<char>(this->file),
-		           std::istreambuf_iterator<char>());
+		this->file.read(ret.data(), ret.size());
+		ret.resize(this->file.gcount());
 
 		return ret;
 	}
@@ -81,8 +80,20 @@ std::string Native::read(ssize_t max) {
 
 
 size_t Native::read_to(void *buf, ssize_t max) {
-	this->file.readsome(reinterpret_cast<std::fstream::char_type *>(buf), max);
-	return this->file.gcount();
+	if (max < 0) {
+		// read the remaining file
+		size_t pos = this->file.tellg();
+		max = this->get_size() - pos;
+	}
+
+	// readsome() only returns what is already buffered
+	this->file.read(reinterpret_cast<std::fstream::char_type *>(buf), max);
+	size_t count = this->file.gcount();
+
+	// reading past the end of the file is not an error here
+	this->file.clear();
+
+	return count;
 }
 
 
@@ -1,14 +1,17 @@
-// Copyright 2015-2024 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <climits>
+#include <cstdint>
 #include <cmath>
 #include <iomanip>
 #include <limits>
 #include <ostream>
 #include <type_traits>
+#include <utility>
 
 #include "compiler.h"
 #include "misc.h"
@@ -72,6 +75,306 @@ constexpr static
 }
 
 
+/**
+ * Integer helpers for the deterministic math functions of FixedPoint.
+ *
+ * None of them use floating point operations, so their results are
+ * identical on every compiler and CPU. This is required for lockstep
+ * simulation.
+ */
+namespace fixed_math {
+
+/**
+ * Number of fractional bits of the internal angle representation.
+ */
+constexpr unsigned int cordic_bits = 30;
+
+/**
+ * pi, pi/2 and 2*pi with cordic_bits fractional bits.
+ */
+constexpr int64_t cordic_pi = 3373259426ll;
+constexpr int64_t cordic_pi_2 = 1686629713ll;
+constexpr int64_t cordic_tau = 6746518852ll;
+
+/**
+ * 2*pi with reduce_bits fractional bits, for reducing huge angles.
+ */
+constexpr unsigned int reduce_bits = 60;
+constexpr uint64_t reduce_tau = 7244019458077122842ull;
+
+/**
+ * Inverse of the CORDIC gain (~0.607253) with cordic_bits fractional bits.
+ */
+constexpr int64_t cordic_gain = 652032874ll;
+
+/**
+ * atan(2^-i) with cordic_bits fractional bits.
+ */
+constexpr std::array<int64_t, 31> cordic_atan{
+	843314857ll, 497837829ll, 263043837ll, 133525159ll, 67021687ll,
+	33543516ll, 16775851ll, 8388437ll, 4194283ll, 2097149ll,
+	1048576ll, 524288ll, 262144ll, 131072ll, 65536ll,
+	32768ll, 16384ll, 8192ll, 4096ll, 2048ll,
+	1024ll, 512ll, 256ll, 128ll, 64ll,
+	32ll, 16ll, 8ll, 4ll, 2ll,
+	1ll};
+
+
+/**
+ * Number of significant bits of a value.
+ */
+constexpr unsigned int bit_width(uint64_t value) {
+	unsigned int width = 0;
+	while (value != 0) {
+		value >>= 1;
+		width += 1;
+	}
+	return width;
+}
+
+
+/**
+ * Calculate floor(sqrt(value * 2^shift)) digit by digit.
+ *
+ * The shifted value is never materialized, so this does not overflow
+ * as long as the result fits into 63 bits.
+ */
+constexpr uint64_t isqrt_shifted(uint64_t value, unsigned int shift) {
+	// skip the leading zero bits
+	unsigned int bits = bit_width(value) + shift;
+	bits += bits % 2;
+
+	uint64_t root = 0;
+	uint64_t rem = 0;
+	for (unsigned int i = bits; i >= 2; i -= 2) {
+		// bring down the next two bits of value * 2^shift
+		int pos = static_cast<int>(i) - 2 - static_cast<int>(shift);
+		uint64_t pair = 0;
+		if (pos >= 0) {
+			pair = (value >> pos) & 3;
+		}
+		else if (pos == -1) {
+			pair = (value & 1) << 1;
+		}
+
+		rem = (rem << 2) | pair;
+		uint64_t trial = (root << 2) | 1;
+		root <<= 1;
+		if (rem >= trial) {
+			rem -= trial;
+			root |= 1;
+		}
+	}
+
+	return root;
+}
+
+
+/**
+ * Reduce the angle raw * 2^-F modulo 2*pi with reduce_bits fractional bits.
+ *
+ * The reduction is exact for the rounded reduce_tau, so the error only grows
+ * by 2^-61 per period. The raw value is shifted up one bit at a time,
+ * which keeps the remainder in 64 bits.
+ *
+ * @return Reduced angle in [0, 2*pi) with cordic_bits fractional bits, rounded.
+ */
+template <unsigned int F>
+constexpr int64_t reduce_angle(uint64_t magnitude) {
+	static_assert(F < reduce_bits, "angles are reduced with more fractional bits than the input has");
+
+	uint64_t rem = magnitude % reduce_tau;
+	for (unsigned int i = F; i < reduce_bits; ++i) {
+		// rem < reduce_tau < 2^63, so this doesn't overflow
+		rem <<= 1;
+		if (rem >= reduce_tau) {
+			rem -= reduce_tau;
+		}
+	}
+
+	constexpr unsigned int shift = reduce_bits - cordic_bits;
+	return static_cast<int64_t>((rem + (uint64_t{1} << (shift - 1))) >> shift);
+}
+
+
+/**
+ * Convert a raw fixed-point value with F fractional bits to the internal
+ * angle representation, reduced to [-pi, pi].
+ */
+template <unsigned int F>
+constexpr int64_t to_cordic_angle(int64_t raw) {
+	// angles of up to 2^6 radians are reduced with cordic_tau. the rounding
+	// error of cordic_tau adds up to at most 3 units in the last place there.
+	// larger angles need more precision.
+	if constexpr (F + 6 < 63) {
+		uint64_t magnitude = raw < 0 ? -static_cast<uint64_t>(raw) : static_cast<uint64_t>(raw);
+		if (magnitude >= (uint64_t{1} << (F + 6))) [[unlikely]] {
+			int64_t angle = reduce_angle<F>(magnitude);
+			if (raw < 0) {
+				angle = -angle;
+			}
+
+			if (angle > cordic_pi) {
+				angle -= cordic_tau;
+			}
+			else if (angle < -cordic_pi) {
+				angle += cordic_tau;
+			}
+			return angle;
+		}
+	}
+
+	if constexpr (F < cordic_bits) {
+		raw *= int64_t{1} << (cordic_bits - F);
+	}
+	else if constexpr (F > cordic_bits) {
+		raw /= int64_t{1} << (F - cordic_bits);
+	}
+
+	raw %= cordic_tau;
+	if (raw > cordic_pi) {
+		raw -= cordic_tau;
+	}
+	else if (raw < -cordic_pi) {
+		raw += cordic_tau;
+	}
+
+	return raw;
+}
+
+
+/**
+ * Convert a value in the internal representation to a raw fixed-point value
+ * with F fractional bits. Rounds to the nearest value.
+ */
+template <unsigned int F>
+constexpr int64_t from_cordic(int64_t value) {
+	if constexpr (F < cordic_bits) {
+		constexpr unsigned int shift = cordic_bits - F;
+		return (value + (int64_t{1} << (shift - 1))) >> shift;
+	}
+	else {
+		return value * (int64_t{1} << (F - cordic_bits));
+	}
+}
+
+
+/**
+ * Calculate cosine and sine of an angle in [-pi, pi] with CORDIC rotation.
+ *
+ * @return (cos, sin) with cordic_bits fractional bits.
+ */
+constexpr std::pair<int64_t, int64_t> cordic_sincos(int64_t angle) {
+	// CORDIC only converges in [-pi/2, pi/2], so mirror the other half
+	bool mirrored = false;
+	if (angle > cordic_pi_2) {
+		angle = cordic_pi - angle;
+		mirrored = true;
+	}
+	else if (angle < -cordic_pi_2) {
+		angle = -cordic_pi - angle;
+		mirrored = true;
+	}
+
+	int64_t x = cordic_gain;
+	int64_t y = 0;
+	int64_t z = angle;
+	for (size_t i = 0; i < cordic_atan.size(); ++i) {
+		int64_t dx = y >> i;
+		int64_t dy = x >> i;
+		if (z >= 0) {
+			x -= dx;
+			y += dy;
+			z -= cordic_atan[i];
+		}
+		else {
+			x += dx;
+			y -= dy;
+			z += cordic_atan[i];
+		}
+	}
+
+	return {mirrored ? -x : x, y};
+}
+
+
+/**
+ * Calculate angle and length of the vector (x, y) with CORDIC vectoring.
+ *
+ * @return (angle, length). The angle is in (-pi, pi] with cordic_bits fractional bits,
+ *         the length has the same scale as x and y. Lengths that don't fit into
+ *         64 bits saturate at the maximum value.
+ */
+constexpr std::pair<int64_t, int64_t> cordic_polar(int64_t x, int64_t y) {
+	if (x == 0 and y == 0) {
+		return {0, 0};
+	}
+
+	// normalize the vector so the larger component has 29 significant bits.
+	// this leaves enough headroom for the CORDIC gain and the length correction.
+	uint64_t magnitude = std::max(x < 0 ? -static_cast<uint64_t>(x) : static_cast<uint64_t>(x),
+	                              y < 0 ? -static_cast<uint64_t>(y) : static_cast<uint64_t>(y));
+	int scale = static_cast<int>(bit_width(magnitude)) - 29;
+	if (scale > 0) {
+		x /= int64_t{1} << scale;
+		y /= int64_t{1} << scale;
+	}
+	else if (scale < 0) {
+		x *= int64_t{1} << -scale;
+		y *= int64_t{1} << -scale;
+	}
+
+	// rotate into the right half-plane
+	int64_t z = 0;
+	if (x < 0) {
+		int64_t tmp = x;
+		if (y >= 0) {
+			x = y;
+			y = -tmp;
+			z = cordic_pi_2;
+		}
+		else {
+			x = -y;
+			y = tmp;
+			z = -cordic_pi_2;
+		}
+	}
+
+	for (size_t i = 0; i < cordic_atan.size(); ++i) {
+		int64_t dx = y >> i;
+		int64_t dy = x >> i;
+		if (y > 0) {
+			x += dx;
+			y -= dy;
+			z += cordic_atan[i];
+		}
+		else {
+			x -= dx;
+			y += dy;
+			z -= cordic_atan[i];
+		}
+	}
+
+	// remove the CORDIC gain and undo the normalization
+	int64_t length = (x * cordic_gain) >> cordic_bits;
+	if (scale > 0) {
+		if (length > (std::numeric_limits<int64_t>::max() >> scale)) {
+			length = std::numeric_limits<int64_t>::max();
+		}
+		else {
+			length *= int64_t{1} << scale;
+		}
+	}
+	else if (scale < 0) {
+		length /= int64_t{1} << -scale;
+	}
+
+	return {z, length};
+}
+
+} // namespace fixed_math
+
+
 /**
  * Fixed-point integer class;
  *
@@ -380,14 +683,28 @@ public:
 		return FixedPoint::this_type::from_raw_value(-this->raw_value);
 	}
 
+	/**
+	 * Calculate sqrt(this^2 + rhs^2) with floating point math.
+	 *
+	 * The result may differ between platforms, use hypotfp() in the simulation.
+	 */
 	template <typename I, unsigned F>
 	constexpr double hypot(const FixedPoint<I, F> rhs) {
 		return std::hypot(this->to_double(), rhs.to_double());
 	}
 
-	template <typename I, unsigned F>
-	constexpr FixedPoint<I, F> hypotfp(const FixedPoint<I, F> rhs) {
-		return FixedPoint<I, F>(this->hypot(rhs));
+	/**
+	 * Calculate sqrt(this^2 + rhs^2) using only integer math.
+	 *
+	 * The intermediate squares are never computed. Results that don't fit
+	 * into the type saturate at max_value().
+	 */
+	constexpr FixedPoint hypotfp(const FixedPoint &rhs) const {
+		auto polar = fixed_math::cordic_polar(this->raw_value, rhs.raw_value);
+		if (polar.second > static_cast<int64_t>(std::numeric_limits<int_type>::max())) {
+			return FixedPoint::max_value();
+		}
+		return FixedPoint::from_raw_value(static_cast<int_type>(polar.second));
 	}
 
 	// Basic operators
@@ -444,13 +761,102 @@ public:
 		return is;
 	}
 
+	/**
+	 * Calculate the square root with floating point math.
+	 *
+	 * The result may differ between platforms, use sqrtfp() in the simulation.
+	 */
 	constexpr double sqrt() {
 		return std::sqrt(this->to_double());
 	}
 
+	/**
+	 * Calculate atan2(this, n) with floating point math.
+	 *
+	 * The result may differ between platforms, use atan2fp() in the simulation.
+	 */
 	constexpr double atan2(const FixedPoint &n) {
 		return std::atan2(this->to_double(), n.to_double());
 	}
+
+	/**
+	 * Calculate the square root using only integer math.
+	 *
+	 * The result is rounded down to the precision of the type.
+	 * Negative numbers return 0.
+	 */
+	constexpr FixedPoint sqrtfp() const {
+		if (this->raw_value <= 0) {
+			return FixedPoint::zero();
+		}
+
+		return FixedPoint::from_raw_value(static_cast<int_type>(
+			fixed_math::isqrt_shifted(static_cast<uint64_t>(this->raw_value), fractional_bits)));
+	}
+
+	/**
+	 * Calculate 1 / sqrt(this) using only integer math.
+	 *
+	 * Zero and negative numbers return max_value().
+	 */
+	constexpr FixedPoint inv_sqrtfp() const {
+		static_assert(2 * fractional_bits < 62, "inv_sqrtfp() needs 2 * fractional_bits < 62");
+
+		if (this->raw_value <= 0) {
+			return FixedPoint::max_value();
+		}
+
+		// calculate the root with extra precision bits so that the
+		// division below keeps the full precision of the type.
+		// the root must stay below 2^61 so the dividend is larger.
+		auto value = static_cast<uint64_t>(this->raw_value);
+		unsigned int width = fixed_math::bit_width(value);
+		unsigned int extra = 62 - 2 * fractional_bits;
+		if (width + fractional_bits + 2 * extra > 122) {
+			extra = (122 - width - fractional_bits) / 2;
+		}
+
+		uint64_t root = fixed_math::isqrt_shifted(value, fractional_bits + 2 * extra);
+		uint64_t result = (uint64_t{1} << (2 * fractional_bits + extra)) / root;
+		if (result > static_cast<uint64_t>(std::numeric_limits<int_type>::max())) {
+			return FixedPoint::max_value();
+		}
+
+		return FixedPoint::from_raw_value(static_cast<int_type>(result));
+	}
+
+	/**
+	 * Calculate the sine (in radians) using only integer math.
+	 */
+	constexpr FixedPoint sinfp() const {
+		auto angle = fixed_math::to_cordic_angle<fractional_bits>(this->raw_value);
+		auto sincos = fixed_math::cordic_sincos(angle);
+		return FixedPoint::from_raw_value(static_cast<int_type>(
+			fixed_math::from_cordic<fractional_bits>(sincos.second)));
+	}
+
+	/**
+	 * Calculate the cosine (in radians) using only integer math.
+	 */
+	constexpr FixedPoint cosfp() const {
+		auto angle = fixed_math::to_cordic_angle<fractional_bits>(this->raw_value);
+		auto sincos = fixed_math::cordic_sincos(angle);
+		return FixedPoint::from_raw_value(static_cast<int_type>(
+			fixed_math::from_cordic<fractional_bits>(sincos.first)));
+	}
+
+	/**
+	 * Calculate atan2(this, x) using only integer math.
+	 *
+	 * @param x x component of the vector, this is the y component.
+	 *
+	 * @return Angle in radians in (-pi, pi]. 0 if both components are 0.
+	 */
+	constexpr FixedPoint atan2fp(const FixedPoint &x) const {
+		auto polar = fixed_math::cordic_polar(x.raw_value, this->raw_value);
+		return FixedPoint::from_raw_value(static_cast<int_type>(
+			fixed_math::from_cordic<fractional_bits>(polar.first)));
+	}
 };
 
 
@@ -525,10 +931,52 @@ typename std::enable_if<std::is_arithmetic<N>::value, FixedPoint<I, F>>::type co
 
 /**
  * FixedPoint / FixedPoint
+ *
+ * Rounds towards -inf, like the integer division in util::div().
  */
 template <typename I, unsigned int F>
 constexpr FixedPoint<I, F> operator/(const FixedPoint<I, F> lhs, const FixedPoint<I, F> rhs) {
-	return FixedPoint<I, F>::from_raw_value(div(lhs.get_raw_value(), rhs.get_raw_value()) << F);
+	using U = typename std::make_unsigned<I>::type;
+
+	I l = lhs.get_raw_value();
+	I r = rhs.get_raw_value();
+
+	bool negative = false;
+	U num = static_cast<U>(l);
+	U den = static_cast<U>(r);
+	if constexpr (std::is_signed_v<I>) {
+		if (l < 0) {
+			num = static_cast<U>(-num);
+			negative = not negative;
+		}
+		if (r < 0) {
+			den = static_cast<U>(-den);
+			negative = not negative;
+		}
+	}
+
+	// long division: integer part first, then one bit per fractional bit.
+	// the remainder is always < den, but shifting it may carry out the top bit.
+	U quotient = num / den;
+	U rem = num % den;
+	for (unsigned int i = 0; i < F; ++i) {
+		bool carry = (rem >> (sizeof(U) * CHAR_BIT - 1)) != 0;
+		rem <<= 1;
+		quotient <<= 1;
+		if (carry or rem >= den) {
+			rem -= den;
+			quotient |= 1;
+		}
+	}
+
+	if (negative) {
+		quotient = static_cast<U>(-quotient);
+		if (rem != 0) {
+			quotient -= 1;
+		}
+	}
+
+	return FixedPoint<I, F>::from_raw_value(static_cast<I>(quotient));
 }
 
 
@@ -1,12 +1,16 @@
-// Copyright 2016-2023 the openage authors. See copying.md for legal info.
+// Copyright 2016-2025 the openage authors. See copying.md for legal info.
 
 #include "fixed_point.h"
 
+#include <cmath>
 #include <cstdint>
+#include <vector>
 
+#include "../log/log.h"
 #include "../testing/testing.h"
-#include "stringformatter.h"
 #include "math_constants.h"
+#include "stringformatter.h"
+#include "timer.h"
 
 namespace openage {
 namespace util {
@@ -124,4 +128,136 @@ void fixed_point() {
 
 }
 
+
+void fixed_point_math() {
+	using TestType = FixedPoint<int64_t, 16>;
+
+	// deterministic functions must be usable at compile time
+	static_assert(TestType::from_int(16).sqrtfp() == TestType::from_int(4));
+	static_assert(TestType::from_int(4).inv_sqrtfp() == TestType::from_double(0.5));
+	static_assert(TestType::zero().sinfp() == TestType::zero());
+	static_assert(TestType::zero().cosfp() == TestType::from_int(1));
+	static_assert(TestType::from_int(3).hypotfp(TestType::from_int(4)) == TestType::from_int(5));
+
+	// division keeps the fractional part and rounds towards -inf
+	TESTEQUALS((TestType(7.5) / TestType(2)).to_double(), 3.75);
+	TESTEQUALS((TestType(-7.5) / TestType(2)).to_double(), -3.75);
+	TESTEQUALS((TestType(1) / TestType(3)).get_raw_value(), 21845);
+	TESTEQUALS((TestType(-1) / TestType(3)).get_raw_value(), -21846);
+	TESTEQUALS((TestType(7.5) % TestType(2)).to_double(), 1.5);
+	TESTEQUALS((TestType(-7.5) % TestType(2)).to_double(), 0.5);
+
+	// accuracy of the integer implementations
+	constexpr double eps = 1e-4;
+	for (int i = 0; i < 1000; ++i) {
+		double value = i * 0.37;
+		TestType fp = TestType::from_double(value);
+
+		TESTEQUALS_FLOAT(fp.sqrtfp().to_double(), std::sqrt(fp.to_double()), eps);
+		if (i > 0) {
+			TESTEQUALS_FLOAT(fp.inv_sqrtfp().to_double(), 1 / std::sqrt(fp.to_double()), eps);
+		}
+
+		TestType angle = TestType::from_double(value - 185.0);
+		TESTEQUALS_FLOAT(angle.sinfp().to_double(), std::sin(angle.to_double()), eps);
+		TESTEQUALS_FLOAT(angle.cosfp().to_double(), std::cos(angle.to_double()), eps);
+
+		TestType x = angle.cosfp() * (i + 1);
+		TestType y = angle.sinfp() * (i + 1);
+		TESTEQUALS_FLOAT(y.atan2fp(x).to_double(), std::atan2(y.to_double(), x.to_double()), eps);
+		TESTEQUALS_FLOAT(x.hypotfp(y).to_double(), std::hypot(x.to_double(), y.to_double()), eps * (i + 1));
+	}
+
+	// edge cases
+	TESTEQUALS(TestType(-1).sqrtfp(), TestType::zero());
+	TESTEQUALS(TestType::zero().inv_sqrtfp(), TestType::max_value());
+	TESTEQUALS(TestType::zero().atan2fp(TestType::zero()), TestType::zero());
+	TESTEQUALS_FLOAT(TestType::zero().atan2fp(TestType(-1)).to_double(), math::PI, eps);
+	TESTEQUALS_FLOAT(TestType(-1).atan2fp(TestType::zero()).to_double(), -math::PI_2, eps);
+	TESTEQUALS_FLOAT(TestType(1e6).sqrtfp().to_double(), 1e3, eps);
+	TESTEQUALS_FLOAT(TestType(1e6).hypotfp(TestType(1e6)).to_double(), 1e6 * math::SQRT_2, 0.1);
+
+	// huge angles are reduced without losing precision
+	TESTEQUALS_FLOAT(TestType::max_value().sinfp().to_double(), -0.0648695096, eps);
+	TESTEQUALS_FLOAT(TestType::max_value().cosfp().to_double(), -0.9978937552, eps);
+	TESTEQUALS_FLOAT(TestType::min_value().sinfp().to_double(), 0.0648847362, eps);
+	TESTEQUALS_FLOAT(TestType::min_value().cosfp().to_double(), -0.9978927653, eps);
+	TESTEQUALS_FLOAT(TestType(1000000).sinfp().to_double(), -0.3499935022, eps);
+	TESTEQUALS_FLOAT(TestType(1000000).cosfp().to_double(), 0.9367521275, eps);
+	TESTEQUALS_FLOAT(TestType(-123456789).sinfp().to_double(), -0.9901147518, eps);
+	TESTEQUALS_FLOAT(TestType(-123456789).cosfp().to_double(), 0.1402596815, eps);
+
+	// lengths that don't fit saturate
+	TESTEQUALS(TestType::min_value().hypotfp(TestType::zero()), TestType::max_value());
+	TESTEQUALS(TestType::zero().hypotfp(TestType::min_value()), TestType::max_value());
+	TESTEQUALS(TestType::max_value().hypotfp(TestType::max_value()), TestType::max_value());
+	TESTEQUALS(TestType::min_value().hypotfp(TestType::min_value()), TestType::max_value());
+	TESTEQUALS_FLOAT(TestType::max_value().hypotfp(TestType::zero()).to_double(),
+	                 TestType::max_value().to_double(),
+	                 TestType::max_value().to_double() * 1e-6);
+}
+
+
+void fixed_point_math_benchmark() {
+	using TestType = FixedPoint<int64_t, 16>;
+	constexpr int iterations = 1 << 20;
+
+	std::vector<TestType> inputs;
+	inputs.reserve(iterations);
+	for (int i = 0; i < iterations; ++i) {
+		inputs.push_back(TestType::from_raw_value((i * 2654435761ll) % (1000ll << 16)));
+	}
+
+	auto run = [&](const char *name, auto fixed, auto reference) {
+		Timer timer;
+		volatile double sink = 0;
+
+		timer.start();
+		for (auto &value : inputs) {
+			sink = sink + fixed(value).to_double();
+		}
+		double fixed_ns = static_cast<double>(timer.getandresetval()) / iterations;
+
+		timer.start();
+		for (auto &value : inputs) {
+			sink = sink + reference(value.to_double());
+		}
+		double double_ns = static_cast<double>(timer.getval()) / iterations;
+
+		double max_error = 0;
+		for (auto &value : inputs) {
+			max_error = std::max(max_error,
+			                     std::abs(fixed(value).to_double() - reference(value.to_double())));
+		}
+
+		log::log(INFO << name << ": fixed " << fixed_ns << " ns/op, double "
+		              << double_ns << " ns/op, max error " << max_error);
+	};
+
+	run(
+		"sqrt",
+		[](TestType v) { return v.sqrtfp(); },
+		[](double v) { return std::sqrt(v); });
+	run(
+		"inv_sqrt",
+		[](TestType v) { return (v + TestType(1)).inv_sqrtfp(); },
+		[](double v) { return 1 / std::sqrt(v + 1); });
+	run(
+		"sin",
+		[](TestType v) { return v.sinfp(); },
+		[](double v) { return std::sin(v); });
+	run(
+		"cos",
+		[](TestType v) { return v.cosfp(); },
+		[](double v) { return std::cos(v); });
+	run(
+		"atan2",
+		[](TestType v) { return v.atan2fp(TestType(500) - v); },
+		[](double v) { return std::atan2(v, 500 - v); });
+	run(
+		"hypot",
+		[](TestType v) { return v.hypotfp(TestType(500) - v); },
+		[](double v) { return std::hypot(v, 500 - v); });
+}
+
 }}} // openage::util::tests
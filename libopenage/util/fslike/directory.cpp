@@ -1,4 +1,4 @@
-// Copyright 2017-2024 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
 #include "directory.h"
 
@@ -32,7 +32,9 @@
 	#include <unistd.h>
 #endif
 
+#include "../../error/error.h"
 #include "../file.h"
+#include "../filelike/mmap.h"
 #include "../filelike/native.h"
 #include "../misc.h"
 #include "../path.h"
@@ -42,8 +44,9 @@
 namespace openage::util::fslike {
 
 
-Directory::Directory(std::string basepath, bool create_if_missing) :
-	basepath{std::move(basepath)} {
+Directory::Directory(std::string basepath, bool create_if_missing, bool use_mmap) :
+	basepath{std::move(basepath)},
+	use_mmap{use_mmap} {
 	if (create_if_missing) {
 		this->mkdirs({});
 	}
@@ -129,7 +132,11 @@ std::vector<Path::part_t> Directory::list(const Path::parts_t &parts) {
 
 	// walk over dir contents
 	while ((ent = readdir(dir)) != nullptr) {
-		ret.emplace_back(ent->d_name);
+		std::string name{ent->d_name};
+		if (name == "." or name == "..") {
+			continue;
+		}
+		ret.push_back(std::move(name));
 	}
 
 	closedir(dir);
@@ -173,8 +180,24 @@ bool Directory::mkdirs(const Path::parts_t &parts) {
 
 
 File Directory::open_r(const Path::parts_t &parts) {
+	std::string path = this->resolve(parts);
+
+	// small files are cheaper to read than to map
+	struct stat buf;
+	if (this->use_mmap
+	    and stat(path.c_str(), &buf) == 0
+	    and static_cast<uint64_t>(buf.st_size) >= MMAP_MIN_SIZE) {
+		try {
+			return File{std::make_shared<filelike::Mmap>(path)};
+		}
+		catch (const Error &) {
+			// e.g. pipes and other special files,
+			// which are read through a buffered stream instead
+		}
+	}
+
 	return File{
-		std::make_shared<filelike::Native>(this->resolve(parts),
+		std::make_shared<filelike::Native>(path,
 	                                       filelike::Native::mode_t::R)};
 }
 
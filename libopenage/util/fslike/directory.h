@@ -1,8 +1,9 @@
-// Copyright 2017-2024 the openage authors. See copying.md for legal info.
+// Copyright 2017-2025 the openage authors. See copying.md for legal info.
 
 #pragma once
 
 
+#include <cstdint>
 #include <string>
 #include <sys/stat.h>
 #include <tuple>
@@ -23,7 +24,18 @@ namespace fslike {
  */
 class Directory : public FSLike {
 public:
-	Directory(std::string basepath, bool create_if_missing = false);
+	/**
+	 * Create a filesystem-like object for a native directory.
+	 *
+	 * @param basepath Path to the directory.
+	 * @param create_if_missing Create the directory if it doesn't exist.
+	 * @param use_mmap Map files that are opened for reading into memory
+	 *                 instead of reading them through a stream. Files smaller
+	 *                 than \p MMAP_MIN_SIZE are always read through a stream.
+	 */
+	Directory(std::string basepath,
+	          bool create_if_missing = false,
+	          bool use_mmap = false);
 
 	bool is_file(const Path::parts_t &parts) override;
 	bool is_dir(const Path::parts_t &parts) override;
@@ -50,6 +62,12 @@ public:
 
 	static Directory get_temp_directory();
 
+	/**
+	 * Minimum size of files that are memory-mapped (in bytes). Mapping a file
+	 * and unmapping it again is more expensive than reading a few pages.
+	 */
+	static constexpr uint64_t MMAP_MIN_SIZE = 16 * 1024;
+
 protected:
 	/**
 	 * resolve the path to an actually usable one.
@@ -60,6 +78,11 @@ protected:
 	std::tuple<struct stat, int> do_stat(const Path::parts_t &parts) const;
 
 	std::string basepath;
+
+	/**
+	 * Whether files opened for reading are memory-mapped.
+	 */
+	bool use_mmap;
 };
 } // namespace fslike
 } // namespace util
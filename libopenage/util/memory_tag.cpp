@@ -0,0 +1,147 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "memory_tag.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+#include "log/log.h"
+#include "log/message.h"
+
+
+namespace openage::util {
+
+namespace {
+
+/**
+ * Counters of one tag. Each tag has its own cache line, so subsystems
+ * on different threads don't contend.
+ */
+struct alignas(64) tag_counters {
+	std::atomic<size_t> live_bytes{0};
+	std::atomic<size_t> peak_bytes{0};
+	std::atomic<size_t> allocations{0};
+	std::atomic<size_t> allocated_bytes{0};
+};
+
+std::array<tag_counters, memory_tag_count> counters;
+
+constexpr std::array<const char *, memory_tag_count> tag_names{
+	"pathfinding",
+	"curve",
+	"event",
+	"renderer",
+	"assets",
+};
+
+/**
+ * State of the previous \p log_memory_stats() call for calculating allocation rates.
+ */
+struct {
+	std::mutex mutex;
+	std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+	std::array<memory_stats, memory_tag_count> stats{};
+} last_log;
+
+/**
+ * Convert bytes to MiB for printing.
+ */
+double to_mib(size_t bytes) {
+	return static_cast<double>(bytes) / (1024 * 1024);
+}
+
+} // namespace
+
+
+const char *get_memory_tag_name(memory_tag tag) {
+	return tag_names[static_cast<size_t>(tag)];
+}
+
+
+void track_alloc(memory_tag tag, size_t bytes) {
+	if (bytes == 0) {
+		return;
+	}
+
+	auto &tag_counters = counters[static_cast<size_t>(tag)];
+	tag_counters.allocations.fetch_add(1, std::memory_order_relaxed);
+	tag_counters.allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+	size_t live = tag_counters.live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	size_t peak = tag_counters.peak_bytes.load(std::memory_order_relaxed);
+	while (live > peak
+	       and not tag_counters.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+	}
+}
+
+
+void track_free(memory_tag tag, size_t bytes) {
+	counters[static_cast<size_t>(tag)].live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+
+memory_stats get_memory_stats(memory_tag tag) {
+	auto &tag_counters = counters[static_cast<size_t>(tag)];
+	return memory_stats{
+		tag_counters.live_bytes.load(std::memory_order_relaxed),
+		tag_counters.peak_bytes.load(std::memory_order_relaxed),
+		tag_counters.allocations.load(std::memory_order_relaxed),
+		tag_counters.allocated_bytes.load(std::memory_order_relaxed),
+	};
+}
+
+
+void reset_memory_peaks() {
+	for (auto &tag_counters : counters) {
+		tag_counters.peak_bytes.store(tag_counters.live_bytes.load(std::memory_order_relaxed),
+		                              std::memory_order_relaxed);
+	}
+}
+
+
+std::string get_memory_report() {
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(2);
+	for (size_t i = 0; i < memory_tag_count; ++i) {
+		auto stats = get_memory_stats(static_cast<memory_tag>(i));
+		out << tag_names[i] << ": "
+		    << to_mib(stats.live_bytes) << " MiB live, "
+		    << to_mib(stats.peak_bytes) << " MiB peak, "
+		    << stats.allocations << " allocations\n";
+	}
+	return out.str();
+}
+
+
+void log_memory_stats() {
+	std::unique_lock lock{last_log.mutex};
+
+	auto now = std::chrono::steady_clock::now();
+	double seconds = std::chrono::duration<double>(now - last_log.time).count();
+	last_log.time = now;
+
+	for (size_t i = 0; i < memory_tag_count; ++i) {
+		auto stats = get_memory_stats(static_cast<memory_tag>(i));
+		auto &last = last_log.stats[i];
+
+		double alloc_rate = 0;
+		double byte_rate = 0;
+		if (seconds > 0) {
+			alloc_rate = (stats.allocations - last.allocations) / seconds;
+			byte_rate = to_mib(stats.allocated_bytes - last.allocated_bytes) / seconds;
+		}
+		last = stats;
+
+		log::log(INFO << "Memory " << tag_names[i] << ": "
+		              << to_mib(stats.live_bytes) << " MiB live, "
+		              << to_mib(stats.peak_bytes) << " MiB peak, "
+		              << alloc_rate << " allocations/s, "
+		              << byte_rate << " MiB/s allocated");
+	}
+}
+
+} // namespace openage::util
@@ -0,0 +1,220 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+
+namespace openage::util {
+
+/**
+ * Subsystems whose memory usage is accounted separately.
+ */
+enum class memory_tag : size_t {
+	pathfinding,
+	curve,
+	event,
+	renderer,
+	assets,
+};
+
+/**
+ * Number of memory tags.
+ */
+constexpr size_t memory_tag_count = 5;
+
+/**
+ * Memory usage of one tag.
+ */
+struct memory_stats {
+	/// Bytes that are currently allocated.
+	size_t live_bytes = 0;
+	/// Highest number of live bytes since the last \p reset_memory_peaks().
+	size_t peak_bytes = 0;
+	/// Number of allocations since the program started.
+	size_t allocations = 0;
+	/// Summed bytes of all allocations since the program started. Frees are not subtracted.
+	size_t allocated_bytes = 0;
+};
+
+/**
+ * Get the name of a memory tag.
+ *
+ * @param tag Memory tag.
+ *
+ * @return Name of the subsystem.
+ */
+const char *get_memory_tag_name(memory_tag tag);
+
+/**
+ * Account an allocation to a tag. Empty allocations are ignored.
+ *
+ * Thread-safe and lock-free.
+ *
+ * @param tag Memory tag.
+ * @param bytes Size of the allocation.
+ */
+void track_alloc(memory_tag tag, size_t bytes);
+
+/**
+ * Account a free to a tag.
+ *
+ * Thread-safe and lock-free.
+ *
+ * @param tag Memory tag.
+ * @param bytes Size of the freed allocation.
+ */
+void track_free(memory_tag tag, size_t bytes);
+
+/**
+ * Get the memory usage of a tag.
+ *
+ * @param tag Memory tag.
+ *
+ * @return Current statistics.
+ */
+memory_stats get_memory_stats(memory_tag tag);
+
+/**
+ * Set the peak bytes of all tags to their current live bytes.
+ */
+void reset_memory_peaks();
+
+/**
+ * Get the memory usage of all tags as text, one line per tag.
+ *
+ * @return Statistics of all tags.
+ */
+std::string get_memory_report();
+
+/**
+ * Log the memory usage of all tags.
+ *
+ * Allocation rates are calculated over the time since the previous call.
+ */
+void log_memory_stats();
+
+
+/**
+ * Allocator for standard containers that accounts the container memory to a tag.
+ *
+ * Memory is allocated with \p std::allocator, so containers with this allocator
+ * only differ in their type.
+ */
+template <typename T, memory_tag tag>
+class TaggedAllocator {
+public:
+	using value_type = T;
+
+	// needed because the tag is not a type parameter
+	template <typename U>
+	struct rebind {
+		using other = TaggedAllocator<U, tag>;
+	};
+
+	TaggedAllocator() noexcept = default;
+
+	template <typename U>
+	TaggedAllocator(const TaggedAllocator<U, tag> &) noexcept {}
+
+	T *allocate(size_t n) {
+		T *ptr = std::allocator<T>{}.allocate(n);
+		track_alloc(tag, n * sizeof(T));
+		return ptr;
+	}
+
+	void deallocate(T *ptr, size_t n) noexcept {
+		track_free(tag, n * sizeof(T));
+		std::allocator<T>{}.deallocate(ptr, n);
+	}
+
+	template <typename U>
+	bool operator==(const TaggedAllocator<U, tag> &) const noexcept {
+		return true;
+	}
+};
+
+
+/**
+ * Accounts a buffer that can't use a \p TaggedAllocator to a tag,
+ * e.g. because its type is part of an interface.
+ *
+ * Copies account the bytes again, moves transfer them.
+ */
+class MemoryCharge {
+public:
+	/**
+	 * Create a new charge.
+	 *
+	 * @param tag Memory tag.
+	 * @param bytes Size of the buffer.
+	 */
+	MemoryCharge(memory_tag tag, size_t bytes = 0) :
+		tag{tag},
+		bytes{bytes} {
+		track_alloc(this->tag, this->bytes);
+	}
+
+	MemoryCharge(const MemoryCharge &other) :
+		MemoryCharge{other.tag, other.bytes} {}
+
+	MemoryCharge(MemoryCharge &&other) noexcept :
+		tag{other.tag},
+		bytes{other.bytes} {
+		other.bytes = 0;
+	}
+
+	MemoryCharge &operator=(const MemoryCharge &other) {
+		if (this != &other) {
+			track_free(this->tag, this->bytes);
+			this->tag = other.tag;
+			this->bytes = other.bytes;
+			track_alloc(this->tag, this->bytes);
+		}
+		return *this;
+	}
+
+	MemoryCharge &operator=(MemoryCharge &&other) noexcept {
+		if (this != &other) {
+			track_free(this->tag, this->bytes);
+			this->tag = other.tag;
+			this->bytes = other.bytes;
+			other.bytes = 0;
+		}
+		return *this;
+	}
+
+	~MemoryCharge() {
+		track_free(this->tag, this->bytes);
+	}
+
+	/**
+	 * Change the size of the buffer.
+	 *
+	 * @param bytes New size of the buffer.
+	 */
+	void set(size_t bytes) {
+		if (bytes > this->bytes) {
+			track_alloc(this->tag, bytes - this->bytes);
+		}
+		else {
+			track_free(this->tag, this->bytes - bytes);
+		}
+		this->bytes = bytes;
+	}
+
+	/**
+	 * Get the accounted size of the buffer.
+	 */
+	size_t get() const {
+		return this->bytes;
+	}
+
+private:
+	memory_tag tag;
+	size_t bytes;
+};
+
+} // namespace openage::util
@@ -0,0 +1,51 @@
+// Copyright 2025-2025 the openage authors. See copying.md for legal info.
+
+#include "memory_tag.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../testing/testing.h"
+
+
+namespace openage::util::tests {
+
+void memory_tracking() {
+	constexpr auto tag = memory_tag::assets;
+	auto before = get_memory_stats(tag);
+
+	// containers account their capacity
+	{
+		std::vector<uint32_t, TaggedAllocator<uint32_t, tag>> values;
+		values.reserve(100);
+
+		auto stats = get_memory_stats(tag);
+		TESTEQUALS(stats.live_bytes - before.live_bytes, 100 * sizeof(uint32_t));
+		TESTEQUALS(stats.allocations - before.allocations, 1);
+		stats.peak_bytes >= stats.live_bytes or TESTFAIL;
+	}
+	TESTEQUALS(get_memory_stats(tag).live_bytes, before.live_bytes);
+
+	// copies of a charge account the bytes again, moves transfer them
+	{
+		MemoryCharge charge{tag, 1000};
+		TESTEQUALS(get_memory_stats(tag).live_bytes - before.live_bytes, 1000);
+
+		MemoryCharge copy{charge};
+		TESTEQUALS(get_memory_stats(tag).live_bytes - before.live_bytes, 2000);
+
+		MemoryCharge moved{std::move(copy)};
+		TESTEQUALS(get_memory_stats(tag).live_bytes - before.live_bytes, 2000);
+
+		moved.set(500);
+		TESTEQUALS(get_memory_stats(tag).live_bytes - before.live_bytes, 1500);
+	}
+	TESTEQUALS(get_memory_stats(tag).live_bytes, before.live_bytes);
+
+	// peaks are lowered to the live bytes
+	reset_memory_peaks();
+	TESTEQUALS(get_memory_stats(tag).peak_bytes, before.live_bytes);
+}
+
+} // namespace openage::util::tests
@@ -1,4 +1,4 @@
-// Copyright 2015-2024 the openage authors. See copying.md for legal info.
+// Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 #include "path.h"
 
@@ -52,8 +52,12 @@ Path::Path(const py::Obj &fsobj_in,
 
 	// test if fsobj is fslike.Directory
 	if (fslike::pyx_fs_is_fslike_directory.call(fsobj_in.get_ref())) {
+		// files are mostly read whole (assets, nyan files, ...),
+		// so map them into memory instead of streaming them
 		this->fsobj = std::make_shared<fslike::Directory>(
-			fsobj_in.getattr("path").bytes());
+			fsobj_in.getattr("path").bytes(),
+			false,
+			true);
 	}
 	else {
 		// we can't create a c++-variant of the path,
@@ -1,4 +1,4 @@
-# Copyright 2015-2024 the openage authors. See copying.md for legal info.
+# Copyright 2015-2025 the openage authors. See copying.md for legal info.
 
 """ Lists of all possible tests; enter your tests here. """
 
@@ -84,6 +84,8 @@ def tests_cpp():
     yield "openage::datastructure::tests::concurrent_queue"
     yield "openage::datastructure::tests::constexpr_map"
     yield "openage::datastructure::tests::pairing_heap"
+    yield "openage::datastructure::tests::seqlock"
+    yield "openage::datastructure::tests::spsc_queue"
     yield "openage::job::tests::test_job_manager"
     yield "openage::path::tests::path_node", "pathfinding"
     yield "openage::path::tests::flow_field", "pathfinding"
@@ -91,19 +93,32 @@ def tests_cpp():
     yield "openage::pyinterface::tests::err_py_to_cpp"
     yield "openage::renderer::tests::font"
     yield "openage::renderer::tests::font_manager"
+    yield "openage::renderer::resources::tests::binary_cache"
+    yield "openage::renderer::resources::tests::texture_atlas"
+    yield "openage::renderer::resources::tests::texture_data"
+    yield "openage::renderer::world::tests::sprite_batch"
+    yield "openage::renderer::world::tests::render_entity"
     yield "openage::rng::tests::run"
     yield "openage::util::tests::constinit_vector"
     yield "openage::util::tests::enum_"
     yield "openage::util::tests::fixed_point"
+    yield "openage::util::tests::fixed_point_math"
     yield "openage::util::tests::init"
     yield "openage::util::tests::matrix"
+    yield "openage::util::tests::memory_tracking"
     yield "openage::util::tests::quaternion"
     yield "openage::util::tests::vector"
     yield "openage::util::tests::siphash"
+    yield "openage::util::tests::mmap_file"
     yield "openage::util::tests::array_conversion"
     yield "openage::curve::tests::container"
     yield "openage::curve::tests::curve_types"
     yield "openage::event::tests::eventtrigger"
+    yield "openage::event::tests::eventstore"
+    yield "openage::event::tests::eventprofiler"
+    yield "openage::event::tests::eventsettle"
+    yield "openage::gamestate::tests::activity_node_table"
+    yield "openage::gamestate::replay::tests::record_stream"
 
 
 def demos_cpp():
@@ -137,3 +152,19 @@ def benchmark_cpp():
 
     # TODO Add a real benchmark here!
     yield ("openage::test::benchmark", "Test the benchmark")
+    yield ("openage::util::tests::fixed_point_math_benchmark",
+           "Fixed-point math functions vs. their double counterparts")
+    yield ("openage::time::tests::clock_benchmark",
+           "Clock reads with 1 writer and N reader threads")
+    yield ("openage::event::tests::eventstore_benchmark",
+           "Heap vs. calendar queue event store on an event trace")
+    yield ("openage::event::tests::eventloop_benchmark",
+           "Executing and creating events on the event loop")
+    yield ("openage::renderer::world::tests::render_entity_benchmark",
+           "Locked vs. lock-free render entity updates under contention")
+    yield ("openage::curve::tests::queue_benchmark",
+           "Insert/pop cycles on a curve queue with and without compaction")
+    yield ("openage::curve::tests::map_benchmark",
+           "Iterating a curve map with many killed elements with and without cleanup")
+    yield ("openage::curve::tests::interpolated_benchmark",
+           "Evaluating many curves one by one vs. in a batch")